@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
 #include <new>
+#include <optional>
 
+#include "common/common_types.h"
 #include "common/polyfill_thread.h"
 
 namespace Common {
@@ -200,6 +203,148 @@ private:
     std::mutex write_mutex;
 };
 
+/// Bounded multi-producer single-consumer ring. Producers claim slots with a CAS on the write
+/// index instead of serializing on a mutex. Each slot carries a sequence number that tells which
+/// lap of the ring it belongs to, and every blocking path sleeps with atomic wait/notify.
+template <typename T, size_t Capacity = detail::DefaultCapacity>
+class LockFreeMPSCQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+public:
+    LockFreeMPSCQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order::relaxed);
+        }
+    }
+
+    /// Returns the position of the element in the queue, or nothing if the queue is full.
+    template <typename... Args>
+    std::optional<size_t> TryEmplace(Args&&... args) {
+        return Emplace<PushMode::Try>(std::forward<Args>(args)...);
+    }
+
+    /// Returns the position of the element in the queue. Elements are popped in this order.
+    template <typename... Args>
+    size_t EmplaceWait(Args&&... args) {
+        return *Emplace<PushMode::Wait>(std::forward<Args>(args)...);
+    }
+
+    bool TryPop(T& t) {
+        const size_t read_index = m_read_index;
+        Slot& slot = m_slots[read_index % Capacity];
+        if (slot.sequence.load(std::memory_order::acquire) != read_index + 1) {
+            return false;
+        }
+
+        t = std::move(slot.data);
+
+        // Hand the slot over to the producers of the next lap.
+        m_read_index = read_index + 1;
+        slot.sequence.store(read_index + Capacity, std::memory_order::release);
+
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (m_waiting_producers.load(std::memory_order::relaxed) != 0) {
+            slot.sequence.notify_all();
+        }
+        return true;
+    }
+
+    void PopWait(T& t) {
+        PopWait(t, {});
+    }
+
+    bool PopWait(T& t, std::stop_token stop_token) {
+        while (!TryPop(t)) {
+            const u32 wakeup = m_consumer_wakeup.load(std::memory_order::acquire);
+            m_consumer_waiting.store(true, std::memory_order::relaxed);
+            std::atomic_thread_fence(std::memory_order::seq_cst);
+
+            // Check again now that producers are guaranteed to see the waiting flag.
+            if (TryPop(t)) {
+                m_consumer_waiting.store(false, std::memory_order::relaxed);
+                return true;
+            }
+
+            std::stop_callback callback(stop_token, [this] { WakeConsumer(); });
+            if (stop_token.stop_requested()) {
+                m_consumer_waiting.store(false, std::memory_order::relaxed);
+                return false;
+            }
+            m_consumer_wakeup.wait(wakeup, std::memory_order::acquire);
+            m_consumer_waiting.store(false, std::memory_order::relaxed);
+        }
+        return true;
+    }
+
+private:
+    enum class PushMode {
+        Try,
+        Wait,
+        Count,
+    };
+
+    struct Slot {
+        std::atomic_size_t sequence;
+        T data{};
+    };
+
+    template <PushMode Mode, typename... Args>
+    std::optional<size_t> Emplace(Args&&... args) {
+        size_t write_index = m_write_index.load(std::memory_order::relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &m_slots[write_index % Capacity];
+            const size_t sequence = slot->sequence.load(std::memory_order::acquire);
+            const auto lap_difference = static_cast<std::ptrdiff_t>(sequence - write_index);
+            if (lap_difference == 0) {
+                // The slot is free for this lap, try to claim it.
+                if (m_write_index.compare_exchange_weak(write_index, write_index + 1,
+                                                        std::memory_order::relaxed)) {
+                    break;
+                }
+            } else if (lap_difference < 0) {
+                // The slot still holds an element of the previous lap, so the queue is full.
+                if constexpr (Mode == PushMode::Try) {
+                    return std::nullopt;
+                } else if constexpr (Mode == PushMode::Wait) {
+                    m_waiting_producers.fetch_add(1, std::memory_order::seq_cst);
+                    slot->sequence.wait(sequence, std::memory_order::acquire);
+                    m_waiting_producers.fetch_sub(1, std::memory_order::relaxed);
+                    write_index = m_write_index.load(std::memory_order::relaxed);
+                } else {
+                    static_assert(Mode < PushMode::Count, "Invalid PushMode.");
+                }
+            } else {
+                // Another producer claimed the slot first.
+                write_index = m_write_index.load(std::memory_order::relaxed);
+            }
+        }
+
+        slot->data = T(std::forward<Args>(args)...);
+        slot->sequence.store(write_index + 1, std::memory_order::release);
+
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (m_consumer_waiting.load(std::memory_order::relaxed)) {
+            WakeConsumer();
+        }
+        return write_index;
+    }
+
+    void WakeConsumer() {
+        m_consumer_wakeup.fetch_add(1, std::memory_order::release);
+        m_consumer_wakeup.notify_one();
+    }
+
+    alignas(128) std::atomic_size_t m_write_index{0};
+    alignas(128) size_t m_read_index{0};
+    // Only written around sleeps, kept apart from the indices that change on every operation.
+    alignas(128) std::atomic_bool m_consumer_waiting{false};
+    std::atomic<u32> m_consumer_wakeup{0};
+    std::atomic<u32> m_waiting_producers{0};
+
+    std::array<Slot, Capacity> m_slots;
+};
+
 template <typename T, size_t Capacity = detail::DefaultCapacity>
 class MPMCQueue {
 public:
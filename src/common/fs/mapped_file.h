@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only memory mapping of a whole file.
+ * The mapping keeps the size the file had when it was opened, later appends are not visible.
+ */
+class MappedFile final {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at the given path.
+     * Check IsOpen() to know if the file could be mapped. An empty file is never mapped.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Unmaps the file, if it was mapped.
+     */
+    void Close();
+
+    /**
+     * Checks whether the file is mapped.
+     *
+     * @returns True if the file is mapped, false otherwise.
+     */
+    [[nodiscard]] bool IsOpen() const {
+        return data != nullptr;
+    }
+
+    /**
+     * Gets the mapped contents of the file.
+     *
+     * @returns A span over the file contents, empty if the file is not mapped.
+     */
+    [[nodiscard]] std::span<const u8> Data() const {
+        return {data, size};
+    }
+
+private:
+    const u8* data{};
+    size_t size{};
+#ifdef _WIN32
+    void* mapping_handle{};
+#endif
+};
+
+} // namespace Common::FS
@@ -49,6 +49,10 @@ public:
         Attach(item);
     }
 
+    [[nodiscard]] TickType GetTick(size_t id) const {
+        return item_pool[id].tick;
+    }
+
     void Free(size_t id) {
         auto& item = item_pool[id];
         Detach(item);
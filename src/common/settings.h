@@ -279,6 +279,9 @@ struct Values {
                                            true,
                                            &use_custom_cpu_ticks};
 
+    SwitchableSetting<bool> use_disk_jit_cache{linkage, false, "use_disk_jit_cache",
+                                               Category::Cpu};
+
     SwitchableSetting<bool> cpu_debug_mode{linkage, false, "cpu_debug_mode", Category::CpuDebug};
 
     Setting<bool> cpuopt_page_tables{linkage, true, "cpuopt_page_tables", Category::CpuDebug};
@@ -291,6 +294,10 @@ struct Values {
                                              Category::CpuDebug};
     Setting<bool> cpuopt_const_prop{linkage, true, "cpuopt_const_prop", Category::CpuDebug};
     Setting<bool> cpuopt_misc_ir{linkage, true, "cpuopt_misc_ir", Category::CpuDebug};
+    Setting<bool> cpuopt_live_range_reg_alloc{linkage, false, "cpuopt_live_range_reg_alloc",
+                                              Category::CpuDebug};
+    Setting<u32> cpuopt_hot_block_threshold{linkage, 0, "cpuopt_hot_block_threshold",
+                                            Category::CpuDebug};
     Setting<bool> cpuopt_reduce_misalign_checks{linkage, true, "cpuopt_reduce_misalign_checks",
                                                 Category::CpuDebug};
     SwitchableSetting<bool> cpuopt_fastmem{linkage, true, "cpuopt_fastmem", Category::CpuDebug};
@@ -472,6 +479,13 @@ struct Values {
                                                            VramUsageMode::Aggressive,
                                                            "vram_usage_mode",
                                                            Category::RendererAdvanced};
+    SwitchableSetting<u32, true> vram_budget{linkage,
+                                             0,
+                                             0,
+                                             65536,
+                                             "vram_budget",
+                                             Category::RendererAdvanced,
+                                             Specialization::Countable};
     SwitchableSetting<bool> skip_cpu_inner_invalidation{linkage,
                                                         false,
                                                         "skip_cpu_inner_invalidation",
@@ -531,6 +545,10 @@ struct Values {
                                                   true,
                                                   &use_fast_gpu_time};
 
+    SwitchableSetting<bool> use_streaming_pipeline_precompile{linkage, false,
+                                                              "use_streaming_pipeline_precompile",
+                                                              Category::RendererAdvanced};
+
     SwitchableSetting<bool> use_vulkan_driver_pipeline_cache{linkage,
                                                              true,
                                                              "use_vulkan_driver_pipeline_cache",
@@ -737,7 +755,11 @@ struct Values {
                                false};
     Setting<bool> dump_macros{
                               linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    Setting<bool> dump_gpu_capture{linkage, false, "dump_gpu_capture",
+                                   Category::DebuggingGraphics, Specialization::Default, false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
+    Setting<bool> dump_service_statistics{linkage, false, "dump_service_statistics",
+                                          Category::Debugging};
     Setting<bool> reporting_services{
                                      linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
@@ -745,6 +767,8 @@ struct Values {
                                     Category::DebuggingGraphics};
     Setting<bool> disable_macro_hle{linkage, false, "disable_macro_hle",
                                     Category::DebuggingGraphics};
+    Setting<bool> disable_macro_ir{linkage, false, "disable_macro_ir",
+                                   Category::DebuggingGraphics};
     Setting<bool> extended_logging{
                                    linkage, false, "extended_logging", Category::Debugging, Specialization::Default, false};
     Setting<bool> use_debug_asserts{linkage, false, "use_debug_asserts", Category::Debugging};
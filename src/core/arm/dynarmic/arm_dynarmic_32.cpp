@@ -228,6 +228,12 @@ std::shared_ptr<Dynarmic::A32::Jit> ArmDynarmic32::MakeJit(Common::PageTable* pa
         config.code_cache_size = std::uint32_t(8_MiB);
     }
 
+    // The live range register allocator is still experimental, it is only used when enabled in
+    // the CPU debug settings.
+    if (Settings::values.cpu_debug_mode && Settings::values.cpuopt_live_range_reg_alloc) {
+        config.optimizations |= Dynarmic::OptimizationFlag::LiveRangeRegAlloc;
+    }
+
     // Safe optimizations
     if (Settings::values.cpu_debug_mode) {
         if (!Settings::values.cpuopt_page_tables) {
@@ -8,6 +8,7 @@
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #include "core/arm/dynarmic/arm_dynarmic_64.h"
 #include "core/arm/dynarmic/dynarmic_exclusive_monitor.h"
+#include "core/arm/dynarmic/dynarmic_translation_cache.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_process.h"
 
@@ -269,6 +270,9 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
     config.wall_clock_cntpct = m_uses_wall_clock;
     config.enable_cycle_counting = !m_uses_wall_clock;
 
+    // Only the persistent translation cache consumes the compiled blocks
+    config.record_compiled_blocks = m_translation_cache != nullptr;
+
     // Code cache size
 #ifdef ARCHITECTURE_arm64
     config.code_cache_size = std::uint32_t(128_MiB);
@@ -287,6 +291,18 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
         config.code_cache_size = std::uint32_t(8_MiB);
     }
 
+    // The live range register allocator is still experimental, it is only used when enabled in
+    // the CPU debug settings.
+    if (Settings::values.cpu_debug_mode && Settings::values.cpuopt_live_range_reg_alloc) {
+        config.optimizations |= Dynarmic::OptimizationFlag::LiveRangeRegAlloc;
+    }
+
+    // Two-tier compilation is likewise opt-in, a block is recompiled with the full pipeline once
+    // it has run this many times.
+    if (Settings::values.cpu_debug_mode) {
+        config.hot_block_threshold = Settings::values.cpuopt_hot_block_threshold.GetValue();
+    }
+
     // Safe optimizations
     if (Settings::values.cpu_debug_mode) {
         if (!Settings::values.cpuopt_page_tables) {
@@ -376,8 +392,17 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
 HaltReason ArmDynarmic64::RunThread(Kernel::KThread* thread) {
     ScopedJitExecution sj(thread->GetOwnerProcess());
 
+    if (m_translation_cache) {
+        m_translation_cache->Precompile(*m_jit);
+    }
+
     m_jit->ClearExclusiveState();
-    return TranslateHaltReason(m_jit->Run());
+    const HaltReason hr = TranslateHaltReason(m_jit->Run());
+
+    if (m_translation_cache) {
+        m_translation_cache->Update(*m_jit);
+    }
+    return hr;
 }
 
 HaltReason ArmDynarmic64::StepThread(Kernel::KThread* thread) {
@@ -419,6 +444,13 @@ ArmDynarmic64::ArmDynarmic64(System& system, bool uses_wall_clock, Kernel::KProc
                              DynarmicExclusiveMonitor& exclusive_monitor, std::size_t core_index)
     : ArmInterface{uses_wall_clock}, m_system{system}, m_exclusive_monitor{exclusive_monitor},
       m_cb(std::make_unique<DynarmicCallbacks64>(*this, process)), m_core_index{core_index} {
+    if (Settings::values.use_disk_jit_cache.GetValue() && process->IsApplication() &&
+        !system.DebuggerEnabled()) {
+        m_translation_cache = std::make_unique<DynarmicTranslationCache>(
+            process->GetMemory(), process->GetProgramId(),
+            system.GetApplicationProcessBuildID(), core_index);
+    }
+
     auto& page_table = process->GetPageTable().GetBasePageTable();
     auto& page_table_impl = page_table.GetImpl();
     m_jit = MakeJit(&page_table_impl, page_table.GetAddressSpaceWidth());
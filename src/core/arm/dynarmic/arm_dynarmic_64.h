@@ -21,6 +21,7 @@ namespace Core {
 
 class DynarmicCallbacks64;
 class DynarmicExclusiveMonitor;
+class DynarmicTranslationCache;
 class System;
 
 class ArmDynarmic64 final : public ArmInterface {
@@ -65,6 +66,7 @@ private:
     std::size_t m_core_index{};
 
     std::shared_ptr<Dynarmic::A64::Jit> m_jit{};
+    std::unique_ptr<DynarmicTranslationCache> m_translation_cache{};
 
     // SVC callback
     u32 m_svc{};
@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <fstream>
+#include <unordered_map>
+
+#include <dynarmic/interface/A64/a64.h>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/hex_util.h"
+#include "common/logging/log.h"
+#include "core/arm/dynarmic/dynarmic_translation_cache.h"
+#include "core/memory.h"
+
+namespace Core {
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC_NUMBER{'d', 'y', 'n', 'c', 'a', 'c', 'h', 'e'};
+constexpr u32 CACHE_VERSION = 2;
+
+// Blocks larger than this are not cached; A64 translation never produces them.
+constexpr u64 MAX_BLOCK_SIZE = 64 * 1024;
+
+constexpr std::chrono::seconds FLUSH_INTERVAL{30};
+
+// Entries whose guest code could not be found this many sessions in a row are dropped. Code of
+// modules mapped after boot is looked up again at every flush, so it is only missed when the
+// module is never loaded.
+constexpr u32 MAX_MISSED_SESSIONS = 4;
+
+} // Anonymous namespace
+
+DynarmicTranslationCache::DynarmicTranslationCache(Memory::Memory& memory, u64 program_id,
+                                                   const std::array<u8, 0x20>& build_id,
+                                                   std::size_t core_index)
+    : m_memory{memory} {
+    const auto shader_dir{Common::FS::GetEdenPath(Common::FS::EdenPath::ShaderDir)};
+    const auto base_dir{shader_dir / fmt::format("{:016x}", program_id)};
+    if (!Common::FS::CreateDirs(base_dir)) {
+        LOG_ERROR(Core_ARM, "Failed to create translation cache directories");
+        return;
+    }
+    const auto build_id_str{Common::HexToString(build_id, false).substr(0, sizeof(u64) * 2)};
+    m_filename = base_dir / fmt::format("dynarmic_{}_core{}.bin", build_id_str, core_index);
+    m_last_flush = std::chrono::steady_clock::now();
+}
+
+DynarmicTranslationCache::~DynarmicTranslationCache() = default;
+
+void DynarmicTranslationCache::Precompile(Dynarmic::A64::Jit& jit) {
+    if (m_precompiled || m_filename.empty()) {
+        return;
+    }
+    m_precompiled = true;
+
+    std::vector<Entry> entries = ReadEntries();
+
+    // Later entries of a location were written after it was last resolved, keep only those.
+    std::unordered_map<u64, size_t> latest_index;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        latest_index[entries[i].location] = i;
+    }
+
+    std::vector<Entry> kept_entries;
+    kept_entries.reserve(latest_index.size());
+    size_t num_precompiled = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        Entry& entry = entries[i];
+        if (latest_index[entry.location] != i) {
+            continue;
+        }
+        if (TryPrecompile(jit, entry)) {
+            entry.missed_sessions = 0;
+            ++num_precompiled;
+        } else if (++entry.missed_sessions < MAX_MISSED_SESSIONS) {
+            // The code may belong to a module that is not mapped yet.
+            m_unresolved.emplace(entry.location, entry);
+        } else {
+            continue;
+        }
+        kept_entries.push_back(entry);
+    }
+    LOG_INFO(Core_ARM, "Precompiled {} of {} cached blocks, {} pending", num_precompiled,
+             kept_entries.size(), m_unresolved.size());
+
+    // Drop duplicate and expired entries and record the missed sessions of the unresolved ones.
+    if (kept_entries.size() != entries.size() || !m_unresolved.empty()) {
+        WriteEntries(kept_entries);
+    }
+}
+
+void DynarmicTranslationCache::Update(Dynarmic::A64::Jit& jit) {
+    if (m_filename.empty()) {
+        return;
+    }
+    const auto now{std::chrono::steady_clock::now()};
+    if (now - m_last_flush < FLUSH_INTERVAL) {
+        return;
+    }
+    m_last_flush = now;
+
+    std::vector<Entry> new_entries;
+
+    // Translate the cached blocks of modules mapped since the last flush. They are appended again
+    // so that the next session finds them resolved.
+    for (auto it = m_unresolved.begin(); it != m_unresolved.end();) {
+        if (!TryPrecompile(jit, it->second)) {
+            ++it;
+            continue;
+        }
+        Entry entry = it->second;
+        entry.missed_sessions = 0;
+        new_entries.push_back(entry);
+        it = m_unresolved.erase(it);
+    }
+
+    for (const Dynarmic::A64::CompiledBlock& block : jit.TakeCompiledBlocks()) {
+        if (m_known_locations.contains(block.location)) {
+            continue;
+        }
+        // Hash the guest code now, while it is guaranteed to still be mapped.
+        u64 code_hash{};
+        if (!HashGuestCode(block.start_address, block.size, code_hash)) {
+            continue;
+        }
+        new_entries.push_back(Entry{
+            .location = block.location,
+            .start_address = block.start_address,
+            .size = static_cast<u32>(block.size),
+            .missed_sessions = 0,
+            .code_hash = code_hash,
+        });
+        m_known_locations.insert(block.location);
+        m_unresolved.erase(block.location);
+    }
+    if (!new_entries.empty()) {
+        AppendEntries(new_entries);
+    }
+}
+
+bool DynarmicTranslationCache::TryPrecompile(Dynarmic::A64::Jit& jit, const Entry& entry) {
+    if (m_known_locations.contains(entry.location)) {
+        return true;
+    }
+    u64 code_hash{};
+    if (!HashGuestCode(entry.start_address, entry.size, code_hash) ||
+        code_hash != entry.code_hash) {
+        return false;
+    }
+    jit.PrecompileBlock(entry.location);
+    m_known_locations.insert(entry.location);
+    return true;
+}
+
+bool DynarmicTranslationCache::HashGuestCode(u64 start_address, u64 size, u64& out_hash) {
+    if (size == 0 || size > MAX_BLOCK_SIZE ||
+        !m_memory.IsValidVirtualAddressRange(start_address, size)) {
+        return false;
+    }
+    m_code_buffer.resize(size);
+    if (!m_memory.ReadBlock(start_address, m_code_buffer.data(), size)) {
+        return false;
+    }
+    out_hash = Common::CityHash64(reinterpret_cast<const char*>(m_code_buffer.data()), size);
+    return true;
+}
+
+std::vector<DynarmicTranslationCache::Entry> DynarmicTranslationCache::ReadEntries() try {
+    std::ifstream file(m_filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return {};
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{static_cast<size_t>(file.tellg())};
+    file.seekg(0, std::ios::beg);
+
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+    if (magic_number != MAGIC_NUMBER || cache_version != CACHE_VERSION) {
+        file.close();
+        LOG_INFO(Core_ARM, "Deleting invalid or outdated translation cache");
+        Common::FS::RemoveFile(m_filename);
+        return {};
+    }
+    const size_t header_size{magic_number.size() + sizeof(cache_version)};
+    std::vector<Entry> entries((end - header_size) / sizeof(Entry));
+    file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(Entry));
+    return entries;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Core_ARM, "Failed to read translation cache: {}", e.what());
+    Common::FS::RemoveFile(m_filename);
+    return {};
+}
+
+void DynarmicTranslationCache::WriteEntries(const std::vector<Entry>& entries) try {
+    // Write a new file and move it over the old one, so that an interrupted write loses nothing.
+    auto temp_filename{m_filename};
+    temp_filename += ".tmp";
+    {
+        std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR(Core_ARM, "Failed to open translation cache file {}",
+                      Common::FS::PathToUTF8String(temp_filename));
+            return;
+        }
+        file.exceptions(std::ofstream::failbit);
+        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+            .write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION))
+            .write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_filename, m_filename, ec);
+    if (ec) {
+        LOG_ERROR(Core_ARM, "Failed to replace translation cache: {}", ec.message());
+        Common::FS::RemoveFile(temp_filename);
+    }
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Core_ARM, "Failed to write translation cache: {}", e.what());
+}
+
+void DynarmicTranslationCache::AppendEntries(const std::vector<Entry>& entries) try {
+    std::ofstream file(m_filename, std::ios::binary | std::ios::ate | std::ios::app);
+    if (!file.is_open()) {
+        LOG_ERROR(Core_ARM, "Failed to open translation cache file {}",
+                  Common::FS::PathToUTF8String(m_filename));
+        return;
+    }
+    file.exceptions(std::ofstream::failbit);
+    if (file.tellp() == 0) {
+        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+            .write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    }
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Core_ARM, "Failed to write translation cache: {}", e.what());
+}
+
+} // namespace Core
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Dynarmic::A64 {
+class Jit;
+}
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace Core {
+
+/**
+ * Persists the set of guest blocks translated by a dynarmic instance, keyed by program ID and
+ * main module build ID. On the next boot of the same build, blocks whose guest code still hashes
+ * to the recorded value are translated up front instead of when the guest first reaches them.
+ */
+class DynarmicTranslationCache {
+public:
+    explicit DynarmicTranslationCache(Memory::Memory& memory, u64 program_id,
+                                      const std::array<u8, 0x20>& build_id,
+                                      std::size_t core_index);
+    ~DynarmicTranslationCache();
+
+    /// Translates every cached block that is still valid for the current guest memory. Blocks whose
+    /// code is not mapped yet are kept pending.
+    void Precompile(Dynarmic::A64::Jit& jit);
+
+    /// Translates the pending blocks whose code got mapped and appends newly translated blocks to
+    /// the cache file, at most once per flush interval.
+    /// The JIT instance must have been created with record_compiled_blocks set.
+    void Update(Dynarmic::A64::Jit& jit);
+
+private:
+    struct Entry {
+        u64 location;
+        u64 start_address;
+        u32 size;
+        /// Consecutive sessions in which the guest code of the block was not found.
+        u32 missed_sessions;
+        u64 code_hash;
+    };
+    static_assert(sizeof(Entry) == 0x20);
+
+    bool TryPrecompile(Dynarmic::A64::Jit& jit, const Entry& entry);
+    bool HashGuestCode(u64 start_address, u64 size, u64& out_hash);
+    std::vector<Entry> ReadEntries();
+    void WriteEntries(const std::vector<Entry>& entries);
+    void AppendEntries(const std::vector<Entry>& entries);
+
+    Memory::Memory& m_memory;
+    std::filesystem::path m_filename;
+    std::unordered_set<u64> m_known_locations;
+    std::unordered_map<u64, Entry> m_unresolved;
+    std::vector<u8> m_code_buffer;
+    std::chrono::steady_clock::time_point m_last_flush{};
+    bool m_precompiled{};
+};
+
+} // namespace Core
@@ -45,6 +45,7 @@
 #include "core/hle/service/psc/time/system_clock.h"
 #include "core/hle/service/psc/time/time_zone_service.h"
 #include "core/hle/service/service.h"
+#include "core/hle/service/service_statistics.h"
 #include "core/hle/service/services.h"
 #include "core/hle/service/set/system_settings_server.h"
 #include "core/hle/service/sm/sm.h"
@@ -293,6 +294,22 @@ struct System::Impl {
     }
 
 
+    SystemResultStatus SetupForGPUReplay(System& system, Frontend::EmuWindow& emu_window) {
+        InitializeKernel(system);
+
+        host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
+        gpu_core = VideoCore::CreateGPU(emu_window, system);
+        if (!gpu_core) {
+            return SystemResultStatus::ErrorVideoCore;
+        }
+
+        is_powered_on = true;
+        perf_stats = std::make_unique<PerfStats>(0);
+        perf_stats->BeginSystemFrame();
+
+        return SystemResultStatus::Success;
+    }
+
     void LoadOverrides(u64 programId) const {
         std::string vendor = gpu_core->Renderer().GetDeviceVendor();
         LOG_INFO(Core, "GPU Vendor: {}", vendor);
@@ -441,6 +458,10 @@ struct System::Impl {
         kernel.ShutdownCores();
         services.reset();
         service_manager.reset();
+        if (Settings::values.dump_service_statistics.GetValue()) {
+            service_statistics.Dump();
+        }
+        service_statistics.Reset();
         fs_controller.Reset();
         cheat_engine.reset();
         core_timing.ClearPendingEvents();
@@ -518,6 +539,8 @@ struct System::Impl {
     bool nvdec_active{};
 
     Reporter reporter;
+    /// Outlives the services, which keep references to their entries.
+    Service::ServiceStatistics service_statistics;
     std::unique_ptr<Memory::CheatEngine> cheat_engine;
     std::unique_ptr<Tools::Freezer> memory_freezer;
     std::array<u8, 0x20> build_id{};
@@ -640,6 +663,10 @@ SystemResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::stri
     return impl->Load(*this, emu_window, filepath, params);
 }
 
+SystemResultStatus System::SetupForGPUReplay(Frontend::EmuWindow& emu_window) {
+    return impl->SetupForGPUReplay(*this, emu_window);
+}
+
 bool System::IsPoweredOn() const {
     return impl->is_powered_on.load(std::memory_order::relaxed);
 }
@@ -876,6 +903,14 @@ const Reporter& System::GetReporter() const {
     return impl->reporter;
 }
 
+Service::ServiceStatistics& System::GetServiceStatistics() {
+    return impl->service_statistics;
+}
+
+const Service::ServiceStatistics& System::GetServiceStatistics() const {
+    return impl->service_statistics;
+}
+
 Service::Glue::ARPManager& System::GetARPManager() {
     return impl->arp_manager;
 }
@@ -76,6 +76,7 @@ class ARPManager;
 }
 
 class ServerManager;
+class ServiceStatistics;
 
 namespace SM {
 class ServiceManager;
@@ -209,6 +210,13 @@ public:
                                           const std::string& filepath,
                                           Service::AM::FrontendAppletParameters& params);
 
+    /**
+     * Sets up the GPU without loading an application, used to replay GPU captures.
+     * @param emu_window Reference to the host-system window used for video output.
+     * @returns SystemResultStatus code, indicating if the operation succeeded.
+     */
+    [[nodiscard]] SystemResultStatus SetupForGPUReplay(Frontend::EmuWindow& emu_window);
+
     /**
      * Indicates if the emulated system is powered on (all subsystems initialized and able to run an
      * application).
@@ -367,6 +375,10 @@ public:
 
     [[nodiscard]] const Reporter& GetReporter() const;
 
+    /// Provides a reference to the per-command statistics of the HLE services.
+    [[nodiscard]] Service::ServiceStatistics& GetServiceStatistics();
+    [[nodiscard]] const Service::ServiceStatistics& GetServiceStatistics() const;
+
     [[nodiscard]] Service::Glue::ARPManager& GetARPManager();
     [[nodiscard]] const Service::Glue::ARPManager& GetARPManager() const;
 
@@ -0,0 +1,416 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/assert.h"
+#include "common/swap.h"
+#include "core/crypto/aes_native.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace Core::Crypto {
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 0x10;
+/// Blocks in flight at once, enough to hide the latency of the AES instructions
+constexpr std::size_t PARALLEL_BLOCKS = 8;
+
+constexpr u8 Multiply(u8 a, u8 b) {
+    u8 result = 0;
+    while (b != 0) {
+        if ((b & 1) != 0) {
+            result ^= a;
+        }
+        a = static_cast<u8>((a << 1) ^ ((a & 0x80) != 0 ? 0x1B : 0));
+        b >>= 1;
+    }
+    return result;
+}
+
+constexpr u8 RotateLeft(u8 value, int amount) {
+    return static_cast<u8>((value << amount) | (value >> (8 - amount)));
+}
+
+constexpr std::array<u8, 256> MakeSbox() {
+    std::array<u8, 256> sbox{};
+    for (std::size_t value = 0; value < sbox.size(); ++value) {
+        // The multiplicative inverse is value^254, zero maps to zero
+        u8 inverse = 1;
+        u8 square = static_cast<u8>(value);
+        for (u32 exponent = 254; exponent != 0; exponent >>= 1) {
+            if ((exponent & 1) != 0) {
+                inverse = Multiply(inverse, square);
+            }
+            square = Multiply(square, square);
+        }
+        sbox[value] = static_cast<u8>(inverse ^ RotateLeft(inverse, 1) ^ RotateLeft(inverse, 2) ^
+                                      RotateLeft(inverse, 3) ^ RotateLeft(inverse, 4) ^ 0x63);
+    }
+    return sbox;
+}
+
+constexpr std::array<u8, 256> SBOX = MakeSbox();
+static_assert(SBOX[0x00] == 0x63 && SBOX[0x53] == 0xED && SBOX[0xFF] == 0x16);
+
+std::array<u8, 16> InvMixColumns(const std::array<u8, 16>& key) {
+    std::array<u8, 16> result;
+    for (std::size_t column = 0; column < 16; column += 4) {
+        const u8 a0 = key[column + 0];
+        const u8 a1 = key[column + 1];
+        const u8 a2 = key[column + 2];
+        const u8 a3 = key[column + 3];
+        result[column + 0] = static_cast<u8>(Multiply(a0, 14) ^ Multiply(a1, 11) ^
+                                             Multiply(a2, 13) ^ Multiply(a3, 9));
+        result[column + 1] = static_cast<u8>(Multiply(a0, 9) ^ Multiply(a1, 14) ^
+                                             Multiply(a2, 11) ^ Multiply(a3, 13));
+        result[column + 2] = static_cast<u8>(Multiply(a0, 13) ^ Multiply(a1, 9) ^
+                                             Multiply(a2, 14) ^ Multiply(a3, 11));
+        result[column + 3] = static_cast<u8>(Multiply(a0, 11) ^ Multiply(a1, 13) ^
+                                             Multiply(a2, 9) ^ Multiply(a3, 14));
+    }
+    return result;
+}
+
+/// Big endian 128-bit counter
+struct Counter {
+    u64 high;
+    u64 low;
+
+    static Counter FromBytes(std::span<const u8, 16> bytes) {
+        u64 high;
+        u64 low;
+        std::memcpy(&high, bytes.data(), sizeof(high));
+        std::memcpy(&low, bytes.data() + sizeof(high), sizeof(low));
+        return {Common::swap64(high), Common::swap64(low)};
+    }
+
+    Counter Add(u64 amount) const {
+        const u64 sum = low + amount;
+        return {high + (sum < low ? 1 : 0), sum};
+    }
+
+    std::array<u8, 16> ToBytes() const {
+        std::array<u8, 16> bytes;
+        const u64 swapped_high = Common::swap64(high);
+        const u64 swapped_low = Common::swap64(low);
+        std::memcpy(bytes.data(), &swapped_high, sizeof(swapped_high));
+        std::memcpy(bytes.data() + sizeof(swapped_high), &swapped_low, sizeof(swapped_low));
+        return bytes;
+    }
+};
+
+#if defined(ARCHITECTURE_x86_64)
+
+using Block = __m128i;
+
+struct RoundKeys {
+    Block keys[11];
+};
+
+Block Load(const void* src) {
+    return _mm_loadu_si128(static_cast<const __m128i*>(src));
+}
+
+void Store(void* dest, Block block) {
+    _mm_storeu_si128(static_cast<__m128i*>(dest), block);
+}
+
+Block Xor(Block lhs, Block rhs) {
+    return _mm_xor_si128(lhs, rhs);
+}
+
+/// Multiplies an XTS tweak by x in GF(2^128)
+Block MultiplyTweak(Block tweak) {
+    const __m128i carries =
+        _mm_and_si128(_mm_srai_epi32(tweak, 31), _mm_set_epi32(0x87, 1, 1, 1));
+    return _mm_xor_si128(_mm_slli_epi32(tweak, 1), _mm_shuffle_epi32(carries, 0x93));
+}
+
+template <std::size_t N>
+void EncryptBlocks(Block (&blocks)[N], const RoundKeys& keys) {
+    for (Block& block : blocks) {
+        block = _mm_xor_si128(block, keys.keys[0]);
+    }
+    for (std::size_t round = 1; round < 10; ++round) {
+        for (Block& block : blocks) {
+            block = _mm_aesenc_si128(block, keys.keys[round]);
+        }
+    }
+    for (Block& block : blocks) {
+        block = _mm_aesenclast_si128(block, keys.keys[10]);
+    }
+}
+
+template <std::size_t N>
+void DecryptBlocks(Block (&blocks)[N], const RoundKeys& keys) {
+    for (Block& block : blocks) {
+        block = _mm_xor_si128(block, keys.keys[0]);
+    }
+    for (std::size_t round = 1; round < 10; ++round) {
+        for (Block& block : blocks) {
+            block = _mm_aesdec_si128(block, keys.keys[round]);
+        }
+    }
+    for (Block& block : blocks) {
+        block = _mm_aesdeclast_si128(block, keys.keys[10]);
+    }
+}
+
+bool DetectNativeAes() {
+    const auto& caps = Common::GetCPUCaps();
+    return caps.aes && caps.sse4_1;
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+using Block = uint8x16_t;
+
+struct RoundKeys {
+    Block keys[11];
+};
+
+Block Load(const void* src) {
+    return vld1q_u8(static_cast<const u8*>(src));
+}
+
+void Store(void* dest, Block block) {
+    vst1q_u8(static_cast<u8*>(dest), block);
+}
+
+Block Xor(Block lhs, Block rhs) {
+    return veorq_u8(lhs, rhs);
+}
+
+/// Multiplies an XTS tweak by x in GF(2^128)
+Block MultiplyTweak(Block tweak) {
+    static constexpr u32 CARRY_VALUES[4]{1, 1, 1, 0x87};
+    const uint32x4_t words = vreinterpretq_u32_u8(tweak);
+    const uint32x4_t carries = vandq_u32(
+        vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(words), 31)),
+        vld1q_u32(CARRY_VALUES));
+    return vreinterpretq_u8_u32(veorq_u32(vshlq_n_u32(words, 1), vextq_u32(carries, carries, 3)));
+}
+
+template <std::size_t N>
+void EncryptBlocks(Block (&blocks)[N], const RoundKeys& keys) {
+    for (std::size_t round = 0; round < 9; ++round) {
+        for (Block& block : blocks) {
+            block = vaesmcq_u8(vaeseq_u8(block, keys.keys[round]));
+        }
+    }
+    for (Block& block : blocks) {
+        block = veorq_u8(vaeseq_u8(block, keys.keys[9]), keys.keys[10]);
+    }
+}
+
+template <std::size_t N>
+void DecryptBlocks(Block (&blocks)[N], const RoundKeys& keys) {
+    for (std::size_t round = 0; round < 9; ++round) {
+        for (Block& block : blocks) {
+            block = vaesimcq_u8(vaesdq_u8(block, keys.keys[round]));
+        }
+    }
+    for (Block& block : blocks) {
+        block = veorq_u8(vaesdq_u8(block, keys.keys[9]), keys.keys[10]);
+    }
+}
+
+bool DetectNativeAes() {
+#if defined(__APPLE__)
+    return true;
+#elif defined(_WIN32)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+
+RoundKeys LoadKeys(const std::array<std::array<u8, 16>, 11>& round_keys) {
+    RoundKeys keys;
+    for (std::size_t round = 0; round < round_keys.size(); ++round) {
+        keys.keys[round] = Load(round_keys[round].data());
+    }
+    return keys;
+}
+
+Block LoadCounter(const Counter& counter) {
+    const std::array<u8, 16> bytes = counter.ToBytes();
+    return Load(bytes.data());
+}
+
+template <std::size_t N>
+void TranscodeCtrBlocks(const RoundKeys& keys, const Counter& counter, const u8* src,
+                        u8* dest) {
+    Block blocks[N];
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = LoadCounter(counter.Add(i));
+    }
+    EncryptBlocks(blocks, keys);
+    for (std::size_t i = 0; i < N; ++i) {
+        Store(dest + i * BLOCK_SIZE, Xor(blocks[i], Load(src + i * BLOCK_SIZE)));
+    }
+}
+
+template <std::size_t N>
+void TranscodeXtsBlocks(const RoundKeys& keys, Block& tweak, const u8* src, u8* dest,
+                        Op op) {
+    Block tweaks[N];
+    Block blocks[N];
+    for (std::size_t i = 0; i < N; ++i) {
+        tweaks[i] = tweak;
+        tweak = MultiplyTweak(tweak);
+        blocks[i] = Xor(Load(src + i * BLOCK_SIZE), tweaks[i]);
+    }
+    if (op == Op::Encrypt) {
+        EncryptBlocks(blocks, keys);
+    } else {
+        DecryptBlocks(blocks, keys);
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        Store(dest + i * BLOCK_SIZE, Xor(blocks[i], tweaks[i]));
+    }
+}
+
+void TranscodeXtsUnit(const RoundKeys& keys, Block tweak, const u8* src, u8* dest,
+                      std::size_t size, Op op) {
+    const std::size_t group_size = PARALLEL_BLOCKS * BLOCK_SIZE;
+    std::size_t offset = 0;
+    for (; offset + group_size <= size; offset += group_size) {
+        TranscodeXtsBlocks<PARALLEL_BLOCKS>(keys, tweak, src + offset, dest + offset, op);
+    }
+    for (; offset < size; offset += BLOCK_SIZE) {
+        TranscodeXtsBlocks<1>(keys, tweak, src + offset, dest + offset, op);
+    }
+}
+
+#endif
+
+} // Anonymous namespace
+
+bool IsNativeAesSupported() {
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+    static const bool is_supported = DetectNativeAes();
+    return is_supported;
+#else
+    return false;
+#endif
+}
+
+NativeAesKey ExpandNativeAesKey(std::span<const u8, 16> key) {
+    std::array<u8, 16 * 11> words;
+    std::memcpy(words.data(), key.data(), key.size());
+
+    u8 round_constant = 1;
+    for (std::size_t i = key.size(); i < words.size(); i += 4) {
+        std::array<u8, 4> temp{words[i - 4], words[i - 3], words[i - 2], words[i - 1]};
+        if (i % key.size() == 0) {
+            temp = {
+                static_cast<u8>(SBOX[temp[1]] ^ round_constant),
+                SBOX[temp[2]],
+                SBOX[temp[3]],
+                SBOX[temp[0]],
+            };
+            round_constant = Multiply(round_constant, 2);
+        }
+        for (std::size_t j = 0; j < temp.size(); ++j) {
+            words[i + j] = static_cast<u8>(words[i - key.size() + j] ^ temp[j]);
+        }
+    }
+
+    NativeAesKey result;
+    for (std::size_t round = 0; round < result.encrypt.size(); ++round) {
+        std::memcpy(result.encrypt[round].data(), words.data() + round * 16, 16);
+    }
+    result.decrypt[0] = result.encrypt[10];
+    for (std::size_t round = 1; round < 10; ++round) {
+        result.decrypt[round] = InvMixColumns(result.encrypt[10 - round]);
+    }
+    result.decrypt[10] = result.encrypt[0];
+    return result;
+}
+
+void NativeAesCtr(const NativeAesKey& key, std::span<const u8, 16> counter, const u8* src,
+                  u8* dest, std::size_t size) {
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+    const RoundKeys keys = LoadKeys(key.encrypt);
+    Counter current = Counter::FromBytes(counter);
+
+    const std::size_t group_size = PARALLEL_BLOCKS * BLOCK_SIZE;
+    std::size_t offset = 0;
+    for (; offset + group_size <= size; offset += group_size) {
+        TranscodeCtrBlocks<PARALLEL_BLOCKS>(keys, current, src + offset, dest + offset);
+        current = current.Add(PARALLEL_BLOCKS);
+    }
+    for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+        TranscodeCtrBlocks<1>(keys, current, src + offset, dest + offset);
+        current = current.Add(1);
+    }
+    if (offset < size) {
+        // Transcode the partial last block through a full one
+        std::array<u8, BLOCK_SIZE> block{};
+        std::memcpy(block.data(), src + offset, size - offset);
+        TranscodeCtrBlocks<1>(keys, current, block.data(), block.data());
+        std::memcpy(dest + offset, block.data(), size - offset);
+    }
+#else
+    UNREACHABLE_MSG("Native AES is not supported on this architecture");
+#endif
+}
+
+void NativeAesXts(const NativeAesKey& data_key, const NativeAesKey& tweak_key,
+                  std::span<const u8, 16> tweak, std::size_t unit_size, const u8* src, u8* dest,
+                  std::size_t size, Op op) {
+    ASSERT(unit_size != 0 && unit_size % BLOCK_SIZE == 0);
+    ASSERT(size % BLOCK_SIZE == 0);
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+    const RoundKeys keys =
+        LoadKeys(op == Op::Encrypt ? data_key.encrypt : data_key.decrypt);
+    const RoundKeys tweak_keys = LoadKeys(tweak_key.encrypt);
+    Counter current = Counter::FromBytes(tweak);
+
+    std::size_t offset = 0;
+    while (offset < size) {
+        // Encrypt the tweaks of the next units together
+        Block tweaks[PARALLEL_BLOCKS];
+        for (std::size_t i = 0; i < PARALLEL_BLOCKS; ++i) {
+            tweaks[i] = LoadCounter(current.Add(i));
+        }
+        EncryptBlocks(tweaks, tweak_keys);
+
+        const std::size_t num_units =
+            std::min(PARALLEL_BLOCKS, (size - offset + unit_size - 1) / unit_size);
+        for (std::size_t unit = 0; unit < num_units; ++unit) {
+            const std::size_t unit_length = std::min(unit_size, size - offset);
+            TranscodeXtsUnit(keys, tweaks[unit], src + offset, dest + offset, unit_length, op);
+            offset += unit_length;
+        }
+        current = current.Add(num_units);
+    }
+#else
+    UNREACHABLE_MSG("Native AES is not supported on this architecture");
+#endif
+}
+
+} // namespace Core::Crypto
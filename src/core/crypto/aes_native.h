@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+
+namespace Core::Crypto {
+
+/// AES-128 round keys in the layout used by the AES instructions of the host
+struct alignas(16) NativeAesKey {
+    std::array<std::array<u8, 16>, 11> encrypt;
+    /// Round keys of the equivalent inverse cipher
+    std::array<std::array<u8, 16>, 11> decrypt;
+};
+
+/// Returns true when the host CPU has the AES instructions used by the native paths
+[[nodiscard]] bool IsNativeAesSupported();
+
+[[nodiscard]] NativeAesKey ExpandNativeAesKey(std::span<const u8, 16> key);
+
+/**
+ * Transcodes data in CTR mode, eight blocks at a time.
+ * The counter is a big endian 128-bit integer incremented for every block. The size does not have
+ * to be a multiple of the block size.
+ */
+void NativeAesCtr(const NativeAesKey& key, std::span<const u8, 16> counter, const u8* src,
+                  u8* dest, std::size_t size);
+
+/**
+ * Transcodes consecutive XTS data units of unit_size bytes.
+ * The tweak of the first unit is a big endian 128-bit integer incremented for every following
+ * unit, the last unit may be shorter. Both sizes must be multiples of the block size.
+ */
+void NativeAesXts(const NativeAesKey& data_key, const NativeAesKey& tweak_key,
+                  std::span<const u8, 16> tweak, std::size_t unit_size, const u8* src, u8* dest,
+                  std::size_t size, Op op);
+
+} // namespace Core::Crypto
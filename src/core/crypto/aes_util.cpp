@@ -5,6 +5,7 @@
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_native.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -20,6 +21,14 @@ NintendoTweak CalculateNintendoTweak(std::size_t sector_id) {
     }
     return out;
 }
+
+void AddToCounter(std::array<u8, 16>& counter, std::size_t amount) {
+    for (std::size_t i = 0xF; i <= 0xF && amount != 0; --i) {
+        amount += counter[i];
+        counter[i] = static_cast<u8>(amount);
+        amount >>= 8;
+    }
+}
 } // Anonymous namespace
 
 static_assert(static_cast<std::size_t>(Mode::CTR) ==
@@ -36,6 +45,12 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // CTR and XTS use the AES instructions of the host instead of mbedtls when available
+    bool use_native{};
+    Mode mode{};
+    std::array<NativeAesKey, 2> native_keys{};
+    std::array<u8, 16> iv{};
 };
 
 template <typename Key, std::size_t KeySize>
@@ -57,6 +72,17 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+    ctx->mode = mode;
+    if (IsNativeAesSupported() && ((mode == Mode::CTR && KeySize == 0x10) ||
+                                   (mode == Mode::XTS && KeySize == 0x20))) {
+        // XTS keys hold the data key followed by the tweak key
+        ctx->use_native = true;
+        for (std::size_t i = 0; i < KeySize / 0x10; ++i) {
+            ctx->native_keys[i] =
+                ExpandNativeAesKey(std::span<const u8, 16>(key.data() + i * 0x10, 0x10));
+        }
+    }
 }
 
 template <typename Key, std::size_t KeySize>
@@ -67,6 +93,20 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->use_native) {
+        if (ctx->mode == Mode::CTR) {
+            NativeAesCtr(ctx->native_keys[0], ctx->iv, src, dest, size);
+            // Continue from the next block like mbedtls does
+            AddToCounter(ctx->iv, (size + 0xF) / 0x10);
+            return;
+        }
+        if (size % 0x10 == 0) {
+            NativeAesXts(ctx->native_keys[0], ctx->native_keys[1], ctx->iv, size, src, dest, size,
+                         op);
+            return;
+        }
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -111,14 +151,33 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
     ASSERT_MSG(size % sector_size == 0, "XTS decryption size must be a multiple of sector size.");
 
+    XTSTranscode(src, size, dest, CalculateNintendoTweak(sector_id), sector_size, op);
+}
+
+template <typename Key, std::size_t KeySize>
+void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8* dest,
+                                           std::span<const u8, 16> tweak, std::size_t sector_size,
+                                           Op op) {
+    if (ctx->use_native && size % 0x10 == 0 && sector_size % 0x10 == 0) {
+        NativeAesXts(ctx->native_keys[0], ctx->native_keys[1], tweak, sector_size, src, dest, size,
+                     op);
+        return;
+    }
+
+    std::array<u8, 16> sector_tweak;
+    std::memcpy(sector_tweak.data(), tweak.data(), sector_tweak.size());
     for (std::size_t i = 0; i < size; i += sector_size) {
-        SetIV(CalculateNintendoTweak(sector_id++));
-        Transcode(src + i, sector_size, dest + i, op);
+        SetIV(sector_tweak);
+        Transcode(src + i, (std::min)(sector_size, size - i), dest + i, op);
+        AddToCounter(sector_tweak, 1);
     }
 }
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
+    if (data.size() == ctx->iv.size()) {
+        std::memcpy(ctx->iv.data(), data.data(), ctx->iv.size());
+    }
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
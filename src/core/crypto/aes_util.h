@@ -56,6 +56,11 @@ public:
     void XTSTranscode(const u8* src, std::size_t size, u8* dest, std::size_t sector_id,
                       std::size_t sector_size, Op op);
 
+    // Transcodes consecutive sectors starting from a big endian tweak that is incremented for
+    // every sector. The last sector may be shorter.
+    void XTSTranscode(const u8* src, std::size_t size, u8* dest, std::span<const u8, 16> tweak,
+                      std::size_t sector_size, Op op);
+
 private:
     std::unique_ptr<CipherContext> ctx;
 };
@@ -55,6 +55,10 @@ public:
 
     void Unmap(DAddr address, size_t size);
 
+    /// Backs device addresses with device memory directly, without a guest process behind them.
+    /// Used to replay GPU captures, where the memory has no CPU side owner.
+    void MapDeviceMemory(DAddr address, PAddr physical_address, size_t size);
+
     void TrackContinuityImpl(DAddr address, VAddr virtual_address, size_t size, Asid asid);
     void TrackContinuity(DAddr address, VAddr virtual_address, size_t size, Asid asid) {
         std::scoped_lock lk(mapping_guard);
@@ -87,19 +87,11 @@ size_t AesXtsStorage::Read(u8* buffer, size_t size, size_t offset) const {
         ASSERT(processed_size == (std::min)(size, m_block_size - skip_size));
     }
 
-    // Decrypt aligned chunks.
-    char* cur = reinterpret_cast<char*>(buffer) + processed_size;
-    size_t remaining = size - processed_size;
-    while (remaining > 0) {
-        const size_t cur_size = (std::min)(m_block_size, remaining);
-
-        m_cipher->SetIV(ctr);
-        m_cipher->Transcode(cur, cur_size, cur, Core::Crypto::Op::Decrypt);
-
-        remaining -= cur_size;
-        cur += cur_size;
-
-        AddCounter(ctr.data(), IvSize, 1);
+    // Decrypt aligned chunks in a single batch.
+    u8* cur = buffer + processed_size;
+    const size_t remaining = size - processed_size;
+    if (remaining > 0) {
+        m_cipher->XTSTranscode(cur, remaining, cur, ctr, m_block_size, Core::Crypto::Op::Decrypt);
     }
 
     return size;
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/file_sys/fssystem/fssystem_compressed_block_cache.h"
+
+namespace FileSys {
+
+void CompressedBlockCache::Initialize(size_t cache_size, size_t block_size_max,
+                                      size_t max_entries) {
+    // Drop anything cached from a previous initialization.
+    this->Finalize();
+
+    // Split the limits between the shards.
+    m_shard_size = cache_size / ShardCount;
+    m_shard_entries = std::max<size_t>(max_entries / ShardCount, 1);
+
+    // A block larger than a shard could never be cached, so the cache is disabled.
+    m_block_size_max = std::min(block_size_max, m_shard_size);
+}
+
+void CompressedBlockCache::Finalize() {
+    for (Shard& shard : m_shards) {
+        std::scoped_lock lk{shard.mutex};
+        shard.blocks.clear();
+        shard.lru.clear();
+        shard.cached_size = 0;
+    }
+}
+
+bool CompressedBlockCache::Read(s64 physical_offset, void* dst, size_t offset, size_t size) {
+    Shard& shard = this->GetShard(physical_offset);
+    {
+        std::scoped_lock lk{shard.mutex};
+        const auto it = shard.blocks.find(physical_offset);
+        if (it != shard.blocks.end() && offset + size <= it->second->data.size()) {
+            // Mark the block as the most recently used one.
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+
+            std::memcpy(dst, it->second->data.data() + offset, size);
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool CompressedBlockCache::Contains(s64 physical_offset) {
+    Shard& shard = this->GetShard(physical_offset);
+    std::scoped_lock lk{shard.mutex};
+    return shard.blocks.contains(physical_offset);
+}
+
+void CompressedBlockCache::Insert(s64 physical_offset, const void* src, size_t size) {
+    if (size == 0 || size > m_block_size_max) {
+        return;
+    }
+
+    // Copy the block before taking the lock.
+    const u8* const bytes = static_cast<const u8*>(src);
+    std::vector<u8> data(bytes, bytes + size);
+
+    Shard& shard = this->GetShard(physical_offset);
+    std::scoped_lock lk{shard.mutex};
+
+    // Another thread may have cached the block in the meantime.
+    if (shard.blocks.contains(physical_offset)) {
+        return;
+    }
+
+    // Evict the least recently used blocks until the new one fits.
+    while (!shard.lru.empty() && (shard.cached_size + size > m_shard_size ||
+                                  shard.blocks.size() >= m_shard_entries)) {
+        const Block& victim = shard.lru.back();
+        shard.cached_size -= victim.data.size();
+        shard.blocks.erase(victim.physical_offset);
+        shard.lru.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.lru.push_front(Block{
+        .physical_offset = physical_offset,
+        .data = std::move(data),
+    });
+    shard.blocks.emplace(physical_offset, shard.lru.begin());
+    shard.cached_size += size;
+}
+
+CompressedBlockCache::Statistics CompressedBlockCache::GetStatistics() const {
+    Statistics statistics{
+        .hits = m_hits.load(std::memory_order_relaxed),
+        .misses = m_misses.load(std::memory_order_relaxed),
+        .evictions = m_evictions.load(std::memory_order_relaxed),
+        .cached_size = 0,
+        .cached_count = 0,
+    };
+    for (const Shard& shard : m_shards) {
+        std::scoped_lock lk{shard.mutex};
+        statistics.cached_size += shard.cached_size;
+        statistics.cached_count += shard.blocks.size();
+    }
+    return statistics;
+}
+
+CompressedBlockCache::Shard& CompressedBlockCache::GetShard(s64 physical_offset) {
+    // Blocks are mostly contiguous, so hash the offset to spread neighbours across shards.
+    constexpr u64 HashMultiplier = 0x9E3779B97F4A7C15ULL;
+    const u64 hash = static_cast<u64>(physical_offset) * HashMultiplier;
+    return m_shards[static_cast<size_t>(hash >> 32) % ShardCount];
+}
+
+} // namespace FileSys
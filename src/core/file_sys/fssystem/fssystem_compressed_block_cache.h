@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace FileSys {
+
+// Decompressed blocks of a compressed storage, keyed by the physical offset of the block.
+// The read-ahead storage shares one instance between all sections with keys of its own.
+// Blocks are spread over independently locked shards, each evicting its least recently used
+// blocks to stay within its share of the size and entry limits.
+class CompressedBlockCache {
+    YUZU_NON_COPYABLE(CompressedBlockCache);
+    YUZU_NON_MOVEABLE(CompressedBlockCache);
+
+public:
+    static constexpr size_t ShardCount = 8;
+
+    struct Statistics {
+        u64 hits;
+        u64 misses;
+        u64 evictions;
+        size_t cached_size;
+        size_t cached_count;
+    };
+
+public:
+    CompressedBlockCache() = default;
+
+    void Initialize(size_t cache_size, size_t block_size_max, size_t max_entries);
+    void Finalize();
+
+    bool IsEnabled() const {
+        return m_block_size_max != 0;
+    }
+
+    // Copies part of a cached block, returns false when the block is not cached.
+    bool Read(s64 physical_offset, void* dst, size_t offset, size_t size);
+
+    bool Contains(s64 physical_offset);
+
+    // Caches a decompressed block, blocks that can never fit are ignored.
+    void Insert(s64 physical_offset, const void* src, size_t size);
+
+    Statistics GetStatistics() const;
+
+private:
+    struct Block {
+        s64 physical_offset;
+        std::vector<u8> data;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Block> lru;
+        std::unordered_map<s64, std::list<Block>::iterator> blocks;
+        size_t cached_size{};
+    };
+
+    Shard& GetShard(s64 physical_offset);
+
+private:
+    std::array<Shard, ShardCount> m_shards;
+    size_t m_shard_size{};
+    size_t m_shard_entries{};
+    size_t m_block_size_max{};
+    std::atomic<u64> m_hits{};
+    std::atomic<u64> m_misses{};
+    std::atomic<u64> m_evictions{};
+};
+
+} // namespace FileSys
@@ -8,6 +8,7 @@
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fs_i_storage.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree.h"
+#include "core/file_sys/fssystem/fssystem_compressed_block_cache.h"
 #include "core/file_sys/fssystem/fssystem_compression_common.h"
 #include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
 #include "core/file_sys/vfs/vfs.h"
@@ -681,6 +682,7 @@ private:
         struct AccessRange {
             s64 virtual_offset;
             s64 virtual_size;
+            s64 physical_offset;
             u32 physical_size;
             bool is_block_alignment_required;
 
@@ -699,9 +701,21 @@ private:
             // Set our fields.
             m_storage_size = storage_size;
 
+            // Initialize the cache of decompressed blocks. The first size bounds the whole cache,
+            // the second bounds the blocks it holds.
+            m_block_cache.Initialize(cache_size_0, cache_size_1, max_cache_entries);
+
             R_SUCCEED();
         }
 
+        void Finalize() {
+            m_block_cache.Finalize();
+        }
+
+        CompressedBlockCache::Statistics GetCacheStatistics() const {
+            return m_block_cache.GetStatistics();
+        }
+
         Result Read(CompressedStorageCore& core, s64 offset, void* buffer, size_t size) {
             // If we have nothing to read, succeed.
             R_SUCCEED_IF(size == 0);
@@ -729,6 +743,7 @@ private:
                     head_range = {
                         .virtual_offset = entry.virt_offset,
                         .virtual_size = virtual_data_size,
+                        .physical_offset = entry.phys_offset,
                         .physical_size = static_cast<u32>(entry.phys_size),
                         .is_block_alignment_required =
                             CompressionTypeUtility::IsBlockAlignmentRequired(
@@ -741,6 +756,7 @@ private:
                         tail_range = {
                             .virtual_offset = entry.virt_offset,
                             .virtual_size = virtual_data_size,
+                            .physical_offset = entry.phys_offset,
                             .physical_size = static_cast<u32>(entry.phys_size),
                             .is_block_alignment_required =
                                 CompressionTypeUtility::IsBlockAlignmentRequired(
@@ -764,6 +780,7 @@ private:
                         tail_range = {
                             .virtual_offset = entry.virt_offset,
                             .virtual_size = virtual_data_size,
+                            .physical_offset = entry.phys_offset,
                             .physical_size = static_cast<u32>(entry.phys_size),
                             .is_block_alignment_required =
                                 CompressionTypeUtility::IsBlockAlignmentRequired(
@@ -782,10 +799,10 @@ private:
             char* cur_dst = static_cast<char*>(buffer);
 
             // Determine our alignment.
-            const bool head_unaligned = head_range.is_block_alignment_required &&
+            bool head_unaligned = head_range.is_block_alignment_required &&
                                         (cur_offset != head_range.virtual_offset ||
                                          static_cast<s64>(cur_size) < head_range.virtual_size);
-            const bool tail_unaligned = [&]() -> bool {
+            bool tail_unaligned = [&]() -> bool {
                 if (tail_range.is_block_alignment_required) {
                     if (static_cast<s64>(cur_size + cur_offset) ==
                         tail_range.GetEndVirtualOffset()) {
@@ -802,11 +819,48 @@ private:
             }();
 
             // Determine start/end offsets.
-            const s64 start_offset =
+            s64 start_offset =
                 head_range.is_block_alignment_required ? head_range.virtual_offset : cur_offset;
-            const s64 end_offset = tail_range.is_block_alignment_required
-                                       ? tail_range.GetEndVirtualOffset()
-                                       : cur_offset + cur_size;
+            s64 end_offset = tail_range.is_block_alignment_required
+                                 ? tail_range.GetEndVirtualOffset()
+                                 : cur_offset + cur_size;
+
+            // If the unaligned head is cached, copy it out and start reading after it.
+            if (head_unaligned && m_block_cache.IsEnabled()) {
+                const size_t skip_size = cur_offset - head_range.virtual_offset;
+                const size_t copy_size =
+                    std::min<size_t>(cur_size, head_range.GetEndVirtualOffset() - cur_offset);
+                if (m_block_cache.Read(head_range.physical_offset, cur_dst, skip_size,
+                                       copy_size)) {
+                    // Advance.
+                    cur_dst += copy_size;
+                    cur_offset += copy_size;
+                    cur_size -= copy_size;
+
+                    // If the read was within the head, we're done.
+                    R_SUCCEED_IF(cur_size == 0);
+
+                    head_unaligned = false;
+                    start_offset = cur_offset;
+                }
+            }
+
+            // If the unaligned tail is cached, copy it out and stop reading before it.
+            if (tail_unaligned && m_block_cache.IsEnabled()) {
+                ASSERT(cur_offset <= tail_range.virtual_offset);
+                const size_t dst_offset = tail_range.virtual_offset - cur_offset;
+                const size_t copy_size = cur_size - dst_offset;
+                if (m_block_cache.Read(tail_range.physical_offset, cur_dst + dst_offset, 0,
+                                       copy_size)) {
+                    cur_size -= copy_size;
+
+                    // If the read was within the tail, we're done.
+                    R_SUCCEED_IF(cur_size == 0);
+
+                    tail_unaligned = false;
+                    end_offset = tail_range.virtual_offset;
+                }
+            }
 
             // Perform the read.
             bool is_burst_reading = false;
@@ -872,6 +926,10 @@ private:
                             R_THROW(rc);
                         }
 
+                        // Keep the decompressed block for later reads of the same block.
+                        m_block_cache.Insert(unaligned_range->physical_offset,
+                                             pooled_buffer.GetBuffer(), size_buffer_required);
+
                         // Copy the data we read to the destination.
                         const size_t skip_size = cur_offset - unaligned_range->virtual_offset;
                         const size_t copy_size = std::min<size_t>(
@@ -893,6 +951,7 @@ private:
 
     private:
         s64 m_storage_size = 0;
+        CompressedBlockCache m_block_cache;
     };
 
 public:
@@ -920,6 +979,7 @@ public:
     }
 
     void Finalize() {
+        m_cache_manager.Finalize();
         m_core.Finalize();
     }
 
@@ -940,6 +1000,10 @@ public:
         return m_core.GetEntryTable();
     }
 
+    CompressedBlockCache::Statistics GetCacheStatistics() const {
+        return m_cache_manager.GetCacheStatistics();
+    }
+
 public:
     virtual size_t GetSize() const override {
         s64 ret{};
@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/fssystem/fssystem_compressed_block_cache.h"
+#include "core/file_sys/fssystem/fssystem_read_ahead_storage.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr size_t CacheSize = 32_MiB;
+constexpr size_t CacheEntryCountMax = 256;
+constexpr size_t WorkerCount = 2;
+
+// Blocks are keyed by the storage id in the upper bits and the block index in the lower ones.
+constexpr size_t BlockIndexBits = 40;
+
+struct ReadAheadContext {
+    ReadAheadContext() : workers{WorkerCount, "ReadAhead"} {
+        cache.Initialize(CacheSize, ReadAheadStorage::BlockSize, CacheEntryCountMax);
+    }
+
+    // Declared before the workers, so that they are stopped before the cache is destroyed.
+    CompressedBlockCache cache;
+    Common::ThreadWorker workers;
+    std::atomic<u64> next_id{};
+};
+
+ReadAheadContext& GetContext() {
+    static ReadAheadContext context;
+    return context;
+}
+
+} // Anonymous namespace
+
+ReadAheadStorage::ReadAheadStorage(VirtualFile base)
+    : m_base(std::move(base)), m_size(m_base->GetSize()),
+      m_id(GetContext().next_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+ReadAheadStorage::~ReadAheadStorage() = default;
+
+size_t ReadAheadStorage::GetSize() const {
+    return m_size;
+}
+
+size_t ReadAheadStorage::Read(u8* buffer, size_t size, size_t offset) const {
+    // Clamp the read to the storage.
+    if (offset >= m_size) {
+        return 0;
+    }
+    size = std::min(size, m_size - offset);
+    if (size == 0) {
+        return 0;
+    }
+
+    this->UpdateStreams(offset, size);
+
+    // Copy the cached blocks, reading runs of missing ones from the base storage.
+    const size_t end = offset + size;
+    size_t miss_begin = offset;
+    const auto read_misses = [&](size_t miss_end) -> bool {
+        if (miss_begin == miss_end) {
+            return true;
+        }
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        const size_t miss_size = miss_end - miss_begin;
+        const size_t read = this->ReadBase(buffer + (miss_begin - offset), miss_size, miss_begin);
+        if (read != miss_size) {
+            miss_begin += read;
+            return false;
+        }
+        return true;
+    };
+
+    for (size_t cur = offset; cur < end;) {
+        const size_t block = cur / BlockSize;
+        const size_t block_offset = cur % BlockSize;
+        const size_t cur_size = std::min(end - cur, BlockSize - block_offset);
+        if (this->ReadCached(block, buffer + (cur - offset), block_offset, cur_size)) {
+            if (!read_misses(cur)) {
+                return miss_begin - offset;
+            }
+            miss_begin = cur + cur_size;
+        }
+        cur += cur_size;
+    }
+    if (!read_misses(end)) {
+        return miss_begin - offset;
+    }
+
+    return size;
+}
+
+ReadAheadStorage::Statistics ReadAheadStorage::GetStatistics() const {
+    return {
+        .hits = m_hits.load(std::memory_order_relaxed),
+        .waits = m_waits.load(std::memory_order_relaxed),
+        .misses = m_misses.load(std::memory_order_relaxed),
+        .prefetched = m_prefetched.load(std::memory_order_relaxed),
+    };
+}
+
+void ReadAheadStorage::UpdateStreams(size_t offset, size_t size) const {
+    // Prefetches reference the storage weakly, which requires it to be owned by a shared pointer.
+    const std::weak_ptr<const ReadAheadStorage> self = this->weak_from_this();
+    if (self.expired()) {
+        return;
+    }
+
+    std::scoped_lock lk{m_mutex};
+
+    // Find the stream continued by this read, small skips forward are still sequential.
+    const auto it = std::ranges::find_if(m_streams, [offset](const Stream& stream) {
+        return stream.read_count != 0 && offset >= stream.next_offset &&
+               offset - stream.next_offset < BlockSize;
+    });
+
+    // Otherwise start a new stream in place of the least recently used one.
+    Stream& stream =
+        it != m_streams.end() ? *it : *std::ranges::min_element(m_streams, {}, &Stream::last_use);
+    if (it == m_streams.end()) {
+        stream = {};
+    }
+    stream.next_offset = offset + size;
+    stream.last_use = ++m_use_counter;
+    if (++stream.read_count < SequentialReadCount) {
+        return;
+    }
+
+    // Keep a fixed number of blocks ahead of the stream in flight or cached.
+    const size_t next_block = stream.next_offset / BlockSize;
+    const size_t first_block = std::max(next_block, stream.prefetch_end);
+    const size_t last_block =
+        std::min(next_block + PrefetchBlockCount, Common::DivideUp(m_size, BlockSize));
+    if (first_block >= last_block) {
+        return;
+    }
+    stream.prefetch_end = last_block;
+
+    auto& context = GetContext();
+    for (size_t block = first_block; block < last_block; ++block) {
+        if (context.cache.Contains(this->GetCacheKey(block)) || m_running.contains(block) ||
+            !m_queued.insert(block).second) {
+            continue;
+        }
+        context.workers.QueueWork([self, block] {
+            if (const auto storage = self.lock()) {
+                storage->Prefetch(block);
+            }
+        });
+    }
+}
+
+void ReadAheadStorage::Prefetch(size_t block) const {
+    {
+        std::scoped_lock lk{m_mutex};
+        // A guest read took the block back while the job was queued.
+        if (m_queued.erase(block) == 0) {
+            return;
+        }
+        m_running.insert(block);
+    }
+
+    const size_t offset = block * BlockSize;
+    const size_t size = std::min(BlockSize, m_size - offset);
+
+    std::vector<u8> data(size);
+    if (this->ReadBase(data.data(), size, offset) == size) {
+        GetContext().cache.Insert(this->GetCacheKey(block), data.data(), size);
+        m_prefetched.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::scoped_lock lk{m_mutex};
+        m_running.erase(block);
+    }
+    m_prefetch_done.notify_all();
+}
+
+bool ReadAheadStorage::ReadCached(size_t block, u8* buffer, size_t offset, size_t size) const {
+    // Waiting on a running prefetch is cheaper than transcoding the block a second time. A queued
+    // one may only start after the workers are done with other storages, so the block is taken
+    // back and read synchronously instead.
+    {
+        std::unique_lock lk{m_mutex};
+        m_queued.erase(block);
+        if (m_running.contains(block)) {
+            m_waits.fetch_add(1, std::memory_order_relaxed);
+            m_prefetch_done.wait(lk, [&] { return !m_running.contains(block); });
+        }
+    }
+
+    if (!GetContext().cache.Read(this->GetCacheKey(block), buffer, offset, size)) {
+        return false;
+    }
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t ReadAheadStorage::ReadBase(u8* buffer, size_t size, size_t offset) const {
+    std::scoped_lock lk{m_base_mutex};
+    return m_base->Read(buffer, size, offset);
+}
+
+s64 ReadAheadStorage::GetCacheKey(size_t block) const {
+    return static_cast<s64>((m_id << BlockIndexBits) | block);
+}
+
+} // namespace FileSys
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include "common/common_funcs.h"
+#include "common/literals.h"
+#include "core/file_sys/fssystem/fs_i_storage.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+// Reads the blocks following sequential accesses on background threads.
+// Guest reads of a RomFS section go through decryption, patching and decompression
+// synchronously. This storage sits on top of that stack, detects streams of sequential reads
+// (usually one per guest file) and transcodes the next blocks of each stream ahead of time into
+// a bounded cache shared by every section. Reads of the base storage are serialized, as the
+// layers below it are not safe to read from several threads at once.
+class ReadAheadStorage : public IReadOnlyStorage,
+                         public std::enable_shared_from_this<ReadAheadStorage> {
+    YUZU_NON_COPYABLE(ReadAheadStorage);
+    YUZU_NON_MOVEABLE(ReadAheadStorage);
+
+public:
+    static constexpr size_t BlockSize = 256_KiB;
+    static constexpr size_t PrefetchBlockCount = 8;
+    static constexpr size_t StreamCountMax = 8;
+    // Consecutive reads before a stream is considered sequential.
+    static constexpr u32 SequentialReadCount = 2;
+
+    struct Statistics {
+        // Blocks copied from the cache, after waiting for a prefetch if it was running.
+        u64 hits;
+        u64 waits;
+        // Runs of blocks read synchronously from the base storage, including the blocks taken
+        // back from prefetches that had not started.
+        u64 misses;
+        u64 prefetched;
+    };
+
+public:
+    explicit ReadAheadStorage(VirtualFile base);
+    ~ReadAheadStorage() override;
+
+    size_t GetSize() const override;
+    size_t Read(u8* buffer, size_t size, size_t offset) const override;
+
+    Statistics GetStatistics() const;
+
+private:
+    struct Stream {
+        size_t next_offset;
+        // Index of the first block not yet prefetched for the stream.
+        size_t prefetch_end;
+        u32 read_count;
+        u64 last_use;
+    };
+
+    // Records a read and queues the blocks following it when it continues a sequential stream.
+    void UpdateStreams(size_t offset, size_t size) const;
+    void Prefetch(size_t block) const;
+
+    bool ReadCached(size_t block, u8* buffer, size_t offset, size_t size) const;
+    size_t ReadBase(u8* buffer, size_t size, size_t offset) const;
+
+    s64 GetCacheKey(size_t block) const;
+
+private:
+    VirtualFile m_base;
+    size_t m_size;
+    u64 m_id;
+    mutable std::mutex m_base_mutex;
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_prefetch_done;
+    mutable std::array<Stream, StreamCountMax> m_streams{};
+    // Blocks whose prefetch is queued on the workers, and those being read by them.
+    mutable std::unordered_set<size_t> m_queued;
+    mutable std::unordered_set<size_t> m_running;
+    mutable u64 m_use_counter{};
+    mutable std::atomic<u64> m_hits{};
+    mutable std::atomic<u64> m_waits{};
+    mutable std::atomic<u64> m_misses{};
+    mutable std::atomic<u64> m_prefetched{};
+};
+
+} // namespace FileSys
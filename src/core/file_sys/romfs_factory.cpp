@@ -7,6 +7,7 @@
 #include "common/logging/log.h"
 #include "core/file_sys/common_funcs.h"
 #include "core/file_sys/content_archive.h"
+#include "core/file_sys/fssystem/fssystem_read_ahead_storage.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
@@ -31,19 +32,33 @@ RomFSFactory::RomFSFactory(Loader::AppLoader& app_loader, ContentProvider& provi
 RomFSFactory::~RomFSFactory() = default;
 
 void RomFSFactory::SetPackedUpdate(VirtualFile update_raw_file) {
+    std::scoped_lock lk{current_process_mutex};
     packed_update_raw = std::move(update_raw_file);
+    current_process_romfs = nullptr;
 }
 
-VirtualFile RomFSFactory::OpenCurrentProcess(u64 current_process_title_id) const {
-    if (!updatable) {
-        return file;
+VirtualFile RomFSFactory::OpenCurrentProcess(u64 title_id) {
+    std::scoped_lock lk{current_process_mutex};
+    if (current_process_romfs && current_process_title_id == title_id) {
+        return current_process_romfs;
     }
 
-    const auto type = ContentRecordType::Program;
-    const auto nca = content_provider.GetEntry(current_process_title_id, type);
-    const PatchManager patch_manager{current_process_title_id, filesystem_controller,
-                                     content_provider};
-    return patch_manager.PatchRomFS(nca.get(), file, ContentRecordType::Program, packed_update_raw);
+    VirtualFile romfs = file;
+    if (updatable) {
+        const auto type = ContentRecordType::Program;
+        const auto nca = content_provider.GetEntry(title_id, type);
+        const PatchManager patch_manager{title_id, filesystem_controller, content_provider};
+        romfs = patch_manager.PatchRomFS(nca.get(), file, ContentRecordType::Program,
+                                         packed_update_raw);
+    }
+    if (romfs == nullptr) {
+        return nullptr;
+    }
+
+    // Titles mostly stream their assets from the RomFS, so read ahead of sequential accesses.
+    current_process_romfs = std::make_shared<ReadAheadStorage>(std::move(romfs));
+    current_process_title_id = title_id;
+    return current_process_romfs;
 }
 
 VirtualFile RomFSFactory::OpenPatchedRomFS(u64 title_id, ContentRecordType type) const {
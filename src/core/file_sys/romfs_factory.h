@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "common/common_types.h"
 #include "core/file_sys/vfs/vfs_types.h"
@@ -41,7 +42,8 @@ public:
     ~RomFSFactory();
 
     void SetPackedUpdate(VirtualFile packed_update_raw);
-    [[nodiscard]] VirtualFile OpenCurrentProcess(u64 current_process_title_id) const;
+    /// Returns the RomFS mounted by the running title, the same storage is shared by every caller
+    [[nodiscard]] VirtualFile OpenCurrentProcess(u64 title_id);
     [[nodiscard]] VirtualFile OpenPatchedRomFS(u64 title_id, ContentRecordType type) const;
     [[nodiscard]] VirtualFile OpenPatchedRomFSWithProgramIndex(u64 title_id, u8 program_index,
                                                                ContentRecordType type) const;
@@ -57,6 +59,10 @@ private:
 
     bool updatable;
 
+    std::mutex current_process_mutex;
+    VirtualFile current_process_romfs;
+    u64 current_process_title_id{};
+
     ContentProvider& content_provider;
     Service::FileSystem::FileSystemController& filesystem_controller;
 };
@@ -3,59 +3,84 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <bit>
 #include <functional>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "common/scope_exit.h"
 #include "core/device_memory_manager.h"
 
 namespace Core {
 
+/**
+ * Per core accumulator of CPU writes to memory cached by the GPU.
+ * Each emulated core owns one manager and is its only producer, marks within a page are merged
+ * into a single open entry and full pages are handed to the GPU thread through a lock free ring,
+ * so cores never contend with each other or with the GPU thread draining them.
+ */
 class GPUDirtyMemoryManager {
 public:
     GPUDirtyMemoryManager() : current{default_transform} {
-        back_buffer.reserve(256);
-        front_buffer.reserve(256);
+        overflow_buffer.reserve(256);
+        front_buffer.reserve(ring_size);
     }
 
     ~GPUDirtyMemoryManager() = default;
 
+    /// Marks a region as written, must only be called from the core owning this manager
     void Collect(PAddr address, size_t size) {
-        TransformAddress t = BuildTransform(address, size);
-        TransformAddress tmp, original;
-        do {
-            tmp = current.load(std::memory_order_acquire);
-            original = tmp;
-            if (tmp.address != t.address) {
-                if (IsValid(tmp.address)) {
-                    std::scoped_lock lk(guard);
-                    back_buffer.emplace_back(tmp);
-                    current.exchange(t, std::memory_order_relaxed);
+        const TransformAddress t = BuildTransform(address, size);
+        TransformAddress tmp = current.load(std::memory_order_acquire);
+        while (true) {
+            if (tmp.address != t.address && IsValid(tmp.address)) {
+                // Moving to another page, the gatherer may have taken the open entry meanwhile
+                const TransformAddress previous = current.exchange(t, std::memory_order_acq_rel);
+                if (IsValid(previous.address)) {
+                    Publish(previous);
+                }
+                return;
+            }
+            TransformAddress next = t;
+            if (tmp.address == t.address) {
+                if ((tmp.mask | t.mask) == tmp.mask) {
                     return;
                 }
-                tmp.address = t.address;
-                tmp.mask = 0;
+                next.mask |= tmp.mask;
             }
-            if ((tmp.mask | t.mask) == tmp.mask) {
+            if (current.compare_exchange_weak(tmp, next, std::memory_order_release,
+                                              std::memory_order_acquire)) {
                 return;
             }
-            tmp.mask |= t.mask;
-        } while (!current.compare_exchange_weak(original, tmp, std::memory_order_release,
-                                                std::memory_order_relaxed));
+        }
     }
 
+    /// Drains the collected regions, invoking the callback once per contiguous written range
     void Gather(std::function<void(PAddr, size_t)>& callback) {
-        {
-            std::scoped_lock lk(guard);
-            TransformAddress t = current.exchange(default_transform, std::memory_order_relaxed);
-            front_buffer.swap(back_buffer);
-            if (IsValid(t.address)) {
-                front_buffer.emplace_back(t);
-            }
+        // Gatherers are serialized until the callbacks are done, as they share the front buffer
+        std::scoped_lock lk(gather_guard);
+        const TransformAddress t = current.exchange(default_transform, std::memory_order_acq_rel);
+        const size_t write = write_index.load(std::memory_order_acquire);
+        size_t read = read_index.load(std::memory_order_relaxed);
+        for (; read != write; ++read) {
+            front_buffer.push_back(ring[read % ring_size]);
         }
+        read_index.store(read, std::memory_order_release);
+        if (has_overflow.load(std::memory_order_acquire)) [[unlikely]] {
+            std::scoped_lock overflow_lk(overflow_guard);
+            front_buffer.insert(front_buffer.end(), overflow_buffer.begin(), overflow_buffer.end());
+            overflow_buffer.clear();
+            has_overflow.store(false, std::memory_order_relaxed);
+        }
+        if (IsValid(t.address)) {
+            front_buffer.emplace_back(t);
+        }
+        PAddr pending_address = 0;
+        size_t pending_size = 0;
         for (auto& transform : front_buffer) {
             size_t offset = 0;
             u64 mask = transform.mask;
@@ -65,12 +90,26 @@ public:
                 mask = mask >> empty_bits;
 
                 const size_t continuous_bits = std::countr_one(mask);
-                callback((static_cast<PAddr>(transform.address) << page_bits) + offset,
-                         continuous_bits << align_bits);
+                const PAddr range_address =
+                    (static_cast<PAddr>(transform.address) << page_bits) + offset;
+                const size_t range_size = continuous_bits << align_bits;
+                // Streamed writes cross pages in order, merge them into a single invalidation
+                if (pending_size != 0 && pending_address + pending_size == range_address) {
+                    pending_size += range_size;
+                } else {
+                    if (pending_size != 0) {
+                        callback(pending_address, pending_size);
+                    }
+                    pending_address = range_address;
+                    pending_size = range_size;
+                }
                 mask = continuous_bits < align_size ? (mask >> continuous_bits) : 0;
                 offset += continuous_bits << align_bits;
             }
         }
+        if (pending_size != 0) {
+            callback(pending_address, pending_size);
+        }
         front_buffer.clear();
     }
 
@@ -89,6 +128,9 @@ private:
     constexpr static size_t align_mask = align_size - 1;
     constexpr static TransformAddress default_transform = {.address = ~0U, .mask = 0U};
 
+    /// Pages that can be pending before the producer has to fall back to the locked buffer
+    constexpr static size_t ring_size = 4096;
+
     bool IsValid(PAddr address) {
         return address < (1ULL << 39);
     }
@@ -113,9 +155,39 @@ private:
         return result;
     }
 
+    /// Hands a page over to the gatherer, only locks when the GPU thread has fallen behind
+    void Publish(TransformAddress transform) {
+        // Host threads of different processes share the system core manager, this is never
+        // contended on the managers of the emulated cores
+        while (producer_busy.test_and_set(std::memory_order_acquire)) [[unlikely]] {
+            std::this_thread::yield();
+        }
+        SCOPE_EXIT {
+            producer_busy.clear(std::memory_order_release);
+        };
+        const size_t write = write_index.load(std::memory_order_relaxed);
+        if (write - read_index.load(std::memory_order_acquire) == ring_size) [[unlikely]] {
+            std::scoped_lock lk(overflow_guard);
+            overflow_buffer.emplace_back(transform);
+            has_overflow.store(true, std::memory_order_release);
+            return;
+        }
+        ring[write % ring_size] = transform;
+        write_index.store(write + 1, std::memory_order_release);
+    }
+
     std::atomic<TransformAddress> current{};
-    std::mutex guard;
-    std::vector<TransformAddress> back_buffer;
+
+    alignas(64) std::atomic_flag producer_busy{};
+    std::atomic<size_t> write_index{};
+    alignas(64) std::atomic<size_t> read_index{};
+    std::array<TransformAddress, ring_size> ring{};
+
+    std::atomic_bool has_overflow{};
+    std::mutex overflow_guard;
+    std::vector<TransformAddress> overflow_buffer;
+
+    std::mutex gather_guard;
     std::vector<TransformAddress> front_buffer;
 };
 
@@ -338,16 +338,30 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
+            // Buffers that are contiguous in host memory are written in place, others go through a
+            // scratch buffer that is copied out after the call.
             auto& buffer = temp[OutBufferIndex];
+            buffer.resize_destructive(0);
+            std::span<u8> guest_buffer{};
             if (ctx.CanWriteBuffer(OutBufferIndex)) {
-                buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
-            } else {
-                buffer.resize_destructive(0);
+                Core::Memory::HostSpans spans;
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    ctx.WriteBufferSpans(spans, OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    ctx.WriteBufferBSpans(spans, OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    ctx.WriteBufferCSpans(spans, OutBufferIndex);
+                }
+                if (spans.size() == 1) {
+                    guest_buffer = spans.front();
+                } else {
+                    buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
+                    guest_buffer = buffer;
+                }
             }
 
-            ElementType* ptr = (ElementType*) buffer.data();
-            size_t size = buffer.size() / sizeof(ElementType);
+            ElementType* ptr = (ElementType*) guest_buffer.data();
+            size_t size = guest_buffer.size() / sizeof(ElementType);
 
             std::get<ArgIndex>(args) = std::span(ptr, size);
 
@@ -412,6 +426,8 @@ void WriteOutArgument(bool is_domain, CallArguments& args, u8* raw_data, HLERequ
 
             return WriteOutArgument<MethodArguments, CallArguments, PrevAlign, DataOffset, OutBufferIndex + 1, RawDataFinished, ArgIndex + 1>(is_domain, args, raw_data, ctx, temp);
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
+            // Buffers written in place leave the scratch buffer empty, and are invalidated now that
+            // the handler is done with them.
             auto& buffer = temp[OutBufferIndex];
             const size_t size = buffer.size();
 
@@ -423,6 +439,14 @@ void WriteOutArgument(bool is_domain, CallArguments& args, u8* raw_data, HLERequ
                 } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
                     ctx.WriteBufferC(buffer.data(), size, OutBufferIndex);
                 }
+            } else if (ctx.CanWriteBuffer(OutBufferIndex)) {
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    ctx.InvalidateWriteBuffer(OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    ctx.InvalidateWriteBufferB(OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    ctx.InvalidateWriteBufferC(OutBufferIndex);
+                }
             }
 
             return WriteOutArgument<MethodArguments, CallArguments, PrevAlign, DataOffset, OutBufferIndex + 1, RawDataFinished, ArgIndex + 1>(is_domain, args, raw_data, ctx, temp);
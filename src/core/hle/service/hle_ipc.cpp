@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <sstream>
 
 #include <boost/range/algorithm_ext/erase.hpp>
@@ -12,7 +13,6 @@
 #include "common/common_types.h"
 #include "common/logging/log.h"
 #include "common/scratch_buffer.h"
-#include "core/guest_memory.h"
 #include "core/hle/kernel/k_auto_object.h"
 #include "core/hle/kernel/k_handle_table.h"
 #include "core/hle/kernel/k_process.h"
@@ -334,29 +334,47 @@ std::vector<u8> HLERequestContext::ReadBufferCopy(std::size_t buffer_index) cons
     }
 }
 
-std::span<const u8> HLERequestContext::ReadBufferA(std::size_t buffer_index) const {
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> gm(memory, 0, 0);
+std::span<const u8> HLERequestContext::ReadBufferImpl(u64 address, std::size_t size,
+                                                      Common::ScratchBuffer<u8>& backup) const {
+    // Buffers that are contiguous in host memory are read in place.
+    Core::Memory::HostSpans spans;
+    if (memory.GatherSpans(address, size, spans) && spans.size() <= 1) {
+        return spans.empty() ? std::span<const u8>{} : spans.front();
+    }
+
+    // Otherwise they are copied, reading unmapped memory as zeroes.
+    backup.resize_destructive(size);
+    if (spans.empty()) {
+        memory.ReadBlockUnsafe(address, backup.data(), size);
+        return backup;
+    }
+    u8* dest = backup.data();
+    for (const std::span<u8> span : spans) {
+        std::memcpy(dest, span.data(), span.size());
+        dest += span.size();
+    }
+    return backup;
+}
 
+std::span<const u8> HLERequestContext::ReadBufferA(std::size_t buffer_index) const {
     ASSERT_OR_EXECUTE_MSG(
         BufferDescriptorA().size() > buffer_index, { return {}; },
         "BufferDescriptorA invalid buffer_index {}", buffer_index);
-    return gm.Read(BufferDescriptorA()[buffer_index].Address(),
-                   BufferDescriptorA()[buffer_index].Size(), &read_buffer_data_a[buffer_index]);
+    return ReadBufferImpl(BufferDescriptorA()[buffer_index].Address(),
+                          BufferDescriptorA()[buffer_index].Size(),
+                          read_buffer_data_a[buffer_index]);
 }
 
 std::span<const u8> HLERequestContext::ReadBufferX(std::size_t buffer_index) const {
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> gm(memory, 0, 0);
-
     ASSERT_OR_EXECUTE_MSG(
         BufferDescriptorX().size() > buffer_index, { return {}; },
         "BufferDescriptorX invalid buffer_index {}", buffer_index);
-    return gm.Read(BufferDescriptorX()[buffer_index].Address(),
-                   BufferDescriptorX()[buffer_index].Size(), &read_buffer_data_x[buffer_index]);
+    return ReadBufferImpl(BufferDescriptorX()[buffer_index].Address(),
+                          BufferDescriptorX()[buffer_index].Size(),
+                          read_buffer_data_x[buffer_index]);
 }
 
 std::span<const u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) const {
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> gm(memory, 0, 0);
-
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
     const bool is_buffer_x{BufferDescriptorX().size() > buffer_index &&
@@ -372,14 +390,16 @@ std::span<const u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) cons
         ASSERT_OR_EXECUTE_MSG(
             BufferDescriptorA().size() > buffer_index, { return {}; },
             "BufferDescriptorA invalid buffer_index {}", buffer_index);
-        return gm.Read(BufferDescriptorA()[buffer_index].Address(),
-                       BufferDescriptorA()[buffer_index].Size(), &read_buffer_data_a[buffer_index]);
+        return ReadBufferImpl(BufferDescriptorA()[buffer_index].Address(),
+                              BufferDescriptorA()[buffer_index].Size(),
+                              read_buffer_data_a[buffer_index]);
     } else {
         ASSERT_OR_EXECUTE_MSG(
             BufferDescriptorX().size() > buffer_index, { return {}; },
             "BufferDescriptorX invalid buffer_index {}", buffer_index);
-        return gm.Read(BufferDescriptorX()[buffer_index].Address(),
-                       BufferDescriptorX()[buffer_index].Size(), &read_buffer_data_x[buffer_index]);
+        return ReadBufferImpl(BufferDescriptorX()[buffer_index].Address(),
+                              BufferDescriptorX()[buffer_index].Size(),
+                              read_buffer_data_x[buffer_index]);
     }
 }
 
@@ -450,6 +470,63 @@ std::size_t HLERequestContext::WriteBufferC(const void* buffer, std::size_t size
     return size;
 }
 
+bool HLERequestContext::WriteBufferSpans(Core::Memory::HostSpans& spans,
+                                         std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return WriteBufferBSpans(spans, buffer_index);
+    } else {
+        return WriteBufferCSpans(spans, buffer_index);
+    }
+}
+
+bool HLERequestContext::WriteBufferBSpans(Core::Memory::HostSpans& spans,
+                                          std::size_t buffer_index) const {
+    spans.clear();
+    if (buffer_index >= BufferDescriptorB().size()) {
+        return false;
+    }
+    return memory.GatherSpans(BufferDescriptorB()[buffer_index].Address(),
+                              BufferDescriptorB()[buffer_index].Size(), spans);
+}
+
+bool HLERequestContext::WriteBufferCSpans(Core::Memory::HostSpans& spans,
+                                          std::size_t buffer_index) const {
+    spans.clear();
+    if (buffer_index >= BufferDescriptorC().size()) {
+        return false;
+    }
+    return memory.GatherSpans(BufferDescriptorC()[buffer_index].Address(),
+                              BufferDescriptorC()[buffer_index].Size(), spans);
+}
+
+void HLERequestContext::InvalidateWriteBuffer(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        InvalidateWriteBufferB(buffer_index);
+    } else {
+        InvalidateWriteBufferC(buffer_index);
+    }
+}
+
+void HLERequestContext::InvalidateWriteBufferB(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorB().size()) {
+        return;
+    }
+    memory.InvalidateRegion(BufferDescriptorB()[buffer_index].Address(),
+                            BufferDescriptorB()[buffer_index].Size());
+}
+
+void HLERequestContext::InvalidateWriteBufferC(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorC().size()) {
+        return;
+    }
+    memory.InvalidateRegion(BufferDescriptorC()[buffer_index].Address(),
+                            BufferDescriptorC()[buffer_index].Size());
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
@@ -19,13 +19,10 @@
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/k_handle_table.h"
 #include "core/hle/kernel/svc_common.h"
+#include "core/memory.h"
 
 union Result;
 
-namespace Core::Memory {
-class Memory;
-}
-
 namespace IPC {
 class ResponseBuilder;
 }
@@ -281,6 +278,26 @@ public:
     std::size_t WriteBufferC(const void* buffer, std::size_t size,
                              std::size_t buffer_index = 0) const;
 
+    /// Helper function to gather the guest memory of a buffer using the appropriate buffer
+    /// descriptor, for writing it in place. Returns false if part of the buffer is unmapped.
+    /// Once written, the buffer must be passed to InvalidateWriteBuffer.
+    bool WriteBufferSpans(Core::Memory::HostSpans& spans, std::size_t buffer_index = 0) const;
+
+    /// Helper function to gather the guest memory of buffer B
+    bool WriteBufferBSpans(Core::Memory::HostSpans& spans, std::size_t buffer_index = 0) const;
+
+    /// Helper function to gather the guest memory of buffer C
+    bool WriteBufferCSpans(Core::Memory::HostSpans& spans, std::size_t buffer_index = 0) const;
+
+    /// Helper function to notify that a buffer gathered with WriteBufferSpans was written in place
+    void InvalidateWriteBuffer(std::size_t buffer_index = 0) const;
+
+    /// Helper function to notify that buffer B was written in place
+    void InvalidateWriteBufferB(std::size_t buffer_index = 0) const;
+
+    /// Helper function to notify that buffer C was written in place
+    void InvalidateWriteBufferC(std::size_t buffer_index = 0) const;
+
     /* Helper function to write a buffer using the appropriate buffer descriptor
      *
      * @tparam T an arbitrary container that satisfies the
@@ -394,6 +411,9 @@ private:
 
     void ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming);
 
+    std::span<const u8> ReadBufferImpl(u64 address, std::size_t size,
+                                       Common::ScratchBuffer<u8>& backup) const;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     Kernel::KHandleTable* client_handle_table{};
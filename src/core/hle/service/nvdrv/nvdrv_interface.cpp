@@ -68,13 +68,11 @@ void NVDRV::Ioctl1(HLERequestContext& ctx) {
     }
 
     // Check device
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    const auto output = GetOutputBuffer(ctx, output_buffer, 0, command.is_out != 0);
     const auto input_buffer = ctx.ReadBuffer(0);
 
-    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
-    }
+    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output);
+    CommitOutputBuffer(ctx, output_buffer, 0, command.is_out != 0);
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
@@ -95,13 +93,10 @@ void NVDRV::Ioctl2(HLERequestContext& ctx) {
 
     const auto input_buffer = ctx.ReadBuffer(0);
     const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    const auto output = GetOutputBuffer(ctx, output_buffer, 0, command.is_out != 0);
 
-    const auto nv_result =
-        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
-    }
+    const auto nv_result = nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output);
+    CommitOutputBuffer(ctx, output_buffer, 0, command.is_out != 0);
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
@@ -121,21 +116,45 @@ void NVDRV::Ioctl3(HLERequestContext& ctx) {
     }
 
     const auto input_buffer = ctx.ReadBuffer(0);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
-    inline_output_buffer.resize_destructive(ctx.GetWriteBufferSize(1));
-
-    const auto nv_result =
-        nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, inline_output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(inline_output_buffer, 1);
-    }
+    const auto output = GetOutputBuffer(ctx, output_buffer, 0, command.is_out != 0);
+    const auto inline_output = GetOutputBuffer(ctx, inline_output_buffer, 1, command.is_out != 0);
+
+    const auto nv_result = nvdrv->Ioctl3(fd, command, input_buffer, output, inline_output);
+    CommitOutputBuffer(ctx, output_buffer, 0, command.is_out != 0);
+    CommitOutputBuffer(ctx, inline_output_buffer, 1, command.is_out != 0);
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
     rb.PushEnum(nv_result);
 }
 
+std::span<u8> NVDRV::GetOutputBuffer(HLERequestContext& ctx, Common::ScratchBuffer<u8>& scratch,
+                                     std::size_t buffer_index, bool is_out) {
+    // Ioctls copy their inputs before writing their outputs, so an output buffer shared with the
+    // input can be written in place as well.
+    scratch.resize_destructive(0);
+    if (is_out) {
+        Core::Memory::HostSpans spans;
+        if (ctx.WriteBufferSpans(spans, buffer_index) && spans.size() == 1) {
+            return spans.front();
+        }
+    }
+    scratch.resize_destructive(ctx.GetWriteBufferSize(buffer_index));
+    return scratch;
+}
+
+void NVDRV::CommitOutputBuffer(HLERequestContext& ctx, const Common::ScratchBuffer<u8>& scratch,
+                               std::size_t buffer_index, bool is_out) {
+    if (!is_out) {
+        return;
+    }
+    if (scratch.size() != 0) {
+        ctx.WriteBuffer(scratch, buffer_index);
+    } else {
+        ctx.InvalidateWriteBuffer(buffer_index);
+    }
+}
+
 void NVDRV::Close(HLERequestContext& ctx) {
     LOG_DEBUG(Service_NVDRV, "called");
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include "common/scratch_buffer.h"
 #include "core/hle/service/nvdrv/nvdrv.h"
@@ -35,6 +36,15 @@ private:
 
     void ServiceError(HLERequestContext& ctx, NvResult result);
 
+    /// Returns the output buffer in guest memory if it can be written in place, otherwise the
+    /// scratch buffer, which has to be written back with CommitOutputBuffer
+    std::span<u8> GetOutputBuffer(HLERequestContext& ctx, Common::ScratchBuffer<u8>& scratch,
+                                  std::size_t buffer_index, bool is_out);
+
+    /// Writes back the scratch buffer, or invalidates the output buffer written in place
+    void CommitOutputBuffer(HLERequestContext& ctx, const Common::ScratchBuffer<u8>& scratch,
+                            std::size_t buffer_index, bool is_out);
+
     std::shared_ptr<Module> nvdrv;
 
     u64 pid{};
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
 #include "common/scope_exit.h"
 
 #include "core/core.h"
@@ -16,6 +18,7 @@
 #include "core/hle/service/hle_ipc.h"
 #include "core/hle/service/ipc_helpers.h"
 #include "core/hle/service/server_manager.h"
+#include "core/hle/service/service_statistics.h"
 #include "core/hle/service/sm/sm.h"
 
 namespace Service {
@@ -291,16 +294,32 @@ MultiWaitHolder* ServerManager::WaitSignaled() {
 }
 
 Result ServerManager::Process(MultiWaitHolder* holder) {
+    auto& statistics = m_system.GetServiceStatistics();
+    const auto start = std::chrono::steady_clock::now();
+
+    Result result = ResultSuccess;
+    ServiceStatistics::ServerEvent event{};
     switch (static_cast<UserDataTag>(holder->GetUserData())) {
     case UserDataTag::Session:
-        R_RETURN(this->OnSessionEvent(static_cast<Session*>(holder)));
+        event = ServiceStatistics::ServerEvent::Session;
+        result = this->OnSessionEvent(static_cast<Session*>(holder));
+        break;
     case UserDataTag::Port:
-        R_RETURN(this->OnPortEvent(static_cast<Port*>(holder)));
+        event = ServiceStatistics::ServerEvent::Port;
+        result = this->OnPortEvent(static_cast<Port*>(holder));
+        break;
     case UserDataTag::DeferEvent:
-        R_RETURN(this->OnDeferralEvent());
+        event = ServiceStatistics::ServerEvent::Deferral;
+        result = this->OnDeferralEvent();
+        break;
     default:
         UNREACHABLE();
     }
+
+    statistics.RecordServerEvent(event, std::chrono::steady_clock::now() - start);
+    statistics.DumpIfDue();
+
+    R_RETURN(result);
 }
 
 bool ServerManager::WaitAndProcessImpl() {
@@ -4,6 +4,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <fmt/ranges.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -38,7 +39,9 @@ namespace Service {
 ServiceFrameworkBase::ServiceFrameworkBase(Core::System& system_, const char* service_name_,
                                            u32 max_sessions_, InvokerFn* handler_invoker_)
     : SessionRequestHandler(system_.Kernel(), service_name_), system{system_},
-      service_name{service_name_}, max_sessions{max_sessions_}, handler_invoker{handler_invoker_} {}
+      service_name{service_name_}, max_sessions{max_sessions_}, handler_invoker{handler_invoker_},
+      statistics{system_.GetServiceStatistics()},
+      statistics_entry{statistics.GetEntry(service_name)} {}
 
 ServiceFrameworkBase::~ServiceFrameworkBase() {
     // Wait for other threads to release access before destroying
@@ -94,7 +97,7 @@ void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info, false);
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
@@ -108,7 +111,33 @@ void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info, true);
+}
+
+void ServiceFrameworkBase::InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase& info,
+                                         bool is_tipc) {
+    // The buffer capacities are read before the handler, which may replace the descriptors.
+    u64 in_capacity = 0;
+    u64 out_capacity = 0;
+    for (const auto& buffer : ctx.BufferDescriptorA()) {
+        in_capacity += buffer.Size();
+    }
+    for (const auto& buffer : ctx.BufferDescriptorX()) {
+        in_capacity += buffer.Size();
+    }
+    for (const auto& buffer : ctx.BufferDescriptorB()) {
+        out_capacity += buffer.Size();
+    }
+    for (const auto& buffer : ctx.BufferDescriptorC()) {
+        out_capacity += buffer.Size();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    handler_invoker(this, info.handler_callback, ctx);
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    statistics.RecordCommand(statistics_entry, ctx.GetCommand(), is_tipc, info.name, duration,
+                             in_capacity, out_capacity);
 }
 
 Result ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
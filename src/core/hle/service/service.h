@@ -9,6 +9,7 @@
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/hle/service/hle_ipc.h"
+#include "core/hle/service/service_statistics.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Namespace Service
@@ -104,6 +105,7 @@ private:
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
     void RegisterHandlersBaseTipc(const FunctionInfoBase* functions, std::size_t n);
     void ReportUnimplementedFunction(HLERequestContext& ctx, const FunctionInfoBase* info);
+    void InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase& info, bool is_tipc);
 
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
@@ -117,6 +119,10 @@ private:
     boost::container::flat_map<u32, FunctionInfoBase> handlers;
     boost::container::flat_map<u32, FunctionInfoBase> handlers_tipc;
 
+    /// Records of the service in the system statistics, shared by the objects with the same name.
+    ServiceStatistics& statistics;
+    ServiceStatistics::Entry& statistics_entry;
+
     /// Used to gain exclusive access to the service members, e.g. from CoreTiming thread.
     std::mutex lock_service;
 };
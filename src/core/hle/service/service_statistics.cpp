@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/fs_util.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/hle/service/service_statistics.h"
+
+namespace Service {
+
+namespace {
+
+constexpr std::chrono::seconds DumpInterval{10};
+
+constexpr std::array<const char*, static_cast<size_t>(ServiceStatistics::ServerEvent::Count)>
+    ServerEventNames{"Session", "Port", "Deferral"};
+
+ServiceStatistics::LatencySummary Summarize(const LatencyHistogram& histogram) {
+    return {
+        .count = histogram.Count(),
+        .total_ns = histogram.Total(),
+        .p50_ns = histogram.ValueAtPercentile(50.0),
+        .p99_ns = histogram.ValueAtPercentile(99.0),
+        .max_ns = histogram.Max(),
+    };
+}
+
+double ToMicroseconds(u64 ns) {
+    return static_cast<double>(ns) / 1000.0;
+}
+
+void FormatLatency(fmt::memory_buffer& buf, std::string_view name,
+                   const ServiceStatistics::LatencySummary& latency) {
+    fmt::format_to(std::back_inserter(buf), "{:<48} {:>10} {:>12.3f} {:>10.1f} {:>10.1f} {:>10.1f}",
+                   name, latency.count, static_cast<double>(latency.total_ns) / 1e6,
+                   ToMicroseconds(latency.p50_ns), ToMicroseconds(latency.p99_ns),
+                   ToMicroseconds(latency.max_ns));
+}
+
+} // Anonymous namespace
+
+void LatencyHistogram::Record(u64 value) {
+    ++buckets[BucketIndex(value)];
+    ++count;
+    total += value;
+    max = std::max(max, value);
+}
+
+void LatencyHistogram::Reset() {
+    *this = {};
+}
+
+u64 LatencyHistogram::ValueAtPercentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const auto target = std::max<u64>(
+        1, static_cast<u64>(std::ceil(static_cast<double>(count) * percentile / 100.0)));
+    u64 seen = 0;
+    for (size_t index = 0; index < BucketCount; ++index) {
+        seen += buckets[index];
+        if (seen >= target) {
+            return std::min(BucketUpperBound(index), max);
+        }
+    }
+    return max;
+}
+
+size_t LatencyHistogram::BucketIndex(u64 value) {
+    if (value < SubBucketCount) {
+        return static_cast<size_t>(value);
+    }
+    const auto exponent = static_cast<u32>(std::bit_width(value)) - 1;
+    if (exponent >= MaxExponent) {
+        return BucketCount - 1;
+    }
+    // The sub-bucket is given by the bits following the most significant one.
+    const u64 sub_bucket = (value >> (exponent - SubBucketBits)) - SubBucketCount;
+    return static_cast<size_t>((exponent - SubBucketBits + 1) * SubBucketCount + sub_bucket);
+}
+
+u64 LatencyHistogram::BucketUpperBound(size_t index) {
+    if (index < SubBucketCount) {
+        return index;
+    }
+    const auto shift = static_cast<u32>(index / SubBucketCount) - 1;
+    const u64 lower = (SubBucketCount + index % SubBucketCount) << shift;
+    return lower + (u64{1} << shift) - 1;
+}
+
+class ServiceStatistics::Entry {
+public:
+    struct Command {
+        const char* name;
+        LatencyHistogram latency;
+        u64 in_capacity;
+        u64 out_capacity;
+    };
+
+    std::mutex mutex;
+    /// Keyed by the command id, with the TIPC flag in the upper half.
+    std::unordered_map<u64, Command> commands;
+};
+
+ServiceStatistics::ServiceStatistics() = default;
+
+ServiceStatistics::~ServiceStatistics() = default;
+
+ServiceStatistics::Entry& ServiceStatistics::GetEntry(std::string_view service_name) {
+    std::scoped_lock lk{entries_mutex};
+    auto it = entries.find(service_name);
+    if (it == entries.end()) {
+        it = entries.emplace(std::string{service_name}, std::make_unique<Entry>()).first;
+    }
+    return *it->second;
+}
+
+void ServiceStatistics::RecordCommand(Entry& entry, u32 command, bool is_tipc, const char* name,
+                                      std::chrono::nanoseconds duration, u64 in_capacity,
+                                      u64 out_capacity) {
+    const u64 key = (u64{is_tipc} << 32) | command;
+    std::scoped_lock lk{entry.mutex};
+    auto& record = entry.commands.try_emplace(key, Entry::Command{.name = name}).first->second;
+    record.latency.Record(static_cast<u64>(duration.count()));
+    record.in_capacity += in_capacity;
+    record.out_capacity += out_capacity;
+}
+
+void ServiceStatistics::RecordServerEvent(ServerEvent event, std::chrono::nanoseconds duration) {
+    std::scoped_lock lk{server_mutex};
+    server_events[static_cast<size_t>(event)].Record(static_cast<u64>(duration.count()));
+}
+
+ServiceStatistics::Summary ServiceStatistics::GetSummary() const {
+    Summary summary{};
+    {
+        std::scoped_lock lk{server_mutex};
+        for (size_t i = 0; i < server_events.size(); ++i) {
+            summary.server_events[i] = Summarize(server_events[i]);
+        }
+    }
+
+    std::scoped_lock lk{entries_mutex};
+    for (const auto& [name, entry] : entries) {
+        ServiceSummary service{.name = name, .total_ns = 0, .commands = {}};
+        {
+            std::scoped_lock entry_lk{entry->mutex};
+            for (const auto& [key, command] : entry->commands) {
+                service.commands.push_back({
+                    .command = static_cast<u32>(key),
+                    .is_tipc = (key >> 32) != 0,
+                    .name = command.name,
+                    .latency = Summarize(command.latency),
+                    .in_capacity = command.in_capacity,
+                    .out_capacity = command.out_capacity,
+                });
+                service.total_ns += command.latency.Total();
+            }
+        }
+        if (service.commands.empty()) {
+            continue;
+        }
+        std::ranges::sort(service.commands, std::greater{},
+                          [](const CommandSummary& command) { return command.latency.total_ns; });
+        summary.services.push_back(std::move(service));
+    }
+    std::ranges::sort(summary.services, std::greater{}, &ServiceSummary::total_ns);
+    return summary;
+}
+
+void ServiceStatistics::Reset() {
+    {
+        std::scoped_lock lk{server_mutex};
+        for (auto& histogram : server_events) {
+            histogram.Reset();
+        }
+    }
+
+    std::scoped_lock lk{entries_mutex};
+    for (const auto& [name, entry] : entries) {
+        std::scoped_lock entry_lk{entry->mutex};
+        entry->commands.clear();
+    }
+}
+
+void ServiceStatistics::Dump() const {
+    const auto summary = GetSummary();
+
+    fmt::memory_buffer buf;
+    const auto header = [&](std::string_view title) {
+        fmt::format_to(std::back_inserter(buf), "{:<48} {:>10} {:>12} {:>10} {:>10} {:>10}", title,
+                       "Count", "Total (ms)", "p50 (us)", "p99 (us)", "Max (us)");
+    };
+
+    header("Server event");
+    buf.push_back('\n');
+    for (size_t i = 0; i < summary.server_events.size(); ++i) {
+        FormatLatency(buf, ServerEventNames[i], summary.server_events[i]);
+        buf.push_back('\n');
+    }
+
+    buf.push_back('\n');
+    header("Service command");
+    fmt::format_to(std::back_inserter(buf), " {:>14} {:>14}\n", "In capacity", "Out capacity");
+    for (const auto& service : summary.services) {
+        fmt::format_to(std::back_inserter(buf), "{} ({:.3f} ms)\n", service.name,
+                       static_cast<double>(service.total_ns) / 1e6);
+        for (const auto& command : service.commands) {
+            const auto name = fmt::format("  {}{}({})", command.is_tipc ? "tipc " : "",
+                                          command.name, command.command);
+            FormatLatency(buf, name, command.latency);
+            fmt::format_to(std::back_inserter(buf), " {:>14} {:>14}\n", command.in_capacity,
+                           command.out_capacity);
+        }
+    }
+
+    const auto log_dir = Common::FS::GetEdenPath(Common::FS::EdenPath::LogDir);
+    if (!Common::FS::CreateDirs(log_dir)) {
+        LOG_ERROR(Service, "Failed to create log directory for the service statistics");
+        return;
+    }
+    const auto path = log_dir / "service_statistics.txt";
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile,
+                                      std::string_view{buf.data(), buf.size()}) != buf.size()) {
+        LOG_ERROR(Service, "Failed to write the service statistics to {}",
+                  Common::FS::PathToUTF8String(path));
+    }
+}
+
+void ServiceStatistics::DumpIfDue() {
+    if (!Settings::values.dump_service_statistics.GetValue()) {
+        return;
+    }
+
+    const s64 now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+    s64 next_dump = next_dump_time.load(std::memory_order_relaxed);
+    if (now < next_dump) {
+        return;
+    }
+    // Only the thread moving the deadline forward writes the dump.
+    const s64 new_next_dump =
+        now + std::chrono::duration_cast<std::chrono::nanoseconds>(DumpInterval).count();
+    if (!next_dump_time.compare_exchange_strong(next_dump, new_next_dump,
+                                                std::memory_order_relaxed)) {
+        return;
+    }
+    if (next_dump != 0) {
+        this->Dump();
+    }
+}
+
+} // namespace Service
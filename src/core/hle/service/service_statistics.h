@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Service {
+
+/**
+ * Histogram of durations with a bounded relative error, in the manner of HdrHistogram.
+ * Each power of two is split into a fixed number of linear sub-buckets, so that recording is a
+ * couple of bit operations and the whole range of a nanosecond duration fits in a few hundred
+ * counters.
+ */
+class LatencyHistogram {
+public:
+    /// Linear sub-buckets per power of two, the relative error is below 1 / SubBucketCount.
+    static constexpr u32 SubBucketBits = 3;
+    static constexpr u32 SubBucketCount = 1U << SubBucketBits;
+    /// Values from 2^MaxExponent (about a minute in nanoseconds) up share the last bucket.
+    static constexpr u32 MaxExponent = 36;
+    static constexpr size_t BucketCount = (MaxExponent - SubBucketBits + 1) * SubBucketCount;
+
+    void Record(u64 value);
+    void Reset();
+
+    /// Returns an upper bound of the value below which the given percentile of the records are.
+    u64 ValueAtPercentile(double percentile) const;
+
+    u64 Count() const {
+        return count;
+    }
+
+    u64 Total() const {
+        return total;
+    }
+
+    u64 Max() const {
+        return max;
+    }
+
+    static size_t BucketIndex(u64 value);
+    /// Returns the largest value recorded into the bucket.
+    static u64 BucketUpperBound(size_t index);
+
+private:
+    std::array<u64, BucketCount> buckets{};
+    u64 count{};
+    u64 total{};
+    u64 max{};
+};
+
+/**
+ * Collects per-command call counts, latencies and buffer capacities of the HLE services, and the
+ * time the server managers spend on each kind of event. Recording is always enabled, the collected
+ * data can be queried by the frontends and is periodically written to the log directory when
+ * dump_service_statistics is set.
+ */
+class ServiceStatistics {
+    YUZU_NON_COPYABLE(ServiceStatistics);
+    YUZU_NON_MOVEABLE(ServiceStatistics);
+
+public:
+    /// Kinds of events processed by a ServerManager.
+    enum class ServerEvent : u32 {
+        Session,
+        Port,
+        Deferral,
+        Count,
+    };
+
+    /// Records of a single service, shared by every handler object using the same name.
+    class Entry;
+
+    struct LatencySummary {
+        u64 count;
+        u64 total_ns;
+        u64 p50_ns;
+        u64 p99_ns;
+        u64 max_ns;
+    };
+
+    struct CommandSummary {
+        u32 command;
+        bool is_tipc;
+        std::string name;
+        LatencySummary latency;
+        /// Total capacity of the input (A and X) and output (B and C) buffers of the requests.
+        /// This bounds the bytes the handlers actually moved, which are not tracked.
+        u64 in_capacity;
+        u64 out_capacity;
+    };
+
+    struct ServiceSummary {
+        std::string name;
+        u64 total_ns;
+        std::vector<CommandSummary> commands;
+    };
+
+    struct Summary {
+        /// Services sorted by the time spent in their handlers, in decreasing order.
+        std::vector<ServiceSummary> services;
+        std::array<LatencySummary, static_cast<size_t>(ServerEvent::Count)> server_events;
+    };
+
+    ServiceStatistics();
+    ~ServiceStatistics();
+
+    /// Returns the records of a service, creating them on first use. The entry lives as long as
+    /// this object.
+    Entry& GetEntry(std::string_view service_name);
+
+    void RecordCommand(Entry& entry, u32 command, bool is_tipc, const char* name,
+                       std::chrono::nanoseconds duration, u64 in_capacity, u64 out_capacity);
+    void RecordServerEvent(ServerEvent event, std::chrono::nanoseconds duration);
+
+    Summary GetSummary() const;
+    void Reset();
+
+    /// Writes the summary to the log directory.
+    void Dump() const;
+    /// Writes the summary when dumping is enabled and the dump interval elapsed since the last one.
+    void DumpIfDue();
+
+private:
+    mutable std::mutex entries_mutex;
+    std::map<std::string, std::unique_ptr<Entry>, std::less<>> entries;
+
+    mutable std::mutex server_mutex;
+    std::array<LatencyHistogram, static_cast<size_t>(ServerEvent::Count)> server_events{};
+
+    std::atomic<s64> next_dump_time{};
+};
+
+} // namespace Service
@@ -358,6 +358,39 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    bool GatherSpans(const Common::ProcessAddress addr, const std::size_t size, HostSpans& spans) {
+        spans.clear();
+        const auto append = [&spans](u8* const host_ptr, const std::size_t amount) {
+            if (!spans.empty() && spans.back().data() + spans.back().size() == host_ptr) {
+                spans.back() = std::span<u8>{spans.back().data(), spans.back().size() + amount};
+            } else {
+                spans.emplace_back(host_ptr, amount);
+            }
+        };
+        const bool mapped = WalkBlock(
+            addr, size, [](const std::size_t, const Common::ProcessAddress) {},
+            [&](const std::size_t copy_amount, u8* const host_ptr) {
+                append(host_ptr, copy_amount);
+            },
+            [&](const Common::ProcessAddress, const std::size_t copy_amount, u8* const host_ptr) {
+                append(host_ptr, copy_amount);
+            },
+            [](const std::size_t) {});
+        if (!mapped) {
+            spans.clear();
+        }
+        return mapped;
+    }
+
+    void InvalidateRegion(const Common::ProcessAddress dest_addr, const std::size_t size) {
+        WalkBlock(
+            dest_addr, size, [](const std::size_t, const Common::ProcessAddress) {},
+            [](const std::size_t, u8* const) {},
+            [&](const Common::ProcessAddress current_vaddr, const std::size_t copy_amount,
+                u8* const) { HandleRasterizerWrite(GetInteger(current_vaddr), copy_amount); },
+            [](const std::size_t) {});
+    }
+
     template <bool UNSAFE>
     bool WriteBlockImpl(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
@@ -1046,6 +1079,10 @@ void Memory::SetCurrentPageTable(Kernel::KProcess& process) {
     impl->SetCurrentPageTable(process);
 }
 
+void Memory::SetCurrentPageTable(Common::PageTable& page_table) {
+    impl->current_page_table = &page_table;
+}
+
 void Memory::MapMemoryRegion(Common::PageTable& page_table, Common::ProcessAddress base, u64 size,
                              Common::PhysicalAddress target, Common::MemoryPermission perms,
                              bool separate_heap) {
@@ -1172,6 +1209,15 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+bool Memory::GatherSpans(const Common::ProcessAddress addr, const std::size_t size,
+                         HostSpans& spans) {
+    return impl->GatherSpans(addr, size, spans);
+}
+
+void Memory::InvalidateRegion(const Common::ProcessAddress dest_addr, const std::size_t size) {
+    impl->InvalidateRegion(dest_addr, size);
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
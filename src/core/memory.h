@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/scratch_buffer.h"
 #include "common/typed_address.h"
 #include "core/guest_memory.h"
@@ -52,6 +54,9 @@ enum : u64 {
     DEFAULT_STACK_SIZE = 0x100000,
 };
 
+/// Host memory backing a range of guest memory, one span per run of contiguous host memory
+using HostSpans = boost::container::small_vector<std::span<u8>, 4>;
+
 /// Central class that handles all memory operations and state.
 class Memory {
 public:
@@ -78,6 +83,13 @@ public:
      */
     void SetCurrentPageTable(Kernel::KProcess& process);
 
+    /**
+     * Changes the currently active page table to one that is not owned by a process.
+     *
+     * @param page_table The page table to use.
+     */
+    void SetCurrentPageTable(Common::PageTable& page_table);
+
     /**
      * Maps an allocated buffer onto a region of the emulated process address space.
      *
@@ -371,6 +383,29 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Gathers the host memory backing a range of the current process' address space, so that it
+     * can be accessed in place. Pages that are adjacent in host memory are merged into one span.
+     * This has no side effects: like ReadBlockUnsafe, it does not trigger GPU flushing, and writes
+     * made through the spans must be followed by InvalidateRegion.
+     *
+     * @param addr  The virtual address of the range.
+     * @param size  The size of the range, in bytes.
+     * @param spans The spans backing the range, in order.
+     *
+     * @returns False if part of the range is unmapped, in which case spans is left empty.
+     */
+    bool GatherSpans(Common::ProcessAddress addr, std::size_t size, HostSpans& spans);
+
+    /**
+     * Notifies that a range of the current process' address space was written in place. Like
+     * WriteBlock, regions of cached rasterizer memory are invalidated.
+     *
+     * @param dest_addr The virtual address of the written range.
+     * @param size      The size of the written range, in bytes.
+     */
+    void InvalidateRegion(Common::ProcessAddress dest_addr, std::size_t size);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+#include <tuple>
+
+#include "core/timing_wheel.h"
+
+namespace Core::Timing {
+
+TimingWheel::TimingWheel() = default;
+
+TimingWheel::~TimingWheel() {
+    Clear();
+}
+
+void TimingWheel::Schedule(s64 time, u64 fifo_order, const std::shared_ptr<EventType>& type,
+                           s64 reschedule_time) {
+    TimingEvent* event;
+    if (free_events.empty()) {
+        event = &event_pool.emplace_back();
+    } else {
+        event = free_events.back();
+        free_events.pop_back();
+    }
+    event->type = type;
+    event->type_key = type.get();
+    event->reschedule_time = reschedule_time;
+    Reschedule(*event, time, fifo_order);
+}
+
+void TimingWheel::Reschedule(TimingEvent& event, s64 time, u64 fifo_order) {
+    event.time = time;
+    event.fifo_order = fifo_order;
+    type_events[event.type_key].push_back(event);
+    Insert(event);
+    ++num_events;
+}
+
+void TimingWheel::Unschedule(const EventType* type) {
+    const auto it = type_events.find(type);
+    if (it == type_events.end()) {
+        return;
+    }
+    TypeList& events = it->second;
+    while (!events.empty()) {
+        TimingEvent& event = events.front();
+        Remove(event);
+        Release(event);
+    }
+    type_events.erase(it);
+}
+
+TimingEvent* TimingWheel::PopDue(s64 now) {
+    if (num_events == 0) {
+        return nullptr;
+    }
+    s64 next_time{};
+    TimingEvent* const event = FindEarliest(now, next_time);
+    if (!event || event->time > now) {
+        return nullptr;
+    }
+    // The earliest event is on level zero, moving the current tick up to it keeps every other
+    // event on its slot. Events scheduled from now on are then placed on lower levels.
+    current_tick = (std::max)(current_tick, event->time >> TICK_SHIFT);
+    Remove(*event);
+    return event;
+}
+
+void TimingWheel::Release(TimingEvent& event) {
+    event.type.reset();
+    free_events.push_back(&event);
+}
+
+std::optional<s64> TimingWheel::NextTime(s64 now) {
+    if (num_events == 0) {
+        return std::nullopt;
+    }
+    s64 next_time{};
+    FindEarliest(now, next_time);
+    return next_time;
+}
+
+void TimingWheel::Clear() {
+    for (auto& level : slots) {
+        for (SlotList& slot : level) {
+            slot.clear();
+        }
+    }
+    overflow.clear();
+    occupied = {};
+    type_events.clear();
+    free_events.clear();
+    event_pool.clear();
+    num_events = 0;
+}
+
+void TimingWheel::Insert(TimingEvent& event) {
+    // Events in the past are kept on the current tick, where they are ordered by their exact time
+    const s64 tick = (std::max)(event.time >> TICK_SHIFT, current_tick);
+    const u64 diff = static_cast<u64>(tick ^ current_tick);
+    const u32 level = diff == 0 ? 0 : static_cast<u32>(std::bit_width(diff) - 1) / LEVEL_SHIFT;
+    if (level >= NUM_LEVELS) {
+        event.level = OVERFLOW_LEVEL;
+        event.slot = 0;
+        overflow.push_back(event);
+        return;
+    }
+    event.level = level;
+    event.slot = static_cast<u32>(tick >> (level * LEVEL_SHIFT)) & (NUM_SLOTS - 1);
+    occupied[level] |= 1ULL << event.slot;
+
+    SlotList& slot = slots[level][event.slot];
+    if (level != 0) {
+        slot.push_back(event);
+        return;
+    }
+    // Level zero slots are kept sorted, new events usually go at the back
+    auto it = slot.end();
+    while (it != slot.begin()) {
+        const auto prev = std::prev(it);
+        if (std::tie(prev->time, prev->fifo_order) < std::tie(event.time, event.fifo_order)) {
+            break;
+        }
+        it = prev;
+    }
+    slot.insert(it, event);
+}
+
+void TimingWheel::Remove(TimingEvent& event) {
+    event.slot_hook.unlink();
+    event.type_hook.unlink();
+    if (event.level != OVERFLOW_LEVEL && slots[event.level][event.slot].empty()) {
+        occupied[event.level] &= ~(1ULL << event.slot);
+    }
+    --num_events;
+}
+
+TimingEvent* TimingWheel::FindEarliest(s64 now, s64& next_time) {
+    const s64 now_tick = now >> TICK_SHIFT;
+    while (true) {
+        u32 level = 0;
+        while (level < NUM_LEVELS && occupied[level] == 0) {
+            ++level;
+        }
+
+        if (level == 0) {
+            // Level zero slots are sorted, the first event of the first occupied slot is next
+            const u32 slot = static_cast<u32>(std::countr_zero(occupied[0]));
+            TimingEvent& earliest = slots[0][slot].front();
+            next_time = earliest.time;
+            return &earliest;
+        }
+
+        // Slots above the current one on a level are in time order, and every event on a level
+        // comes after the events of the levels below it
+        s64 slot_start;
+        u32 slot = 0;
+        if (level < NUM_LEVELS) {
+            slot = static_cast<u32>(std::countr_zero(occupied[level]));
+            const u32 window_shift = (level + 1) * LEVEL_SHIFT;
+            slot_start = ((current_tick >> window_shift) << window_shift) |
+                         (static_cast<s64>(slot) << (level * LEVEL_SHIFT));
+        } else {
+            slot_start = (std::numeric_limits<s64>::max)();
+            for (const TimingEvent& event : overflow) {
+                slot_start = (std::min)(slot_start, event.time >> TICK_SHIFT);
+            }
+            slot_start = (std::max)(slot_start, current_tick);
+        }
+        if (slot_start > now_tick) {
+            next_time = slot_start << TICK_SHIFT;
+            return nullptr;
+        }
+
+        // The slot is due, spread its events on the levels below
+        current_tick = slot_start;
+        SlotList pending;
+        pending.splice(pending.end(), GetSlot(level, slot));
+        if (level < NUM_LEVELS) {
+            occupied[level] &= ~(1ULL << slot);
+        }
+        while (!pending.empty()) {
+            TimingEvent& event = pending.front();
+            pending.pop_front();
+            Insert(event);
+        }
+    }
+}
+
+} // namespace Core::Timing
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/intrusive/list.hpp>
+
+#include "common/common_types.h"
+
+namespace Core::Timing {
+
+struct EventType;
+
+/// A scheduled instance of an EventType.
+struct TimingEvent {
+    using Hook = boost::intrusive::list_member_hook<
+        boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+
+    s64 time;
+    u64 fifo_order;
+    std::weak_ptr<EventType> type;
+    /// Identity of the type, only used to find the other events of the type
+    const EventType* type_key;
+    s64 reschedule_time;
+
+    /// Links the event into its wheel slot
+    Hook slot_hook;
+    /// Links the event with the other scheduled instances of its type
+    Hook type_hook;
+    u32 level;
+    u32 slot;
+};
+
+/**
+ * Hierarchical timing wheel holding the events scheduled on CoreTiming.
+ *
+ * Each level has 64 slots, slots of level N cover 64^N ticks of 1024ns. An event is placed on the
+ * lowest level whose slot still separates it from the current tick, so scheduling and
+ * unscheduling are O(1). When the first occupied slot is above level zero and is due, its events
+ * are cascaded down to the lower levels. Level zero slots are kept sorted by time and then by the
+ * order events were added, new events are almost always appended at the end.
+ *
+ * Events of each type are also linked together, so that unscheduling a type does not need to
+ * search the wheel.
+ */
+class TimingWheel {
+public:
+    TimingWheel();
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /// Adds an event to the wheel.
+    void Schedule(s64 time, u64 fifo_order, const std::shared_ptr<EventType>& type,
+                  s64 reschedule_time);
+
+    /// Adds back an event previously returned by PopDue, keeping its type and reschedule time.
+    void Reschedule(TimingEvent& event, s64 time, u64 fifo_order);
+
+    /// Removes all the scheduled events of the given type.
+    void Unschedule(const EventType* type);
+
+    /// Removes and returns the earliest event if it is due at the given time, nullptr otherwise.
+    /// The event stays allocated until it is passed to Release or Reschedule.
+    TimingEvent* PopDue(s64 now);
+
+    /// Returns an event obtained from PopDue to the pool.
+    void Release(TimingEvent& event);
+
+    /// Returns a time no later than the earliest scheduled event, which is exact once the event
+    /// is close enough to be on level zero.
+    std::optional<s64> NextTime(s64 now);
+
+    /// Removes every scheduled event.
+    void Clear();
+
+    bool Empty() const {
+        return num_events == 0;
+    }
+
+private:
+    static constexpr u32 TICK_SHIFT = 10;
+    static constexpr u32 LEVEL_SHIFT = 6;
+    static constexpr u32 NUM_SLOTS = 1U << LEVEL_SHIFT;
+    static constexpr u32 NUM_LEVELS = 6;
+    /// Level used for events further away than what the wheel can hold
+    static constexpr u32 OVERFLOW_LEVEL = NUM_LEVELS;
+
+    using SlotList = boost::intrusive::list<
+        TimingEvent,
+        boost::intrusive::member_hook<TimingEvent, TimingEvent::Hook, &TimingEvent::slot_hook>,
+        boost::intrusive::constant_time_size<false>>;
+    using TypeList = boost::intrusive::list<
+        TimingEvent,
+        boost::intrusive::member_hook<TimingEvent, TimingEvent::Hook, &TimingEvent::type_hook>,
+        boost::intrusive::constant_time_size<false>>;
+
+    /// Places an event on the slot matching its time relative to the current tick.
+    void Insert(TimingEvent& event);
+
+    /// Unlinks an event from its slot and from the list of its type.
+    void Remove(TimingEvent& event);
+
+    /// Cascades the wheel up to the given time. Returns the earliest event when it is on level
+    /// zero, otherwise a lower bound of its time is written to next_time.
+    TimingEvent* FindEarliest(s64 now, s64& next_time);
+
+    SlotList& GetSlot(u32 level, u32 slot) {
+        return level == OVERFLOW_LEVEL ? overflow : slots[level][slot];
+    }
+
+    std::array<std::array<SlotList, NUM_SLOTS>, NUM_LEVELS> slots;
+    std::array<u64, NUM_LEVELS> occupied{};
+    SlotList overflow;
+    s64 current_tick{};
+    size_t num_events{};
+
+    std::unordered_map<const EventType*, TypeList> type_events;
+
+    std::deque<TimingEvent> event_pool;
+    std::vector<TimingEvent*> free_events;
+};
+
+} // namespace Core::Timing
@@ -329,8 +329,10 @@ A64AddressSpace::A64AddressSpace(const A64::UserConfig& conf)
 
 IR::Block A64AddressSpace::GenerateIR(IR::LocationDescriptor descriptor) const {
     const auto get_code = [this](u64 vaddr) { return conf.callbacks->MemoryReadCode(vaddr); };
-    IR::Block ir_block = A64::Translate(A64::LocationDescriptor{descriptor}, get_code,
-                                        {conf.define_unpredictable_behaviour, conf.wall_clock_cntpct});
+    A64::TranslationOptions options{conf.define_unpredictable_behaviour, conf.wall_clock_cntpct};
+    // This backend does not implement A64ExitIf, so the translator must not form traces
+    options.max_trace_length = 0;
+    IR::Block ir_block = A64::Translate(A64::LocationDescriptor{descriptor}, get_code, options);
 
     Optimization::A64CallbackConfigPass(ir_block, conf);
     Optimization::NamingPass(ir_block);
@@ -351,7 +353,26 @@ IR::Block A64AddressSpace::GenerateIR(IR::LocationDescriptor descriptor) const {
 }
 
 void A64AddressSpace::InvalidateCacheRanges(const boost::icl::interval_set<u64>& ranges) {
-    InvalidateBasicBlocks(block_ranges.InvalidateRanges(ranges));
+    const auto descriptors = block_ranges.InvalidateRanges(ranges);
+    for (const auto& descriptor : descriptors) {
+        compiled_blocks.erase(descriptor);
+    }
+    InvalidateBasicBlocks(descriptors);
+}
+
+void A64AddressSpace::ClearCache() {
+    AddressSpace::ClearCache();
+    compiled_blocks.clear();
+}
+
+std::vector<A64::CompiledBlock> A64AddressSpace::TakeCompiledBlocks() {
+    std::vector<A64::CompiledBlock> result;
+    result.reserve(compiled_blocks.size());
+    for (const auto& [location, info] : compiled_blocks) {
+        result.push_back(info);
+    }
+    compiled_blocks.clear();
+    return result;
 }
 
 void A64AddressSpace::EmitPrelude() {
@@ -595,6 +616,9 @@ void A64AddressSpace::RegisterNewBasicBlock(const IR::Block& block, const Emitte
     const A64::LocationDescriptor end_location{block.EndLocation()};
     const auto range = boost::icl::discrete_interval<u64>::closed(descriptor.PC(), end_location.PC() - 1);
     block_ranges.AddRange(range, descriptor);
+    if (conf.record_compiled_blocks && !descriptor.SingleStepping()) {
+        compiled_blocks.insert_or_assign(descriptor, A64::CompiledBlock{descriptor.UniqueHash(), descriptor.PC(), end_location.PC() - descriptor.PC()});
+    }
 }
 
 }  // namespace Dynarmic::Backend::Arm64
@@ -5,8 +5,11 @@
 
 #pragma once
 
+#include <vector>
+
 #include "dynarmic/backend/arm64/address_space.h"
 #include "dynarmic/backend/block_range_information.h"
+#include "dynarmic/interface/A64/a64.h"
 #include "dynarmic/interface/A64/config.h"
 
 namespace Dynarmic::Backend::Arm64 {
@@ -20,6 +23,10 @@ public:
     IR::Block GenerateIR(IR::LocationDescriptor) const override;
 
     void InvalidateCacheRanges(const boost::icl::interval_set<u64>& ranges);
+    void ClearCache() override;
+
+    /// Returns the blocks emitted since the last call that are still valid, and forgets them.
+    std::vector<A64::CompiledBlock> TakeCompiledBlocks();
 
 protected:
     friend class A64Core;
@@ -30,6 +37,7 @@ protected:
 
     const A64::UserConfig conf;
     BlockRangeInformation<u64> block_ranges;
+    ankerl::unordered_dense::map<IR::LocationDescriptor, A64::CompiledBlock> compiled_blocks;
 };
 
 }  // namespace Dynarmic::Backend::Arm64
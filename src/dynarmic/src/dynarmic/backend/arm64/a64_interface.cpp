@@ -75,6 +75,16 @@ struct Jit::Impl final {
         HaltExecution(HaltReason::CacheInvalidation);
     }
 
+    std::vector<CompiledBlock> TakeCompiledBlocks() {
+        return current_address_space.TakeCompiledBlocks();
+    }
+
+    void PrecompileBlock(std::uint64_t location) {
+        ASSERT(!is_executing);
+        PerformRequestedCacheInvalidation(static_cast<HaltReason>(Atomic::Load(&halt_reason)));
+        current_address_space.GetOrEmit(IR::LocationDescriptor{location});
+    }
+
     void Reset() {
         current_state = {};
     }
@@ -218,6 +228,14 @@ void Jit::InvalidateCacheRange(std::uint64_t start_address, std::size_t length)
     impl->InvalidateCacheRange(start_address, length);
 }
 
+std::vector<CompiledBlock> Jit::TakeCompiledBlocks() {
+    return impl->TakeCompiledBlocks();
+}
+
+void Jit::PrecompileBlock(std::uint64_t location) {
+    impl->PrecompileBlock(location);
+}
+
 void Jit::Reset() {
     impl->Reset();
 }
@@ -43,7 +43,7 @@ public:
 
     void InvalidateBasicBlocks(const ankerl::unordered_dense::set<IR::LocationDescriptor>& descriptors);
 
-    void ClearCache();
+    virtual void ClearCache();
 
     void DumpDisassembly() const;
 
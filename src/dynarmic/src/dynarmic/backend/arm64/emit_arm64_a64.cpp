@@ -378,6 +378,11 @@ void EmitIR<IR::Opcode::A64SetPC>(oaknut::CodeGenerator& code, EmitContext& ctx,
     code.STR(Xvalue, Xstate, offsetof(A64JitState, pc));
 }
 
+template<>
+void EmitIR<IR::Opcode::A64ExitIf>(oaknut::CodeGenerator&, EmitContext&, IR::Inst*) {
+    ASSERT_FALSE("A64ExitIf is only emitted for traces, which this backend never requests");
+}
+
 template<>
 void EmitIR<IR::Opcode::A64CallSupervisor>(oaknut::CodeGenerator& code, EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
@@ -127,6 +127,11 @@ void EmitIR<IR::Opcode::A64SetPC>(biscuit::Assembler&, EmitContext&, IR::Inst*)
     UNIMPLEMENTED();
 }
 
+template<>
+void EmitIR<IR::Opcode::A64ExitIf>(biscuit::Assembler&, EmitContext&, IR::Inst*) {
+    UNIMPLEMENTED();
+}
+
 template<>
 void EmitIR<IR::Opcode::A64CallSupervisor>(biscuit::Assembler&, EmitContext&, IR::Inst*) {
     UNIMPLEMENTED();
@@ -118,7 +118,11 @@ A32EmitX64::BlockDescriptor A32EmitX64::Emit(IR::Block& block) {
         return gprs;
     }();
 
-    new (&this->reg_alloc) RegAlloc(&code, gpr_order, any_xmm);
+    const bool use_live_ranges = conf.HasOptimization(OptimizationFlag::LiveRangeRegAlloc);
+    if (use_live_ranges) {
+        live_ranges.Analyze(block);
+    }
+    new (&this->reg_alloc) RegAlloc(&code, gpr_order, any_xmm, use_live_ranges ? &live_ranges : nullptr);
     A32EmitContext ctx{conf, reg_alloc, block};
 
     // Start emitting.
@@ -148,6 +152,7 @@ A32EmitX64::BlockDescriptor A32EmitX64::Emit(IR::Block& block) {
             default: [[unlikely]] ASSERT_FALSE("Invalid opcode: {}", inst->GetOpcode());
             }
             reg_alloc.EndOfAllocScope();
+            live_ranges.Advance();
             func(reg_alloc);
         }
     };
@@ -128,6 +128,7 @@ protected:
 
     const A32::UserConfig conf;
     RegAlloc reg_alloc; //reusable reg alloc
+    LiveRanges live_ranges; //reusable live range analysis
     BlockRangeInformation<u32> block_ranges;
     std::array<FastDispatchEntry, fast_dispatch_table_size> fast_dispatch_table;
     ankerl::unordered_dense::map<u64, FastmemPatchInfo> fastmem_patch_info;
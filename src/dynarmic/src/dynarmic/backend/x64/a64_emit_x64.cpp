@@ -11,6 +11,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include "dynarmic/common/assert.h"
+#include <mcl/bit_cast.hpp>
 #include <mcl/scope_exit.hpp>
 #include "dynarmic/common/common_types.h"
 #include <mcl/type_traits/integer_of_size.hpp>
@@ -89,13 +90,21 @@ A64EmitX64::BlockDescriptor A64EmitX64::Emit(IR::Block& block) noexcept {
         return gprs;
     }();
 
-    new (&this->reg_alloc) RegAlloc{&code, gpr_order, any_xmm};
+    const bool use_live_ranges = conf.HasOptimization(OptimizationFlag::LiveRangeRegAlloc);
+    if (use_live_ranges) {
+        live_ranges.Analyze(block);
+    }
+    new (&this->reg_alloc) RegAlloc{&code, gpr_order, any_xmm, use_live_ranges ? &live_ranges : nullptr};
     A64EmitContext ctx{conf, reg_alloc, block};
 
     // Start emitting.
     code.align();
     const auto* const entrypoint = code.getCurr();
 
+    if (conf.hot_block_threshold != 0 && !ctx.IsSingleStep() && !IsHotBlock(block.Location())) {
+        EmitBlockCounter(ctx);
+    }
+
     DEBUG_ASSERT(block.GetCondition() == IR::Cond::AL);
     typedef void (EmitX64::*EmitHandlerFn)(EmitContext& context, IR::Inst* inst);
     constexpr EmitHandlerFn opcode_handlers[] = {
@@ -141,6 +150,7 @@ a64_branch:
         (this->*a64_handlers[size_t(opcode) - std::size(opcode_handlers)])(ctx, &inst);
 finish_this_inst:
         ctx.reg_alloc.EndOfAllocScope();
+        live_ranges.Advance();
         if (conf.very_verbose_debugging_output) [[unlikely]] {
             EmitVerboseDebuggingOutput(reg_alloc);
         }
@@ -166,6 +176,9 @@ finish_this_inst:
 
     const auto range = boost::icl::discrete_interval<u64>::closed(descriptor.PC(), end_location.PC() - 1);
     block_ranges.AddRange(range, descriptor);
+    if (conf.record_compiled_blocks && !descriptor.SingleStepping()) {
+        compiled_blocks.insert_or_assign(descriptor, A64::CompiledBlock{descriptor.UniqueHash(), descriptor.PC(), end_location.PC() - descriptor.PC()});
+    }
 
     return RegisterBlock(descriptor, entrypoint, size);
 }
@@ -173,12 +186,104 @@ finish_this_inst:
 void A64EmitX64::ClearCache() {
     EmitX64::ClearCache();
     block_ranges.ClearCache();
+    compiled_blocks.clear();
     ClearFastDispatchTable();
     fastmem_patch_info.clear();
+    block_counters.clear();
+    block_counter_of.clear();
+    free_block_counters.clear();
 }
 
 void A64EmitX64::InvalidateCacheRanges(const boost::icl::interval_set<u64>& ranges) {
-    InvalidateBasicBlocks(block_ranges.InvalidateRanges(ranges));
+    const auto locations = block_ranges.InvalidateRanges(ranges);
+    for (const auto& location : locations) {
+        compiled_blocks.erase(location);
+        // The new code at this location has to earn its promotion again
+        hot_blocks.erase(location);
+    }
+    RecycleBlockCounters(locations);
+    InvalidateBasicBlocks(locations);
+}
+
+std::vector<A64::CompiledBlock> A64EmitX64::TakeCompiledBlocks() {
+    std::vector<A64::CompiledBlock> result;
+    result.reserve(compiled_blocks.size());
+    for (const auto& [location, info] : compiled_blocks) {
+        result.push_back(info);
+    }
+    compiled_blocks.clear();
+    return result;
+}
+
+bool A64EmitX64::IsHotBlock(IR::LocationDescriptor location) const {
+    return hot_blocks.contains(location);
+}
+
+void A64EmitX64::EmitBlockCounter(A64EmitContext& ctx) {
+    const IR::LocationDescriptor location = ctx.Location();
+    u32*& slot = block_counter_of[location];
+    if (!slot) {
+        if (free_block_counters.empty()) {
+            slot = &block_counters.emplace_back();
+        } else {
+            slot = free_block_counters.back();
+            free_block_counters.pop_back();
+        }
+    }
+    u32& counter = *slot;
+    counter = conf.hot_block_threshold;
+
+    SharedLabel promote = GenSharedLabel(), resume = GenSharedLabel();
+
+    // Nothing is allocated at block entry, so rax is free to use here.
+    code.mov(rax, mcl::bit_cast<u64>(&counter));
+    code.sub(dword[rax], 1);
+    code.jz(*promote, code.T_NEAR);
+    code.L(*resume);
+
+    ctx.deferred_emits.emplace_back([this, promote, resume, location] {
+        code.L(*promote);
+        code.SwitchMxcsrOnExit();
+        ABI_PushCallerSaveRegistersAndAdjustStack(code);
+        code.mov(code.ABI_PARAM1, mcl::bit_cast<u64>(this));
+        code.mov(code.ABI_PARAM2, location.Value());
+        code.mov(code.ABI_PARAM3, code.ABI_JIT_PTR);
+        code.CallLambda([](A64EmitX64* self, u64 location_value, A64JitState* jit_state) {
+            self->PromoteHotBlock(IR::LocationDescriptor{location_value}, *jit_state);
+        });
+        ABI_PopCallerSaveRegistersAndAdjustStack(code);
+        code.SwitchMxcsrOnEntry();
+        code.jmp(*resume, code.T_NEAR);
+    });
+}
+
+void A64EmitX64::PromoteHotBlock(IR::LocationDescriptor location, A64JitState& jit_state) {
+    // The currently executing code stays valid until the next cache clear; unlinking it here
+    // makes the next dispatch to this location recompile it with the full pipeline.
+    hot_blocks.insert(location);
+    RecycleBlockCounters({location});
+    InvalidateBasicBlocks({location});
+
+    // Returns and indirect branches would otherwise keep entering the cold code through the
+    // lookup caches, as they are only flushed on cache clears.
+    if (conf.HasOptimization(OptimizationFlag::FastDispatch)) {
+        (*fast_dispatch_table_lookup)(location.Value()) = {};
+    }
+    for (size_t i = 0; i < A64JitState::RSBSize; ++i) {
+        if (jit_state.rsb_location_descriptors[i] == location.Value()) {
+            jit_state.rsb_location_descriptors[i] = 0xFFFFFFFFFFFFFFFFull;
+            jit_state.rsb_codeptrs[i] = 0;
+        }
+    }
+}
+
+void A64EmitX64::RecycleBlockCounters(const ankerl::unordered_dense::set<IR::LocationDescriptor>& locations) {
+    for (const auto& location : locations) {
+        if (const auto it = block_counter_of.find(location); it != block_counter_of.end()) {
+            free_block_counters.push_back(it->second);
+            block_counter_of.erase(it);
+        }
+    }
 }
 
 void A64EmitX64::ClearFastDispatchTable() {
@@ -498,6 +603,33 @@ void A64EmitX64::EmitA64SetPC(A64EmitContext& ctx, IR::Inst* inst) {
     }
 }
 
+void A64EmitX64::EmitA64ExitIf(A64EmitContext& ctx, IR::Inst* inst) {
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    const auto cond = args[0].GetImmediateCond();
+    const IR::LocationDescriptor target{args[1].GetImmediateU64()};
+    const size_t cycles = args[2].GetImmediateU64();
+    const IR::LocationDescriptor location = ctx.Location().SetSingleStepping(false);
+    const bool is_single_step = ctx.IsSingleStep();
+
+    // EmitCond clobbers eax.
+    ctx.reg_alloc.ScratchGpr(HostLoc::RAX);
+
+    // The exit itself is placed out of line; the fall-through path only pays for the test.
+    // Inverting an A64 condition flips its lowest bit (EQ/NE, CS/CC, ...).
+    SharedLabel exit = GenSharedLabel();
+    Xbyak::Label stay = EmitCond(static_cast<IR::Cond>(static_cast<size_t>(cond) ^ 1));
+    code.jmp(*exit, code.T_NEAR);
+    code.L(stay);
+
+    ctx.deferred_emits.emplace_back([this, exit, target, cycles, location, is_single_step] {
+        code.L(*exit);
+        if (conf.enable_cycle_counting) {
+            EmitAddCycles(cycles);
+        }
+        EmitX64::EmitTerminal(IR::Term::LinkBlock{target}, location, is_single_step);
+    });
+}
+
 void A64EmitX64::EmitA64CallSupervisor(A64EmitContext& ctx, IR::Inst* inst) {
     ctx.reg_alloc.HostCall(nullptr);
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
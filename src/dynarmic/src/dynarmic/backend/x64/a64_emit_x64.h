@@ -6,9 +6,11 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <map>
 #include <optional>
 #include <tuple>
+#include <vector>
 #include <ankerl/unordered_dense.h>
 #include <boost/container/static_vector.hpp>
 
@@ -50,6 +52,13 @@ public:
 
     void InvalidateCacheRanges(const boost::icl::interval_set<u64>& ranges);
 
+    /// Returns the blocks emitted since the last call that are still valid, and forgets them.
+    std::vector<A64::CompiledBlock> TakeCompiledBlocks();
+
+    /// Returns true if the block at this location has reached the hot block threshold and
+    /// should be compiled with the full optimization pipeline.
+    bool IsHotBlock(IR::LocationDescriptor location) const;
+
 protected:
     struct FastDispatchEntry {
         u64 location_descriptor = 0xFFFF'FFFF'FFFF'FFFFull;
@@ -64,6 +73,11 @@ protected:
     void GenFastmemFallbacks();
     void GenTerminalHandlers();
 
+    // Tiered compilation
+    void EmitBlockCounter(A64EmitContext& ctx);
+    void PromoteHotBlock(IR::LocationDescriptor location, A64JitState& jit_state);
+    void RecycleBlockCounters(const ankerl::unordered_dense::set<IR::LocationDescriptor>& locations);
+
     // Microinstruction emitters
     void EmitPushRSB(EmitContext& ctx, IR::Inst* inst);
 #define OPCODE(...)
@@ -124,7 +138,13 @@ protected:
 //data
     const A64::UserConfig conf;
     RegAlloc reg_alloc; //reusable reg alloc
+    LiveRanges live_ranges; //reusable live range analysis
     BlockRangeInformation<u64> block_ranges;
+    ankerl::unordered_dense::map<IR::LocationDescriptor, A64::CompiledBlock> compiled_blocks;
+    ankerl::unordered_dense::set<IR::LocationDescriptor> hot_blocks;
+    std::deque<u32> block_counters; // stable addresses referenced by emitted code
+    ankerl::unordered_dense::map<IR::LocationDescriptor, u32*> block_counter_of;
+    std::vector<u32*> free_block_counters;
     std::array<FastDispatchEntry, fast_dispatch_table_size> fast_dispatch_table;
     ankerl::unordered_dense::map<u64, FastmemPatchInfo> fastmem_patch_info;
     ankerl::unordered_dense::map<std::tuple<bool, size_t, int, int>, void (*)()> read_fallbacks;
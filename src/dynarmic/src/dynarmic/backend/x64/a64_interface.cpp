@@ -129,6 +129,16 @@ public:
         HaltExecution(HaltReason::CacheInvalidation);
     }
 
+    std::vector<CompiledBlock> TakeCompiledBlocks() {
+        return emitter.TakeCompiledBlocks();
+    }
+
+    void PrecompileBlock(u64 location) {
+        ASSERT(!is_executing);
+        PerformRequestedCacheInvalidation(static_cast<HaltReason>(Atomic::Load(&jit_state.halt_reason)));
+        GetBlock(IR::LocationDescriptor{location});
+    }
+
     void Reset() {
         ASSERT(!is_executing);
         jit_state = {};
@@ -264,6 +274,7 @@ private:
             return block->entrypoint;
 
         constexpr size_t MINIMUM_REMAINING_CODESIZE = 1 * 1024 * 1024;
+        constexpr size_t MAX_TRACE_LENGTH = 128;
         if (block_of_code.SpaceRemaining() < MINIMUM_REMAINING_CODESIZE) {
             // Immediately evacuate cache
             invalidate_entire_cache = true;
@@ -271,23 +282,39 @@ private:
         }
         block_of_code.EnsureMemoryCommitted(MINIMUM_REMAINING_CODESIZE);
 
+        // With tiered compilation, cold blocks skip the IR optimizations entirely and are
+        // recompiled once the emitted execution counter marks them as hot. Hot blocks are
+        // recompiled as traces so that the passes below can work across branches.
+        const bool is_hot = conf.hot_block_threshold == 0 || emitter.IsHotBlock(current_location);
+        const bool form_trace = conf.hot_block_threshold != 0 && is_hot;
+
         // JIT Compile
         const auto get_code = [this](u64 vaddr) { return conf.callbacks->MemoryReadCode(vaddr); };
         IR::Block ir_block = A64::Translate(A64::LocationDescriptor{current_location}, get_code,
-                                            {conf.define_unpredictable_behaviour, conf.wall_clock_cntpct});
+                                            {conf.define_unpredictable_behaviour, conf.wall_clock_cntpct, true, form_trace ? MAX_TRACE_LENGTH : 0});
         Optimization::PolyfillPass(ir_block, polyfill_options);
         Optimization::A64CallbackConfigPass(ir_block, conf);
         Optimization::NamingPass(ir_block);
-        if (conf.HasOptimization(OptimizationFlag::GetSetElimination) && !conf.check_halt_on_memory_access) {
-            Optimization::A64GetSetElimination(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-        }
-        if (conf.HasOptimization(OptimizationFlag::ConstProp)) {
-            Optimization::ConstantPropagation(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-        }
-        if (conf.HasOptimization(OptimizationFlag::MiscIROpt)) {
-            Optimization::A64MergeInterpretBlocksPass(ir_block, conf.callbacks);
+        if (is_hot) {
+            if (conf.HasOptimization(OptimizationFlag::GetSetElimination) && !conf.check_halt_on_memory_access) {
+                Optimization::A64GetSetElimination(ir_block);
+                Optimization::DeadCodeElimination(ir_block);
+            }
+            if (conf.HasOptimization(OptimizationFlag::ConstProp)) {
+                Optimization::ConstantPropagation(ir_block);
+                Optimization::DeadCodeElimination(ir_block);
+            }
+            if (conf.hot_block_threshold != 0) {
+                // Hot blocks can afford a second round to clean up after the passes above.
+                Optimization::IdentityRemovalPass(ir_block);
+                if (conf.HasOptimization(OptimizationFlag::ConstProp)) {
+                    Optimization::ConstantPropagation(ir_block);
+                }
+                Optimization::DeadCodeElimination(ir_block);
+            }
+            if (conf.HasOptimization(OptimizationFlag::MiscIROpt)) {
+                Optimization::A64MergeInterpretBlocksPass(ir_block, conf.callbacks);
+            }
         }
         Optimization::VerificationPass(ir_block);
         return emitter.Emit(ir_block).entrypoint;
@@ -349,6 +376,14 @@ void Jit::InvalidateCacheRange(u64 start_address, size_t length) {
     impl->InvalidateCacheRange(start_address, length);
 }
 
+std::vector<CompiledBlock> Jit::TakeCompiledBlocks() {
+    return impl->TakeCompiledBlocks();
+}
+
+void Jit::PrecompileBlock(u64 location) {
+    impl->PrecompileBlock(location);
+}
+
 void Jit::Reset() {
     impl->Reset();
 }
@@ -20,6 +20,7 @@
 #include "dynarmic/backend/x64/abi.h"
 #include "dynarmic/backend/x64/stack_layout.h"
 #include "dynarmic/backend/x64/verbose_debugging_output.h"
+#include "dynarmic/ir/basic_block.h"
 
 namespace Dynarmic::Backend::X64 {
 
@@ -104,6 +105,7 @@ void HostLocInfo::ReleaseAll() noexcept {
         accumulated_uses = 0;
         total_uses = 0;
         max_bit_width = 0;
+        is_remat = false;
     }
 
     is_being_used_count = 0;
@@ -115,6 +117,9 @@ void HostLocInfo::AddValue(IR::Inst* inst) noexcept {
         is_set_last_use = false;
         values.clear();
     }
+    if (values.empty()) {
+        is_remat = false;
+    }
     values.push_back(inst);
     ASSERT(size_t(total_uses) + inst->UseCount() < (std::numeric_limits<uint16_t>::max)());
     total_uses += inst->UseCount();
@@ -208,10 +213,56 @@ bool Argument::IsInMemory() const noexcept {
     return HostLocIsSpill(*reg_alloc.ValueLocation(value.GetInst()));
 }
 
-RegAlloc::RegAlloc(BlockOfCode* code, boost::container::static_vector<HostLoc, 28> gpr_order, boost::container::static_vector<HostLoc, 28> xmm_order) noexcept
+void LiveRanges::Analyze(const IR::Block& block) noexcept {
+    ranges.clear();
+    use_positions.clear();
+    position = 0;
+
+    const auto for_each_use = [&block](auto&& func) {
+        u32 inst_position = 0;
+        for (const IR::Inst& inst : block) {
+            for (size_t i = 0; i < inst.NumArgs(); i++) {
+                const auto arg = inst.GetArg(i);
+                if (!arg.IsImmediate() && !IsValuelessType(arg.GetType())) {
+                    func(arg.GetInst(), inst_position);
+                }
+            }
+            inst_position++;
+        }
+    };
+
+    // Count uses, then lay out each value's use positions contiguously and in ascending order.
+    for_each_use([this](const IR::Inst* value, u32) {
+        ranges[value].end++;
+    });
+    u32 offset = 0;
+    for (auto& [value, range] : ranges) {
+        range.begin = offset;
+        offset += range.end;
+        range.end = range.begin;
+    }
+    use_positions.resize(offset);
+    for_each_use([this](const IR::Inst* value, u32 inst_position) {
+        use_positions[ranges[value].end++] = inst_position;
+    });
+}
+
+size_t LiveRanges::NextUse(const IR::Inst* inst) const noexcept {
+    const auto iter = ranges.find(inst);
+    if (iter == ranges.end()) {
+        return SIZE_MAX;
+    }
+    const auto begin = use_positions.begin() + iter->second.begin;
+    const auto end = use_positions.begin() + iter->second.end;
+    const auto next = std::lower_bound(begin, end, position);
+    return next != end ? *next : SIZE_MAX;
+}
+
+RegAlloc::RegAlloc(BlockOfCode* code, boost::container::static_vector<HostLoc, 28> gpr_order, boost::container::static_vector<HostLoc, 28> xmm_order, const LiveRanges* live_ranges) noexcept
     : gpr_order(gpr_order),
     xmm_order(xmm_order),
-    code(code)
+    code(code),
+    live_ranges(live_ranges)
 {}
 
 //static std::uint64_t Zfncwjkrt_blockOfCodeShim = 0;
@@ -414,6 +465,10 @@ void RegAlloc::ReleaseStackSpace(const size_t stack_space) noexcept {
 }
 
 HostLoc RegAlloc::SelectARegister(const boost::container::static_vector<HostLoc, 28>& desired_locations) const noexcept {
+    if (live_ranges) {
+        return SelectARegisterByNextUse(desired_locations);
+    }
+
     // TODO(lizzie): Overspill causes issues (reads to 0 and such) on some games, I need to make a testbench
     // to later track this down - however I just modified the LRU algo so it prefers empty registers first
     // we need to test high register pressure (and spills, maybe 32 regs?)
@@ -470,6 +525,39 @@ HostLoc RegAlloc::SelectARegister(const boost::container::static_vector<HostLoc,
     return *it_final;
 }
 
+HostLoc RegAlloc::SelectARegisterByNextUse(const boost::container::static_vector<HostLoc, 28>& desired_locations) const noexcept {
+    // Linear-scan style selection: an empty register if there is one, otherwise the register
+    // whose values are next needed furthest in the future. Its live range is split at this point
+    // and the remainder lives in a spill slot until it is reloaded by its next use.
+    auto it_final = desired_locations.cend();
+    size_t furthest_next_use = 0;
+    bool final_is_remat = false;
+    for (auto it = desired_locations.cbegin(); it != desired_locations.cend(); it++) {
+        auto const& loc_info = LocInfo(*it);
+        DEBUG_ASSERT(*it != ABI_JIT_PTR);
+        // Same restrictions as SelectARegister.
+        if (loc_info.IsLocked() || (*it >= HostLoc::R13 && *it <= HostLoc::R15)) {
+            continue;
+        }
+        if (loc_info.IsEmpty()) {
+            return *it;
+        }
+        size_t next_use = SIZE_MAX;
+        for (const IR::Inst* value : loc_info.values) {
+            next_use = std::min(next_use, live_ranges->NextUse(value));
+        }
+        // Constants are cheaper to evict since they never need to be stored.
+        if (it_final == desired_locations.cend() || next_use > furthest_next_use
+            || (next_use == furthest_next_use && loc_info.is_remat && !final_is_remat)) {
+            it_final = it;
+            furthest_next_use = next_use;
+            final_is_remat = loc_info.is_remat;
+        }
+    }
+    ASSERT_MSG(it_final != desired_locations.cend(), "All candidate registers have already been allocated");
+    return *it_final;
+}
+
 void RegAlloc::DefineValueImpl(IR::Inst* def_inst, HostLoc host_loc) noexcept {
     ASSERT_MSG(!ValueLocation(def_inst), "def_inst has already been defined");
     LocInfo(host_loc).AddValue(def_inst);
@@ -482,6 +570,10 @@ void RegAlloc::DefineValueImpl(IR::Inst* def_inst, const IR::Value& use_inst) no
         const HostLoc location = ScratchImpl(gpr_order);
         DefineValueImpl(def_inst, location);
         LoadImmediate(use_inst, location);
+        if (live_ranges) {
+            LocInfo(location).is_remat = true;
+            LocInfo(location).remat_value = use_inst.GetImmediateAsU64();
+        }
         return;
     }
 
@@ -519,13 +611,21 @@ void RegAlloc::Move(HostLoc to, HostLoc from) noexcept {
     ASSERT(LocInfo(to).IsEmpty() && !LocInfo(from).IsLocked());
     ASSERT(bit_width <= HostLocBitWidth(to));
     ASSERT_MSG(!LocInfo(from).IsEmpty(), "Mov eliminated");
-    EmitMove(bit_width, to, from);
+    if (LocInfo(from).is_remat && HostLocIsSpill(from)) {
+        LoadImmediate(IR::Value{LocInfo(from).remat_value}, to);
+    } else {
+        EmitMove(bit_width, to, from);
+    }
     LocInfo(to) = std::exchange(LocInfo(from), {});
 }
 
 void RegAlloc::CopyToScratch(size_t bit_width, HostLoc to, HostLoc from) noexcept {
     ASSERT(LocInfo(to).IsEmpty() && !LocInfo(from).IsEmpty());
-    EmitMove(bit_width, to, from);
+    if (LocInfo(from).is_remat && HostLocIsSpill(from)) {
+        LoadImmediate(IR::Value{LocInfo(from).remat_value}, to);
+    } else {
+        EmitMove(bit_width, to, from);
+    }
 }
 
 void RegAlloc::Exchange(HostLoc a, HostLoc b) noexcept {
@@ -555,6 +655,11 @@ void RegAlloc::SpillRegister(HostLoc loc) noexcept {
     ASSERT_MSG(!LocInfo(loc).IsEmpty(), "There is no need to spill unoccupied registers");
     ASSERT_MSG(!LocInfo(loc).IsLocked(), "Registers that have been allocated must not be spilt");
     auto const new_loc = FindFreeSpill(HostLocIsXMM(loc));
+    if (LocInfo(loc).is_remat) {
+        // Rematerialized on reload, so the spill slot is only used for bookkeeping.
+        LocInfo(new_loc) = std::exchange(LocInfo(loc), {});
+        return;
+    }
     Move(new_loc, loc);
 }
 
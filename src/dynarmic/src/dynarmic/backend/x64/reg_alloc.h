@@ -11,12 +11,14 @@
 #include <array>
 #include <functional>
 #include <optional>
+#include <vector>
 
 #include "dynarmic/common/common_types.h"
 #include <xbyak/xbyak.h>
 #include <boost/container/static_vector.hpp>
 #include <boost/container/flat_set.hpp>
 #include <boost/pool/pool_alloc.hpp>
+#include <ankerl/unordered_dense.h>
 
 #include "dynarmic/backend/x64/block_of_code.h"
 #include "dynarmic/backend/x64/hostloc.h"
@@ -29,6 +31,7 @@
 
 namespace Dynarmic::IR {
 enum class AccType;
+class Block;
 }  // namespace Dynarmic::IR
 
 namespace Dynarmic::Backend::X64 {
@@ -96,7 +99,9 @@ private:
     uint8_t max_bit_width = 0; //Valid values: 1,2,4,8,16,32,128
     bool is_scratch : 1 = false; //1
     bool is_set_last_use : 1 = false; //1
+    bool is_remat : 1 = false; //1, values are the constant remat_value
     alignas(16) uint8_t lru_counter = 0; //1
+    u64 remat_value = 0; //8
     friend class RegAlloc;
 };
 static_assert(sizeof(HostLocInfo) == 64);
@@ -141,11 +146,32 @@ private:
     bool allocated = false; //1
 };
 
+/// Use positions of every value in a block, numbered in emission order. Lets the register
+/// allocator make linear-scan decisions instead of purely local ones.
+class LiveRanges final {
+public:
+    void Analyze(const IR::Block& block) noexcept;
+    /// Called by the emitter once it is done with an instruction.
+    inline void Advance() noexcept {
+        position++;
+    }
+    /// Position of the next use of inst at or after the current instruction.
+    size_t NextUse(const IR::Inst* inst) const noexcept;
+private:
+    struct Range {
+        u32 begin = 0;
+        u32 end = 0;
+    };
+    ankerl::unordered_dense::map<const IR::Inst*, Range> ranges;
+    std::vector<u32> use_positions;
+    u32 position = 0;
+};
+
 class RegAlloc final {
 public:
     using ArgumentInfo = std::array<Argument, IR::max_arg_count>;
     RegAlloc() noexcept = default;
-    RegAlloc(BlockOfCode* code, boost::container::static_vector<HostLoc, 28> gpr_order, boost::container::static_vector<HostLoc, 28> xmm_order) noexcept;
+    RegAlloc(BlockOfCode* code, boost::container::static_vector<HostLoc, 28> gpr_order, boost::container::static_vector<HostLoc, 28> xmm_order, const LiveRanges* live_ranges = nullptr) noexcept;
 
     ArgumentInfo GetArgumentInfo(const IR::Inst* inst) noexcept;
     void RegisterPseudoOperation(const IR::Inst* inst) noexcept;
@@ -221,6 +247,7 @@ private:
     friend struct Argument;
 
     HostLoc SelectARegister(const boost::container::static_vector<HostLoc, 28>& desired_locations) const noexcept;
+    HostLoc SelectARegisterByNextUse(const boost::container::static_vector<HostLoc, 28>& desired_locations) const noexcept;
     inline std::optional<HostLoc> ValueLocation(const IR::Inst* value) const noexcept {
         for (size_t i = 0; i < hostloc_info.size(); i++) {
             if (hostloc_info[i].ContainsValue(value)) {
@@ -262,6 +289,7 @@ private:
     alignas(64) boost::container::static_vector<HostLoc, 28> xmm_order;
     alignas(64) std::array<HostLocInfo, NonSpillHostLocCount + SpillCount> hostloc_info;
     BlockOfCode* code = nullptr;
+    const LiveRanges* live_ranges = nullptr;
     size_t reserved_stack_space = 0;
 };
 // Ensure a cache line (or less) is used, this is primordial
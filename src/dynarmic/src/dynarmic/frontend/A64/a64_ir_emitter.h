@@ -281,6 +281,12 @@ public:
         Inst(Opcode::A64SetPC, value);
     }
 
+    /// Leaves the block for `target` if `cond` holds, charging `cycles` for the instructions
+    /// executed so far. Used by trace formation to turn a conditional branch into a side exit.
+    void ExitIf(IR::Cond cond, const LocationDescriptor& target, u64 cycles) noexcept {
+        Inst(Opcode::A64ExitIf, IR::Value{cond}, Imm64(IR::LocationDescriptor{target}.Value()), Imm64(cycles));
+    }
+
 private:
     IR::U64 ImmCurrentLocationDescriptor() noexcept {
         return Imm64(IR::LocationDescriptor{*current_location}.Value());
@@ -33,7 +33,12 @@ IR::Block Translate(LocationDescriptor descriptor, MemoryReadCodeFuncType memory
             should_continue = visitor.RaiseException(Exception::NoExecuteFault);
         }
 
-        visitor.ir.current_location = visitor.ir.current_location->AdvancePC(4);
+        if (visitor.trace_next_pc) {
+            visitor.ir.current_location = visitor.ir.current_location->SetPC(*visitor.trace_next_pc);
+            visitor.trace_next_pc.reset();
+        } else {
+            visitor.ir.current_location = visitor.ir.current_location->AdvancePC(4);
+        }
         block.CycleCount()++;
     } while (should_continue && !single_step);
 
@@ -38,6 +38,13 @@ struct TranslationOptions {
     /// If this is false, we treat the instruction as a NOP.
     /// If this is true, we emit an ExceptionRaised instruction.
     bool hook_hint_instructions = true;
+
+    /// Maximum number of instructions in a trace. If this is non-zero, forward direct branches
+    /// are followed instead of ending the block: unconditional branches are folded in and
+    /// conditional branches become side exits, with the fall-through taken as the likely path.
+    /// Side exits are emitted as A64ExitIf, so only backends implementing it (currently x64) may
+    /// set this.
+    size_t max_trace_length = 0;
 };
 
 /**
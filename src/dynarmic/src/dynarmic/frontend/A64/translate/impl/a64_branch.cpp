@@ -11,6 +11,12 @@ bool TranslatorVisitor::B_cond(Imm<19> imm19, Cond cond) {
     const s64 offset = concatenate(imm19, Imm<2>{0}).SignExtend<s64>();
     const u64 target = ir.PC() + offset;
 
+    // Forward conditional branches are predicted not taken: the taken path becomes a side exit.
+    if (cond != Cond::AL && cond != Cond::NV && target > ir.PC() && CanExtendTrace(ir.PC() + 4)) {
+        ir.ExitIf(cond, ir.current_location->SetPC(target), ir.block.CycleCount() + 1);
+        return true;
+    }
+
     const auto cond_pass = IR::Term::LinkBlock{ir.current_location->SetPC(target)};
     const auto cond_fail = IR::Term::LinkBlock{ir.current_location->AdvancePC(4)};
     ir.SetTerm(IR::Term::If{cond, cond_pass, cond_fail});
@@ -21,6 +27,11 @@ bool TranslatorVisitor::B_uncond(Imm<26> imm26) {
     const s64 offset = concatenate(imm26, Imm<2>{0}).SignExtend<s64>();
     const u64 target = ir.PC() + offset;
 
+    if (CanExtendTrace(target)) {
+        trace_next_pc = target;
+        return true;
+    }
+
     //ir.SetTerm(IR::Term::LinkBlockFast{ir.current_location->SetPC(target)});
     ir.SetTerm(IR::Term::LinkBlock{ir.current_location->SetPC(target)});
     return false;
@@ -33,6 +44,11 @@ bool TranslatorVisitor::BL(Imm<26> imm26) {
     ir.PushRSB(ir.current_location->AdvancePC(4));
 
     const u64 target = ir.PC() + offset;
+    if (CanExtendTrace(target)) {
+        trace_next_pc = target;
+        return true;
+    }
+
     ir.SetTerm(IR::Term::LinkBlock{ir.current_location->SetPC(target)});
     return false;
 }
@@ -41,6 +41,20 @@ bool TranslatorVisitor::RaiseException(Exception exception) {
     return false;
 }
 
+bool TranslatorVisitor::CanExtendTrace(u64 target) const {
+    // Only forward branches within a bounded span are followed. The block's [start, end) range
+    // then still covers every instruction in the trace, which keeps range invalidation correct.
+    constexpr u64 max_trace_span = 0x1000;
+
+    if (options.max_trace_length == 0 || ir.current_location->SingleStepping()) {
+        return false;
+    }
+    const u64 start = A64::LocationDescriptor{ir.block.Location()}.PC();
+    return ir.block.CycleCount() + 1 < options.max_trace_length
+        && target > ir.PC()
+        && target - start <= max_trace_span;
+}
+
 std::optional<TranslatorVisitor::BitMasks> TranslatorVisitor::DecodeBitMasks(bool immN, Imm<6> imms, Imm<6> immr, bool immediate) {
     const int len = mcl::bit::highest_set_bit((immN ? 1 << 6 : 0) | (imms.ZeroExtend() ^ 0b111111));
     if (len < 1) {
@@ -24,6 +24,11 @@ struct TranslatorVisitor final {
     A64::IREmitter ir;
     TranslationOptions options;
 
+    /// Set when the current instruction is a direct branch folded into the trace.
+    std::optional<u64> trace_next_pc;
+
+    bool CanExtendTrace(u64 target) const;
+
     bool InterpretThisInstruction();
     bool UnpredictableInstruction();
     bool DecodeError();
@@ -18,6 +18,16 @@
 namespace Dynarmic {
 namespace A64 {
 
+/// Describes a block of guest code that has been translated by a Jit instance.
+struct CompiledBlock {
+    /// Opaque location descriptor of the block (guest PC combined with relevant FPCR state).
+    std::uint64_t location;
+    /// First guest address covered by the block.
+    std::uint64_t start_address;
+    /// Size in bytes of the guest code covered by the block.
+    std::uint64_t size;
+};
+
 class Jit final {
 public:
     explicit Jit(UserConfig conf);
@@ -48,6 +58,21 @@ public:
      */
     void InvalidateCacheRange(std::uint64_t start_address, std::size_t length);
 
+    /**
+     * Returns the blocks translated since the last call, and forgets them.
+     * Blocks that were invalidated in the meantime and single-stepping blocks are not included.
+     * Always empty unless UserConfig::record_compiled_blocks is set.
+     */
+    std::vector<CompiledBlock> TakeCompiledBlocks();
+
+    /**
+     * Compiles the block at the given location ahead of execution so that it is already
+     * present in the code cache when it is first reached.
+     * @param location Location descriptor as previously returned by TakeCompiledBlocks.
+     * Cannot be called from a callback.
+     */
+    void PrecompileBlock(std::uint64_t location);
+
     /**
      * Reset CPU state to state at startup. Does not clear code cache.
      * Cannot be called from a callback.
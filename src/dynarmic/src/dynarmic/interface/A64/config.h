@@ -166,7 +166,7 @@ struct UserConfig {
     /// - Block linking optimizations
     /// - RSB optimizations
     /// This is intended to be used for debugging.
-    OptimizationFlag optimizations = all_safe_optimizations;
+    OptimizationFlag optimizations = default_optimizations;
 
     /// Declares how many valid address bits are there in virtual addresses.
     /// Determines the size of page_table. Valid values are between 12 and 64 inclusive.
@@ -203,6 +203,14 @@ struct UserConfig {
     // Maximum size is limited by the maximum length of a x86_64 / arm64 jump.
     std::uint32_t code_cache_size = 128 * 1024 * 1024;  // bytes
 
+    /// Enables two-tier compilation when non-zero. Blocks are first compiled with a minimal
+    /// set of IR passes and count their own executions; a block that runs this many times is
+    /// recompiled with the full optimization pipeline. When zero, every block is compiled
+    /// with the full pipeline straight away. Hot blocks are also extended into traces along
+    /// forward branches, with conditional branches turned into side exits.
+    /// This is currently only implemented by the x64 backend.
+    std::uint32_t hot_block_threshold = 0;
+
     /// Determines if we should detect memory accesses via page_table that straddle are
     /// misaligned. Accesses that straddle page boundaries will fallback to the relevant
     /// memory callback.
@@ -234,6 +242,11 @@ struct UserConfig {
     /// instruction is executed.
     bool hook_hint_instructions = false;
 
+    /// When set to true, the location and guest code range of every compiled block are
+    /// recorded until they are retrieved with Jit::TakeCompiledBlocks, or until the block
+    /// is invalidated.
+    bool record_compiled_blocks = false;
+
     /// Determines what happens if the guest accesses an entry that is off the end of the
     /// page table. If true, Dynarmic will silently mirror page_table's address space. If
     /// false, accessing memory outside of page_table bounds will result in a call to the
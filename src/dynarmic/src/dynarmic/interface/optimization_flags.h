@@ -34,6 +34,11 @@ enum class OptimizationFlag : std::uint32_t {
     MiscIROpt = 0x00000020,
     /// Optimize for code speed rather than for code size (this serves well for tight loops)
     CodeSpeed = 0x00000040,
+    /// This makes the x64 register allocator look ahead over the live ranges of values in a block.
+    /// When registers run out, the value whose next use is furthest away is split off into a spill
+    /// slot, and values known to be constants are rematerialized instead of stored and reloaded.
+    /// This is a safe but experimental optimization, it is not part of default_optimizations.
+    LiveRangeRegAlloc = 0x00000080,
 
     /// This is an UNSAFE optimization that reduces accuracy of fused multiply-add operations.
     /// This unfuses fused instructions to improve performance on host CPUs without FMA support.
@@ -80,4 +85,7 @@ constexpr bool operator!(OptimizationFlag f) {
     return f == no_optimizations;
 }
 
+/// Optimizations enabled by default, experimental ones have to be opted into explicitly.
+constexpr OptimizationFlag default_optimizations = all_safe_optimizations & ~OptimizationFlag::LiveRangeRegAlloc;
+
 }  // namespace Dynarmic
@@ -190,6 +190,7 @@ constexpr bool ReadsFromCPSR(const Opcode op) noexcept {
     case Opcode::A32UpdateUpperLocationDescriptor:
     case Opcode::A64GetCFlag:
     case Opcode::A64GetNZCVRaw:
+    case Opcode::A64ExitIf:
     case Opcode::ConditionalSelect32:
     case Opcode::ConditionalSelect64:
     case Opcode::ConditionalSelectNZCV:
@@ -595,6 +596,7 @@ constexpr bool MayHaveSideEffects(const Opcode op) noexcept {
         || op == Opcode::CallHostFunction
         || op == Opcode::A64DataCacheOperationRaised
         || op == Opcode::A64InstructionCacheOperationRaised
+        || op == Opcode::A64ExitIf
         || IsSetCheckBitOperation(op)
         || IsBarrier(op)
         || CausesCPUException(op)
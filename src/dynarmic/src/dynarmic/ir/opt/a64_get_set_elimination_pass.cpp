@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <algorithm>
 #include <array>
 
 #include "dynarmic/common/common_types.h"
@@ -147,6 +148,16 @@ void A64GetSetElimination(IR::Block& block) {
             do_set(nzcv_info, inst->GetArg(0), inst, TrackingType::NZCVRaw);
             break;
         }
+        case IR::Opcode::A64ExitIf: {
+            // A side exit observes the guest state, so pending sets must be kept. Known values
+            // are still valid on the fall-through path and can continue to be forwarded.
+            const auto keep_set = [](RegisterInfo& info) { info.set_instruction_present = false; };
+            std::for_each(reg_info.begin(), reg_info.end(), keep_set);
+            std::for_each(vec_info.begin(), vec_info.end(), keep_set);
+            keep_set(sp_info);
+            nzcv_info = {};
+            break;
+        }
         default: {
             if (ReadsFromCPSR(opcode) || WritesToCPSR(opcode)) {
                 nzcv_info = {};
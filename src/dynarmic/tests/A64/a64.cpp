@@ -3,12 +3,20 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <algorithm>
+
 #include <catch2/catch_test_macros.hpp>
 #include <oaknut/oaknut.hpp>
 
 #include "./testenv.h"
+#include "dynarmic/common/fp/fpcr.h"
 #include "dynarmic/common/fp/fpsr.h"
+#include "dynarmic/frontend/A64/a64_location_descriptor.h"
+#include "dynarmic/frontend/A64/translate/a64_translate.h"
 #include "dynarmic/interface/exclusive_monitor.h"
+#include "dynarmic/ir/basic_block.h"
+#include "dynarmic/ir/microinstruction.h"
+#include "dynarmic/ir/opcodes.h"
 
 using namespace Dynarmic;
 using namespace oaknut::util;
@@ -2385,3 +2393,121 @@ TEST_CASE("A64: CLZ{W}", "[a64]") {
     REQUIRE(jit.GetRegister(1) == 4);
     REQUIRE(jit.GetRegister(2) == 5);
 }
+
+TEST_CASE("A64: Tiered compilation", "[a64]") {
+    // Counts the translations of the loop body by its reads of the first instruction
+    class CountingEnv final : public A64TestEnv {
+    public:
+        std::optional<std::uint32_t> MemoryReadCode(u64 vaddr) override {
+            if (vaddr == 4) {
+                ++loop_reads;
+            }
+            return A64TestEnv::MemoryReadCode(vaddr);
+        }
+        size_t loop_reads = 0;
+    };
+
+    const auto run = [](u32 hot_block_threshold) {
+        CountingEnv env;
+        A64::UserConfig conf{};
+        conf.callbacks = &env;
+        conf.hot_block_threshold = hot_block_threshold;
+        A64::Jit jit{conf};
+        env.code_mem.emplace_back(0xd2800000); // mov x0, #0
+        env.code_mem.emplace_back(0x91000400); // add x0, x0, #1
+        env.code_mem.emplace_back(0xf101901f); // cmp x0, #100
+        env.code_mem.emplace_back(0x54ffffc1); // b.ne #-8
+        env.code_mem.emplace_back(0x14000000); // b .
+        jit.SetPC(0); // at _start
+        env.ticks_left = 1000;
+        CheckedRun([&]() { jit.Run(); });
+        REQUIRE(jit.GetRegister(0) == 100);
+        REQUIRE(jit.GetPC() == 16);
+        return env.loop_reads;
+    };
+
+    // The loop runs past the threshold, so its block is translated a second time once hot
+    const size_t single_tier_reads = run(0);
+    const size_t two_tier_reads = run(10);
+    REQUIRE(two_tier_reads > single_tier_reads);
+}
+
+TEST_CASE("A64: Invalidated blocks are compiled cold again", "[a64]") {
+    A64TestEnv env;
+    A64::UserConfig conf{};
+    conf.callbacks = &env;
+    conf.hot_block_threshold = 10;
+    A64::Jit jit{conf};
+    env.code_mem.emplace_back(0xd2800000); // mov x0, #0
+    env.code_mem.emplace_back(0x91000400); // add x0, x0, #1
+    env.code_mem.emplace_back(0xf101901f); // cmp x0, #100
+    env.code_mem.emplace_back(0x54ffffc1); // b.ne #-8
+    env.code_mem.emplace_back(0x14000000); // b .
+
+    const auto run = [&] {
+        jit.SetPC(0); // at _start
+        env.ticks_left = 1000;
+        CheckedRun([&]() { jit.Run(); });
+        REQUIRE(jit.GetRegister(0) == 100);
+        REQUIRE(jit.GetPC() == 16);
+    };
+
+    // The loop is promoted on every run, its counters are reused after each invalidation
+    for (int i = 0; i < 3; ++i) {
+        run();
+        jit.InvalidateCacheRange(4, 4);
+    }
+
+    // Hot code compiled before the change must not survive the invalidation
+    env.code_mem[1] = 0x91000800; // add x0, x0, #2
+    jit.InvalidateCacheRange(4, 4);
+    run();
+}
+
+TEST_CASE("A64: Trace formation with side exits", "[a64]") {
+    A64TestEnv env;
+    A64::UserConfig conf{};
+    conf.callbacks = &env;
+    conf.hot_block_threshold = 10;
+    A64::Jit jit{conf};
+    env.code_mem.emplace_back(0xd2800000); // mov x0, #0
+    env.code_mem.emplace_back(0x91000400); // add x0, x0, #1
+    env.code_mem.emplace_back(0xf101901f); // cmp x0, #100
+    env.code_mem.emplace_back(0x540000a0); // b.eq #+20
+    env.code_mem.emplace_back(0x14000002); // b #+8
+    env.code_mem.emplace_back(0x14000000); // b .
+    env.code_mem.emplace_back(0x91000821); // add x1, x1, #2
+    env.code_mem.emplace_back(0x17fffffa); // b #-24
+    env.code_mem.emplace_back(0x14000000); // b .
+    jit.SetPC(0); // at _start
+    env.ticks_left = 2000;
+    CheckedRun([&]() { jit.Run(); });
+    REQUIRE(jit.GetRegister(0) == 100);
+    REQUIRE(jit.GetRegister(1) == 198);
+    REQUIRE(jit.GetPC() == 32);
+}
+
+TEST_CASE("A64: Side exits are only emitted for traces", "[a64]") {
+    A64TestEnv env;
+    env.code_mem.emplace_back(0xf101901f); // cmp x0, #100
+    env.code_mem.emplace_back(0x540000a0); // b.eq #+20
+    env.code_mem.emplace_back(0x91000400); // add x0, x0, #1
+    env.code_mem.emplace_back(0x14000000); // b .
+    env.code_mem.emplace_back(0x14000000); // b .
+    env.code_mem.emplace_back(0x14000000); // b .
+    env.code_mem.emplace_back(0x14000000); // b .
+
+    const auto get_code = [&env](u64 vaddr) { return env.MemoryReadCode(vaddr); };
+    const auto has_side_exit = [&](size_t max_trace_length) {
+        A64::TranslationOptions options{};
+        options.max_trace_length = max_trace_length;
+        const IR::Block block = A64::Translate({0, FP::FPCR{}}, get_code, options);
+        return std::any_of(block.begin(), block.end(), [](const IR::Inst& inst) {
+            return inst.GetOpcode() == IR::Opcode::A64ExitIf;
+        });
+    };
+
+    // Backends without A64ExitIf leave max_trace_length at its default
+    REQUIRE(!has_side_exit(A64::TranslationOptions{}.max_trace_length));
+    REQUIRE(has_side_exit(32));
+}
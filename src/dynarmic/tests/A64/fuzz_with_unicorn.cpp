@@ -524,3 +524,34 @@ TEST_CASE("A64: Large random block", "[a64][unicorn]") {
         RunTestInstance(jit, uni, jit_env, uni_env, regs, vecs, start_address, instructions, pstate, fpcr);
     }
 }
+
+TEST_CASE("A64: Large random block (live range register allocation)", "[a64][unicorn]") {
+    A64TestEnv jit_env{};
+    A64TestEnv uni_env{};
+
+    auto jit_user_config = GetUserConfig(jit_env);
+    jit_user_config.optimizations |= OptimizationFlag::LiveRangeRegAlloc;
+    Dynarmic::A64::Jit jit{jit_user_config};
+    A64Unicorn uni{uni_env};
+
+    A64Unicorn::RegisterArray regs;
+    A64Unicorn::VectorArray vecs;
+
+    constexpr size_t instruction_count = 100;
+    std::vector<u32> instructions(instruction_count);
+
+    for (size_t iteration = 0; iteration < 500; ++iteration) {
+        std::generate(regs.begin(), regs.end(), [] { return RandInt<u64>(0, ~u64(0)); });
+        std::generate(vecs.begin(), vecs.end(), RandomVector);
+
+        for (size_t j = 0; j < instruction_count; ++j) {
+            instructions[j] = GenRandomInst(j * 4, j == instruction_count - 1);
+        }
+
+        const u64 start_address = RandInt<u64>(0, 0x10'0000'0000) * 4;
+        const u32 pstate = RandInt<u32>(0, 0xF) << 28;
+        const u32 fpcr = RandomFpcr();
+
+        RunTestInstance(jit, uni, jit_env, uni_env, regs, vecs, start_address, instructions, pstate, fpcr);
+    }
+}
@@ -0,0 +1,392 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/detached_tasks.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/framebuffer_layout.h"
+#include "core/frontend/graphics_context.h"
+#include "core/hle/kernel/board/nintendo/nx/k_system_control.h"
+#include "core/memory.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/host1x/host1x.h"
+#include "video_core/memory_manager.h"
+
+#include <SDL.h>
+#include <SDL_syswm.h>
+
+namespace {
+
+using namespace VideoCommon::Capture;
+
+class DummyContext : public Core::Frontend::GraphicsContext {};
+
+/// Window without input, only creates a surface when the renderer needs to present to one
+class ReplayWindow final : public Core::Frontend::EmuWindow {
+public:
+    explicit ReplayWindow(bool create_surface) {
+        UpdateCurrentFramebufferLayout(Layout::ScreenUndocked::Width,
+                                       Layout::ScreenUndocked::Height);
+        if (!create_surface) {
+            return;
+        }
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+            LOG_CRITICAL(Frontend, "Failed to initialize SDL2: {}", SDL_GetError());
+            std::exit(EXIT_FAILURE);
+        }
+        render_window =
+            SDL_CreateWindow("Eden GPU replay", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                             Layout::ScreenUndocked::Width, Layout::ScreenUndocked::Height, 0);
+        SDL_SysWMinfo wm;
+        SDL_VERSION(&wm.version);
+        if (render_window == nullptr || SDL_GetWindowWMInfo(render_window, &wm) == SDL_FALSE) {
+            LOG_CRITICAL(Frontend, "Failed to create the replay window: {}", SDL_GetError());
+            std::exit(EXIT_FAILURE);
+        }
+        switch (wm.subsystem) {
+#ifdef SDL_VIDEO_DRIVER_WINDOWS
+        case SDL_SYSWM_TYPE::SDL_SYSWM_WINDOWS:
+            window_info.type = Core::Frontend::WindowSystemType::Windows;
+            window_info.render_surface = reinterpret_cast<void*>(wm.info.win.window);
+            break;
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11
+        case SDL_SYSWM_TYPE::SDL_SYSWM_X11:
+            window_info.type = Core::Frontend::WindowSystemType::X11;
+            window_info.display_connection = wm.info.x11.display;
+            window_info.render_surface = reinterpret_cast<void*>(wm.info.x11.window);
+            break;
+#endif
+#ifdef SDL_VIDEO_DRIVER_WAYLAND
+        case SDL_SYSWM_TYPE::SDL_SYSWM_WAYLAND:
+            window_info.type = Core::Frontend::WindowSystemType::Wayland;
+            window_info.display_connection = wm.info.wl.display;
+            window_info.render_surface = wm.info.wl.surface;
+            break;
+#endif
+#ifdef SDL_VIDEO_DRIVER_COCOA
+        case SDL_SYSWM_TYPE::SDL_SYSWM_COCOA:
+            window_info.type = Core::Frontend::WindowSystemType::Cocoa;
+            window_info.render_surface = SDL_Metal_CreateView(render_window);
+            break;
+#endif
+        default:
+            LOG_CRITICAL(Frontend, "Window manager subsystem {} not implemented",
+                         static_cast<int>(wm.subsystem));
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    ~ReplayWindow() override {
+        if (render_window != nullptr) {
+            SDL_DestroyWindow(render_window);
+            SDL_Quit();
+        }
+    }
+
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<DummyContext>();
+    }
+
+    bool IsShown() const override {
+        return true;
+    }
+
+    void OnFrameDisplayed() override {
+        if (render_window != nullptr) {
+            SDL_PumpEvents();
+        }
+    }
+
+private:
+    SDL_Window* render_window{};
+};
+
+/// Feeds the records of a capture to the GPU
+class Replayer {
+public:
+    explicit Replayer(Core::System& system_, bool benchmark_)
+        : system{system_}, gpu{system.GPU()}, device_memory{gpu.Host1x().MemoryManager()},
+          backing_end{Kernel::Board::Nintendo::Nx::KSystemControl::Init::GetIntendedMemorySize()},
+          benchmark{benchmark_} {}
+
+    bool Run(Reader& reader) {
+        if (benchmark) {
+            // Read the whole capture ahead of time so disk reads are not timed
+            std::vector<Record> records;
+            while (auto record = reader.Next()) {
+                records.push_back(std::move(*record));
+            }
+            return ReplayAll(records);
+        }
+        last_frame = std::chrono::steady_clock::now();
+        while (auto record = reader.Next()) {
+            std::visit([this](auto& value) { Replay(value); }, *record);
+            if (failed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void PrintStatistics() const {
+        if (frame_times.empty()) {
+            std::printf("No frames were presented\n");
+            return;
+        }
+        std::vector<double> sorted = frame_times;
+        std::ranges::sort(sorted);
+        double total = 0.0;
+        for (const double frame_time : sorted) {
+            total += frame_time;
+        }
+        const size_t p99 = (std::min)(sorted.size() - 1, sorted.size() * 99 / 100);
+        std::printf("frames: %zu\n", sorted.size());
+        std::printf("average: %.3f ms (%.1f fps)\n", total / sorted.size(),
+                    1000.0 * sorted.size() / total);
+        std::printf("min: %.3f ms, max: %.3f ms, p99: %.3f ms\n", sorted.front(), sorted.back(),
+                    sorted[p99]);
+    }
+
+    void PrintBenchmark() const {
+        const double seconds = std::chrono::duration<double>(submit_time).count();
+        std::printf("submissions: %zu, command words: %llu\n", num_submissions,
+                    static_cast<unsigned long long>(num_command_words));
+        if (seconds > 0.0) {
+            std::printf("command processing: %.3f ms, %.2f Mwords/s\n", seconds * 1000.0,
+                        static_cast<double>(num_command_words) / seconds / 1'000'000.0);
+        }
+    }
+
+private:
+    bool ReplayAll(std::vector<Record>& records) {
+        last_frame = std::chrono::steady_clock::now();
+        for (auto& record : records) {
+            std::visit([this](auto& value) { Replay(value); }, record);
+            if (failed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Replay(AddressSpaceRecord& record) {
+        auto memory_manager = std::make_shared<Tegra::MemoryManager>(
+            system, record.address_space_bits, record.split_address, record.big_page_bits,
+            record.page_bits);
+        gpu.InitAddressSpace(*memory_manager);
+        address_spaces.insert_or_assign(record.id, std::move(memory_manager));
+    }
+
+    void Replay(ChannelRecord& record) {
+        auto channel = gpu.AllocateChannel();
+        if (const auto it = address_spaces.find(record.address_space);
+            it != address_spaces.end()) {
+            channel->memory_manager = it->second;
+        }
+        gpu.InitChannel(*channel, record.program_id);
+        channels.insert_or_assign(record.channel, std::move(channel));
+    }
+
+    void Replay(MapRecord& record) {
+        const auto it = address_spaces.find(record.address_space);
+        if (it == address_spaces.end()) {
+            return;
+        }
+        BackDeviceMemory(record.device_addr, record.size);
+        it->second->Map(record.gpu_addr, record.device_addr, record.size, record.kind,
+                        record.is_big_pages);
+    }
+
+    void Replay(UnmapRecord& record) {
+        const auto it = address_spaces.find(record.address_space);
+        if (it == address_spaces.end()) {
+            return;
+        }
+        it->second->Unmap(record.gpu_addr, record.size);
+    }
+
+    void Replay(MemoryRecord& record) {
+        BackDeviceMemory(record.device_addr, record.data.size());
+        device_memory.WriteBlock(record.device_addr, record.data.data(), record.data.size());
+    }
+
+    void Replay(SubmitListRecord& record) {
+        const auto it = channels.find(record.channel);
+        if (it == channels.end()) {
+            LOG_ERROR(HW_GPU, "Submission to unknown channel {}", record.channel);
+            return;
+        }
+        if (!benchmark) {
+            gpu.PushGPUEntries(it->second->bind_id, std::move(record.entries));
+            return;
+        }
+        num_command_words += record.entries.prefetch_command_list.size();
+        for (const auto& header : record.entries.command_lists) {
+            num_command_words += header.size;
+        }
+        ++num_submissions;
+        // Submissions block until they are processed on synchronous GPU
+        const auto start = std::chrono::steady_clock::now();
+        gpu.PushGPUEntries(it->second->bind_id, std::move(record.entries));
+        submit_time += std::chrono::steady_clock::now() - start;
+    }
+
+    void Replay(FlushRegionRecord& record) {
+        gpu.FlushRegion(record.addr, record.size);
+    }
+
+    void Replay(InvalidateRegionRecord& record) {
+        gpu.InvalidateRegion(record.addr, record.size);
+    }
+
+    void Replay(CompositeRecord& record) {
+        gpu.RequestComposite(std::move(record.layers), {});
+        const auto now = std::chrono::steady_clock::now();
+        frame_times.push_back(
+            std::chrono::duration<double, std::milli>(now - last_frame).count());
+        last_frame = now;
+    }
+
+    /// Backs device pages that were mapped to guest memory in the capture with host memory
+    void BackDeviceMemory(DAddr addr, u64 size) {
+        const DAddr end = addr + size;
+        for (DAddr page = Common::AlignDown(addr, Core::Memory::YUZU_PAGESIZE); page < end;
+             page += Core::Memory::YUZU_PAGESIZE) {
+            if (device_memory.GetPointer<u8>(page) != nullptr) {
+                continue;
+            }
+            // Allocate from the top of DRAM, the kernel only takes memory from the bottom
+            if (backing_end - backing_used < Core::Memory::YUZU_PAGESIZE * 2) {
+                LOG_CRITICAL(HW_GPU, "Out of device memory to back the capture");
+                failed = true;
+                return;
+            }
+            backing_used += Core::Memory::YUZU_PAGESIZE;
+            device_memory.MapDeviceMemory(page, backing_end - backing_used,
+                                          Core::Memory::YUZU_PAGESIZE);
+        }
+    }
+
+    Core::System& system;
+    Tegra::GPU& gpu;
+    Tegra::MaxwellDeviceMemoryManager& device_memory;
+
+    std::map<u64, std::shared_ptr<Tegra::MemoryManager>> address_spaces;
+    std::map<s32, std::shared_ptr<Tegra::Control::ChannelState>> channels;
+
+    const u64 backing_end;
+    u64 backing_used{};
+    bool failed{};
+
+    const bool benchmark;
+    size_t num_submissions{};
+    u64 num_command_words{};
+    std::chrono::steady_clock::duration submit_time{};
+
+    std::chrono::steady_clock::time_point last_frame;
+    std::vector<double> frame_times;
+};
+
+void PrintHelp(const char* argv0) {
+    std::printf("Usage: %s [options] <capture>\n"
+                "-r, --renderer   Renderer to replay with: null (default) or vulkan\n"
+                "-b, --benchmark  Time command processing with a synchronous GPU\n"
+                "-h, --help       Display this help and exit\n",
+                argv0);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+    Common::DetachedTasks detached_tasks;
+
+    std::filesystem::path capture_path;
+    Settings::RendererBackend renderer = Settings::RendererBackend::Null;
+    bool benchmark = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            PrintHelp(argv[0]);
+            return 0;
+        }
+        if (arg == "-b" || arg == "--benchmark") {
+            benchmark = true;
+            continue;
+        }
+        if (arg == "-r" || arg == "--renderer") {
+            if (++i == argc) {
+                PrintHelp(argv[0]);
+                return -1;
+            }
+            const std::string name = argv[i];
+            if (name == "null") {
+                renderer = Settings::RendererBackend::Null;
+            } else if (name == "vulkan") {
+                renderer = Settings::RendererBackend::Vulkan;
+            } else {
+                LOG_CRITICAL(Frontend, "Unsupported renderer {}", name);
+                return -1;
+            }
+            continue;
+        }
+        capture_path = arg;
+    }
+    if (capture_path.empty()) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    Reader reader;
+    if (!reader.Open(capture_path)) {
+        LOG_CRITICAL(Frontend, "Failed to open capture {}", capture_path.string());
+        return -1;
+    }
+
+    // Replays run on the GPU thread so the submissions are timed the same way as in game, benchmarks
+    // wait for every submission to be processed instead
+    Settings::values.renderer_backend.SetValue(renderer);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(!benchmark);
+    Settings::values.use_disk_shader_cache.SetValue(false);
+
+    Core::System system{};
+    system.Initialize();
+
+    ReplayWindow window{renderer != Settings::RendererBackend::Null};
+    if (system.SetupForGPUReplay(window) != Core::SystemResultStatus::Success) {
+        LOG_CRITICAL(Frontend, "Failed to initialize VideoCore!");
+        return -1;
+    }
+    system.GPU().Start();
+
+    Replayer replayer{system, benchmark};
+    const bool success = replayer.Run(reader);
+    replayer.PrintStatistics();
+    if (benchmark) {
+        replayer.PrintBenchmark();
+    }
+
+    system.ShutdownMainProcess();
+    detached_tasks.WaitForAllTasks();
+    return success ? 0 : -1;
+}
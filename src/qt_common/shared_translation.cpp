@@ -112,6 +112,12 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QObject* parent)
            tr("Set a custom value of CPU ticks. Higher values can increase performance, but may "
               "also cause the game to freeze. A range of 77–21000 is recommended."));
     INSERT(Settings, cpu_backend, tr("Backend:"), QString());
+    INSERT(Settings,
+           use_disk_jit_cache,
+           tr("Use disk translation cache"),
+           tr("Remembers which guest code was translated in previous sessions and translates it "
+              "while the game boots.\n"
+              "Reduces stuttering early in a session at the cost of a longer boot."));
 
     // Cpu Debug
 
@@ -247,6 +253,12 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QObject* parent)
            vram_usage_mode,
            tr("VRAM Usage Mode:"),
            tr("Selects whether the emulator should prefer to conserve memory or make maximum usage of available video memory for performance.\nAggressive mode may severely impact the performance of other applications such as recording software."));
+    INSERT(Settings,
+           vram_budget,
+           tr("VRAM Budget (MiB):"),
+           tr("Maximum amount of video memory the texture cache may use before it evicts textures "
+              "regardless of how expensive they are to load back.\nSet to 0 to derive it from the "
+              "memory available on the GPU."));
     INSERT(Settings,
            skip_cpu_inner_invalidation,
            tr("Skip CPU Inner Invalidation"),
@@ -312,6 +324,12 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QObject* parent)
            tr("Enables GPU vendor-specific pipeline cache.\nThis option can improve shader loading "
               "time significantly in cases where the Vulkan driver does not store pipeline cache "
               "files internally."));
+    INSERT(Settings,
+           use_streaming_pipeline_precompile,
+           tr("Precompile cached pipelines in the background"),
+           tr("Starts the game without waiting for the pipeline cache to be built.\nCached "
+              "pipelines are compiled in the order they were first used, and a pipeline the game "
+              "needs is moved to the front of the queue.\nOnly available on Vulkan."));
     INSERT(
         Settings,
         enable_compute_pipelines,
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "shader_recompiler/arena.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/maxwell/control_flow.h"
+#include "shader_recompiler/frontend/maxwell/translate_program.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/program_header.h"
+#include "shader_recompiler/stage.h"
+#include "video_core/shader_environment.h"
+
+namespace {
+
+using VideoCommon::FileEnvironment;
+
+/// Same pools the renderers translate with, released after every shader
+struct ShaderPools {
+    void ReleaseContents() {
+        flow_block.ReleaseContents();
+        block.ReleaseContents();
+        inst.ReleaseContents();
+        arena.ReleaseContents();
+    }
+
+    Shader::Arena arena;
+    Shader::ObjectPool<Shader::IR::Inst> inst{8192};
+    Shader::ObjectPool<Shader::IR::Block> block{32};
+    Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+};
+
+/// Reads every shader of the pipeline cache files in a path
+void LoadCorpus(const std::filesystem::path& path, std::vector<FileEnvironment>& corpus) {
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == ".bin") {
+                LoadCorpus(entry.path(), corpus);
+            }
+        }
+        return;
+    }
+    // Opening a file with the wrong version deletes it, so check the version beforehand
+    const std::optional<u32> version{VideoCommon::ReadPipelineCacheVersion(path)};
+    if (!version) {
+        return;
+    }
+    VideoCommon::PipelineCacheReader reader(path, *version);
+    if (!reader.IsOpen()) {
+        return;
+    }
+    for (const VideoCommon::PipelineCacheEntry& entry : reader.Entries()) {
+        for (FileEnvironment& env : reader.ReadEnvironments(entry)) {
+            corpus.push_back(std::move(env));
+        }
+    }
+    LOG_INFO(Frontend, "Loaded {} pipelines from {}", reader.Entries().size(), path.string());
+}
+
+/// Runs the frontend on a shader, returns false when it fails to translate
+bool Translate(ShaderPools& pools, FileEnvironment& env, const Shader::HostTranslateInfo& host_info) {
+    const bool is_compute{env.ShaderStage() == Shader::Stage::Compute};
+    const u32 cfg_offset{static_cast<u32>(env.StartAddress() +
+                                          (is_compute ? 0 : sizeof(Shader::ProgramHeader)))};
+    try {
+        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset,
+                                       env.ShaderStage() == Shader::Stage::VertexA);
+        [[maybe_unused]] const Shader::IR::Program program{Shader::Maxwell::TranslateProgram(
+            pools.inst, pools.block, pools.arena, env, cfg, host_info)};
+    } catch (const Shader::Exception& exception) {
+        LOG_ERROR(Frontend, "{}", exception.what());
+        return false;
+    }
+    return true;
+}
+
+void PrintHelp(const char* argv0) {
+    std::printf("Usage: %s [options] <pipeline cache files or directories>\n"
+                "-n, --iterations  Times each shader is translated, the fastest is kept (default 5)\n"
+                "-h, --help        Display this help and exit\n",
+                argv0);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    size_t iterations = 5;
+    std::vector<std::filesystem::path> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            PrintHelp(argv[0]);
+            return 0;
+        }
+        if (arg == "-n" || arg == "--iterations") {
+            if (++i == argc) {
+                PrintHelp(argv[0]);
+                return -1;
+            }
+            iterations = (std::max)(std::strtoull(argv[i], nullptr, 10), 1ULL);
+            continue;
+        }
+        paths.emplace_back(arg);
+    }
+    if (paths.empty()) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    std::vector<FileEnvironment> corpus;
+    for (const auto& path : paths) {
+        LoadCorpus(path, corpus);
+    }
+    if (corpus.empty()) {
+        LOG_CRITICAL(Frontend, "No shaders were found");
+        return -1;
+    }
+
+    const Shader::HostTranslateInfo host_info{};
+    ShaderPools pools;
+    std::vector<double> best_times(corpus.size(), std::numeric_limits<double>::max());
+    size_t num_failures = 0;
+    for (size_t iteration = 0; iteration < iterations; ++iteration) {
+        for (size_t index = 0; index < corpus.size(); ++index) {
+            const auto start = std::chrono::steady_clock::now();
+            const bool success = Translate(pools, corpus[index], host_info);
+            pools.ReleaseContents();
+            const auto end = std::chrono::steady_clock::now();
+            if (!success) {
+                num_failures += iteration == 0 ? 1 : 0;
+                continue;
+            }
+            best_times[index] = (std::min)(
+                best_times[index], std::chrono::duration<double, std::micro>(end - start).count());
+        }
+    }
+
+    std::vector<double> times;
+    for (const double time : best_times) {
+        if (time != std::numeric_limits<double>::max()) {
+            times.push_back(time);
+        }
+    }
+    std::printf("shaders: %zu, failed: %zu\n", corpus.size(), num_failures);
+    if (times.empty()) {
+        return -1;
+    }
+    std::ranges::sort(times);
+    double total = 0.0;
+    for (const double time : times) {
+        total += time;
+    }
+    const auto percentile = [&](size_t p) { return times[(times.size() - 1) * p / 100]; };
+    std::printf("total: %.3f ms, average: %.1f us, %.0f shaders/s\n", total / 1000.0,
+                total / times.size(), times.size() * 1'000'000.0 / total);
+    std::printf("p50: %.1f us, p90: %.1f us, p99: %.1f us, max: %.1f us\n", percentile(50),
+                percentile(90), percentile(99), times.back());
+    return 0;
+}
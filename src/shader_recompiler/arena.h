@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Shader {
+
+/// Monotonic allocator backing the containers of the IR of a compilation.
+/// Deallocations are ignored, memory is reclaimed all at once when the contents are released.
+class Arena {
+public:
+    explicit Arena(size_t chunk_size_ = 64 * 1024) : chunk_size{chunk_size_} {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    [[nodiscard]] void* Allocate(size_t size, size_t alignment) {
+        size_t offset{(used + alignment - 1) & ~(alignment - 1)};
+        if (chunks.empty() || offset + size > chunks.back().size) {
+            AddChunk(size);
+            offset = 0;
+        }
+        used = offset + size;
+        total_used += size;
+        return chunks.back().storage.get() + offset;
+    }
+
+    /// Releases all allocations, keeping enough memory to fit the same amount without growing
+    void ReleaseContents() {
+        if (chunks.size() > 1) {
+            const size_t total_size{std::max(total_used, chunk_size)};
+            chunks.clear();
+            chunks.push_back(Chunk{
+                .storage = std::unique_ptr<std::byte[]>(new std::byte[total_size]),
+                .size = total_size,
+            });
+        }
+        used = 0;
+        total_used = 0;
+    }
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> storage;
+        size_t size;
+    };
+
+    void AddChunk(size_t min_size) {
+        const size_t size{std::max(min_size, chunk_size)};
+        // new[] returns memory aligned for any fundamental type, the offsets are aligned from it
+        chunks.push_back(Chunk{
+            .storage = std::unique_ptr<std::byte[]>(new std::byte[size]),
+            .size = size,
+        });
+        used = 0;
+    }
+
+    std::vector<Chunk> chunks;
+    size_t used{};
+    size_t total_used{};
+    size_t chunk_size{};
+};
+
+/// Standard allocator handing out memory from an arena
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena_) noexcept : arena{&arena_} {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena{other.arena} {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena == other.arena;
+    }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+} // namespace Shader
@@ -11,7 +11,9 @@
 
 namespace Shader::IR {
 
-Block::Block(ObjectPool<Inst>& inst_pool_) : inst_pool{&inst_pool_} {}
+Block::Block(ObjectPool<Inst>& inst_pool_, Arena& arena_)
+    : inst_pool{&inst_pool_}, arena{&arena_}, imm_predecessors(ArenaAllocator<Block*>{arena_}),
+      imm_successors(ArenaAllocator<Block*>{arena_}) {}
 
 Block::~Block() = default;
 
@@ -20,13 +22,13 @@ void Block::AppendNewInst(Opcode op, std::initializer_list<Value> args) {
 }
 
 Block::iterator Block::PrependNewInst(iterator insertion_point, const Inst& base_inst) {
-    Inst* const inst{inst_pool->Create(base_inst)};
+    Inst* const inst{inst_pool->Create(base_inst, *arena)};
     return instructions.insert(insertion_point, *inst);
 }
 
 Block::iterator Block::PrependNewInst(iterator insertion_point, Opcode op,
                                       std::initializer_list<Value> args, u32 flags) {
-    Inst* const inst{inst_pool->Create(op, flags)};
+    Inst* const inst{inst_pool->Create(op, flags, *arena)};
     const auto result_it{instructions.insert(insertion_point, *inst)};
 
     if (inst->NumArgs() != args.size()) {
@@ -12,6 +12,7 @@
 
 #include "common/bit_cast.h"
 #include "common/common_types.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/frontend/ir/condition.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/object_pool.h"
@@ -27,7 +28,7 @@ public:
     using reverse_iterator = InstructionList::reverse_iterator;
     using const_reverse_iterator = InstructionList::const_reverse_iterator;
 
-    explicit Block(ObjectPool<Inst>& inst_pool_);
+    explicit Block(ObjectPool<Inst>& inst_pool_, Arena& arena_);
     ~Block();
 
     Block(const Block&) = delete;
@@ -168,14 +169,16 @@ public:
 private:
     /// Memory pool for instruction list
     ObjectPool<Inst>* inst_pool;
+    /// Memory arena for the containers of the block and its instructions
+    Arena* arena;
 
     /// List of instructions in this block
     InstructionList instructions;
 
     /// Block immediate predecessors
-    std::vector<Block*> imm_predecessors;
+    std::vector<Block*, ArenaAllocator<Block*>> imm_predecessors;
     /// Block immediate successors
-    std::vector<Block*> imm_successors;
+    std::vector<Block*, ArenaAllocator<Block*>> imm_successors;
 
     /// Intrusively store the value of a register in the block.
     std::array<Value, NUM_REGS> ssa_reg_values;
@@ -31,22 +31,25 @@ void RemovePseudoInstruction(IR::Inst*& inst, IR::Opcode expected_opcode) {
     inst = nullptr;
 }
 
-void AllocAssociatedInsts(std::unique_ptr<AssociatedInsts>& associated_insts) {
+void AllocAssociatedInsts(AssociatedInsts*& associated_insts, Arena& arena) {
     if (!associated_insts) {
-        associated_insts = std::make_unique<AssociatedInsts>();
+        associated_insts = std::construct_at(
+            static_cast<AssociatedInsts*>(arena.Allocate(sizeof(AssociatedInsts),
+                                                         alignof(AssociatedInsts))));
     }
 }
 } // Anonymous namespace
 
-Inst::Inst(IR::Opcode op_, u32 flags_) noexcept : op{op_}, flags{flags_} {
+Inst::Inst(IR::Opcode op_, u32 flags_, Arena& arena_) noexcept
+    : op{op_}, flags{flags_}, arena{&arena_} {
     if (op == Opcode::Phi) {
-        std::construct_at(&phi_args);
+        std::construct_at(&phi_args, PhiArgs::allocator_type(ArenaAllocator<PhiArg>{*arena}));
     } else {
         std::construct_at(&args);
     }
 }
 
-Inst::Inst(const Inst& base) : op{base.op}, flags{base.flags} {
+Inst::Inst(const Inst& base, Arena& arena_) : op{base.op}, flags{base.flags}, arena{&arena_} {
     if (base.op == Opcode::Phi) {
         throw NotImplementedException("Copying phi node");
     }
@@ -330,7 +333,7 @@ void Inst::OrderPhiArgs() {
         throw LogicError("{} is not a Phi instruction", op);
     }
     std::sort(phi_args.begin(), phi_args.end(),
-              [](const std::pair<Block*, Value>& a, const std::pair<Block*, Value>& b) {
+              [](const PhiArg& a, const PhiArg& b) {
                   return a.first->GetOrder() < b.first->GetOrder();
               });
 }
@@ -386,30 +389,30 @@ void Inst::Use(const Value& value) {
     Inst* const inst{value.Inst()};
     ++inst->use_count;
 
-    std::unique_ptr<AssociatedInsts>& assoc_inst{inst->associated_insts};
+    AssociatedInsts*& assoc_inst{inst->associated_insts};
     switch (op) {
     case Opcode::GetZeroFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         SetPseudoInstruction(assoc_inst->zero_inst, this);
         break;
     case Opcode::GetSignFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         SetPseudoInstruction(assoc_inst->sign_inst, this);
         break;
     case Opcode::GetCarryFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         SetPseudoInstruction(assoc_inst->carry_inst, this);
         break;
     case Opcode::GetOverflowFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         SetPseudoInstruction(assoc_inst->overflow_inst, this);
         break;
     case Opcode::GetSparseFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         SetPseudoInstruction(assoc_inst->sparse_inst, this);
         break;
     case Opcode::GetInBoundsFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         SetPseudoInstruction(assoc_inst->in_bounds_inst, this);
         break;
     default:
@@ -421,30 +424,30 @@ void Inst::UndoUse(const Value& value) {
     Inst* const inst{value.Inst()};
     --inst->use_count;
 
-    std::unique_ptr<AssociatedInsts>& assoc_inst{inst->associated_insts};
+    AssociatedInsts*& assoc_inst{inst->associated_insts};
     switch (op) {
     case Opcode::GetZeroFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         RemovePseudoInstruction(assoc_inst->zero_inst, Opcode::GetZeroFromOp);
         break;
     case Opcode::GetSignFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         RemovePseudoInstruction(assoc_inst->sign_inst, Opcode::GetSignFromOp);
         break;
     case Opcode::GetCarryFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         RemovePseudoInstruction(assoc_inst->carry_inst, Opcode::GetCarryFromOp);
         break;
     case Opcode::GetOverflowFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         RemovePseudoInstruction(assoc_inst->overflow_inst, Opcode::GetOverflowFromOp);
         break;
     case Opcode::GetSparseFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         RemovePseudoInstruction(assoc_inst->sparse_inst, Opcode::GetSparseFromOp);
         break;
     case Opcode::GetInBoundsFromOp:
-        AllocAssociatedInsts(assoc_inst);
+        AllocAssociatedInsts(assoc_inst, *inst->arena);
         RemovePseudoInstruction(assoc_inst->in_bounds_inst, Opcode::GetInBoundsFromOp);
         break;
     default:
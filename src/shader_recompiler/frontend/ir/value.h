@@ -16,6 +16,7 @@
 #include "common/assert.h"
 #include "common/bit_cast.h"
 #include "common/common_types.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/frontend/ir/attribute.h"
 #include "shader_recompiler/frontend/ir/opcodes.h"
@@ -112,11 +113,12 @@ public:
 
 class Inst : public boost::intrusive::list_base_hook<> {
 public:
-    explicit Inst(IR::Opcode op_, u32 flags_) noexcept;
-    explicit Inst(const Inst& base);
+    explicit Inst(IR::Opcode op_, u32 flags_, Arena& arena_) noexcept;
+    explicit Inst(const Inst& base, Arena& arena_);
     ~Inst();
 
     Inst& operator=(const Inst&) = delete;
+    Inst(const Inst&) = delete;
 
     Inst& operator=(Inst&&) = delete;
     Inst(Inst&&) = delete;
@@ -239,12 +241,17 @@ private:
     int use_count{};
     u32 flags{};
     u32 definition{};
+    using PhiArg = std::pair<Block*, Value>;
+    using PhiArgs = boost::container::small_vector<PhiArg, 2, ArenaAllocator<PhiArg>>;
+
     union {
         NonTriviallyDummy dummy{};
-        boost::container::small_vector<std::pair<Block*, Value>, 2> phi_args;
+        PhiArgs phi_args;
         std::array<Value, 5> args;
     };
-    std::unique_ptr<AssociatedInsts> associated_insts;
+    AssociatedInsts* associated_insts{};
+    /// Backs the phi arguments and associated instructions
+    Arena* arena;
 };
 static_assert(sizeof(Inst) <= 128, "Inst size unintentionally increased");
 
@@ -650,10 +650,11 @@ private:
 class TranslatePass {
 public:
     TranslatePass(ObjectPool<IR::Inst>& inst_pool_, ObjectPool<IR::Block>& block_pool_,
-                  ObjectPool<Statement>& stmt_pool_, Environment& env_, Statement& root_stmt,
-                  IR::AbstractSyntaxList& syntax_list_, const HostTranslateInfo& host_info)
-        : stmt_pool{stmt_pool_}, inst_pool{inst_pool_}, block_pool{block_pool_}, env{env_},
-          syntax_list{syntax_list_} {
+                  Arena& arena_, ObjectPool<Statement>& stmt_pool_, Environment& env_,
+                  Statement& root_stmt, IR::AbstractSyntaxList& syntax_list_,
+                  const HostTranslateInfo& host_info)
+        : stmt_pool{stmt_pool_}, inst_pool{inst_pool_}, block_pool{block_pool_}, arena{arena_},
+          env{env_}, syntax_list{syntax_list_} {
         Visit(root_stmt, nullptr, nullptr);
 
         IR::Block& first_block{*syntax_list.front().data.block};
@@ -671,7 +672,7 @@ private:
             if (current_block) {
                 return;
             }
-            current_block = block_pool.Create(inst_pool);
+            current_block = block_pool.Create(inst_pool, arena);
             auto& node{syntax_list.emplace_back()};
             node.type = IR::AbstractSyntaxNode::Type::Block;
             node.data.block = current_block;
@@ -737,7 +738,7 @@ private:
                 break;
             }
             case StatementType::Loop: {
-                IR::Block* const loop_header_block{block_pool.Create(inst_pool)};
+                IR::Block* const loop_header_block{block_pool.Create(inst_pool, arena)};
                 if (current_block) {
                     current_block->AddBranch(loop_header_block);
                 }
@@ -745,7 +746,7 @@ private:
                 header_node.type = IR::AbstractSyntaxNode::Type::Block;
                 header_node.data.block = loop_header_block;
 
-                IR::Block* const continue_block{block_pool.Create(inst_pool)};
+                IR::Block* const continue_block{block_pool.Create(inst_pool, arena)};
                 IR::Block* const merge_block{MergeBlock(parent, stmt)};
 
                 const size_t loop_node_index{syntax_list.size()};
@@ -811,7 +812,7 @@ private:
             }
             case StatementType::Return: {
                 ensure_block();
-                IR::Block* return_block{block_pool.Create(inst_pool)};
+                IR::Block* return_block{block_pool.Create(inst_pool, arena)};
                 IR::IREmitter{*return_block}.Epilogue();
                 current_block->AddBranch(return_block);
 
@@ -862,7 +863,7 @@ private:
             merge_stmt = stmt_pool.Create(&dummy_flow_block, &parent);
             parent.children.insert(std::next(Tree::s_iterator_to(stmt)), *merge_stmt);
         }
-        return block_pool.Create(inst_pool);
+        return block_pool.Create(inst_pool, arena);
     }
 
     void DemoteCombinationPass() {
@@ -973,6 +974,7 @@ private:
     ObjectPool<Statement>& stmt_pool;
     ObjectPool<IR::Inst>& inst_pool;
     ObjectPool<IR::Block>& block_pool;
+    Arena& arena;
     Environment& env;
     IR::AbstractSyntaxList& syntax_list;
     bool uses_demote_to_helper{};
@@ -981,13 +983,13 @@ private:
 } // Anonymous namespace
 
 IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
-                                Environment& env, Flow::CFG& cfg,
+                                Arena& arena, Environment& env, Flow::CFG& cfg,
                                 const HostTranslateInfo& host_info) {
     ObjectPool<Statement> stmt_pool{64};
     GotoPass goto_pass{cfg, stmt_pool};
     Statement& root{goto_pass.RootStatement()};
     IR::AbstractSyntaxList syntax_list;
-    TranslatePass{inst_pool, block_pool, stmt_pool, env, root, syntax_list, host_info};
+    TranslatePass{inst_pool, block_pool, arena, stmt_pool, env, root, syntax_list, host_info};
     return syntax_list;
 }
 
@@ -17,8 +17,9 @@ struct HostTranslateInfo;
 namespace Shader::Maxwell {
 
 [[nodiscard]] IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool,
-                                           ObjectPool<IR::Block>& block_pool, Environment& env,
-                                           Flow::CFG& cfg, const HostTranslateInfo& host_info);
+                                           ObjectPool<IR::Block>& block_pool, Arena& arena,
+                                           Environment& env, Flow::CFG& cfg,
+                                           const HostTranslateInfo& host_info);
 
 [[nodiscard]] IR::Program MergeDualVertexPrograms(IR::Program& vertex_a, IR::Program& vertex_b,
                                                   Environment& env_vertex_b);
@@ -30,6 +31,7 @@ void ConvertLegacyToGeneric(IR::Program& program, const RuntimeInfo& runtime_inf
 // passthrough geometry shader that reads the generic and sets the layer.
 [[nodiscard]] IR::Program GenerateGeometryPassthrough(ObjectPool<IR::Inst>& inst_pool,
                                                       ObjectPool<IR::Block>& block_pool,
+                                                      Arena& arena,
                                                       const HostTranslateInfo& host_info,
                                                       IR::Program& source_program,
                                                       Shader::OutputTopology output_topology);
@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/hex_util.h"
+#include "core/crypto/aes_native.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+namespace {
+
+using Core::Crypto::AESCipher;
+using Core::Crypto::Key128;
+using Core::Crypto::Key256;
+using Core::Crypto::Mode;
+using Core::Crypto::Op;
+
+std::vector<u8> RandomBytes(size_t size, u32 seed) {
+    std::mt19937 rng{seed};
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+    return bytes;
+}
+
+std::array<u8, 16> AddToCounter(std::array<u8, 16> counter, u64 amount) {
+    for (size_t i = counter.size(); i-- > 0 && amount != 0;) {
+        amount += counter[i];
+        counter[i] = static_cast<u8>(amount);
+        amount >>= 8;
+    }
+    return counter;
+}
+
+/// Runs a transcode over a buffer until a fixed amount was processed, returns GB/s
+template <typename Func>
+double MeasureThroughput(size_t buffer_size, Func&& func) {
+    constexpr size_t TOTAL_SIZE = size_t{1} << 30;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t processed = 0; processed < TOTAL_SIZE; processed += buffer_size) {
+        func();
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(TOTAL_SIZE) / 1e9 / time.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AES[CtrVector]", "[core]") {
+    // NIST SP 800-38A, F.5.1
+    const auto key = Common::HexStringToArray<16>("2b7e151628aed2a6abf7158809cf4f3c");
+    const auto counter = Common::HexStringToArray<16>("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    const auto plaintext = Common::HexStringToArray<64>(
+        "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+        "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+    const auto ciphertext = Common::HexStringToArray<64>(
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    std::array<u8, 64> result{};
+    cipher.SetIV(counter);
+    cipher.Transcode(plaintext.data(), plaintext.size(), result.data(), Op::Encrypt);
+    REQUIRE(result == ciphertext);
+
+    // The counter continues after a transcode, as it does with mbedtls
+    cipher.SetIV(counter);
+    cipher.Transcode(ciphertext.data(), 20, result.data(), Op::Decrypt);
+    cipher.Transcode(ciphertext.data() + 32, 32, result.data() + 32, Op::Decrypt);
+    REQUIRE(std::memcmp(result.data(), plaintext.data(), 20) == 0);
+    REQUIRE(std::memcmp(result.data() + 32, plaintext.data() + 32, 32) == 0);
+}
+
+TEST_CASE("AES[XtsVector]", "[core]") {
+    // IEEE 1619-2007, vector 2
+    const auto key = Common::HexStringToArray<32>(
+        "1111111111111111111111111111111122222222222222222222222222222222");
+    const auto tweak = Common::HexStringToArray<16>("33333333330000000000000000000000");
+    const auto ciphertext = Common::HexStringToArray<32>(
+        "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0");
+    std::array<u8, 32> plaintext;
+    plaintext.fill(0x44);
+
+    AESCipher<Key256> cipher(key, Mode::XTS);
+    std::array<u8, 32> result{};
+    cipher.SetIV(tweak);
+    cipher.Transcode(plaintext.data(), plaintext.size(), result.data(), Op::Encrypt);
+    REQUIRE(result == ciphertext);
+
+    cipher.XTSTranscode(ciphertext.data(), ciphertext.size(), result.data(), tweak,
+                        ciphertext.size(), Op::Decrypt);
+    REQUIRE(result == plaintext);
+}
+
+TEST_CASE("AES[NativeCtrBatches]", "[core]") {
+    if (!Core::Crypto::IsNativeAesSupported()) {
+        return;
+    }
+    const auto key = Core::Crypto::ExpandNativeAesKey(
+        Common::HexStringToArray<16>("000102030405060708090a0b0c0d0e0f"));
+    // Crosses a carry between the two halves of the counter
+    const auto counter = Common::HexStringToArray<16>("0123456789abcdeffffffffffffffffb");
+    const std::vector<u8> input = RandomBytes(0x1000 + 7, 1);
+
+    std::vector<u8> batched(input.size());
+    Core::Crypto::NativeAesCtr(key, counter, input.data(), batched.data(), input.size());
+
+    std::vector<u8> single(input.size());
+    for (size_t offset = 0; offset < input.size(); offset += 16) {
+        const size_t size = std::min<size_t>(16, input.size() - offset);
+        Core::Crypto::NativeAesCtr(key, AddToCounter(counter, offset / 16), input.data() + offset,
+                                   single.data() + offset, size);
+    }
+    REQUIRE(batched == single);
+
+    std::vector<u8> decrypted(input.size());
+    Core::Crypto::NativeAesCtr(key, counter, batched.data(), decrypted.data(), batched.size());
+    REQUIRE(decrypted == input);
+}
+
+TEST_CASE("AES[NativeXtsBatches]", "[core]") {
+    if (!Core::Crypto::IsNativeAesSupported()) {
+        return;
+    }
+    const auto data_key = Core::Crypto::ExpandNativeAesKey(
+        Common::HexStringToArray<16>("27182818284590452353602874713526"));
+    const auto tweak_key = Core::Crypto::ExpandNativeAesKey(
+        Common::HexStringToArray<16>("31415926535897932384626433832795"));
+    const auto tweak = Common::HexStringToArray<16>("00000000000000000000000000fffffe");
+    constexpr size_t UNIT_SIZE = 0x200;
+    // Eleven whole units and a shorter one, more units than are encrypted at once
+    const std::vector<u8> input = RandomBytes(UNIT_SIZE * 11 + 0x60, 2);
+
+    std::vector<u8> batched(input.size());
+    Core::Crypto::NativeAesXts(data_key, tweak_key, tweak, UNIT_SIZE, input.data(), batched.data(),
+                               input.size(), Op::Encrypt);
+
+    std::vector<u8> single(input.size());
+    for (size_t offset = 0; offset < input.size(); offset += UNIT_SIZE) {
+        const size_t size = std::min(UNIT_SIZE, input.size() - offset);
+        Core::Crypto::NativeAesXts(data_key, tweak_key, AddToCounter(tweak, offset / UNIT_SIZE),
+                                   size, input.data() + offset, single.data() + offset, size,
+                                   Op::Encrypt);
+    }
+    REQUIRE(batched == single);
+
+    std::vector<u8> decrypted(input.size());
+    Core::Crypto::NativeAesXts(data_key, tweak_key, tweak, UNIT_SIZE, batched.data(),
+                               decrypted.data(), batched.size(), Op::Decrypt);
+    REQUIRE(decrypted == input);
+}
+
+TEST_CASE("AES[Throughput]", "[core][.benchmark]") {
+    constexpr size_t BUFFER_SIZE = 0x40000;
+    std::vector<u8> buffer = RandomBytes(BUFFER_SIZE, 3);
+
+    const auto ctr_key = Common::HexStringToArray<16>("000102030405060708090a0b0c0d0e0f");
+    AESCipher<Key128> ctr_cipher(ctr_key, Mode::CTR);
+    const std::array<u8, 16> iv{};
+    const double ctr_speed = MeasureThroughput(BUFFER_SIZE, [&] {
+        ctr_cipher.SetIV(iv);
+        ctr_cipher.Transcode(buffer.data(), buffer.size(), buffer.data(), Op::Decrypt);
+    });
+
+    const auto xts_key = Common::HexStringToArray<32>(
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    AESCipher<Key256> xts_cipher(xts_key, Mode::XTS);
+    const double xts_speed = MeasureThroughput(BUFFER_SIZE, [&] {
+        xts_cipher.XTSTranscode(buffer.data(), buffer.size(), buffer.data(), 0, 0x200,
+                                Op::Decrypt);
+    });
+    const double xts_per_sector_speed = MeasureThroughput(BUFFER_SIZE, [&] {
+        for (size_t offset = 0; offset < BUFFER_SIZE; offset += 0x200) {
+            xts_cipher.SetIV(AddToCounter(iv, offset / 0x200));
+            xts_cipher.Transcode(buffer.data() + offset, 0x200, buffer.data() + offset,
+                                 Op::Decrypt);
+        }
+    });
+
+    printf("AES (%s): CTR %.2f GB/s, XTS %.2f GB/s batched, %.2f GB/s per sector\n",
+           Core::Crypto::IsNativeAesSupported() ? "native" : "mbedtls", ctr_speed, xts_speed,
+           xts_per_sector_speed);
+}
@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "common/lz4_compression.h"
+#include "core/file_sys/fssystem/fssystem_bucket_tree.h"
+#include "core/file_sys/fssystem/fssystem_compressed_storage.h"
+#include "core/file_sys/fssystem/fssystem_compression_configuration.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+namespace {
+
+using namespace Common::Literals;
+using FileSys::CompressedStorage;
+
+constexpr size_t BLOCK_SIZE = 64_KiB;
+constexpr size_t NUM_BLOCKS = 256;
+constexpr size_t IMAGE_SIZE = BLOCK_SIZE * NUM_BLOCKS;
+constexpr size_t CACHE_SIZE = 4_MiB;
+
+/// LZ4 compressed storage in the layout used by NCA sections, built in memory
+struct CompressedImage {
+    std::vector<u8> contents;
+    FileSys::VirtualFile data;
+    FileSys::VirtualFile node;
+    FileSys::VirtualFile entry;
+    s32 entry_count{};
+};
+
+/// Tokens picked at random from a small set, compressible like typical game assets
+std::vector<u8> MakeContents() {
+    std::mt19937 rng{1234};
+    std::array<u64, 64> tokens;
+    for (u64& token : tokens) {
+        token = (static_cast<u64>(rng()) << 32) | rng();
+    }
+    std::vector<u8> contents(IMAGE_SIZE);
+    for (size_t offset = 0; offset < IMAGE_SIZE; offset += sizeof(u64)) {
+        std::memcpy(contents.data() + offset, &tokens[rng() % tokens.size()], sizeof(u64));
+    }
+    return contents;
+}
+
+CompressedImage MakeImage() {
+    CompressedImage image{.contents = MakeContents()};
+
+    std::vector<u8> data;
+    std::vector<CompressedStorage::Entry> entries;
+    for (size_t block = 0; block < NUM_BLOCKS; ++block) {
+        const u8* const source = image.contents.data() + block * BLOCK_SIZE;
+        const std::vector<u8> compressed = Common::Compression::CompressDataLZ4(source, BLOCK_SIZE);
+        REQUIRE(compressed.size() < BLOCK_SIZE);
+
+        data.resize(Common::AlignUp(data.size(), FileSys::CompressionBlockAlignment));
+        entries.push_back({
+            .virt_offset = static_cast<s64>(block * BLOCK_SIZE),
+            .phys_offset = static_cast<s64>(data.size()),
+            .compression_type = FileSys::CompressionType::Lz4,
+            .phys_size = static_cast<s32>(compressed.size()),
+        });
+        data.insert(data.end(), compressed.begin(), compressed.end());
+    }
+    image.entry_count = static_cast<s32>(entries.size());
+
+    // A single entry set holds every entry, so the L1 node only has its offset
+    const FileSys::BucketTree::NodeHeader header{
+        .index = 0,
+        .count = 1,
+        .offset = static_cast<s64>(IMAGE_SIZE),
+    };
+    REQUIRE(sizeof(header) + entries.size() * sizeof(CompressedStorage::Entry) <=
+            CompressedStorage::NodeSize);
+
+    std::vector<u8> node(CompressedStorage::QueryNodeStorageSize(image.entry_count));
+    const s64 entry_set_offset = 0;
+    std::memcpy(node.data(), &header, sizeof(header));
+    std::memcpy(node.data() + sizeof(header), &entry_set_offset, sizeof(entry_set_offset));
+
+    std::vector<u8> entry(CompressedStorage::QueryEntryStorageSize(image.entry_count));
+    const FileSys::BucketTree::NodeHeader entry_set_header{
+        .index = 0,
+        .count = image.entry_count,
+        .offset = static_cast<s64>(IMAGE_SIZE),
+    };
+    std::memcpy(entry.data(), &entry_set_header, sizeof(entry_set_header));
+    std::memcpy(entry.data() + sizeof(entry_set_header), entries.data(),
+                entries.size() * sizeof(CompressedStorage::Entry));
+
+    image.data = std::make_shared<FileSys::VectorVfsFile>(std::move(data));
+    image.node = std::make_shared<FileSys::VectorVfsFile>(std::move(node));
+    image.entry = std::make_shared<FileSys::VectorVfsFile>(std::move(entry));
+    return image;
+}
+
+std::shared_ptr<CompressedStorage> OpenStorage(const CompressedImage& image, size_t cache_size) {
+    auto storage = std::make_shared<CompressedStorage>();
+    const Result result = storage->Initialize(
+        image.data, image.node, image.entry, image.entry_count, BLOCK_SIZE, 640_KiB,
+        FileSys::GetNcaCompressionConfiguration().get_decompressor, cache_size, 256_KiB, 64);
+    REQUIRE(R_SUCCEEDED(result));
+    return storage;
+}
+
+/// Reads the whole storage with requests of the given size, returns MiB/s
+double Stream(const CompressedStorage& storage, size_t request_size) {
+    std::vector<u8> buffer(request_size);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < IMAGE_SIZE; offset += request_size) {
+        storage.Read(buffer.data(), request_size, offset);
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(IMAGE_SIZE) / 1_MiB / time.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CompressedStorage[ReadMatches]", "[core]") {
+    const CompressedImage image = MakeImage();
+    const auto cached = OpenStorage(image, CACHE_SIZE);
+    const auto uncached = OpenStorage(image, 0);
+
+    std::mt19937 rng{5678};
+    std::vector<u8> buffer;
+    for (size_t i = 0; i < 4000; ++i) {
+        const size_t size = 1 + rng() % (i % 2 == 0 ? 4_KiB : 3 * BLOCK_SIZE);
+        const size_t offset = rng() % (IMAGE_SIZE - size);
+        for (const auto& storage : {cached, uncached}) {
+            buffer.assign(size, 0);
+            REQUIRE(storage->Read(buffer.data(), size, offset) == size);
+            REQUIRE(std::memcmp(buffer.data(), image.contents.data() + offset, size) == 0);
+        }
+    }
+    REQUIRE(cached->GetCacheStatistics().hits > 0);
+    REQUIRE(uncached->GetCacheStatistics().hits + uncached->GetCacheStatistics().misses == 0);
+}
+
+TEST_CASE("CompressedStorage[SequentialReadsHit]", "[core]") {
+    const CompressedImage image = MakeImage();
+    const auto storage = OpenStorage(image, CACHE_SIZE);
+
+    constexpr size_t REQUEST_SIZE = 4_KiB;
+    std::vector<u8> buffer(REQUEST_SIZE);
+    for (size_t offset = 0; offset < IMAGE_SIZE; offset += REQUEST_SIZE) {
+        REQUIRE(storage->Read(buffer.data(), REQUEST_SIZE, offset) == REQUEST_SIZE);
+        REQUIRE(std::memcmp(buffer.data(), image.contents.data() + offset, REQUEST_SIZE) == 0);
+    }
+
+    // Each block is decompressed once, the other reads within it are served from the cache
+    const auto statistics = storage->GetCacheStatistics();
+    REQUIRE(statistics.misses == NUM_BLOCKS);
+    REQUIRE(statistics.hits == NUM_BLOCKS * (BLOCK_SIZE / REQUEST_SIZE - 1));
+    REQUIRE(statistics.evictions > 0);
+    REQUIRE(statistics.cached_size <= CACHE_SIZE);
+}
+
+TEST_CASE("CompressedStorage[StreamThroughput]", "[core][.benchmark]") {
+    const CompressedImage image = MakeImage();
+    for (const size_t request_size : {4_KiB, 16_KiB, 256_KiB, 1_MiB}) {
+        const auto uncached = OpenStorage(image, 0);
+        const auto cached = OpenStorage(image, CACHE_SIZE);
+        const double uncached_speed = Stream(*uncached, request_size);
+        const double cached_speed = Stream(*cached, request_size);
+        const auto statistics = cached->GetCacheStatistics();
+        printf("Compressed storage, %4zu KiB reads: %8.1f MiB/s uncached, %8.1f MiB/s cached, "
+               "%llu hits, %llu misses\n",
+               request_size / 1_KiB, uncached_speed, cached_speed,
+               static_cast<unsigned long long>(statistics.hits),
+               static_cast<unsigned long long>(statistics.misses));
+    }
+}
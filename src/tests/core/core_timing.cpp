@@ -3,16 +3,23 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
 #include <optional>
+#include <random>
 #include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/heap/fibonacci_heap.hpp>
 
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/timing_wheel.h"
 
 namespace {
 // Numbers are chosen randomly to make sure the correct one is given.
@@ -50,6 +57,128 @@ u64 TestTimerSpeed(Core::Timing::CoreTiming& core_timing) {
     return end - start;
 }
 
+std::optional<std::chrono::nanoseconds> EmptyCallback(s64, std::chrono::nanoseconds) {
+    return std::nullopt;
+}
+
+/// Adapts the timing wheel to the looping event benchmark
+struct WheelQueue {
+    void Schedule(s64 time, u64 fifo_order, const std::shared_ptr<Core::Timing::EventType>& type,
+                  s64 reschedule_time) {
+        wheel.Schedule(time, fifo_order, type, reschedule_time);
+    }
+
+    bool RunDue(s64 now, u64& fifo_order) {
+        Core::Timing::TimingEvent* const event = wheel.PopDue(now);
+        if (!event) {
+            return false;
+        }
+        wheel.Reschedule(*event, event->time + event->reschedule_time, fifo_order++);
+        return true;
+    }
+
+    void Unschedule(const std::shared_ptr<Core::Timing::EventType>& type) {
+        wheel.Unschedule(type.get());
+    }
+
+    Core::Timing::TimingWheel wheel;
+};
+
+/// The fibonacci heap CoreTiming used before the timing wheel, kept to compare against
+struct HeapQueue {
+    struct Event;
+    using Heap = boost::heap::fibonacci_heap<Event, boost::heap::compare<std::greater<>>>;
+
+    struct Event {
+        s64 time;
+        u64 fifo_order;
+        const Core::Timing::EventType* type;
+        s64 reschedule_time;
+        Heap::handle_type handle{};
+
+        friend bool operator>(const Event& left, const Event& right) {
+            return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
+        }
+    };
+
+    void Schedule(s64 time, u64 fifo_order, const std::shared_ptr<Core::Timing::EventType>& type,
+                  s64 reschedule_time) {
+        auto h{heap.emplace(Event{time, fifo_order, type.get(), reschedule_time})};
+        (*h).handle = h;
+    }
+
+    bool RunDue(s64 now, u64& fifo_order) {
+        if (heap.empty() || heap.top().time > now) {
+            return false;
+        }
+        const Event& event = heap.top();
+        heap.update(event.handle, Event{event.time + event.reschedule_time, fifo_order++,
+                                        event.type, event.reschedule_time, event.handle});
+        return true;
+    }
+
+    void Unschedule(const std::shared_ptr<Core::Timing::EventType>& type) {
+        std::vector<Heap::handle_type> to_remove;
+        for (auto itr = heap.begin(); itr != heap.end(); itr++) {
+            if (itr->type == type.get()) {
+                to_remove.push_back(itr->handle);
+            }
+        }
+        for (auto& h : to_remove) {
+            heap.erase(h);
+        }
+    }
+
+    Heap heap;
+};
+
+struct LoopingEventResult {
+    double callbacks_per_second;
+    double reschedules_per_second;
+};
+
+/// Runs thousands of looping events with periods between 16us and 16ms on a simulated clock, then
+/// unschedules and schedules them again at random.
+template <typename Queue>
+LoopingEventResult RunLoopingEvents(
+    const std::vector<std::shared_ptr<Core::Timing::EventType>>& events) {
+    constexpr size_t NUM_CALLBACKS = 1'000'000;
+    constexpr size_t NUM_RESCHEDULES = 20'000;
+    constexpr s64 CLOCK_STEP = 10'000;
+
+    Queue queue;
+    u64 fifo_order = 0;
+    const auto period = [](size_t index) { return static_cast<s64>(16'000 << (index % 11)); };
+    for (size_t i = 0; i < events.size(); ++i) {
+        queue.Schedule(period(i), fifo_order++, events[i], period(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    s64 now = 0;
+    size_t callbacks = 0;
+    while (callbacks < NUM_CALLBACKS) {
+        now += CLOCK_STEP;
+        while (queue.RunDue(now, fifo_order)) {
+            ++callbacks;
+        }
+    }
+    const std::chrono::duration<double> run_time = std::chrono::steady_clock::now() - start;
+
+    std::mt19937 rng{1234};
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NUM_RESCHEDULES; ++i) {
+        const size_t index = rng() % events.size();
+        queue.Unschedule(events[index]);
+        queue.Schedule(now + period(index), fifo_order++, events[index], period(index));
+    }
+    const std::chrono::duration<double> reschedule_time = std::chrono::steady_clock::now() - start;
+
+    return {
+        .callbacks_per_second = static_cast<double>(callbacks) / run_time.count(),
+        .reschedules_per_second = static_cast<double>(NUM_RESCHEDULES) / reschedule_time.count(),
+    };
+}
+
 } // Anonymous namespace
 
 TEST_CASE("CoreTiming[BasicOrder]", "[core]") {
@@ -139,3 +268,60 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[TimingWheelOrder]", "[core]") {
+    constexpr size_t NUM_EVENTS = 20000;
+    std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+    for (size_t i = 0; i < 64; ++i) {
+        events.push_back(Core::Timing::CreateEvent("event", EmptyCallback));
+    }
+
+    // Times from nanoseconds up to days away, so every level and the overflow list are used
+    std::mt19937_64 rng{5678};
+    Core::Timing::TimingWheel wheel;
+    for (u64 fifo_order = 0; fifo_order < NUM_EVENTS; ++fifo_order) {
+        const s64 time = static_cast<s64>(rng() >> (17 + rng() % 47));
+        wheel.Schedule(time, fifo_order, events[rng() % events.size()], 0);
+    }
+    // Unscheduled events must never come out
+    std::vector<std::shared_ptr<Core::Timing::EventType>> unscheduled;
+    for (size_t i = 0; i < events.size(); i += 4) {
+        wheel.Unschedule(events[i].get());
+        unscheduled.push_back(events[i]);
+    }
+
+    s64 now = 0;
+    std::tuple<s64, u64> last{-1, 0};
+    size_t popped = 0;
+    while (!wheel.Empty()) {
+        const std::optional<s64> next_time = wheel.NextTime(now);
+        REQUIRE(next_time.has_value());
+        now = (std::max)(now, *next_time);
+        while (Core::Timing::TimingEvent* const event = wheel.PopDue(now)) {
+            const std::tuple<s64, u64> current{event->time, event->fifo_order};
+            REQUIRE(last < current);
+            REQUIRE(std::ranges::find(unscheduled, event->type.lock()) == unscheduled.end());
+            last = current;
+            ++popped;
+            wheel.Release(*event);
+        }
+    }
+    REQUIRE(popped > NUM_EVENTS / 2);
+    REQUIRE(popped < NUM_EVENTS);
+}
+
+TEST_CASE("CoreTiming[LoopingEventThroughput]", "[core][.benchmark]") {
+    constexpr size_t NUM_EVENTS = 4096;
+    std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+    for (size_t i = 0; i < NUM_EVENTS; ++i) {
+        events.push_back(Core::Timing::CreateEvent("looping", EmptyCallback));
+    }
+
+    const LoopingEventResult heap = RunLoopingEvents<HeapQueue>(events);
+    const LoopingEventResult wheel = RunLoopingEvents<WheelQueue>(events);
+
+    printf("Looping events, fibonacci heap: %.0f callbacks/s, %.0f reschedules/s\n",
+           heap.callbacks_per_second, heap.reschedules_per_second);
+    printf("Looping events, timing wheel:   %.0f callbacks/s, %.0f reschedules/s\n",
+           wheel.callbacks_per_second, wheel.reschedules_per_second);
+}
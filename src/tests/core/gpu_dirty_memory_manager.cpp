@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/gpu_dirty_memory_manager.h"
+
+namespace {
+
+constexpr size_t CHUNK_BITS = 6;
+constexpr size_t NUM_PRODUCERS = 4;
+
+/// 64 byte chunks reported by Gather
+class Coverage {
+public:
+    explicit Coverage(size_t size) : chunks(size >> CHUNK_BITS) {}
+
+    void Mark(PAddr address, size_t size) {
+        for (size_t chunk = address >> CHUNK_BITS; chunk < (address + size) >> CHUNK_BITS;
+             ++chunk) {
+            chunks[chunk] = true;
+        }
+    }
+
+    bool Covers(PAddr address, size_t size) const {
+        const size_t end = (address + size + (1ULL << CHUNK_BITS) - 1) >> CHUNK_BITS;
+        for (size_t chunk = address >> CHUNK_BITS; chunk < end; ++chunk) {
+            if (!chunks[chunk]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<bool> chunks;
+};
+
+std::vector<std::pair<PAddr, size_t>> Gather(Core::GPUDirtyMemoryManager& manager) {
+    std::vector<std::pair<PAddr, size_t>> ranges;
+    std::function<void(PAddr, size_t)> callback = [&](PAddr address, size_t size) {
+        ranges.emplace_back(address, size);
+    };
+    manager.Gather(callback);
+    return ranges;
+}
+
+struct ConcurrentGatherResult {
+    double marks_per_second;
+    size_t num_ranges;
+};
+
+/// Collects writes on every producer while a GPU thread drains them, checks none was lost
+ConcurrentGatherResult RunConcurrentGather(size_t writes_per_producer) {
+    constexpr size_t memory_size = 256ULL << 20;
+    std::vector<std::unique_ptr<Core::GPUDirtyMemoryManager>> managers;
+    std::vector<std::vector<std::pair<PAddr, size_t>>> writes(NUM_PRODUCERS);
+    for (size_t core = 0; core < NUM_PRODUCERS; ++core) {
+        managers.push_back(std::make_unique<Core::GPUDirtyMemoryManager>());
+        // Mostly streamed vertex data with scattered writes in between
+        std::mt19937_64 rng{core};
+        PAddr stream = core * (memory_size / NUM_PRODUCERS);
+        for (size_t i = 0; i < writes_per_producer; ++i) {
+            if (rng() % 8 != 0) {
+                writes[core].emplace_back(stream, 0x20);
+                stream = (stream + 0x20) % memory_size;
+            } else {
+                // Collect expects writes split at page boundaries like HandleRasterizerWrite does
+                const PAddr address = rng() % memory_size;
+                const size_t size = 1 + rng() % 0x100;
+                writes[core].emplace_back(address, (std::min)(size, 0x800 - (address & 0x7ff)));
+            }
+        }
+    }
+
+    // Emulates the GPU thread draining the managers at every submission
+    Coverage coverage(memory_size);
+    size_t num_ranges = 0;
+    std::function<void(PAddr, size_t)> callback = [&](PAddr address, size_t size) {
+        coverage.Mark(address, size);
+        ++num_ranges;
+    };
+    std::atomic_bool done{};
+    std::thread gpu_thread([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            for (auto& manager : managers) {
+                manager->Gather(callback);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (size_t core = 0; core < NUM_PRODUCERS; ++core) {
+        producers.emplace_back([&, core] {
+            for (const auto& [address, size] : writes[core]) {
+                managers[core]->Collect(address, size);
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    done.store(true, std::memory_order_release);
+    gpu_thread.join();
+    for (auto& manager : managers) {
+        manager->Gather(callback);
+    }
+
+    for (const auto& core_writes : writes) {
+        for (const auto& [address, size] : core_writes) {
+            REQUIRE(coverage.Covers(address, size));
+        }
+    }
+    const size_t total_writes = NUM_PRODUCERS * writes_per_producer;
+    return {
+        .marks_per_second = static_cast<double>(total_writes) / elapsed.count(),
+        .num_ranges = num_ranges,
+    };
+}
+
+} // Anonymous namespace
+
+TEST_CASE("GPUDirtyMemoryManager[Coalescing]", "[core]") {
+    auto manager = std::make_unique<Core::GPUDirtyMemoryManager>();
+
+    // A vertex buffer streamed over several pages is reported as a single range
+    for (PAddr address = 0x10000; address < 0x20000; address += 0x100) {
+        manager->Collect(address, 0x100);
+    }
+    auto ranges = Gather(*manager);
+    REQUIRE(ranges.size() == 1);
+    REQUIRE(ranges[0] == std::pair<PAddr, size_t>{0x10000, 0x10000});
+    REQUIRE(Gather(*manager).empty());
+
+    // Disjoint writes stay apart and are rounded to 64 bytes
+    manager->Collect(0x1010, 0x10);
+    manager->Collect(0x1100, 0x40);
+    manager->Collect(0x9000, 0x80);
+    ranges = Gather(*manager);
+    REQUIRE(ranges.size() == 3);
+    REQUIRE(ranges[0] == std::pair<PAddr, size_t>{0x1000, 0x40});
+    REQUIRE(ranges[1] == std::pair<PAddr, size_t>{0x1100, 0x40});
+    REQUIRE(ranges[2] == std::pair<PAddr, size_t>{0x9000, 0x80});
+}
+
+TEST_CASE("GPUDirtyMemoryManager[Overflow]", "[core]") {
+    auto manager = std::make_unique<Core::GPUDirtyMemoryManager>();
+
+    // Touch more pages than fit in the ring before the GPU thread drains it
+    constexpr size_t memory_size = 64ULL << 20;
+    std::vector<PAddr> writes;
+    for (PAddr address = 0; address < memory_size; address += 0x1000) {
+        writes.push_back(address);
+        manager->Collect(address, 0x40);
+    }
+    Coverage coverage(memory_size);
+    for (const auto& [address, size] : Gather(*manager)) {
+        coverage.Mark(address, size);
+    }
+    for (const PAddr address : writes) {
+        REQUIRE(coverage.Covers(address, 0x40));
+    }
+}
+
+TEST_CASE("GPUDirtyMemoryManager[ConcurrentGather]", "[core]") {
+    (void)RunConcurrentGather(100'000);
+}
+
+TEST_CASE("GPUDirtyMemoryManager[ConcurrentGatherThroughput]", "[core][.benchmark]") {
+    constexpr size_t writes_per_producer = 2'000'000;
+    const auto result = RunConcurrentGather(writes_per_producer);
+    std::printf("GPUDirtyMemoryManager: %zu producers, %.0f marks/s, %zu marks drained as %zu "
+                "ranges\n",
+                NUM_PRODUCERS, result.marks_per_second, NUM_PRODUCERS * writes_per_producer,
+                result.num_ranges);
+}
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/memory.h"
+
+namespace {
+
+using Core::Memory::HostSpans;
+using Core::Memory::YUZU_PAGEBITS;
+using Core::Memory::YUZU_PAGESIZE;
+
+constexpr std::size_t ADDRESS_SPACE_BITS = 24;
+constexpr u64 BASE_PAGE = 0x10;
+constexpr u64 BASE_ADDRESS = BASE_PAGE << YUZU_PAGEBITS;
+
+struct Environment {
+    Environment() {
+        page_table.Resize(ADDRESS_SPACE_BITS, YUZU_PAGEBITS);
+        memory.SetCurrentPageTable(page_table);
+    }
+
+    /// Maps a guest page to a page of the host buffer
+    void Map(u64 guest_page, std::size_t host_page) {
+        const auto pointer = reinterpret_cast<uintptr_t>(host.data() + host_page * YUZU_PAGESIZE);
+        page_table.pointers[guest_page].Store(pointer - (guest_page << YUZU_PAGEBITS),
+                                              Common::PageType::Memory);
+    }
+
+    u8* HostPage(std::size_t host_page) {
+        return host.data() + host_page * YUZU_PAGESIZE;
+    }
+
+    Core::System system;
+    Core::Memory::Memory memory{system};
+    Common::PageTable page_table;
+    std::vector<u8> host = std::vector<u8>(8 * YUZU_PAGESIZE);
+};
+
+} // Anonymous namespace
+
+TEST_CASE("Memory[GatherSpansMerge]", "[core]") {
+    Environment env;
+    // Three guest pages backed by contiguous host pages, then one backed by a distant host page
+    env.Map(BASE_PAGE, 0);
+    env.Map(BASE_PAGE + 1, 1);
+    env.Map(BASE_PAGE + 2, 2);
+    env.Map(BASE_PAGE + 3, 5);
+
+    HostSpans spans;
+    REQUIRE(env.memory.GatherSpans(BASE_ADDRESS + 0x800, 2 * YUZU_PAGESIZE, spans));
+    REQUIRE(spans.size() == 1);
+    REQUIRE(spans[0].data() == env.HostPage(0) + 0x800);
+    REQUIRE(spans[0].size() == 2 * YUZU_PAGESIZE);
+
+    // A range crossing into the distant page is split where the host memory stops being contiguous
+    REQUIRE(env.memory.GatherSpans(BASE_ADDRESS + 0x800, 3 * YUZU_PAGESIZE, spans));
+    REQUIRE(spans.size() == 2);
+    REQUIRE(spans[0].data() == env.HostPage(0) + 0x800);
+    REQUIRE(spans[0].size() == 3 * YUZU_PAGESIZE - 0x800);
+    REQUIRE(spans[1].data() == env.HostPage(5));
+    REQUIRE(spans[1].size() == 0x800);
+
+    // Host pages mapped in reverse order are never merged
+    env.Map(BASE_PAGE + 8, 7);
+    env.Map(BASE_PAGE + 9, 6);
+    REQUIRE(env.memory.GatherSpans(BASE_ADDRESS + 8 * YUZU_PAGESIZE, 2 * YUZU_PAGESIZE, spans));
+    REQUIRE(spans.size() == 2);
+    REQUIRE(spans[0].data() == env.HostPage(7));
+    REQUIRE(spans[1].data() == env.HostPage(6));
+}
+
+TEST_CASE("Memory[GatherSpansUnmapped]", "[core]") {
+    Environment env;
+    env.Map(BASE_PAGE, 0);
+    env.Map(BASE_PAGE + 2, 2);
+
+    // A hole in the middle of the range fails the whole gather and leaves no spans behind
+    HostSpans spans;
+    REQUIRE(env.memory.GatherSpans(BASE_ADDRESS, YUZU_PAGESIZE, spans));
+    REQUIRE(spans.size() == 1);
+    REQUIRE(!env.memory.GatherSpans(BASE_ADDRESS, 3 * YUZU_PAGESIZE, spans));
+    REQUIRE(spans.empty());
+
+    // Ranges ending in an unmapped page, or leaving the address space, fail as well
+    REQUIRE(!env.memory.GatherSpans(BASE_ADDRESS + 2 * YUZU_PAGESIZE, 2 * YUZU_PAGESIZE, spans));
+    REQUIRE(spans.empty());
+    const u64 end = 1ULL << ADDRESS_SPACE_BITS;
+    REQUIRE(!env.memory.GatherSpans(end - YUZU_PAGESIZE, 2 * YUZU_PAGESIZE, spans));
+    REQUIRE(spans.empty());
+}
@@ -0,0 +1,339 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "common/scope_exit.h"
+#include "core/file_sys/fssystem/fs_i_storage.h"
+#include "core/file_sys/fssystem/fssystem_read_ahead_storage.h"
+
+namespace {
+
+using namespace Common::Literals;
+using namespace std::chrono_literals;
+using FileSys::ReadAheadStorage;
+
+constexpr size_t IMAGE_SIZE = 32_MiB;
+
+void Spin(std::chrono::nanoseconds duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+/// In-memory storage with a latency on every read, like the layers reading and transcoding a file.
+/// The latency is slept rather than spun, so that the overlap is measurable on a single core.
+class SlowStorage : public FileSys::IReadOnlyStorage {
+public:
+    explicit SlowStorage(std::vector<u8> contents_) : contents{std::move(contents_)} {}
+
+    size_t GetSize() const override {
+        return contents.size();
+    }
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        if (offset >= contents.size()) {
+            return 0;
+        }
+        size = std::min(size, contents.size() - offset);
+        std::this_thread::sleep_for(size / 1_KiB * 1us);
+        std::memcpy(buffer, contents.data() + offset, size);
+        return size;
+    }
+
+private:
+    std::vector<u8> contents;
+};
+
+/// Reads made by the workers, as opposed to those of the threads marked as guests
+thread_local bool is_guest_thread = false;
+
+class GuestThread {
+public:
+    GuestThread() {
+        is_guest_thread = true;
+    }
+
+    ~GuestThread() {
+        is_guest_thread = false;
+    }
+};
+
+/// In-memory storage recording the offsets read ahead by the workers. Those reads block until the
+/// gate is opened, so prefetches can be held in flight.
+class GatedStorage : public FileSys::IReadOnlyStorage {
+public:
+    explicit GatedStorage(std::vector<u8> contents_) : contents{std::move(contents_)} {}
+
+    size_t GetSize() const override {
+        return contents.size();
+    }
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        if (!is_guest_thread) {
+            std::unique_lock lk{mutex};
+            background_offsets.push_back(offset);
+            opened.wait(lk, [this] { return is_open; });
+        }
+        if (offset >= contents.size()) {
+            return 0;
+        }
+        size = std::min(size, contents.size() - offset);
+        std::memcpy(buffer, contents.data() + offset, size);
+        return size;
+    }
+
+    /// Closes the gate, forgetting the reads made so far
+    void Close() {
+        std::scoped_lock lk{mutex};
+        background_offsets.clear();
+        is_open = false;
+    }
+
+    void Open() {
+        {
+            std::scoped_lock lk{mutex};
+            is_open = true;
+        }
+        opened.notify_all();
+    }
+
+    std::vector<size_t> BackgroundOffsets() const {
+        std::scoped_lock lk{mutex};
+        return background_offsets;
+    }
+
+private:
+    std::vector<u8> contents;
+    mutable std::mutex mutex;
+    mutable std::condition_variable opened;
+    mutable std::vector<size_t> background_offsets;
+    bool is_open = true;
+};
+
+/// Reads two requests ending at a block boundary. The stream is detected on the second one, which
+/// does not touch the blocks queued for it, so the guest never waits on them here.
+void StartStream(const ReadAheadStorage& storage, size_t end_offset) {
+    constexpr size_t REQUEST_SIZE = 64_KiB;
+    std::vector<u8> buffer(REQUEST_SIZE);
+    // Small skips forward still continue a stream
+    REQUIRE(storage.Read(buffer.data(), REQUEST_SIZE, end_offset - 2 * REQUEST_SIZE - 4_KiB) ==
+            REQUEST_SIZE);
+    REQUIRE(storage.Read(buffer.data(), REQUEST_SIZE, end_offset - REQUEST_SIZE) == REQUEST_SIZE);
+}
+
+/// Polls a condition set by the workers, fails after a generous timeout instead of hanging
+template <typename Predicate>
+bool WaitUntil(Predicate&& predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+/// Starts a stream whose read ahead blocks in the base storage, returns the first block queued.
+/// The reads detecting it hit blocks prefetched beforehand, otherwise they would wait on the base
+/// storage, which is held by the blocked workers.
+size_t StartGatedStream(const ReadAheadStorage& storage, GatedStorage& base) {
+    constexpr size_t WARM_BLOCK = 20;
+    StartStream(storage, WARM_BLOCK * ReadAheadStorage::BlockSize);
+    REQUIRE(WaitUntil([&] {
+        return storage.GetStatistics().prefetched == ReadAheadStorage::PrefetchBlockCount;
+    }));
+    base.Close();
+    const size_t first_block = WARM_BLOCK + ReadAheadStorage::PrefetchBlockCount;
+    StartStream(storage, first_block * ReadAheadStorage::BlockSize);
+    return first_block;
+}
+
+std::vector<u8> MakeContents() {
+    std::mt19937 rng{1234};
+    std::vector<u8> contents(IMAGE_SIZE);
+    for (u8& byte : contents) {
+        byte = static_cast<u8>(rng());
+    }
+    return contents;
+}
+
+/// Streams the whole storage with guest work between the reads, returns MiB/s
+double Stream(const FileSys::VfsFile& storage, size_t request_size) {
+    std::vector<u8> buffer(request_size);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < IMAGE_SIZE; offset += request_size) {
+        storage.Read(buffer.data(), request_size, offset);
+        Spin(request_size / 1_KiB * 1us);
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(IMAGE_SIZE) / 1_MiB / time.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ReadAheadStorage[ReadMatches]", "[core]") {
+    const std::vector<u8> contents = MakeContents();
+    const auto storage =
+        std::make_shared<ReadAheadStorage>(std::make_shared<SlowStorage>(contents));
+
+    // Two interleaved sequential streams mixed with random reads
+    std::mt19937 rng{5678};
+    std::vector<u8> buffer;
+    size_t stream_offsets[2]{0, IMAGE_SIZE / 2};
+    for (size_t i = 0; i < 2000; ++i) {
+        const size_t size = 1 + rng() % (i % 3 == 0 ? 4_KiB : 3 * ReadAheadStorage::BlockSize);
+        size_t offset = rng() % (IMAGE_SIZE - size);
+        if (i % 3 != 2) {
+            offset = stream_offsets[i % 3] % (IMAGE_SIZE - size);
+            stream_offsets[i % 3] = offset + size;
+        }
+        buffer.assign(size, 0);
+        REQUIRE(storage->Read(buffer.data(), size, offset) == size);
+        REQUIRE(std::memcmp(buffer.data(), contents.data() + offset, size) == 0);
+    }
+
+    // Reads past the end are clamped
+    buffer.assign(4_KiB, 0);
+    REQUIRE(storage->Read(buffer.data(), buffer.size(), IMAGE_SIZE - 1_KiB) == 1_KiB);
+    REQUIRE(storage->Read(buffer.data(), buffer.size(), IMAGE_SIZE) == 0);
+}
+
+TEST_CASE("ReadAheadStorage[StreamDetection]", "[core]") {
+    GuestThread guest;
+    const auto base = std::make_shared<GatedStorage>(MakeContents());
+    const auto storage = std::make_shared<ReadAheadStorage>(base);
+    constexpr size_t BLOCK = ReadAheadStorage::BlockSize;
+    std::vector<u8> buffer(64_KiB);
+
+    // Scattered reads, and reads going backwards, never start a stream
+    for (const size_t offset : {20 * BLOCK, 4 * BLOCK, 60 * BLOCK, 40 * BLOCK, 39 * BLOCK}) {
+        REQUIRE(storage->Read(buffer.data(), buffer.size(), offset) == buffer.size());
+    }
+
+    const size_t stream_offset = 100 * BLOCK;
+    StartStream(*storage, stream_offset);
+    REQUIRE(WaitUntil([&] {
+        return storage->GetStatistics().prefetched == ReadAheadStorage::PrefetchBlockCount;
+    }));
+
+    // Only the blocks following the stream were read ahead
+    std::vector<size_t> prefetched = base->BackgroundOffsets();
+    std::ranges::sort(prefetched);
+    REQUIRE(prefetched.size() == ReadAheadStorage::PrefetchBlockCount);
+    for (size_t i = 0; i < prefetched.size(); ++i) {
+        REQUIRE(prefetched[i] == stream_offset + i * BLOCK);
+    }
+
+    // Continuing the stream within the prefetched blocks hits the cache
+    const auto before = storage->GetStatistics();
+    REQUIRE(storage->Read(buffer.data(), buffer.size(), stream_offset) == buffer.size());
+    const auto after = storage->GetStatistics();
+    REQUIRE(after.hits == before.hits + 1);
+    REQUIRE(after.misses == before.misses);
+}
+
+TEST_CASE("ReadAheadStorage[Waits]", "[core]") {
+    GuestThread guest;
+    const std::vector<u8> contents = MakeContents();
+    const auto base = std::make_shared<GatedStorage>(contents);
+    SCOPE_EXIT {
+        base->Open();
+    };
+    const auto storage = std::make_shared<ReadAheadStorage>(base);
+    constexpr size_t BLOCK = ReadAheadStorage::BlockSize;
+    constexpr size_t REQUEST_SIZE = 64_KiB;
+
+    // Each worker starts a prefetch, the first to read the base storage blocks in it
+    const size_t first_block = StartGatedStream(*storage, *base);
+    REQUIRE(WaitUntil([&] { return base->BackgroundOffsets().size() == 1; }));
+    const size_t running_block = base->BackgroundOffsets()[0] / BLOCK;
+    const size_t queued_block = first_block + ReadAheadStorage::PrefetchBlockCount - 1;
+    REQUIRE(running_block - first_block < 2);
+    const auto prefetched = storage->GetStatistics().prefetched;
+    const auto misses = storage->GetStatistics().misses;
+
+    // A read of the running block waits for it instead of reading it again
+    std::vector<u8> running_buffer(REQUEST_SIZE);
+    std::thread running_reader([&] {
+        GuestThread reader_guest;
+        REQUIRE(storage->Read(running_buffer.data(), REQUEST_SIZE, running_block * BLOCK) ==
+                REQUEST_SIZE);
+    });
+    REQUIRE(WaitUntil([&] { return storage->GetStatistics().waits == 1; }));
+
+    // A read of a queued block takes it back, it is not delayed by the prefetches queued before
+    std::vector<u8> queued_buffer(REQUEST_SIZE);
+    std::thread queued_reader([&] {
+        GuestThread reader_guest;
+        REQUIRE(storage->Read(queued_buffer.data(), REQUEST_SIZE, queued_block * BLOCK) ==
+                REQUEST_SIZE);
+    });
+    REQUIRE(WaitUntil([&] { return storage->GetStatistics().misses == misses + 1; }));
+
+    base->Open();
+    running_reader.join();
+    queued_reader.join();
+    REQUIRE(std::memcmp(running_buffer.data(), contents.data() + running_block * BLOCK,
+                        REQUEST_SIZE) == 0);
+    REQUIRE(std::memcmp(queued_buffer.data(), contents.data() + queued_block * BLOCK,
+                        REQUEST_SIZE) == 0);
+
+    // Every block but the one taken back is read ahead
+    REQUIRE(WaitUntil([&] {
+        const size_t num_reads = base->BackgroundOffsets().size();
+        return num_reads >= ReadAheadStorage::PrefetchBlockCount - 1 &&
+               storage->GetStatistics().prefetched == prefetched + num_reads;
+    }));
+    const auto statistics = storage->GetStatistics();
+    REQUIRE(statistics.waits == 1);
+    REQUIRE(statistics.hits >= 1);
+    REQUIRE(std::ranges::count(base->BackgroundOffsets(), queued_block * BLOCK) == 0);
+}
+
+TEST_CASE("ReadAheadStorage[Teardown]", "[core]") {
+    GuestThread guest;
+    const auto base = std::make_shared<GatedStorage>(MakeContents());
+    SCOPE_EXIT {
+        base->Open();
+    };
+    auto storage = std::make_shared<ReadAheadStorage>(base);
+
+    (void)StartGatedStream(*storage, *base);
+    REQUIRE(WaitUntil([&] { return base->BackgroundOffsets().size() == 1; }));
+
+    // Prefetches keep the storage alive while they run, the base is released once they are done
+    storage.reset();
+    base->Open();
+    REQUIRE(WaitUntil([&] { return base.use_count() == 1; }));
+    REQUIRE(base->BackgroundOffsets().size() <= ReadAheadStorage::PrefetchBlockCount);
+}
+
+TEST_CASE("ReadAheadStorage[StreamThroughput]", "[core][.benchmark]") {
+    const auto base = std::make_shared<SlowStorage>(MakeContents());
+    for (const size_t request_size : {16_KiB, 64_KiB, 256_KiB}) {
+        const auto storage = std::make_shared<ReadAheadStorage>(base);
+        const double direct_speed = Stream(*base, request_size);
+        const double read_ahead_speed = Stream(*storage, request_size);
+        const auto statistics = storage->GetStatistics();
+        printf("Read-ahead storage, %3zu KiB reads: %7.1f MiB/s direct, %7.1f MiB/s read ahead, "
+               "%llu hits, %llu waits\n",
+               request_size / 1_KiB, direct_speed, read_ahead_speed,
+               static_cast<unsigned long long>(statistics.hits),
+               static_cast<unsigned long long>(statistics.waits));
+    }
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <chrono>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/hle/service/service_statistics.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+using Service::LatencyHistogram;
+using Service::ServiceStatistics;
+
+} // Anonymous namespace
+
+TEST_CASE("LatencyHistogram[Buckets]", "[core]") {
+    // Small values are exact, the buckets are contiguous and their bounds grow monotonically
+    for (u64 value = 0; value < LatencyHistogram::SubBucketCount * 2; ++value) {
+        REQUIRE(LatencyHistogram::BucketIndex(value) == value);
+    }
+    for (size_t index = 1; index < LatencyHistogram::BucketCount - 1; ++index) {
+        const u64 upper = LatencyHistogram::BucketUpperBound(index);
+        REQUIRE(LatencyHistogram::BucketIndex(upper) == index);
+        REQUIRE(LatencyHistogram::BucketIndex(upper + 1) == index + 1);
+    }
+    REQUIRE(LatencyHistogram::BucketIndex(~u64{0}) == LatencyHistogram::BucketCount - 1);
+}
+
+TEST_CASE("LatencyHistogram[Percentiles]", "[core]") {
+    LatencyHistogram histogram;
+    REQUIRE(histogram.ValueAtPercentile(50.0) == 0);
+
+    for (u64 value = 1; value <= 100000; ++value) {
+        histogram.Record(value * 100);
+    }
+    REQUIRE(histogram.Count() == 100000);
+    REQUIRE(histogram.Max() == 10000000);
+
+    // The bound is above the exact percentile, by less than the bucket width
+    const auto check = [&](double percentile, u64 exact) {
+        const u64 value = histogram.ValueAtPercentile(percentile);
+        REQUIRE(value >= exact);
+        REQUIRE(value <= exact + exact / LatencyHistogram::SubBucketCount);
+    };
+    check(50.0, 5000000);
+    check(99.0, 9900000);
+    REQUIRE(histogram.ValueAtPercentile(100.0) == histogram.Max());
+}
+
+TEST_CASE("ServiceStatistics[Summary]", "[core]") {
+    ServiceStatistics statistics;
+    auto& fast = statistics.GetEntry("fast");
+    auto& slow = statistics.GetEntry("slow");
+    REQUIRE(&statistics.GetEntry("slow") == &slow);
+
+    for (int i = 0; i < 1000; ++i) {
+        statistics.RecordCommand(fast, 1, false, "Poll", 1us, 0, 8);
+    }
+    statistics.RecordCommand(slow, 2, false, "Read", 5ms, 16, 0x1000);
+    statistics.RecordCommand(slow, 2, false, "Read", 3ms, 16, 0x1000);
+    statistics.RecordCommand(slow, 2, true, "Read", 1ms, 0, 0);
+    statistics.RecordServerEvent(ServiceStatistics::ServerEvent::Session, 10us);
+
+    const auto summary = statistics.GetSummary();
+    REQUIRE(summary.server_events[0].count == 1);
+    REQUIRE(summary.services.size() == 2);
+
+    // Services and their commands are sorted by the time spent in them
+    const auto& slow_summary = summary.services[0];
+    REQUIRE(slow_summary.name == "slow");
+    REQUIRE(slow_summary.total_ns == 9000000);
+    REQUIRE(slow_summary.commands.size() == 2);
+    REQUIRE(!slow_summary.commands[0].is_tipc);
+    REQUIRE(slow_summary.commands[0].latency.count == 2);
+    REQUIRE(slow_summary.commands[0].latency.max_ns == 5000000);
+    REQUIRE(slow_summary.commands[0].out_capacity == 0x2000);
+    REQUIRE(slow_summary.commands[1].is_tipc);
+
+    const auto& fast_summary = summary.services[1];
+    REQUIRE(fast_summary.commands[0].name == "Poll");
+    REQUIRE(fast_summary.commands[0].latency.count == 1000);
+    REQUIRE(fast_summary.commands[0].latency.p99_ns == 1000);
+
+    // Entries outlive a reset, which only clears the records
+    statistics.Reset();
+    REQUIRE(statistics.GetSummary().services.empty());
+    statistics.RecordCommand(fast, 1, false, "Poll", 1us, 0, 8);
+    REQUIRE(statistics.GetSummary().services.size() == 1);
+}
@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/astc.h"
+#include "video_core/textures/astc_kernels.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#endif
+
+namespace {
+
+struct Footprint {
+    u32 width;
+    u32 height;
+};
+
+constexpr std::array<Footprint, 14> FOOTPRINTS{{
+    {4, 4},
+    {5, 4},
+    {5, 5},
+    {6, 5},
+    {6, 6},
+    {8, 5},
+    {8, 6},
+    {8, 8},
+    {10, 5},
+    {10, 6},
+    {10, 8},
+    {10, 10},
+    {12, 10},
+    {12, 12},
+}};
+
+// Color endpoint modes without HDR endpoints
+constexpr std::array<u32, 10> LDR_ENDPOINT_MODES{0, 1, 4, 5, 6, 8, 9, 10, 12, 13};
+
+void SetBits(std::array<u8, 16>& block, u32 offset, u32 count, u32 value) {
+    for (u32 bit = 0; bit < count; ++bit) {
+        const u32 position = offset + bit;
+        const u8 mask = static_cast<u8>(1U << (position % 8));
+        if ((value >> bit) & 1) {
+            block[position / 8] |= mask;
+        } else {
+            block[position / 8] &= static_cast<u8>(~mask);
+        }
+    }
+}
+
+/// Builds valid LDR blocks that cover single and dual plane weights, one to four partitions and
+/// every LDR endpoint mode. Everything that is not part of the block header is random.
+std::vector<u8> MakeBlockCorpus(size_t num_blocks) {
+    std::mt19937 rng{0xA57C};
+    std::vector<u8> corpus(num_blocks * 16);
+    for (size_t i = 0; i < num_blocks; ++i) {
+        std::array<u8, 16> block;
+        for (u8& byte : block) {
+            byte = static_cast<u8>(rng());
+        }
+        const u32 partitions = 1 + static_cast<u32>(rng() % 4);
+        const bool dual_plane = partitions < 4 && rng() % 4 == 0;
+        // Weight grid of 4x2 to 4x4, which fits in every footprint, with 2 to 4 weight levels
+        const u32 grid_height = dual_plane ? 0 : static_cast<u32>(rng() % 3);
+        const u32 range = 2 + static_cast<u32>(rng() % 3);
+
+        // Pick an endpoint mode whose values still fit with at least the 0..5 range
+        const u32 num_weights = 4 * (grid_height + 2) * (dual_plane ? 2 : 1);
+        const std::array<u32, 3> weight_bits{num_weights, (num_weights * 8 + 4) / 5,
+                                             num_weights * 2};
+        const u32 header_bits = (partitions == 1 ? 17 : 29) + (dual_plane ? 2 : 0);
+        const u32 color_bits = 128 - header_bits - weight_bits[range - 2];
+        size_t mode_index = rng() % LDR_ENDPOINT_MODES.size();
+        while (mode_index > 0) {
+            const u32 num_values = partitions * ((LDR_ENDPOINT_MODES[mode_index] >> 2) + 1) * 2;
+            if (num_values + (num_values * 8 + 4) / 5 <= color_bits) {
+                break;
+            }
+            --mode_index;
+        }
+        const u32 endpoint_mode = LDR_ENDPOINT_MODES[mode_index];
+
+        u32 mode = (range >> 1) | ((range & 1) << 4) | (grid_height << 5);
+        if (dual_plane) {
+            mode |= 1U << 10;
+        }
+        SetBits(block, 0, 11, mode);
+        SetBits(block, 11, 2, partitions - 1);
+        if (partitions == 1) {
+            SetBits(block, 13, 4, endpoint_mode);
+        } else {
+            // The partition index stays random, all partitions share one endpoint mode
+            SetBits(block, 23, 6, endpoint_mode << 2);
+        }
+        std::copy(block.begin(), block.end(), corpus.begin() + i * 16);
+    }
+    return corpus;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ASTC[VoidExtent]", "[video_core]") {
+    // Void extent block with a constant color of R=0x11 G=0x22 B=0x33 A=0x44
+    std::array<u8, 16> block{};
+    SetBits(block, 0, 12, 0xDFC);
+    SetBits(block, 12, 52, 0);
+    SetBits(block, 64, 16, 0x1100);
+    SetBits(block, 80, 16, 0x2200);
+    SetBits(block, 96, 16, 0x3300);
+    SetBits(block, 112, 16, 0x4400);
+
+    std::vector<u32> texels(6 * 6);
+    Tegra::Texture::ASTC::DecompressBlocks(block, 6, 6, texels);
+    for (const u32 texel : texels) {
+        REQUIRE(texel == 0x44332211);
+    }
+}
+
+TEST_CASE("ASTC[InterpolateKernels]", "[video_core]") {
+    using namespace Tegra::Texture::ASTC;
+    constexpr size_t NUM_BLOCKS = 512;
+    const std::vector<u8> corpus = MakeBlockCorpus(NUM_BLOCKS);
+
+    std::vector<std::pair<const char*, InterpolateFunction>> kernels;
+#if defined(ARCHITECTURE_x86_64)
+    const auto& cpu_caps{Common::GetCPUCaps()};
+    if (cpu_caps.sse4_1) {
+        kernels.emplace_back("SSE4.1", InterpolateSSE41);
+    }
+    if (cpu_caps.avx2) {
+        kernels.emplace_back("AVX2", InterpolateAVX2);
+    }
+#elif defined(ARCHITECTURE_arm64)
+    kernels.emplace_back("SSE4.1", InterpolateSSE41);
+#endif
+
+    // Every kernel must match the scalar one bit for bit, on every block of every footprint
+    for (const Footprint& footprint : FOOTPRINTS) {
+        const u32 num_texels = footprint.width * footprint.height;
+        std::vector<u32> expected(num_texels);
+        std::vector<u32> result(num_texels);
+        for (size_t i = 0; i < NUM_BLOCKS; ++i) {
+            const std::span<const u8, 16> block{corpus.data() + i * 16, 16};
+            DecodedBlock decoded{};
+            REQUIRE(DecodeBlock(block, footprint.width, footprint.height, decoded, expected));
+            InterpolateScalar(decoded, num_texels, expected.data());
+            for (const auto& [name, interpolate] : kernels) {
+                INFO(name << " " << footprint.width << "x" << footprint.height << " block " << i);
+                std::ranges::fill(result, 0);
+                interpolate(decoded, num_texels, result.data());
+                REQUIRE(result == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("ASTC[DecodeThroughput]", "[video_core][.benchmark]") {
+    constexpr size_t NUM_BLOCKS = 1 << 14;
+    const std::vector<u8> corpus = MakeBlockCorpus(NUM_BLOCKS);
+
+    for (const Footprint& footprint : FOOTPRINTS) {
+        const u32 num_texels = footprint.width * footprint.height;
+        std::vector<u32> texels(NUM_BLOCKS * num_texels);
+
+        const auto start = std::chrono::steady_clock::now();
+        Tegra::Texture::ASTC::DecompressBlocks(corpus, footprint.width, footprint.height, texels);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const double mpix = static_cast<double>(NUM_BLOCKS * num_texels) / 1e6;
+        printf("ASTC %2ux%-2u: %8.2f MPix/s\n", footprint.width, footprint.height,
+               mpix / elapsed.count());
+    }
+}
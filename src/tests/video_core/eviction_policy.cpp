@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "video_core/texture_cache/eviction_policy.h"
+
+namespace {
+
+using namespace Common::Literals;
+using VideoCommon::EvictionCandidate;
+using VideoCommon::EvictionPlan;
+using VideoCommon::EvictionPolicy;
+using VideoCommon::ImageId;
+using VideoCommon::UploadPath;
+
+EvictionCandidate MakeCandidate(u32 id, u64 size_bytes, u64 last_use,
+                                UploadPath upload_path = UploadPath::Accelerated,
+                                bool costly_load = false, bool must_download = false) {
+    return {
+        .image_id = ImageId{id},
+        .gpu_addr = u64{id} << 32,
+        .size_bytes = size_bytes,
+        .last_use = last_use,
+        .upload_path = upload_path,
+        .costly_load = costly_load,
+        .must_download = must_download,
+    };
+}
+
+} // Anonymous namespace
+
+TEST_CASE("EvictionPolicy[Plan]", "[video_core]") {
+    EvictionPolicy policy;
+    policy.Configure(1_GiB, 3_GiB, 4_GiB);
+
+    REQUIRE(policy.Plan(512_MiB).bytes_to_free == 0);
+
+    const EvictionPlan relaxed = policy.Plan(2_GiB);
+    REQUIRE(relaxed.bytes_to_free > 0);
+    REQUIRE(relaxed.max_downloads == 0);
+    REQUIRE(!relaxed.allow_costly);
+
+    const EvictionPlan high = policy.Plan(3_GiB + 512_MiB);
+    REQUIRE(high.bytes_to_free >= 512_MiB);
+    REQUIRE(high.max_downloads > 0);
+    REQUIRE(high.minimum_age < relaxed.minimum_age);
+
+    const EvictionPlan critical = policy.Plan(5_GiB);
+    REQUIRE(critical.bytes_to_free == 2_GiB);
+    REQUIRE(critical.allow_costly);
+    REQUIRE(critical.minimum_age < high.minimum_age);
+}
+
+TEST_CASE("EvictionPolicy[Select]", "[video_core]") {
+    EvictionPolicy policy;
+    const u64 frame_tick = 1000;
+    const EvictionPlan plan{
+        .bytes_to_free = 64_MiB,
+        .minimum_age = 25,
+        .max_downloads = 1,
+        .allow_costly = false,
+    };
+    std::vector<EvictionCandidate> candidates{
+        MakeCandidate(1, 16_MiB, 990),
+        MakeCandidate(2, 16_MiB, 900, UploadPath::Converted),
+        MakeCandidate(3, 16_MiB, 900, UploadPath::Accelerated, true),
+        MakeCandidate(4, 16_MiB, 900, UploadPath::Accelerated, false, true),
+        MakeCandidate(5, 16_MiB, 900, UploadPath::Accelerated, false, true),
+        MakeCandidate(6, 16_MiB, 900),
+    };
+    const auto selected = policy.Select(plan, candidates, frame_tick);
+    REQUIRE(selected.size() == 3);
+    // Cheapest image to load back goes first
+    REQUIRE(selected[0].image_id == ImageId{6});
+    // Only one download is allowed, recently used and costly images are never picked
+    REQUIRE(std::ranges::count_if(selected, [](const auto& c) { return c.must_download; }) == 1);
+    REQUIRE(std::ranges::none_of(selected, [](const auto& c) {
+        return c.image_id == ImageId{1} || c.image_id == ImageId{3};
+    }));
+
+    // A larger image that is equally cheap and old frees more memory for its creation cost
+    candidates = {MakeCandidate(1, 64_KiB, 900), MakeCandidate(2, 8_MiB, 900)};
+    REQUIRE(policy.Select(plan, candidates, frame_tick)[0].image_id == ImageId{2});
+}
+
+TEST_CASE("EvictionPolicy[Statistics]", "[video_core]") {
+    EvictionPolicy policy;
+    policy.Configure(256_MiB, 448_MiB, 512_MiB);
+
+    // Replay a title streaming through more textures than fit in the budget, with a working set
+    // that is drawn every frame and a tail of textures that come back after a while
+    struct Texture {
+        u64 size_bytes;
+        UploadPath upload_path;
+        bool resident;
+        u64 last_use;
+    };
+    std::mt19937_64 rng{0xe71c7};
+    std::vector<Texture> textures(2048);
+    for (Texture& texture : textures) {
+        texture.size_bytes = u64{256_KiB} << (rng() % 6);
+        texture.upload_path = static_cast<UploadPath>(rng() % 3);
+        texture.resident = false;
+        texture.last_use = 0;
+    }
+    u64 used_memory = 0;
+    std::vector<EvictionCandidate> candidates;
+    for (u64 frame_tick = 1; frame_tick <= 3000; ++frame_tick) {
+        for (u32 draw = 0; draw < 64; ++draw) {
+            const u32 id = draw < 32 ? draw : static_cast<u32>(rng() % textures.size());
+            Texture& texture = textures[id];
+            if (!texture.resident) {
+                const GPUVAddr gpu_addr = u64{id} << 32;
+                policy.RecordRegistration(gpu_addr, texture.size_bytes, frame_tick);
+                used_memory += texture.size_bytes;
+                texture.resident = true;
+            }
+            texture.last_use = frame_tick;
+        }
+        candidates.clear();
+        for (u32 id = 0; id < textures.size(); ++id) {
+            const Texture& texture = textures[id];
+            if (texture.resident) {
+                candidates.push_back(
+                    MakeCandidate(id, texture.size_bytes, texture.last_use, texture.upload_path));
+            }
+        }
+        const EvictionPlan plan = policy.Plan(used_memory);
+        for (const EvictionCandidate& candidate : policy.Select(plan, candidates, frame_tick)) {
+            REQUIRE(candidate.image_id.index >= 32);
+            textures[candidate.image_id.index].resident = false;
+            used_memory -= candidate.size_bytes;
+            policy.RecordEviction(candidate, frame_tick);
+        }
+        policy.TickFrame(used_memory, frame_tick);
+    }
+
+    const auto& statistics = policy.Statistics();
+    REQUIRE(statistics.evictions > 0);
+    REQUIRE(statistics.reuploads > 0);
+    REQUIRE(statistics.reuploads <= statistics.evictions);
+    REQUIRE(statistics.budget_overruns < 30);
+}
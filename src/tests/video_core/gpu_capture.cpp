@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/gpu_capture.h"
+
+namespace {
+
+using namespace VideoCommon::Capture;
+
+} // Anonymous namespace
+
+TEST_CASE("GPUCapture[RoundTrip]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "eden_gpu_capture_test.gpucap";
+
+    Tegra::CommandList entries(2);
+    entries.command_lists[0].raw = 0x1234'5678'9abcULL;
+    entries.command_lists[1].raw = 0x8000'0000'0000'0042ULL;
+    entries.prefetch_command_list.emplace_back().argument = 0x2001'0040;
+
+    std::vector<u8> memory(0x3000);
+    for (size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<u8>(i * 7);
+    }
+    Tegra::FramebufferConfig layer{};
+    layer.address = 0x4000'0000;
+    layer.width = 1280;
+    layer.height = 720;
+
+    {
+        Writer writer;
+        REQUIRE(writer.Open(path));
+        writer.Write(AddressSpaceRecord{1, 40, 1ULL << 34, 17, 12});
+        writer.Write(ChannelRecord{3, 0x0100'0000'0000'1000ULL, 1});
+        writer.Write(MapRecord{1, 0x10'0000, 0x2000'0000, 0x3000, Tegra::PTEKind::PITCH, false});
+        writer.WriteMemory(0x2000'0000, memory);
+        writer.Write(SubmitListRecord{3, entries});
+        writer.Write(FlushRegionRecord{0x2000'1000, 0x100});
+        writer.Write(InvalidateRegionRecord{0x2000'2000, 0x200});
+        writer.Write(UnmapRecord{1, 0x10'0000, 0x3000});
+        writer.Write(CompositeRecord{{layer}});
+    }
+
+    Reader reader;
+    REQUIRE(reader.Open(path));
+
+    auto record = reader.Next();
+    REQUIRE(record);
+    const auto& address_space = std::get<AddressSpaceRecord>(*record);
+    REQUIRE(address_space.split_address == 1ULL << 34);
+    REQUIRE(address_space.big_page_bits == 17);
+
+    record = reader.Next();
+    REQUIRE(record);
+    REQUIRE(std::get<ChannelRecord>(*record).program_id == 0x0100'0000'0000'1000ULL);
+
+    record = reader.Next();
+    REQUIRE(record);
+    const auto& map = std::get<MapRecord>(*record);
+    REQUIRE(map.device_addr == 0x2000'0000);
+    REQUIRE(map.kind == Tegra::PTEKind::PITCH);
+    REQUIRE(!map.is_big_pages);
+
+    record = reader.Next();
+    REQUIRE(record);
+    const auto& memory_record = std::get<MemoryRecord>(*record);
+    REQUIRE(memory_record.device_addr == 0x2000'0000);
+    REQUIRE(memory_record.data == memory);
+
+    record = reader.Next();
+    REQUIRE(record);
+    const auto& submit = std::get<SubmitListRecord>(*record);
+    REQUIRE(submit.channel == 3);
+    REQUIRE(submit.entries.command_lists.size() == 2);
+    REQUIRE(submit.entries.command_lists[1].raw == entries.command_lists[1].raw);
+    REQUIRE(submit.entries.prefetch_command_list.size() == 1);
+    REQUIRE(submit.entries.prefetch_command_list[0].argument == 0x2001'0040);
+
+    record = reader.Next();
+    REQUIRE(record);
+    REQUIRE(std::get<FlushRegionRecord>(*record).size == 0x100);
+
+    record = reader.Next();
+    REQUIRE(record);
+    REQUIRE(std::get<InvalidateRegionRecord>(*record).addr == 0x2000'2000);
+
+    record = reader.Next();
+    REQUIRE(record);
+    REQUIRE(std::get<UnmapRecord>(*record).gpu_addr == 0x10'0000);
+
+    record = reader.Next();
+    REQUIRE(record);
+    const auto& composite = std::get<CompositeRecord>(*record);
+    REQUIRE(composite.layers.size() == 1);
+    REQUIRE(composite.layers[0].address == layer.address);
+    REQUIRE(composite.layers[0].height == 720);
+
+    REQUIRE(!reader.Next());
+    std::filesystem::remove(path);
+}
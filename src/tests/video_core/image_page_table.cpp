@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/hash.h"
+#include "video_core/texture_cache/image_page_table.h"
+
+namespace {
+
+constexpr u64 PAGE_BITS = 20;
+
+using FlatTable = VideoCommon::ImagePageTable<u32>;
+using HashTable = std::unordered_map<u64, std::vector<u32>, Common::IdentityHash<u64>>;
+
+const std::vector<u32>* Find(const HashTable& table, u64 page) {
+    const auto it = table.find(page);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+const FlatTable::Bucket* Find(const FlatTable& table, u64 page) {
+    return table.Find(page);
+}
+
+struct Image {
+    u64 addr;
+    u64 size;
+};
+
+struct Operation {
+    enum class Type {
+        /// Looks up the images used by a draw, like FillGraphicsImageViews does
+        Draw,
+        /// Looks up the images touched by a CPU write, like WriteMemory does
+        Write,
+    };
+    Type type;
+    u64 addr;
+    u64 size;
+};
+
+template <typename Table>
+void Register(Table& table, const std::vector<Image>& images) {
+    for (u32 id = 0; id < images.size(); ++id) {
+        const Image& image = images[id];
+        const u64 page_end = (image.addr + image.size - 1) >> PAGE_BITS;
+        for (u64 page = image.addr >> PAGE_BITS; page <= page_end; ++page) {
+            table[page].push_back(id);
+        }
+    }
+}
+
+/// Same walk as TextureCache::ForEachImageInRegion, returns the number of overlapping images
+template <typename Table>
+size_t CountOverlaps(const Table& table, const std::vector<Image>& images,
+                     std::vector<bool>& picked, std::vector<u32>& found, u64 addr, u64 size) {
+    found.clear();
+    const u64 page_end = (addr + size - 1) >> PAGE_BITS;
+    for (u64 page = addr >> PAGE_BITS; page <= page_end; ++page) {
+        const auto* const ids = Find(table, page);
+        if (!ids) {
+            continue;
+        }
+        for (const u32 id : *ids) {
+            const Image& image = images[id];
+            if (picked[id] || image.addr >= addr + size || addr >= image.addr + image.size) {
+                continue;
+            }
+            picked[id] = true;
+            found.push_back(id);
+        }
+    }
+    for (const u32 id : found) {
+        picked[id] = false;
+    }
+    return found.size();
+}
+
+/// Builds a trace resembling a frame: most operations are draws sampling a working set of
+/// textures and render targets, the rest are small CPU writes scattered over the address space
+std::pair<std::vector<Image>, std::vector<Operation>> MakeTrace(size_t num_images,
+                                                                size_t num_operations) {
+    std::mt19937_64 rng{0x7e57};
+    std::vector<Image> images;
+    u64 addr = 0x8000'0000;
+    for (size_t i = 0; i < num_images; ++i) {
+        const u64 size = u64{64} << 10 << (rng() % 10);
+        addr += (rng() % 4) << 16;
+        images.push_back({addr, size});
+        addr += size;
+    }
+    std::vector<Operation> operations;
+    for (size_t i = 0; i < num_operations; ++i) {
+        if (rng() % 4 != 0) {
+            const Image& image = images[rng() % std::min<size_t>(images.size(), 256)];
+            operations.push_back({Operation::Type::Draw, image.addr, image.size});
+        } else {
+            const u64 offset = rng() % (addr - 0x8000'0000);
+            operations.push_back({Operation::Type::Write, 0x8000'0000 + offset,
+                                  u64{4} << 10 << (rng() % 5)});
+        }
+    }
+    return {std::move(images), std::move(operations)};
+}
+
+template <typename Table>
+double Replay(const Table& table, const std::vector<Image>& images,
+              const std::vector<Operation>& operations, size_t& checksum) {
+    std::vector<bool> picked(images.size());
+    std::vector<u32> found;
+    const auto start = std::chrono::steady_clock::now();
+    for (const Operation& operation : operations) {
+        checksum += CountOverlaps(table, images, picked, found, operation.addr, operation.size);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ImagePageTable[Consistency]", "[video_core]") {
+    const auto [images, operations] = MakeTrace(2048, 20000);
+    FlatTable flat;
+    HashTable hash;
+    Register(flat, images);
+    Register(hash, images);
+    REQUIRE(flat.Find(0) == nullptr);
+    REQUIRE(flat.Find(u64{1} << 40) == nullptr);
+
+    std::vector<bool> picked(images.size());
+    std::vector<u32> found;
+    for (const Operation& operation : operations) {
+        const size_t flat_count =
+            CountOverlaps(flat, images, picked, found, operation.addr, operation.size);
+        const size_t hash_count =
+            CountOverlaps(hash, images, picked, found, operation.addr, operation.size);
+        REQUIRE(flat_count == hash_count);
+    }
+
+    // Unregister every other image and check the pages were cleared the same way
+    for (u32 id = 0; id < images.size(); id += 2) {
+        const u64 page_end = (images[id].addr + images[id].size - 1) >> PAGE_BITS;
+        for (u64 page = images[id].addr >> PAGE_BITS; page <= page_end; ++page) {
+            auto& flat_ids = *flat.Find(page);
+            flat_ids.erase(std::ranges::find(flat_ids, id));
+            auto& hash_ids = hash[page];
+            hash_ids.erase(std::ranges::find(hash_ids, id));
+        }
+    }
+    for (const Image& image : images) {
+        REQUIRE(CountOverlaps(flat, images, picked, found, image.addr, image.size) ==
+                CountOverlaps(hash, images, picked, found, image.addr, image.size));
+    }
+}
+
+TEST_CASE("ImagePageTable[ReplayThroughput]", "[video_core][.benchmark]") {
+    const auto [images, operations] = MakeTrace(4096, 2'000'000);
+    FlatTable flat;
+    HashTable hash;
+    Register(flat, images);
+    Register(hash, images);
+
+    size_t flat_checksum = 0;
+    size_t hash_checksum = 0;
+    const double flat_time = Replay(flat, images, operations, flat_checksum);
+    const double hash_time = Replay(hash, images, operations, hash_checksum);
+    REQUIRE(flat_checksum == hash_checksum);
+
+    std::printf("ImagePageTable: replayed %zu lookups, flat %.0f ops/s, unordered_map %.0f ops/s "
+                "(%.2fx)\n",
+                operations.size(), operations.size() / flat_time, operations.size() / hash_time,
+                hash_time / flat_time);
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/macro/macro_disk_cache.h"
+#include "video_core/macro/macro_ir.h"
+
+namespace {
+
+using namespace Tegra::Macro;
+
+constexpr u64 HASH = 0x1234;
+
+/// Function sending its first parameter to a method
+IR::Function MakeFunction(u32 method) {
+    IR::Function function;
+    function.insts.push_back({.opcode = IR::Opcode::Const, .imm = method});
+    function.insts.push_back({.opcode = IR::Opcode::Parameter});
+    function.insts.push_back({.opcode = IR::Opcode::Send, .args = {0, 1, IR::INVALID_VALUE}});
+    // Constants are not placed in blocks
+    function.blocks.push_back({.insts = {1, 2}});
+    return function;
+}
+
+IR::Specialization MakeSpecialization(u32 parameter) {
+    return {.parameters = {parameter}, .guards = {}, .residual = MakeFunction(0x100)};
+}
+
+class CacheFile {
+public:
+    explicit CacheFile(const char* name) : path{std::filesystem::temp_directory_path() / name} {
+        std::filesystem::remove(path);
+    }
+
+    ~CacheFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    std::filesystem::path path;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("MacroDiskCache[RoundTrip]", "[video_core]") {
+    const CacheFile file{"eden_macro_disk_cache_round_trip.bin"};
+    const std::vector<u32> code{1, 2, 3};
+    const std::vector<u32> other_code{4, 5, 6};
+    {
+        DiskCache cache{file.path};
+        cache.StoreFunction(HASH, code, MakeFunction(0x100));
+        cache.StoreSpecialization(HASH, MakeSpecialization(7));
+        // Entries are visible before they are written
+        REQUIRE(cache.LoadFunction(HASH, code));
+        REQUIRE(cache.LoadSpecializations(HASH).size() == 1);
+    }
+    DiskCache cache{file.path};
+    const std::optional<IR::Function> function = cache.LoadFunction(HASH, code);
+    REQUIRE(function);
+    REQUIRE(function->insts.size() == 3);
+    REQUIRE(function->insts[0].imm == 0x100);
+    // Same hash, different code
+    REQUIRE(!cache.LoadFunction(HASH, other_code));
+
+    const std::vector<IR::Specialization> specializations = cache.LoadSpecializations(HASH);
+    REQUIRE(specializations.size() == 1);
+    REQUIRE(specializations[0].parameters == std::vector<u32>{7});
+    REQUIRE(cache.LoadSpecializations(HASH + 1).empty());
+}
+
+TEST_CASE("MacroDiskCache[SpecializationCap]", "[video_core]") {
+    const CacheFile file{"eden_macro_disk_cache_specialization_cap.bin"};
+    constexpr u32 NUM_STORED = DiskCache::MAX_SPECIALIZATIONS + 8;
+    {
+        DiskCache cache{file.path};
+        for (u32 i = 0; i < NUM_STORED; ++i) {
+            cache.StoreSpecialization(HASH, MakeSpecialization(i));
+        }
+        // Storing one again does not add a record
+        cache.StoreSpecialization(HASH, MakeSpecialization(NUM_STORED - 1));
+    }
+    // The dropped records are compacted away
+    std::vector<u8> payload;
+    IR::Serialize(MakeSpecialization(0), payload);
+    constexpr size_t FILE_HEADER_SIZE = 8;
+    constexpr size_t ENTRY_HEADER_SIZE = 16;
+    const size_t entry_size = ENTRY_HEADER_SIZE + payload.size();
+    REQUIRE(std::filesystem::file_size(file.path) ==
+            FILE_HEADER_SIZE + DiskCache::MAX_SPECIALIZATIONS * entry_size);
+
+    DiskCache cache{file.path};
+    const std::vector<IR::Specialization> specializations = cache.LoadSpecializations(HASH);
+    REQUIRE(specializations.size() == DiskCache::MAX_SPECIALIZATIONS);
+    // The oldest ones were dropped
+    for (size_t i = 0; i < specializations.size(); ++i) {
+        const u32 parameter = static_cast<u32>(NUM_STORED - DiskCache::MAX_SPECIALIZATIONS + i);
+        REQUIRE(specializations[i].parameters == std::vector<u32>{parameter});
+    }
+}
+
+TEST_CASE("MacroDiskCache[ReplacedFunction]", "[video_core]") {
+    const CacheFile file{"eden_macro_disk_cache_replaced_function.bin"};
+    const std::vector<u32> code{1, 2, 3};
+    const std::vector<u32> new_code{4, 5, 6};
+    {
+        DiskCache cache{file.path};
+        cache.StoreFunction(HASH, code, MakeFunction(0x100));
+    }
+    const auto single_size = std::filesystem::file_size(file.path);
+    {
+        DiskCache cache{file.path};
+        cache.StoreFunction(HASH, new_code, MakeFunction(0x200));
+    }
+    REQUIRE(std::filesystem::file_size(file.path) == single_size);
+
+    DiskCache cache{file.path};
+    REQUIRE(!cache.LoadFunction(HASH, code));
+    const std::optional<IR::Function> function = cache.LoadFunction(HASH, new_code);
+    REQUIRE(function);
+    REQUIRE(function->insts[0].imm == 0x200);
+}
@@ -0,0 +1,434 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <array>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_ir.h"
+#include "video_core/macro/macro_ir_executor.h"
+
+namespace {
+
+using namespace Tegra::Macro;
+
+constexpr size_t NUM_FAKE_REGISTERS = 0x1000;
+
+/// Register file that records every method call
+class FakeEnvironment final : public IR::Environment {
+public:
+    explicit FakeEnvironment(u32 seed) {
+        std::mt19937 rng{seed};
+        for (u32& reg : registers) {
+            reg = rng() % 4 == 0 ? 0 : rng();
+        }
+    }
+
+    u32 ReadRegister(u32 method) override {
+        return registers[method % NUM_FAKE_REGISTERS];
+    }
+
+    void CallMethod(u32 method, u32 argument) override {
+        registers[method % NUM_FAKE_REGISTERS] = argument;
+        calls.emplace_back(method, argument);
+    }
+
+    void CallMultiMethod(u32 method, std::span<const u32> arguments) override {
+        for (const u32 argument : arguments) {
+            CallMethod(method, argument);
+        }
+    }
+
+    std::array<u32, NUM_FAKE_REGISTERS> registers{};
+    std::vector<std::pair<u32, u32>> calls;
+};
+
+/// Straightforward macro interpreter the IR is checked against
+class ReferenceInterpreter {
+public:
+    /// Returns false when the macro did not finish within the step budget
+    bool Run(std::span<const u32> code_, std::span<const u32> parameters_, IR::Environment& env_) {
+        code = code_;
+        parameters = parameters_;
+        env = &env_;
+        registers = {};
+        registers[1] = Fetch();
+        for (size_t steps = 0; steps < 100000; ++steps) {
+            if (!Step(false)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    u32 Fetch() {
+        return next_parameter < parameters.size() ? parameters[next_parameter++] : 0;
+    }
+
+    bool Step(bool is_delay_slot) {
+        const u32 base = pc;
+        const Opcode opcode{code[pc]};
+        ++pc;
+        if (delayed_pc) {
+            pc = *delayed_pc;
+            delayed_pc.reset();
+        }
+        const auto reg = [&](u32 index) { return registers[index]; };
+        switch (opcode.operation) {
+        case Operation::ALU:
+            Result(opcode, Alu(opcode.alu_operation, reg(opcode.src_a), reg(opcode.src_b)));
+            break;
+        case Operation::AddImmediate:
+            Result(opcode, reg(opcode.src_a) + opcode.immediate);
+            break;
+        case Operation::ExtractInsert: {
+            const u32 src = (reg(opcode.src_b) >> opcode.bf_src_bit) & opcode.GetBitfieldMask();
+            u32 dst = reg(opcode.src_a) & ~(opcode.GetBitfieldMask() << opcode.bf_dst_bit);
+            Result(opcode, dst | (src << opcode.bf_dst_bit));
+            break;
+        }
+        case Operation::ExtractShiftLeftImmediate:
+            Result(opcode, ((reg(opcode.src_b) >> (reg(opcode.src_a) & 31)) & opcode.GetBitfieldMask())
+                               << opcode.bf_dst_bit);
+            break;
+        case Operation::ExtractShiftLeftRegister:
+            Result(opcode,
+                   ((reg(opcode.src_b) >> opcode.bf_src_bit) & opcode.GetBitfieldMask())
+                       << (reg(opcode.src_a) & 31));
+            break;
+        case Operation::Read:
+            Result(opcode, env->ReadRegister(reg(opcode.src_a) + opcode.immediate));
+            break;
+        case Operation::Branch: {
+            const bool is_zero = reg(opcode.src_a) == 0;
+            if (is_zero == (opcode.branch_condition == BranchCondition::Zero)) {
+                if (opcode.branch_annul) {
+                    pc = base + opcode.immediate;
+                    return true;
+                }
+                delayed_pc = base + opcode.immediate;
+                return Step(true);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        if (opcode.is_exit && !is_delay_slot) {
+            Step(true);
+            return false;
+        }
+        return true;
+    }
+
+    u32 Alu(ALUOperation operation, u32 a, u32 b) {
+        switch (operation) {
+        case ALUOperation::Add:
+        case ALUOperation::AddWithCarry: {
+            const u64 result =
+                u64{a} + b + (operation == ALUOperation::AddWithCarry && carry ? 1 : 0);
+            carry = result > 0xffffffff;
+            return static_cast<u32>(result);
+        }
+        case ALUOperation::Subtract:
+        case ALUOperation::SubtractWithBorrow: {
+            const u64 borrow = operation == ALUOperation::SubtractWithBorrow && !carry ? 1 : 0;
+            const u64 result = u64{a} - b - borrow;
+            carry = result < 0x100000000;
+            return static_cast<u32>(result);
+        }
+        case ALUOperation::Xor:
+            return a ^ b;
+        case ALUOperation::Or:
+            return a | b;
+        case ALUOperation::And:
+            return a & b;
+        case ALUOperation::AndNot:
+            return a & ~b;
+        case ALUOperation::Nand:
+            return ~(a & b);
+        default:
+            return 0;
+        }
+    }
+
+    void Result(Opcode opcode, u32 result) {
+        const auto set = [&](u32 value) {
+            if (opcode.dst != 0) {
+                registers[opcode.dst] = value;
+            }
+        };
+        switch (opcode.result_operation) {
+        case ResultOperation::IgnoreAndFetch:
+            set(Fetch());
+            break;
+        case ResultOperation::Move:
+            set(result);
+            break;
+        case ResultOperation::MoveAndSetMethod:
+            set(result);
+            method.raw = result;
+            break;
+        case ResultOperation::FetchAndSend:
+            set(Fetch());
+            Send(result);
+            break;
+        case ResultOperation::MoveAndSend:
+            set(result);
+            Send(result);
+            break;
+        case ResultOperation::FetchAndSetMethod:
+            set(Fetch());
+            method.raw = result;
+            break;
+        case ResultOperation::MoveAndSetMethodFetchAndSend:
+            set(result);
+            method.raw = result;
+            Send(Fetch());
+            break;
+        case ResultOperation::MoveAndSetMethodSend:
+            set(result);
+            method.raw = result;
+            Send((result >> 12) & 0x3f);
+            break;
+        }
+    }
+
+    void Send(u32 value) {
+        env->CallMethod(method.address, value);
+        method.address.Assign(method.address + method.increment);
+    }
+
+    std::span<const u32> code;
+    std::span<const u32> parameters;
+    IR::Environment* env{};
+    std::array<u32, NUM_MACRO_REGISTERS> registers{};
+    u32 pc{};
+    std::optional<u32> delayed_pc;
+    size_t next_parameter{};
+    MethodAddress method{};
+    bool carry{};
+};
+
+u32 AddImmediate(ResultOperation result, u32 dst, u32 src, s32 imm, bool is_exit = false) {
+    Opcode opcode{};
+    opcode.operation.Assign(Operation::AddImmediate);
+    opcode.result_operation.Assign(result);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src);
+    opcode.immediate.Assign(imm);
+    opcode.is_exit.Assign(is_exit ? 1 : 0);
+    return opcode.raw;
+}
+
+u32 ReadRegister(u32 dst, u32 src, s32 imm) {
+    Opcode opcode{};
+    opcode.operation.Assign(Operation::Read);
+    opcode.result_operation.Assign(ResultOperation::Move);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src);
+    opcode.immediate.Assign(imm);
+    return opcode.raw;
+}
+
+u32 Branch(BranchCondition condition, bool annul, u32 src, s32 offset) {
+    Opcode opcode{};
+    opcode.operation.Assign(Operation::Branch);
+    opcode.branch_condition.Assign(condition);
+    opcode.branch_annul.Assign(annul ? 1 : 0);
+    opcode.src_a.Assign(src);
+    opcode.immediate.Assign(offset);
+    return opcode.raw;
+}
+
+/// Generates terminating macros, branches only go forward and never into delay slots
+std::vector<u32> RandomMacro(std::mt19937& rng) {
+    constexpr std::array alu_operations{
+        ALUOperation::Add, ALUOperation::AddWithCarry, ALUOperation::Subtract,
+        ALUOperation::SubtractWithBorrow, ALUOperation::Xor, ALUOperation::Or,
+        ALUOperation::And, ALUOperation::AndNot, ALUOperation::Nand,
+    };
+    const size_t size = 4 + rng() % 28;
+    std::vector<u32> code(size);
+    bool previous_needs_slot = false;
+    for (size_t pc = 0; pc < size; ++pc) {
+        Opcode opcode{static_cast<u32>(rng())};
+        const bool is_last = pc + 2 >= size;
+        const bool can_branch = !previous_needs_slot && !is_last;
+        u32 operation = rng() % 7;
+        if (operation == 6) {
+            operation = can_branch ? 7 : 1;
+        }
+        opcode.operation.Assign(static_cast<Operation>(operation));
+        opcode.is_exit.Assign(pc + 2 == size || (!is_last && rng() % 16 == 0) ? 1 : 0);
+        switch (opcode.operation) {
+        case Operation::ALU:
+            opcode.alu_operation.Assign(alu_operations[rng() % alu_operations.size()]);
+            break;
+        case Operation::AddImmediate:
+            opcode.immediate.Assign(static_cast<s32>(rng() % 0x2000) - 0x1000);
+            break;
+        case Operation::Read:
+            opcode.immediate.Assign(static_cast<s32>(rng() % 0x80));
+            break;
+        case Operation::Branch:
+            opcode.immediate.Assign(static_cast<s32>(1 + rng() % (size - 2 - pc)));
+            break;
+        default:
+            break;
+        }
+        if (pc + 1 == size) {
+            opcode.is_exit.Assign(0);
+        }
+        previous_needs_slot = opcode.operation == Operation::Branch || opcode.is_exit != 0;
+        code[pc] = opcode.raw;
+    }
+    return code;
+}
+
+std::vector<u32> RandomParameters(std::mt19937& rng) {
+    std::vector<u32> parameters(1 + rng() % 8);
+    for (u32& parameter : parameters) {
+        parameter = rng() % 3 == 0 ? rng() % 4 : rng();
+    }
+    return parameters;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MacroIR[Random]", "[video_core]") {
+    std::mt19937 rng{0x6d616372};
+    size_t num_lowered = 0;
+    size_t num_specialized = 0;
+    for (u32 iteration = 0; iteration < 2000; ++iteration) {
+        const std::vector<u32> code = RandomMacro(rng);
+        const std::vector<u32> parameters = RandomParameters(rng);
+        const u32 seed = rng();
+
+        FakeEnvironment reference_env{seed};
+        ReferenceInterpreter reference;
+        REQUIRE(reference.Run(code, parameters, reference_env));
+
+        std::optional<IR::Function> function = IR::Lower(code);
+        REQUIRE(function);
+        REQUIRE(IR::Validate(*function));
+        IR::Optimize(*function);
+        IR::BatchSends(*function);
+        REQUIRE(IR::Validate(*function));
+        ++num_lowered;
+
+        FakeEnvironment ir_env{seed};
+        IR::Program{*function}.Execute(ir_env, parameters);
+        REQUIRE(ir_env.calls == reference_env.calls);
+
+        std::vector<u8> serialized;
+        IR::Serialize(*function, serialized);
+        std::span<const u8> input{serialized};
+        const std::optional<IR::Function> loaded = IR::DeserializeFunction(input);
+        REQUIRE(loaded);
+        REQUIRE(input.empty());
+        FakeEnvironment loaded_env{seed};
+        IR::Program{*loaded}.Execute(loaded_env, parameters);
+        REQUIRE(loaded_env.calls == reference_env.calls);
+
+        FakeEnvironment trace_env{seed};
+        const std::optional<IR::Specialization> specialization =
+            IR::Trace(*function, trace_env, parameters);
+        REQUIRE(trace_env.calls == reference_env.calls);
+        if (!specialization) {
+            continue;
+        }
+        ++num_specialized;
+        FakeEnvironment replay_env{seed};
+        for (const auto& [reg, value] : specialization->guards) {
+            REQUIRE(replay_env.ReadRegister(reg) == value);
+        }
+        REQUIRE(specialization->residual.blocks.size() == 1);
+        IR::Program{specialization->residual}.Execute(replay_env, parameters);
+        REQUIRE(replay_env.calls == reference_env.calls);
+    }
+    REQUIRE(num_specialized > num_lowered / 2);
+}
+
+TEST_CASE("MacroIR[Specialization]", "[video_core]") {
+    // Sends r1 parameters to method 0x100
+    const std::vector<u32> code{
+        AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, 0x100),
+        AddImmediate(ResultOperation::Move, 2, 1, 0),
+        Branch(BranchCondition::Zero, true, 2, 5),
+        AddImmediate(ResultOperation::IgnoreAndFetch, 3, 0, 0),
+        AddImmediate(ResultOperation::MoveAndSend, 0, 3, 0),
+        AddImmediate(ResultOperation::Move, 2, 2, -1),
+        Branch(BranchCondition::NotZero, true, 2, -3),
+        AddImmediate(ResultOperation::Move, 0, 0, 0, true),
+        AddImmediate(ResultOperation::Move, 0, 0, 0),
+    };
+    std::optional<IR::Function> function = IR::Lower(code);
+    REQUIRE(function);
+    IR::Optimize(*function);
+
+    const std::vector<u32> parameters{3, 10, 20, 30};
+    FakeEnvironment reference_env{1};
+    REQUIRE(ReferenceInterpreter{}.Run(code, parameters, reference_env));
+    FakeEnvironment program_env{1};
+    IR::Program{*function}.Execute(program_env, parameters);
+    REQUIRE(program_env.calls == reference_env.calls);
+
+    FakeEnvironment env{1};
+    const std::optional<IR::Specialization> specialization =
+        IR::Trace(*function, env, parameters);
+    REQUIRE(specialization);
+    REQUIRE(specialization->guards.empty());
+    REQUIRE(env.calls == reference_env.calls);
+
+    // The loop is unrolled and its sends merged into a single batch
+    const IR::Function& residual = specialization->residual;
+    REQUIRE(residual.blocks.size() == 1);
+    REQUIRE(residual.blocks[0].insts.size() == 1);
+    const IR::Inst& batch = residual.insts[residual.blocks[0].insts[0]];
+    REQUIRE(batch.opcode == IR::Opcode::SendBatch);
+    REQUIRE(batch.imm == 0x100);
+    REQUIRE(batch.list == std::vector<u32>{10, 20, 30});
+
+    std::vector<u8> serialized;
+    IR::Serialize(*specialization, serialized);
+    std::span<const u8> input{serialized};
+    const std::optional<IR::Specialization> loaded = IR::DeserializeSpecialization(input);
+    REQUIRE(loaded);
+    REQUIRE(loaded->parameters == parameters);
+    REQUIRE(loaded->residual.insts.size() == residual.insts.size());
+}
+
+TEST_CASE("MacroIR[Guards]", "[video_core]") {
+    // Sends the first parameter to method 0x200 when register 0x40 is zero, to 0x201 otherwise
+    const std::vector<u32> code{
+        ReadRegister(2, 0, 0x40),
+        Branch(BranchCondition::Zero, true, 2, 3),
+        AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, 0x201),
+        Branch(BranchCondition::Zero, true, 0, 2),
+        AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, 0x200),
+        AddImmediate(ResultOperation::MoveAndSend, 0, 1, 0, true),
+        AddImmediate(ResultOperation::Move, 0, 0, 0),
+    };
+    std::optional<IR::Function> function = IR::Lower(code);
+    REQUIRE(function);
+    IR::Optimize(*function);
+
+    FakeEnvironment env{2};
+    env.registers[0x40] = 0;
+    const std::optional<IR::Specialization> specialization = IR::Trace(*function, env, {{7}});
+    REQUIRE(specialization);
+    REQUIRE(specialization->guards == std::vector<std::pair<u32, u32>>{{0x40, 0}});
+    REQUIRE(env.calls == std::vector<std::pair<u32, u32>>{{0x200, 7}});
+
+    // Macros that can not be lowered are left to the other backends
+    REQUIRE(!IR::Lower(std::vector<u32>{Branch(BranchCondition::Zero, true, 0, 4)}));
+    REQUIRE(!IR::Lower(std::vector<u32>{}));
+}
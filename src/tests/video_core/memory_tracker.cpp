@@ -1,9 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <chrono>
+#include <cstdio>
 #include <memory>
+#include <random>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -544,3 +548,77 @@ TEST_CASE("MemoryTracker: Cached write downloads") {
     memory_track->MarkRegionAsCpuModified(c, WORD);
     REQUIRE(rasterizer.Count() == 0);
 }
+
+TEST_CASE("MemoryTracker: Random region queries", "[video_core]") {
+    constexpr u64 NUM_PAGES = 4 * HIGH_PAGE_SIZE / PAGE;
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, NUM_PAGES * PAGE);
+    std::vector<bool> cpu_pages(NUM_PAGES);
+    std::vector<bool> gpu_pages(NUM_PAGES);
+    std::mt19937_64 rng{0x5ca9};
+    for (int i = 0; i < 64; ++i) {
+        const u64 page = rng() % NUM_PAGES;
+        if (i % 2 == 0) {
+            memory_track->MarkRegionAsCpuModified(c + page * PAGE, PAGE);
+            cpu_pages[page] = true;
+        } else {
+            memory_track->MarkRegionAsGpuModified(c + page * PAGE, PAGE);
+            gpu_pages[page] = true;
+        }
+    }
+    const auto any_page = [](const std::vector<bool>& pages, u64 first, u64 last) {
+        for (u64 page = first; page < last; ++page) {
+            if (pages[page]) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (int i = 0; i < 4096; ++i) {
+        const u64 addr = rng() % (NUM_PAGES * PAGE);
+        const u64 size = 1 + rng() % (NUM_PAGES * PAGE - addr);
+        const u64 first = addr / PAGE;
+        const u64 last = (addr + size + PAGE - 1) / PAGE;
+        REQUIRE(memory_track->IsRegionCpuModified(c + addr, size) ==
+                any_page(cpu_pages, first, last));
+        REQUIRE(memory_track->IsRegionGpuModified(c + addr, size) ==
+                any_page(gpu_pages, first, last));
+    }
+}
+
+TEST_CASE("MemoryTracker: Scan throughput", "[video_core][.benchmark]") {
+    // Streaming pools are large and mostly clean, so most queries scan words without finding bits
+    constexpr u64 POOL_SIZE = 256ULL << 20;
+    constexpr int ITERATIONS = 20000;
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, POOL_SIZE);
+    memory_track->MarkRegionAsGpuModified(c + POOL_SIZE - PAGE, PAGE);
+
+    const auto measure = [&](const char* name, auto&& func) {
+        size_t found = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            found += func() ? 1 : 0;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("MemoryTracker: %s over 256 MiB, %.2f us per query\n", name,
+                    elapsed.count() * 1e6 / ITERATIONS);
+        return found;
+    };
+    REQUIRE(measure("IsRegionCpuModified", [&] {
+                return memory_track->IsRegionCpuModified(c, POOL_SIZE);
+            }) == 0);
+    REQUIRE(measure("IsRegionGpuModified", [&] {
+                return memory_track->IsRegionGpuModified(c, POOL_SIZE);
+            }) == ITERATIONS);
+    REQUIRE(measure("ForEachUploadRange", [&] {
+                bool any = false;
+                memory_track->ForEachUploadRange(c, POOL_SIZE, [&](u64, u64) { any = true; });
+                return any;
+            }) == 0);
+    REQUIRE(measure("ModifiedGpuRegion", [&] {
+                return memory_track->ModifiedGpuRegion(c, POOL_SIZE).first != 0;
+            }) == ITERATIONS);
+}
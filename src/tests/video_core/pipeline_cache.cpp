@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/shader_environment.h"
+
+namespace {
+
+using VideoCommon::GenericEnvironment;
+using VideoCommon::PipelineCacheEntry;
+using VideoCommon::PipelineCacheReader;
+
+constexpr u32 CACHE_VERSION = 7;
+
+/// Environment holding a fixed program, standing in for the ones read from guest memory
+class TestEnvironment final : public GenericEnvironment {
+public:
+    explicit TestEnvironment(Shader::Stage stage_, std::vector<u64> code_) {
+        stage = stage_;
+        start_address = 0x30;
+        code = std::move(code_);
+        cached_lowest = 0;
+        cached_highest = static_cast<u32>((code.size() - 1) * sizeof(u64));
+    }
+
+    u32 ReadCbufValue(u32, u32) override {
+        return 0;
+    }
+
+    Shader::TextureType ReadTextureType(u32) override {
+        return Shader::TextureType::Color2D;
+    }
+
+    Shader::TexturePixelFormat ReadTexturePixelFormat(u32) override {
+        return Shader::TexturePixelFormat::A8B8G8R8_UNORM;
+    }
+
+    bool IsTexturePixelFormatInteger(u32) override {
+        return false;
+    }
+
+    u32 ReadViewportTransformState() override {
+        return 1;
+    }
+
+    std::optional<Shader::ReplaceConstant> GetReplaceConstBuffer(u32, u32) override {
+        return std::nullopt;
+    }
+};
+
+struct Key {
+    u64 hash;
+    u64 salt;
+};
+
+class CacheFile {
+public:
+    explicit CacheFile(const char* name) : path{std::filesystem::temp_directory_path() / name} {
+        std::filesystem::remove(path);
+    }
+
+    ~CacheFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    void Append(const Key& key, u64 first_use, PipelineCacheReader* reader = nullptr) const {
+        const TestEnvironment env{Shader::Stage::Compute, {key.hash, key.salt, ~key.hash}};
+        VideoCommon::SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env},
+                                       first_use, path, CACHE_VERSION, reader);
+    }
+
+    std::unique_ptr<PipelineCacheReader> Open() const {
+        return std::make_unique<PipelineCacheReader>(path, CACHE_VERSION);
+    }
+
+    u64 Size() const {
+        return std::filesystem::file_size(path);
+    }
+
+    std::vector<char> Read() const {
+        std::ifstream file{path, std::ios::binary};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    void Write(const std::vector<char>& data) const {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    std::filesystem::path path;
+};
+
+std::span<const char> KeySpan(const Key& key) {
+    return {reinterpret_cast<const char*>(&key), sizeof(key)};
+}
+
+} // Anonymous namespace
+
+TEST_CASE("PipelineCache[RoundTrip]", "[video_core]") {
+    const CacheFile cache{"eden_pipeline_cache_round_trip.bin"};
+    cache.Append({1, 2}, 10);
+    cache.Append({3, 4}, 20);
+
+    const auto reader{cache.Open()};
+    REQUIRE(reader->IsOpen());
+    REQUIRE(reader->Entries().size() == 2);
+    REQUIRE(reader->Find(Key{5, 6}) == nullptr);
+
+    const PipelineCacheEntry* const entry{reader->Find(Key{3, 4})};
+    REQUIRE(entry != nullptr);
+    REQUIRE(entry->first_use == 20);
+    REQUIRE(entry->is_compute);
+    REQUIRE(entry->num_envs == 1);
+    REQUIRE(std::ranges::equal(entry->key, KeySpan({3, 4})));
+
+    std::vector<VideoCommon::FileEnvironment> envs{reader->ReadEnvironments(*entry)};
+    REQUIRE(envs.size() == 1);
+    REQUIRE(envs[0].ShaderStage() == Shader::Stage::Compute);
+    REQUIRE(envs[0].StartAddress() == 0x30);
+    REQUIRE(envs[0].ReadInstruction(0) == 3);
+    REQUIRE(envs[0].ReadInstruction(8) == 4);
+    REQUIRE(envs[0].ReadInstruction(16) == ~u64{3});
+}
+
+TEST_CASE("PipelineCache[SkipsStoredKeys]", "[video_core]") {
+    const CacheFile cache{"eden_pipeline_cache_skips_stored_keys.bin"};
+    cache.Append({1, 2}, 10);
+    const u64 size{cache.Size()};
+    {
+        const auto reader{cache.Open()};
+        reader->UpdateIndex();
+        const u64 indexed_size{cache.Size()};
+        REQUIRE(indexed_size > size);
+
+        cache.Append({1, 2}, 30, reader.get());
+        REQUIRE(cache.Size() == indexed_size);
+
+        cache.Append({3, 4}, 30, reader.get());
+        REQUIRE(cache.Size() > indexed_size);
+    }
+    REQUIRE(cache.Open()->Entries().size() == 2);
+}
+
+TEST_CASE("PipelineCache[InvalidatedReader]", "[video_core]") {
+    const CacheFile cache{"eden_pipeline_cache_invalidated_reader.bin"};
+    cache.Append({1, 2}, 10);
+    {
+        const auto reader{cache.Open()};
+        reader->Invalidate();
+        const u64 size{cache.Size()};
+        cache.Append({3, 4}, 20, reader.get());
+        REQUIRE(cache.Size() == size);
+        REQUIRE(std::filesystem::exists(cache.path));
+    }
+    // The file is deleted once unmapped
+    REQUIRE(!std::filesystem::exists(cache.path));
+}
+
+TEST_CASE("PipelineCache[UnindexedTail]", "[video_core]") {
+    const CacheFile cache{"eden_pipeline_cache_unindexed_tail.bin"};
+    for (u64 i = 0; i < 8; ++i) {
+        cache.Append({i, i}, i);
+    }
+    const auto reader{cache.Open()};
+    REQUIRE(reader->Entries().size() == 8);
+    for (u64 i = 0; i < 8; ++i) {
+        const PipelineCacheEntry* const entry{reader->Find(Key{i, i})};
+        REQUIRE(entry != nullptr);
+        REQUIRE(entry->first_use == i);
+    }
+}
+
+TEST_CASE("PipelineCache[StaleIndex]", "[video_core]") {
+    const CacheFile cache{"eden_pipeline_cache_stale_index.bin"};
+    cache.Append({1, 1}, 1);
+    cache.Append({2, 2}, 2);
+    cache.Open()->UpdateIndex();
+
+    // The index is current, nothing has to be written
+    const u64 indexed_size{cache.Size()};
+    cache.Open()->UpdateIndex();
+    REQUIRE(cache.Size() == indexed_size);
+
+    // Pipelines appended after the index are walked and the index is rebuilt over all of them
+    cache.Append({3, 3}, 3);
+    const u64 appended_size{cache.Size()};
+    {
+        const auto reader{cache.Open()};
+        REQUIRE(reader->Entries().size() == 3);
+        reader->UpdateIndex();
+    }
+    const u64 reindexed_size{cache.Size()};
+    REQUIRE(reindexed_size > appended_size);
+
+    const auto reader{cache.Open()};
+    REQUIRE(reader->Entries().size() == 3);
+    REQUIRE(reader->Find(Key{3, 3}) != nullptr);
+    reader->UpdateIndex();
+    REQUIRE(cache.Size() == reindexed_size);
+}
+
+TEST_CASE("PipelineCache[TruncatedRecord]", "[video_core]") {
+    const CacheFile cache{"eden_pipeline_cache_truncated_record.bin"};
+    cache.Append({1, 1}, 1);
+    cache.Append({2, 2}, 2);
+    cache.Append({3, 3}, 3);
+    std::vector<char> data{cache.Read()};
+    data.resize(data.size() - 5);
+    cache.Write(data);
+    {
+        const auto reader{cache.Open()};
+        REQUIRE(reader->Entries().size() == 2);
+        REQUIRE(reader->Find(Key{3, 3}) == nullptr);
+        // The index is written past the torn record
+        reader->UpdateIndex();
+    }
+    cache.Append({4, 4}, 4);
+
+    const auto reader{cache.Open()};
+    REQUIRE(reader->Entries().size() == 3);
+    REQUIRE(reader->Find(Key{2, 2}) != nullptr);
+    REQUIRE(reader->Find(Key{4, 4}) != nullptr);
+}
+
+TEST_CASE("PipelineCache[KeyHashCollision]", "[video_core]") {
+    const CacheFile cache{"eden_pipeline_cache_key_hash_collision.bin"};
+    cache.Append({1, 1}, 1);
+    cache.Append({2, 2}, 2);
+
+    // Give the second record the key hash of the first one, its key stays different
+    u64 first_hash{};
+    u64 second_offset{};
+    {
+        const auto reader{cache.Open()};
+        REQUIRE(reader->Entries().size() == 2);
+        first_hash = reader->Entries()[0].key_hash;
+        second_offset = reader->Entries()[1].offset;
+    }
+    std::vector<char> data{cache.Read()};
+    std::memcpy(data.data() + second_offset, &first_hash, sizeof(first_hash));
+    cache.Write(data);
+
+    const auto check{[&] {
+        const auto reader{cache.Open()};
+        REQUIRE(reader->Entries().size() == 2);
+        REQUIRE(reader->Entries()[1].key_hash == first_hash);
+        const PipelineCacheEntry* const entry{reader->Find(Key{1, 1})};
+        REQUIRE(entry != nullptr);
+        REQUIRE(entry->first_use == 1);
+        REQUIRE(std::ranges::equal(entry->key, KeySpan({1, 1})));
+        reader->UpdateIndex();
+    }};
+    // Once from the unindexed tail, then from the index
+    check();
+    check();
+}
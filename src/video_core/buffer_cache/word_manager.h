@@ -9,6 +9,16 @@
 #include <span>
 #include <utility>
 
+#if defined(ARCHITECTURE_x86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 #include "common/alignment.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -227,6 +237,121 @@ public:
         }
     }
 
+    /**
+     * Returns true when any word has bits set, scanning several words at a time
+     *
+     * @param words   Words to scan
+     * @param exclude Bits to ignore on each word, only read when exclude_bits is true
+     * @param count   Number of words to scan
+     */
+    template <bool exclude_bits>
+    static bool AnyBitsSet(const u64* words, [[maybe_unused]] const u64* exclude,
+                           size_t count) noexcept {
+        size_t index = 0;
+#if defined(ARCHITECTURE_x86_64) && defined(__AVX2__)
+        for (; index + 4 <= count; index += 4) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + index));
+            if constexpr (exclude_bits) {
+                const __m256i excluded =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(exclude + index));
+                value = _mm256_andnot_si256(excluded, value);
+            }
+            if (!_mm256_testz_si256(value, value)) {
+                return true;
+            }
+        }
+#elif defined(ARCHITECTURE_x86_64) && defined(__SSE4_1__)
+        for (; index + 2 <= count; index += 2) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + index));
+            if constexpr (exclude_bits) {
+                const __m128i excluded =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(exclude + index));
+                value = _mm_andnot_si128(excluded, value);
+            }
+            if (!_mm_testz_si128(value, value)) {
+                return true;
+            }
+        }
+#elif defined(ARCHITECTURE_arm64) && defined(__ARM_NEON)
+        for (; index + 2 <= count; index += 2) {
+            uint64x2_t value = vld1q_u64(words + index);
+            if constexpr (exclude_bits) {
+                value = vbicq_u64(value, vld1q_u64(exclude + index));
+            }
+            if (vmaxvq_u32(vreinterpretq_u32_u64(value)) != 0) {
+                return true;
+            }
+        }
+#endif
+        for (; index < count; ++index) {
+            u64 value = words[index];
+            if constexpr (exclude_bits) {
+                value &= ~exclude[index];
+            }
+            if (value != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns true when any bit of the pages in a region is set
+     *
+     * @param state_words Words to query
+     * @param exclude     Bits to ignore on each word, only read when exclude_bits is true
+     * @param offset      Offset in bytes from the start of the buffer
+     * @param size        Size in bytes of the region to query
+     */
+    template <bool exclude_bits>
+    bool AnyBitsInRegion(std::span<const u64> state_words, std::span<const u64> exclude,
+                         size_t offset, size_t size) const noexcept {
+        const size_t start = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset), 0LL));
+        const size_t end = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset + size), 0LL));
+        if (start >= SizeBytes() || end <= start) {
+            return false;
+        }
+        const size_t first_page = start / BYTES_PER_PAGE;
+        const size_t end_page =
+            (std::min)(Common::DivCeil(end, BYTES_PER_PAGE), NumWords() * PAGES_PER_WORD);
+        const size_t first_word = first_page / PAGES_PER_WORD;
+        const size_t last_word = (end_page - 1) / PAGES_PER_WORD;
+        const u64 first_mask = ~u64{0} << (first_page % PAGES_PER_WORD);
+        const u64 last_mask = ~u64{0} >> (PAGES_PER_WORD - 1 - (end_page - 1) % PAGES_PER_WORD);
+        const auto word_bits = [&](size_t index, u64 mask) {
+            u64 value = state_words[index] & mask;
+            if constexpr (exclude_bits) {
+                value &= ~exclude[index];
+            }
+            return value != 0;
+        };
+        if (first_word == last_word) {
+            return word_bits(first_word, first_mask & last_mask);
+        }
+        if (word_bits(first_word, first_mask) || word_bits(last_word, last_mask)) {
+            return true;
+        }
+        const u64* const exclude_words = exclude_bits ? exclude.data() + first_word + 1 : nullptr;
+        return AnyBitsSet<exclude_bits>(state_words.data() + first_word + 1, exclude_words,
+                                        last_word - first_word - 1);
+    }
+
+    /// Returns true when iterating a region for the given state type could find or change bits
+    template <Type type, bool clear>
+    bool MayHaveBitsInRegion(size_t offset, size_t size) const noexcept {
+        const std::span<const u64> state_words = words.template Span<type>();
+        const std::span<const u64> untracked_words = words.template Span<Type::Untracked>();
+        if constexpr (type == Type::GPU) {
+            return AnyBitsInRegion<true>(state_words, untracked_words, offset, size);
+        } else if constexpr (clear && (type == Type::CPU || type == Type::CachedCPU)) {
+            // Clearing also stops tracking untracked pages, even when they are not modified
+            return AnyBitsInRegion<false>(state_words, {}, offset, size) ||
+                   AnyBitsInRegion<false>(untracked_words, {}, offset, size);
+        } else {
+            return AnyBitsInRegion<false>(state_words, {}, offset, size);
+        }
+    }
+
     template <typename Func>
     void IteratePages(u64 mask, Func&& func) const {
         size_t offset = 0;
@@ -290,10 +415,13 @@ public:
     void ForEachModifiedRange(VAddr query_cpu_range, s64 size, Func&& func) {
         static_assert(type != Type::Untracked);
 
+        const size_t offset = query_cpu_range - cpu_addr;
+        if (!MayHaveBitsInRegion<type, clear>(offset, size)) {
+            return;
+        }
         std::span<u64> state_words = words.template Span<type>();
         [[maybe_unused]] std::span<u64> untracked_words = words.template Span<Type::Untracked>();
         [[maybe_unused]] std::span<u64> cached_words = words.template Span<Type::CachedCPU>();
-        const size_t offset = query_cpu_range - cpu_addr;
         bool pending = false;
         size_t pending_offset{};
         size_t pending_pointer{};
@@ -351,23 +479,7 @@ public:
     template <Type type>
     [[nodiscard]] bool IsRegionModified(u64 offset, u64 size) const noexcept {
         static_assert(type != Type::Untracked);
-
-        const std::span<const u64> state_words = words.template Span<type>();
-        [[maybe_unused]] const std::span<const u64> untracked_words =
-            words.template Span<Type::Untracked>();
-        bool result = false;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
-            if constexpr (type == Type::GPU) {
-                mask &= ~untracked_words[index];
-            }
-            const u64 word = state_words[index] & mask;
-            if (word != 0) {
-                result = true;
-                return true;
-            }
-            return false;
-        });
-        return result;
+        return MayHaveBitsInRegion<type, false>(offset, size);
     }
 
     /**
@@ -379,6 +491,10 @@ public:
     template <Type type>
     [[nodiscard]] std::pair<u64, u64> ModifiedRegion(u64 offset, u64 size) const noexcept {
         static_assert(type != Type::Untracked);
+        static constexpr std::pair<u64, u64> EMPTY{0, 0};
+        if (!MayHaveBitsInRegion<type, false>(offset, size)) {
+            return EMPTY;
+        }
         const std::span<const u64> state_words = words.template Span<type>();
         [[maybe_unused]] const std::span<const u64> untracked_words =
             words.template Span<Type::Untracked>();
@@ -398,7 +514,6 @@ public:
             begin = (std::min)(begin, page_index + local_page_begin);
             end = page_index + local_page_end;
         });
-        static constexpr std::pair<u64, u64> EMPTY{0, 0};
         return begin < end ? std::make_pair(begin * BYTES_PER_PAGE, end * BYTES_PER_PAGE) : EMPTY;
     }
 
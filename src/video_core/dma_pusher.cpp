@@ -144,6 +144,19 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (!dma_increment_once) {
+                // Registers that don't trigger actions are written as a whole run
+                const u32 max_write = static_cast<u32>(
+                    std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
+                const u32 written = CallMethodRun(&command_header.argument, max_write);
+                if (written != 0) {
+                    dma_state.method += written;
+                    dma_state.method_count -= written;
+                    index += written;
+                    continue;
+                }
+                dma_state.is_last_call = dma_state.method_count <= 1;
+                CallMethod(command_header.argument);
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -232,6 +245,22 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+u32 DmaPusher::CallMethodRun(const u32* base_start, u32 num_methods) const {
+    if (dma_state.method < non_puller_methods) {
+        return 0;
+    }
+    auto subchannel = subchannels[dma_state.subchannel];
+    const auto& execution_mask = subchannel->execution_mask;
+    u32 amount = 0;
+    while (amount < num_methods && !execution_mask[dma_state.method + amount]) {
+        ++amount;
+    }
+    if (amount != 0) {
+        subchannel->CallMethodRun(dma_state.method, base_start, amount);
+    }
+    return amount;
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_) {
     rasterizer = rasterizer_;
     puller.BindRasterizer(rasterizer);
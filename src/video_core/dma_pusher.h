@@ -154,6 +154,7 @@ private:
 
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
+    u32 CallMethodRun(const u32* base_start, u32 num_methods) const;
 
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
@@ -30,6 +30,13 @@ public:
     virtual void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                                  u32 methods_pending) = 0;
 
+    /// Write consecutive registers, none of which are set in the execution mask.
+    virtual void CallMethodRun(u32 method, const u32* base_start, u32 amount) {
+        for (u32 i = 0; i < amount; i++) {
+            method_sink.emplace_back(method + i, base_start[i]);
+        }
+    }
+
     void ConsumeSink() {
         if (method_sink.empty()) {
             return;
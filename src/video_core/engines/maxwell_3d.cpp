@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include "common/assert.h"
@@ -22,17 +23,17 @@ namespace Tegra::Engines {
 /// First register id that is actually a Macro call.
 constexpr u32 MacroRegistersStart = 0xE00;
 
-Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_)
+Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_, u64 program_id)
     : draw_manager{std::make_unique<DrawManager>(this)}, system{system_},
-      memory_manager{memory_manager_}, macro_engine{GetMacroEngine(*this)}, upload_state{
-                                                                                memory_manager,
-                                                                                regs.upload} {
+      memory_manager{memory_manager_}, macro_engine{GetMacroEngine(*this, program_id)},
+      upload_state{memory_manager, regs.upload} {
     dirty.flags.flip();
     InitializeRegisterDefaults();
     execution_mask.reset();
     for (size_t i = 0; i < execution_mask.size(); i++) {
         execution_mask[i] = IsMethodExecutable(static_cast<u32>(i));
     }
+    UpdateMethodClasses();
 }
 
 Maxwell3D::~Maxwell3D() = default;
@@ -126,6 +127,19 @@ void Maxwell3D::InitializeRegisterDefaults() {
     shadow_state = regs;
 }
 
+void Maxwell3D::UpdateMethodClasses() {
+    for (u32 method = 0; method < Regs::NUM_REGS; ++method) {
+        if (execution_mask[method]) {
+            method_classes[method] = MethodClass::Execute;
+        } else if (std::ranges::any_of(dirty.tables,
+                                       [method](const auto& table) { return table[method] != 0; })) {
+            method_classes[method] = MethodClass::Dirty;
+        } else {
+            method_classes[method] = MethodClass::Store;
+        }
+    }
+}
+
 bool Maxwell3D::IsMethodExecutable(u32 method) {
     if (method >= MacroRegistersStart) {
         return true;
@@ -326,6 +340,28 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
 }
 
+void Maxwell3D::ProcessRepeatedRegister(u32 method, const u32* base_start, u32 amount) {
+    // Only the last write is kept, but any write that changed the value makes it dirty
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        shadow_state.reg_array[method] = base_start[amount - 1];
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        ProcessDirtyRegisters(method, shadow_state.reg_array[method]);
+        return;
+    }
+    bool changed = regs.reg_array[method] != base_start[0];
+    for (u32 i = 1; i < amount; i++) {
+        changed |= base_start[i] != base_start[i - 1];
+    }
+    regs.reg_array[method] = base_start[amount - 1];
+    if (changed && method_classes[method] != MethodClass::Store) {
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method]] = true;
+        }
+    }
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -465,6 +501,10 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
         return;
     }
     default:
+        if (!execution_mask[method]) {
+            ProcessRepeatedRegister(method, base_start, amount);
+            break;
+        }
         for (u32 i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - i <= 1);
         }
@@ -472,6 +512,50 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::CallMethodRun(u32 method, const u32* base_start, u32 amount) {
+    ASSERT_MSG(method + amount <= Regs::NUM_REGS,
+               "Invalid Maxwell3D register, increase the size of the Regs structure");
+    ConsumeSink();
+
+    const u32* arguments = base_start;
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], base_start, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        arguments = &shadow_state.reg_array[method];
+    }
+    u32* const registers = &regs.reg_array[method];
+    if (std::memcmp(registers, arguments, amount * sizeof(u32)) == 0) {
+        // Redundant state changes are common, nothing to do for them
+        return;
+    }
+    // Process the run in spans of registers of the same class, spans without dirty flags are
+    // copied as a whole
+    for (u32 begin = 0; begin < amount;) {
+        const MethodClass method_class = method_classes[method + begin];
+        u32 end = begin + 1;
+        while (end < amount && method_classes[method + end] == method_class) {
+            ++end;
+        }
+        if (method_class == MethodClass::Store) {
+            std::memcpy(registers + begin, arguments + begin, (end - begin) * sizeof(u32));
+            begin = end;
+            continue;
+        }
+        for (u32 i = begin; i < end; i++) {
+            if (registers[i] == arguments[i]) {
+                continue;
+            }
+            registers[i] = arguments[i];
+            for (const auto& table : dirty.tables) {
+                dirty.flags[table[method + i]] = true;
+            }
+        }
+        begin = end;
+    }
+}
+
 void Maxwell3D::ProcessMacroUpload(u32 data) {
     macro_engine->AddCode(regs.load_mme.instruction_ptr++, data);
 }
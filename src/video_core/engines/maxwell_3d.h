@@ -53,7 +53,7 @@ class DrawManager;
 
 class Maxwell3D final : public EngineInterface {
 public:
-    explicit Maxwell3D(Core::System& system, MemoryManager& memory_manager);
+    explicit Maxwell3D(Core::System& system, MemoryManager& memory_manager, u64 program_id);
     ~Maxwell3D();
 
     /// Binds a rasterizer to this engine.
@@ -3078,6 +3078,12 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write consecutive registers that do not trigger any action.
+    void CallMethodRun(u32 method, const u32* base_start, u32 amount) override;
+
+    /// Reclassifies the registers, must be called after the dirty tables are changed.
+    void UpdateMethodClasses();
+
     bool ShouldExecute() const {
         return execute_on;
     }
@@ -3140,6 +3146,9 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    /// Writes a non-incrementing run of arguments to a register that does not trigger any action.
+    void ProcessRepeatedRegister(u32 method, const u32* base_start, u32 amount);
+
     void ConsumeSinkImpl() override;
 
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
@@ -3186,6 +3195,13 @@ private:
 
     bool IsMethodExecutable(u32 method);
 
+    /// How a write to a register has to be processed
+    enum class MethodClass : u8 {
+        Store,   ///< Only stored, no dirty flag is attached to it
+        Dirty,   ///< Stored, sets its dirty flags when the value changes
+        Execute, ///< Triggers an action
+    };
+
     Core::System& system;
     MemoryManager& memory_manager;
 
@@ -3194,6 +3210,8 @@ private:
     /// Start offsets of each macro in macro_memory
     std::array<u32, 0x80> macro_positions{};
 
+    std::array<MethodClass, Regs::NUM_REGS> method_classes{};
+
     /// Macro method that is currently being executed / being fed parameters.
     u32 executing_macro = 0;
     /// Parameters that have been submitted to the macro call so far.
@@ -73,10 +73,12 @@ struct GPU::Impl {
         to_init.Init(system, gpu, program_id);
         to_init.BindRasterizer(rasterizer);
         rasterizer->InitializeChannel(to_init);
+        gpu_thread.CaptureRecorder().RecordChannel(to_init);
     }
 
     void InitAddressSpace(Tegra::MemoryManager& memory_manager) {
         memory_manager.BindRasterizer(rasterizer);
+        gpu_thread.CaptureRecorder().RecordAddressSpace(memory_manager);
     }
 
     void ReleaseChannel(Control::ChannelState& to_release) {
@@ -98,8 +100,11 @@ struct GPU::Impl {
 
     /// Synchronizes CPU writes with Host GPU memory.
     void InvalidateGPUCache() {
-        std::function<void(PAddr, size_t)> callback_writes(
-            [this](PAddr address, size_t size) { rasterizer->OnCacheInvalidation(address, size); });
+        std::function<void(PAddr, size_t)> callback_writes([this](PAddr address, size_t size) {
+            // Captures drain writes made before a submission when pushing it, these came after
+            gpu_thread.CaptureRecorder().MarkDirty(address, size);
+            rasterizer->OnCacheInvalidation(address, size);
+        });
         system.GatherGPUDirtyMemory(callback_writes);
     }
 
@@ -281,6 +286,7 @@ struct GPU::Impl {
     }
 
     bool OnCPUWrite(DAddr addr, u64 size) {
+        gpu_thread.CaptureRecorder().MarkDirty(addr, size);
         return rasterizer->OnCPUWrite(addr, size);
     }
 
@@ -291,6 +297,7 @@ struct GPU::Impl {
 
     void RequestComposite(std::vector<Tegra::FramebufferConfig>&& layers,
                           std::vector<Service::Nvidia::NvFence>&& fences) {
+        gpu_thread.CaptureRecorder().RecordComposite(layers);
         size_t num_fences{fences.size()};
         size_t current_request_counter{};
         {
@@ -556,4 +563,8 @@ void GPU::FlushAndInvalidateRegion(DAddr addr, u64 size) {
     impl->FlushAndInvalidateRegion(addr, size);
 }
 
+VideoCommon::Capture::Recorder& GPU::CaptureRecorder() {
+    return impl->gpu_thread.CaptureRecorder();
+}
+
 } // namespace Tegra
@@ -24,6 +24,10 @@ class RendererBase;
 class ShaderNotify;
 } // namespace VideoCore
 
+namespace VideoCommon::Capture {
+class Recorder;
+}
+
 namespace Tegra {
 class DmaPusher;
 struct CommandList;
@@ -253,6 +257,9 @@ public:
     /// Notify rasterizer that any caches of the specified region should be flushed and invalidated
     void FlushAndInvalidateRegion(DAddr addr, u64 size);
 
+    /// Returns the recorder of GPU captures, active when dump_gpu_capture is enabled
+    [[nodiscard]] VideoCommon::Capture::Recorder& CaptureRecorder();
+
 private:
     struct Impl;
     mutable std::unique_ptr<Impl> impl;
@@ -0,0 +1,411 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include "common/common_funcs.h"
+#include "common/logging/log.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+
+namespace VideoCommon::Capture {
+
+namespace {
+
+constexpr u32 CAPTURE_MAGIC = Common::MakeMagic('E', 'G', 'P', 'C');
+constexpr u32 CAPTURE_VERSION = 1;
+
+/// Memory records are split so a corrupted size can not make the reader allocate too much
+constexpr u64 MAX_MEMORY_RECORD_SIZE = 64ULL << 20;
+
+/// More than the display compositor can present at once
+constexpr u64 MAX_COMPOSITE_LAYERS = 64;
+
+struct FileHeader {
+    u32 magic;
+    u32 version;
+};
+
+struct RecordHeader {
+    u32 type;
+    u32 reserved;
+    u64 payload_size;
+};
+
+struct SubmitListHeader {
+    s32 channel;
+    u32 num_command_lists;
+    u32 num_prefetch_commands;
+    u32 reserved;
+};
+
+template <typename T>
+constexpr bool IsTrivialRecord =
+    std::is_same_v<T, AddressSpaceRecord> || std::is_same_v<T, ChannelRecord> ||
+    std::is_same_v<T, MapRecord> || std::is_same_v<T, UnmapRecord> ||
+    std::is_same_v<T, FlushRegionRecord> || std::is_same_v<T, InvalidateRegionRecord>;
+
+template <typename T, size_t index = 0>
+constexpr size_t RecordIndex() {
+    if constexpr (std::is_same_v<std::variant_alternative_t<index, Record>, T>) {
+        return index;
+    } else {
+        return RecordIndex<T, index + 1>();
+    }
+}
+
+template <size_t index = 0>
+std::optional<Record> DefaultRecord(size_t type) {
+    if constexpr (index < std::variant_size_v<Record>) {
+        if (type == index) {
+            return Record{std::in_place_index<index>};
+        }
+        return DefaultRecord<index + 1>(type);
+    } else {
+        return std::nullopt;
+    }
+}
+
+} // Anonymous namespace
+
+bool Writer::Open(const std::filesystem::path& path) {
+    file.Open(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    if (!file.IsOpen()) {
+        return false;
+    }
+    return file.WriteObject(FileHeader{CAPTURE_MAGIC, CAPTURE_VERSION});
+}
+
+void Writer::Close() {
+    file.Close();
+}
+
+void Writer::WriteHeader(size_t type, u64 payload_size) {
+    (void)file.WriteObject(RecordHeader{
+        .type = static_cast<u32>(type),
+        .reserved = 0,
+        .payload_size = payload_size,
+    });
+}
+
+void Writer::Write(const Record& record) {
+    std::visit(
+        [this]<typename T>(const T& value) {
+            if constexpr (IsTrivialRecord<T>) {
+                WriteHeader(RecordIndex<T>(), sizeof(T));
+                (void)file.WriteObject(value);
+            } else if constexpr (std::is_same_v<T, MemoryRecord>) {
+                WriteMemory(value.device_addr, value.data);
+            } else if constexpr (std::is_same_v<T, SubmitListRecord>) {
+                const auto& command_lists = value.entries.command_lists;
+                const auto& prefetch = value.entries.prefetch_command_list;
+                const SubmitListHeader header{
+                    .channel = value.channel,
+                    .num_command_lists = static_cast<u32>(command_lists.size()),
+                    .num_prefetch_commands = static_cast<u32>(prefetch.size()),
+                    .reserved = 0,
+                };
+                WriteHeader(RecordIndex<T>(), sizeof(header) +
+                                                command_lists.size() * sizeof(u64) +
+                                                prefetch.size() * sizeof(u32));
+                (void)file.WriteObject(header);
+                (void)file.WriteSpan(std::span(command_lists.data(), command_lists.size()));
+                (void)file.WriteSpan(std::span(prefetch.data(), prefetch.size()));
+            } else if constexpr (std::is_same_v<T, CompositeRecord>) {
+                WriteHeader(RecordIndex<T>(),
+                            sizeof(u64) + value.layers.size() * sizeof(Tegra::FramebufferConfig));
+                (void)file.WriteObject(static_cast<u64>(value.layers.size()));
+                (void)file.WriteSpan(std::span<const Tegra::FramebufferConfig>(value.layers));
+            }
+        },
+        record);
+}
+
+void Writer::WriteMemory(DAddr device_addr, std::span<const u8> data) {
+    constexpr size_t type = RecordIndex<MemoryRecord>();
+    while (!data.empty()) {
+        const size_t size = (std::min<size_t>)(data.size(), MAX_MEMORY_RECORD_SIZE);
+        WriteHeader(type, sizeof(u64) + size);
+        (void)file.WriteObject(device_addr);
+        (void)file.WriteSpan(data.first(size));
+        device_addr += size;
+        data = data.subspan(size);
+    }
+}
+
+bool Reader::Open(const std::filesystem::path& path) {
+    file.Open(path, Common::FS::FileAccessMode::Read, Common::FS::FileType::BinaryFile);
+    FileHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header)) {
+        return false;
+    }
+    if (header.magic != CAPTURE_MAGIC || header.version != CAPTURE_VERSION) {
+        LOG_ERROR(HW_GPU, "Unsupported GPU capture {} version {}", header.magic, header.version);
+        return false;
+    }
+    return true;
+}
+
+std::optional<Record> Reader::Next() {
+    RecordHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header)) {
+        return std::nullopt;
+    }
+    std::optional<Record> record = DefaultRecord(header.type);
+    if (!record) {
+        LOG_ERROR(HW_GPU, "Unknown GPU capture record type {}", header.type);
+        return std::nullopt;
+    }
+    const bool is_valid = std::visit(
+        [this, &header]<typename T>(T& value) {
+            if constexpr (IsTrivialRecord<T>) {
+                return header.payload_size == sizeof(T) && file.ReadObject(value);
+            } else if constexpr (std::is_same_v<T, MemoryRecord>) {
+                if (header.payload_size < sizeof(u64) ||
+                    header.payload_size > sizeof(u64) + MAX_MEMORY_RECORD_SIZE) {
+                    return false;
+                }
+                value.data.resize(header.payload_size - sizeof(u64));
+                return file.ReadObject(value.device_addr) &&
+                       file.ReadSpan(std::span<u8>(value.data)) == value.data.size();
+            } else if constexpr (std::is_same_v<T, SubmitListRecord>) {
+                SubmitListHeader submit{};
+                if (!file.ReadObject(submit) ||
+                    header.payload_size != sizeof(submit) +
+                                               u64{submit.num_command_lists} * sizeof(u64) +
+                                               u64{submit.num_prefetch_commands} * sizeof(u32)) {
+                    return false;
+                }
+                value.channel = submit.channel;
+                auto& command_lists = value.entries.command_lists;
+                auto& prefetch = value.entries.prefetch_command_list;
+                command_lists.resize(submit.num_command_lists);
+                prefetch.resize(submit.num_prefetch_commands);
+                return file.ReadSpan(std::span(command_lists.data(), command_lists.size())) ==
+                           command_lists.size() &&
+                       file.ReadSpan(std::span(prefetch.data(), prefetch.size())) == prefetch.size();
+            } else if constexpr (std::is_same_v<T, CompositeRecord>) {
+                u64 num_layers{};
+                if (!file.ReadObject(num_layers) || num_layers > MAX_COMPOSITE_LAYERS ||
+                    header.payload_size !=
+                        sizeof(u64) + num_layers * sizeof(Tegra::FramebufferConfig)) {
+                    return false;
+                }
+                value.layers.resize(num_layers);
+                return file.ReadSpan(std::span<Tegra::FramebufferConfig>(value.layers)) ==
+                       value.layers.size();
+            }
+        },
+        *record);
+    if (!is_valid) {
+        LOG_ERROR(HW_GPU, "Corrupted GPU capture record of type {}", header.type);
+        return std::nullopt;
+    }
+    return record;
+}
+
+Recorder::Recorder(Tegra::MaxwellDeviceMemoryManager& device_memory_)
+    : device_memory{device_memory_} {}
+
+Recorder::~Recorder() {
+    End();
+}
+
+bool Recorder::Begin(const std::filesystem::path& path) {
+    std::scoped_lock lk{mutex};
+    if (!writer.Open(path)) {
+        LOG_ERROR(HW_GPU, "Failed to create GPU capture {}", Common::FS::PathToUTF8String(path));
+        return false;
+    }
+    LOG_INFO(HW_GPU, "Recording GPU capture to {}", Common::FS::PathToUTF8String(path));
+    active.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void Recorder::End() {
+    std::scoped_lock lk{mutex};
+    if (!active.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
+    WriteDirtyMemory();
+    writer.Close();
+    // Pinned pages are not released, the system is torn down when capturing ends
+    pinned_ranges.clear();
+}
+
+void Recorder::RecordAddressSpace(const Tegra::MemoryManager& memory_manager) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    writer.Write(AddressSpaceRecord{
+        .id = memory_manager.GetID(),
+        .address_space_bits = memory_manager.GetAddressSpaceBits(),
+        .split_address = memory_manager.GetSplitAddress(),
+        .big_page_bits = memory_manager.GetBigPageBits(),
+        .page_bits = memory_manager.GetPageBits(),
+    });
+}
+
+void Recorder::RecordChannel(const Tegra::Control::ChannelState& channel) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    writer.Write(ChannelRecord{
+        .channel = channel.bind_id,
+        .program_id = channel.program_id,
+        .address_space = channel.memory_manager ? channel.memory_manager->GetID() : ~0ULL,
+    });
+}
+
+void Recorder::RecordMap(const Tegra::MemoryManager& memory_manager, GPUVAddr gpu_addr,
+                         DAddr device_addr, u64 size, Tegra::PTEKind kind, bool is_big_pages) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    writer.Write(MapRecord{
+        .address_space = memory_manager.GetID(),
+        .gpu_addr = gpu_addr,
+        .device_addr = device_addr,
+        .size = size,
+        .kind = kind,
+        .is_big_pages = is_big_pages,
+    });
+    // Keep the pages cached so CPU writes to them are reported while the capture runs
+    device_memory.UpdatePagesCachedCount(device_addr, size, 1);
+    pinned_ranges.insert_or_assign({memory_manager.GetID(), gpu_addr},
+                                   PinnedRange{device_addr, size});
+    WriteMemory(device_addr, size);
+}
+
+void Recorder::RecordUnmap(const Tegra::MemoryManager& memory_manager, GPUVAddr gpu_addr,
+                           u64 size) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    writer.Write(UnmapRecord{
+        .address_space = memory_manager.GetID(),
+        .gpu_addr = gpu_addr,
+        .size = size,
+    });
+    const u64 id = memory_manager.GetID();
+    const GPUVAddr gpu_end = gpu_addr + size;
+    auto it = pinned_ranges.lower_bound({id, gpu_addr});
+    // A range mapped below the unmapped one may extend into it
+    if (it != pinned_ranges.begin()) {
+        const auto previous = std::prev(it);
+        if (previous->first.first == id &&
+            previous->first.second + previous->second.size > gpu_addr) {
+            it = previous;
+        }
+    }
+    while (it != pinned_ranges.end() && it->first.first == id && it->first.second < gpu_end) {
+        const GPUVAddr range_addr = it->first.second;
+        const PinnedRange range = it->second;
+        const GPUVAddr range_end = range_addr + range.size;
+        it = pinned_ranges.erase(it);
+
+        const GPUVAddr unpin_addr = (std::max)(range_addr, gpu_addr);
+        const GPUVAddr unpin_end = (std::min)(range_end, gpu_end);
+        device_memory.UpdatePagesCachedCount(range.device_addr + (unpin_addr - range_addr),
+                                             unpin_end - unpin_addr, -1);
+        // The parts left mapped stay pinned
+        if (range_addr < gpu_addr) {
+            pinned_ranges.emplace(std::make_pair(id, range_addr),
+                                  PinnedRange{range.device_addr, gpu_addr - range_addr});
+        }
+        if (range_end > gpu_end) {
+            pinned_ranges.emplace(
+                std::make_pair(id, gpu_end),
+                PinnedRange{range.device_addr + (gpu_end - range_addr), range_end - gpu_end});
+            break;
+        }
+    }
+}
+
+void Recorder::RecordSubmitList(s32 channel, const Tegra::CommandList& entries) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    WriteDirtyMemory();
+    writer.Write(SubmitListRecord{channel, entries});
+}
+
+void Recorder::RecordFlushRegion(DAddr addr, u64 size) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    writer.Write(FlushRegionRecord{addr, size});
+}
+
+void Recorder::RecordInvalidateRegion(DAddr addr, u64 size) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    WriteDirtyMemory();
+    WriteMemory(addr, size);
+    writer.Write(InvalidateRegionRecord{addr, size});
+}
+
+void Recorder::RecordComposite(std::span<const Tegra::FramebufferConfig> layers) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    WriteDirtyMemory();
+    writer.Write(CompositeRecord{{layers.begin(), layers.end()}});
+}
+
+void Recorder::MarkDirty(DAddr addr, u64 size) {
+    if (!IsActive()) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    if (!dirty_ranges.empty()) {
+        // Most writes continue the previous one
+        auto& [last_addr, last_size] = dirty_ranges.back();
+        if (addr >= last_addr && addr <= last_addr + last_size) {
+            last_size = (std::max)(last_size, addr + size - last_addr);
+            return;
+        }
+    }
+    dirty_ranges.emplace_back(addr, size);
+}
+
+void Recorder::WriteDirtyMemory() {
+    if (dirty_ranges.empty()) {
+        return;
+    }
+    std::ranges::sort(dirty_ranges);
+    DAddr range_addr = dirty_ranges.front().first;
+    DAddr range_end = range_addr;
+    for (const auto& [addr, size] : dirty_ranges) {
+        if (addr > range_end) {
+            WriteMemory(range_addr, range_end - range_addr);
+            range_addr = addr;
+        }
+        range_end = (std::max)(range_end, addr + size);
+    }
+    WriteMemory(range_addr, range_end - range_addr);
+    dirty_ranges.clear();
+}
+
+void Recorder::WriteMemory(DAddr device_addr, u64 size) {
+    if (size == 0) {
+        return;
+    }
+    scratch_buffer.resize_destructive(size);
+    device_memory.ReadBlockUnsafe(device_addr, scratch_buffer.data(), size);
+    writer.WriteMemory(device_addr, std::span<const u8>(scratch_buffer.data(), size));
+}
+
+} // namespace VideoCommon::Capture
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/scratch_buffer.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/framebuffer_config.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/pte_kind.h"
+
+namespace Tegra {
+class MemoryManager;
+namespace Control {
+struct ChannelState;
+}
+} // namespace Tegra
+
+namespace VideoCommon::Capture {
+
+/// GPU address space created by the guest
+struct AddressSpaceRecord {
+    u64 id;
+    u64 address_space_bits;
+    GPUVAddr split_address;
+    u64 big_page_bits;
+    u64 page_bits;
+};
+
+/// GPU channel bound to an address space
+struct ChannelRecord {
+    s32 channel;
+    u64 program_id;
+    u64 address_space;
+};
+
+/// Device memory mapped into an address space
+struct MapRecord {
+    u64 address_space;
+    GPUVAddr gpu_addr;
+    DAddr device_addr;
+    u64 size;
+    Tegra::PTEKind kind;
+    bool is_big_pages;
+};
+
+struct UnmapRecord {
+    u64 address_space;
+    GPUVAddr gpu_addr;
+    u64 size;
+};
+
+/// Contents of device memory as seen by the GPU at this point of the capture
+struct MemoryRecord {
+    DAddr device_addr;
+    std::vector<u8> data;
+};
+
+struct SubmitListRecord {
+    s32 channel;
+    Tegra::CommandList entries;
+};
+
+struct FlushRegionRecord {
+    DAddr addr;
+    u64 size;
+};
+
+struct InvalidateRegionRecord {
+    DAddr addr;
+    u64 size;
+};
+
+/// Frame presented to the screen, marks the end of a frame
+struct CompositeRecord {
+    std::vector<Tegra::FramebufferConfig> layers;
+};
+
+/// Records are stored with their index in this variant as type
+using Record = std::variant<AddressSpaceRecord, ChannelRecord, MapRecord, UnmapRecord, MemoryRecord,
+                            SubmitListRecord, FlushRegionRecord, InvalidateRegionRecord,
+                            CompositeRecord>;
+
+/// Serializes records to a capture file
+class Writer {
+public:
+    [[nodiscard]] bool Open(const std::filesystem::path& path);
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    void Write(const Record& record);
+
+    /// Writes a MemoryRecord without copying its contents into one
+    void WriteMemory(DAddr device_addr, std::span<const u8> data);
+
+private:
+    void WriteHeader(size_t type, u64 payload_size);
+
+    Common::FS::IOFile file;
+};
+
+/// Deserializes records from a capture file
+class Reader {
+public:
+    [[nodiscard]] bool Open(const std::filesystem::path& path);
+
+    /// Returns the next record, or nullopt at the end of the capture or on a corrupted record
+    [[nodiscard]] std::optional<Record> Next();
+
+private:
+    Common::FS::IOFile file;
+};
+
+/**
+ * Records the work submitted to the GPU thread along with the guest memory it reads, so it can be
+ * replayed without the CPU emulator.
+ * GPU mapped memory is snapshotted when mapped and kept marked as cached while the capture runs,
+ * so every CPU write to it reaches the rasterizer write hooks. Written ranges are accumulated, the
+ * pending GPU dirty memory is drained when a list is submitted, and their contents are stored right
+ * before the submission.
+ */
+class Recorder {
+public:
+    explicit Recorder(Tegra::MaxwellDeviceMemoryManager& device_memory_);
+    ~Recorder();
+
+    [[nodiscard]] bool Begin(const std::filesystem::path& path);
+    void End();
+
+    [[nodiscard]] bool IsActive() const noexcept {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    void RecordAddressSpace(const Tegra::MemoryManager& memory_manager);
+    void RecordChannel(const Tegra::Control::ChannelState& channel);
+    void RecordMap(const Tegra::MemoryManager& memory_manager, GPUVAddr gpu_addr, DAddr device_addr,
+                   u64 size, Tegra::PTEKind kind, bool is_big_pages);
+    void RecordUnmap(const Tegra::MemoryManager& memory_manager, GPUVAddr gpu_addr, u64 size);
+    void RecordSubmitList(s32 channel, const Tegra::CommandList& entries);
+    void RecordFlushRegion(DAddr addr, u64 size);
+    void RecordInvalidateRegion(DAddr addr, u64 size);
+    void RecordComposite(std::span<const Tegra::FramebufferConfig> layers);
+
+    /// Notifies a CPU write to device memory, its contents are stored before the next submission
+    void MarkDirty(DAddr addr, u64 size);
+
+private:
+    struct PinnedRange {
+        DAddr device_addr;
+        u64 size;
+    };
+
+    void WriteDirtyMemory();
+    void WriteMemory(DAddr device_addr, u64 size);
+
+    Tegra::MaxwellDeviceMemoryManager& device_memory;
+
+    std::atomic_bool active{};
+    std::mutex mutex;
+    Writer writer;
+    std::vector<std::pair<DAddr, u64>> dirty_ranges;
+    std::map<std::pair<u64, GPUVAddr>, PinnedRange> pinned_ranges;
+    Common::ScratchBuffer<u8> scratch_buffer;
+};
+
+} // namespace VideoCommon::Capture
@@ -4,7 +4,18 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include "common/assert.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "common/thread.h"
@@ -33,10 +44,10 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
     VideoCore::RasterizerInterface* const rasterizer = renderer.ReadRasterizer();
 
     CommandDataContainer next;
+    u64 fence{};
 
     while (!stop_token.stop_requested()) {
-        state.queue.PopWait(next, stop_token);
-        if (stop_token.stop_requested()) {
+        if (!state.queue.PopWait(next, stop_token)) {
             break;
         }
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
@@ -50,18 +61,19 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
         } else {
             ASSERT(false);
         }
-        state.signaled_fence.store(next.fence);
+        state.signaled_fence.store(++fence, std::memory_order::release);
         if (next.block) {
-            // We have to lock the write_lock to ensure that the condition_variable wait not get a
-            // race between the check and the lock itself.
-            std::scoped_lock lk{state.write_lock};
-            state.cv.notify_all();
+            state.signaled_fence.notify_all();
         }
     }
+
+    // Release any caller still blocked on a command that will never run.
+    state.signaled_fence.store(std::numeric_limits<u64>::max(), std::memory_order::release);
+    state.signaled_fence.notify_all();
 }
 
 ThreadManager::ThreadManager(Core::System& system_, bool is_async_)
-    : system{system_}, is_async{is_async_} {}
+    : system{system_}, is_async{is_async_}, capture{system_.Host1x().MemoryManager()} {}
 
 ThreadManager::~ThreadManager() = default;
 
@@ -69,15 +81,45 @@ void ThreadManager::StartThread(VideoCore::RendererBase& renderer,
                                 Core::Frontend::GraphicsContext& context,
                                 Tegra::Control::Scheduler& scheduler) {
     rasterizer = renderer.ReadRasterizer();
+    if (Settings::values.dump_gpu_capture.GetValue()) {
+        const auto capture_dir = Common::FS::GetEdenPath(Common::FS::EdenPath::DumpDir) / "gpu";
+        if (Common::FS::CreateDirs(capture_dir)) {
+            const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch());
+            (void)capture.Begin(capture_dir / fmt::format("{:016X}_{}.gpucap",
+                                                          system.GetApplicationProcessProgramID(),
+                                                          timestamp.count()));
+        } else {
+            LOG_ERROR(HW_GPU, "Failed to create GPU capture directory");
+        }
+    }
     thread = std::jthread(RunThread, std::ref(system), std::ref(renderer), std::ref(context),
                           std::ref(scheduler), std::ref(state));
 }
 
 void ThreadManager::SubmitList(s32 channel, Tegra::CommandList&& entries) {
+    if (capture.IsActive()) {
+        // CPU writes made before this submission must be stored before it in the capture. They are
+        // drained here instead of on the GPU thread, which would only see them once it runs it.
+        // The invalidations are pushed once the gather is done, as pushing may wait on the GPU
+        // thread, which gathers as well.
+        std::vector<std::pair<PAddr, size_t>> dirty_ranges;
+        std::function<void(PAddr, size_t)> callback_writes(
+            [this, &dirty_ranges](PAddr address, size_t size) {
+                capture.MarkDirty(address, size);
+                dirty_ranges.emplace_back(address, size);
+            });
+        system.GatherGPUDirtyMemory(callback_writes);
+        for (const auto& [address, size] : dirty_ranges) {
+            PushCommand(InvalidateRegionCommand(address, size));
+        }
+    }
+    capture.RecordSubmitList(channel, entries);
     PushCommand(SubmitListCommand(channel, std::move(entries)));
 }
 
 void ThreadManager::FlushRegion(DAddr addr, u64 size) {
+    capture.RecordFlushRegion(addr, size);
     if (!is_async) {
         // Always flush with synchronous GPU mode
         PushCommand(FlushRegionCommand(addr, size));
@@ -97,11 +139,13 @@ void ThreadManager::TickGPU() {
 }
 
 void ThreadManager::InvalidateRegion(DAddr addr, u64 size) {
+    capture.RecordInvalidateRegion(addr, size);
     rasterizer->OnCacheInvalidation(addr, size);
 }
 
 void ThreadManager::FlushAndInvalidateRegion(DAddr addr, u64 size) {
     // Skip flush on asynch mode, as FlushAndInvalidateRegion is not used for anything too important
+    capture.RecordInvalidateRegion(addr, size);
     rasterizer->OnCacheInvalidation(addr, size);
 }
 
@@ -111,14 +155,14 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
         block = true;
     }
 
-    std::unique_lock lk(state.write_lock);
-    const u64 fence{++state.last_fence};
-    state.queue.EmplaceWait(std::move(command_data), fence, block);
+    const u64 fence{state.queue.EmplaceWait(std::move(command_data), block) + 1};
 
     if (block) {
-        Common::CondvarWait(state.cv, lk, thread.get_stop_token(), [this, fence] {
-            return fence <= state.signaled_fence.load(std::memory_order_relaxed);
-        });
+        u64 signaled_fence{state.signaled_fence.load(std::memory_order::acquire)};
+        while (signaled_fence < fence) {
+            state.signaled_fence.wait(signaled_fence, std::memory_order::acquire);
+            signaled_fence = state.signaled_fence.load(std::memory_order::acquire);
+        }
     }
 
     return fence;
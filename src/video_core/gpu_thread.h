@@ -4,8 +4,6 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
-#include <mutex>
 #include <optional>
 #include <thread>
 #include <variant>
@@ -13,6 +11,7 @@
 #include "common/bounded_threadsafe_queue.h"
 #include "common/polyfill_thread.h"
 #include "video_core/framebuffer_config.h"
+#include "video_core/gpu_capture.h"
 
 namespace Tegra {
 struct FramebufferConfig;
@@ -79,22 +78,19 @@ using CommandData =
 struct CommandDataContainer {
     CommandDataContainer() = default;
 
-    explicit CommandDataContainer(CommandData&& data_, u64 next_fence_, bool block_)
-        : data{std::move(data_)}, fence{next_fence_}, block(block_) {}
+    explicit CommandDataContainer(CommandData&& data_, bool block_)
+        : data{std::move(data_)}, block(block_) {}
 
     CommandData data;
-    u64 fence{};
     bool block{};
 };
 
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
-    using CommandQueue = Common::MPSCQueue<CommandDataContainer>;
-    std::mutex write_lock;
+    using CommandQueue = Common::LockFreeMPSCQueue<CommandDataContainer>;
     CommandQueue queue;
-    u64 last_fence{};
+    /// Fence of a command is its position in the queue plus one, so it is known without locking
     std::atomic<u64> signaled_fence{};
-    std::condition_variable_any cv;
 };
 
 /// Class used to manage the GPU thread
@@ -121,6 +117,11 @@ public:
 
     void TickGPU();
 
+    /// Returns the recorder of GPU captures, submissions are recorded in the order they are pushed
+    [[nodiscard]] Capture::Recorder& CaptureRecorder() noexcept {
+        return capture;
+    }
+
 private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data, bool block = false);
@@ -130,6 +131,7 @@ private:
     VideoCore::RasterizerInterface* rasterizer = nullptr;
 
     SynchState state;
+    Capture::Recorder capture;
     std::jthread thread;
 };
 
@@ -4,6 +4,7 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <optional>
@@ -18,6 +19,7 @@
 #include "common/settings.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/macro/macro.h"
+#include "video_core/macro/macro_disk_cache.h"
 #include "video_core/macro/macro_hle.h"
 #include "video_core/macro/macro_interpreter.h"
 
@@ -27,6 +29,51 @@
 
 namespace Tegra {
 
+namespace {
+
+/// Sampled calls with the same parameters before a specialization is traced for them
+constexpr u32 SPECIALIZATION_THRESHOLD = 2;
+/// Only one in this many calls without a matching specialization is hashed and counted
+constexpr u32 SAMPLE_INTERVAL = 8;
+/// Longer parameter lists, like constant buffer uploads, rarely repeat and are never specialized
+constexpr size_t MAX_SPECIALIZED_PARAMETERS = 64;
+constexpr size_t MAX_SPECIALIZATIONS = Macro::DiskCache::MAX_SPECIALIZATIONS;
+/// Specialization is disabled for macros that keep failing to trace or to match their guards
+constexpr u32 MAX_TRACE_FAILURES = 4;
+constexpr u32 MAX_GUARD_FAILURES = 64;
+/// Parameter lists that are tracked before the counts start over
+constexpr size_t MAX_TRACKED_PARAMETERS = 256;
+
+} // Anonymous namespace
+
+namespace Macro {
+
+using Maxwell3D = Engines::Maxwell3D;
+
+u32 Maxwell3DEnvironment::ReadRegister(u32 method) {
+    return maxwell3d.GetRegisterValue(method);
+}
+
+void Maxwell3DEnvironment::CallMethod(u32 method, u32 argument) {
+    maxwell3d.CallMethod(method, argument, true);
+}
+
+void Maxwell3DEnvironment::CallMultiMethod(u32 method, std::span<const u32> arguments) {
+    constexpr u32 cb_data_begin = MAXWELL3D_REG_INDEX(const_buffer.buffer);
+    constexpr u32 cb_data_end = cb_data_begin + 16;
+    if (method >= cb_data_begin && method < cb_data_end) {
+        // Constant buffer uploads can be processed as a single block
+        const auto amount = static_cast<u32>(arguments.size());
+        maxwell3d.CallMultiMethod(method, arguments.data(), amount, amount);
+        return;
+    }
+    for (const u32 argument : arguments) {
+        maxwell3d.CallMethod(method, argument, true);
+    }
+}
+
+} // namespace Macro
+
 static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
     const auto base_dir{Common::FS::GetEdenPath(Common::FS::EdenPath::DumpDir)};
     const auto macro_dir{base_dir / "macros"};
@@ -54,8 +101,9 @@ static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
     macro_file.write(reinterpret_cast<const char*>(code.data()), code.size_bytes());
 }
 
-MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d_)
-    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {}
+MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d_, u64 program_id)
+    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_},
+      environment{maxwell3d_}, disk_cache{Macro::DiskCache::Get(program_id)} {}
 
 MacroEngine::~MacroEngine() = default;
 
@@ -71,12 +119,11 @@ void MacroEngine::ClearCode(u32 method) {
 void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
     auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
-        const auto& cache_info = compiled_macro->second;
+        auto& cache_info = compiled_macro->second;
         if (cache_info.has_hle_program) {
             cache_info.hle_program->Execute(parameters, method);
         } else {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
+            ExecuteLLE(cache_info, parameters, method);
         }
     } else {
         // Macro not compiled, check if it's uploaded and if so, compile it
@@ -97,8 +144,9 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
         auto& cache_info = macro_cache[method];
 
         if (!mid_method.has_value()) {
-            cache_info.lle_program = Compile(macro_code->second);
             cache_info.hash = Common::HashValue(macro_code->second);
+            Lower(cache_info, macro_code->second);
+            cache_info.lle_program = Compile(macro_code->second, cache_info.ir.get());
         } else {
             const auto& macro_cached = uploaded_macro_code[mid_method.value()];
             const auto rebased_method = method - mid_method.value();
@@ -107,13 +155,13 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
             std::memcpy(code.data(), macro_cached.data() + rebased_method,
                         code.size() * sizeof(u32));
             cache_info.hash = Common::HashValue(code);
-            cache_info.lle_program = Compile(code);
+            Lower(cache_info, code);
+            cache_info.lle_program = Compile(code, cache_info.ir.get());
         }
 
         auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
         if (!hle_program || Settings::values.disable_macro_hle) {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
+            ExecuteLLE(cache_info, parameters, method);
         } else {
             cache_info.has_hle_program = true;
             cache_info.hle_program = std::move(hle_program);
@@ -126,14 +174,108 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
     }
 }
 
-std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
+void MacroEngine::Lower(CacheInfo& cache_info, const std::vector<u32>& code) {
+    if (Settings::values.disable_macro_ir) {
+        return;
+    }
+    std::optional<Macro::IR::Function> function;
+    if (disk_cache) {
+        function = disk_cache->LoadFunction(cache_info.hash, code);
+    }
+    if (!function) {
+        function = Macro::IR::Lower(code);
+        if (!function) {
+            return;
+        }
+        Macro::IR::Optimize(*function);
+        Macro::IR::BatchSends(*function);
+        if (disk_cache) {
+            disk_cache->StoreFunction(cache_info.hash, code, *function);
+        }
+    }
+    cache_info.ir = std::make_unique<Macro::IR::Function>(std::move(*function));
+    if (disk_cache) {
+        for (auto& specialization : disk_cache->LoadSpecializations(cache_info.hash)) {
+            if (cache_info.specializations.size() == MAX_SPECIALIZATIONS) {
+                break;
+            }
+            cache_info.specializations.push_back(
+                std::make_unique<CachedSpecialization>(std::move(specialization)));
+        }
+    }
+}
+
+void MacroEngine::ExecuteLLE(CacheInfo& cache_info, const std::vector<u32>& parameters,
+                             u32 method) {
+    maxwell3d.RefreshParameters();
+    if (cache_info.ir && parameters.size() <= MAX_SPECIALIZED_PARAMETERS &&
+        ExecuteSpecialized(cache_info, parameters)) {
+        return;
+    }
+    cache_info.lle_program->Execute(parameters, method);
+}
+
+bool MacroEngine::ExecuteSpecialized(CacheInfo& cache_info, const std::vector<u32>& parameters) {
+    bool parameters_matched = false;
+    for (const auto& cached : cache_info.specializations) {
+        if (cached->specialization.parameters != parameters) {
+            continue;
+        }
+        parameters_matched = true;
+        const bool guards_hold =
+            std::ranges::all_of(cached->specialization.guards, [this](const auto& guard) {
+                return environment.ReadRegister(guard.first) == guard.second;
+            });
+        if (guards_hold) {
+            cache_info.guard_failures = 0;
+            cached->program.Execute(environment, parameters);
+            return true;
+        }
+    }
+    if (parameters_matched && ++cache_info.guard_failures == MAX_GUARD_FAILURES) {
+        cache_info.specializations.clear();
+        cache_info.trace_failures = MAX_TRACE_FAILURES;
+    }
+    if (cache_info.trace_failures >= MAX_TRACE_FAILURES ||
+        cache_info.specializations.size() == MAX_SPECIALIZATIONS) {
+        return false;
+    }
+    if (cache_info.calls_until_sample != 0) {
+        --cache_info.calls_until_sample;
+        return false;
+    }
+    cache_info.calls_until_sample = SAMPLE_INTERVAL - 1;
+    const u64 key = Common::HashValue(parameters);
+    if (cache_info.parameter_counts.size() == MAX_TRACKED_PARAMETERS) {
+        cache_info.parameter_counts.clear();
+    }
+    if (++cache_info.parameter_counts[key] < SPECIALIZATION_THRESHOLD) {
+        return false;
+    }
+    cache_info.parameter_counts.erase(key);
+
+    // Tracing executes the macro
+    auto specialization = Macro::IR::Trace(*cache_info.ir, environment, parameters);
+    if (!specialization) {
+        ++cache_info.trace_failures;
+        return true;
+    }
+    if (disk_cache) {
+        disk_cache->StoreSpecialization(cache_info.hash, *specialization);
+    }
+    cache_info.specializations.push_back(
+        std::make_unique<CachedSpecialization>(std::move(*specialization)));
+    return true;
+}
+
+std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d, u64 program_id) {
     if (Settings::values.disable_macro_jit) {
-        return std::make_unique<MacroInterpreter>(maxwell3d);
+        return std::make_unique<MacroInterpreter>(maxwell3d, program_id);
     }
 #ifdef ARCHITECTURE_x86_64
-    return std::make_unique<MacroJITx64>(maxwell3d);
+    return std::make_unique<MacroJITx64>(maxwell3d, program_id);
 #else
-    return std::make_unique<MacroInterpreter>(maxwell3d);
+    return std::make_unique<MacroInterpreter>(maxwell3d, program_id);
 #endif
 }
 
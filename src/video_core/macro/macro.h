@@ -8,6 +8,7 @@
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
+#include "video_core/macro/macro_ir_executor.h"
 
 namespace Tegra {
 
@@ -93,6 +94,23 @@ union MethodAddress {
     BitField<12, 6, u32> increment;
 };
 
+class DiskCache;
+
+/// Runs IR functions against a Maxwell3D engine
+class Maxwell3DEnvironment final : public IR::Environment {
+public:
+    explicit Maxwell3DEnvironment(Engines::Maxwell3D& maxwell3d_) : maxwell3d{maxwell3d_} {}
+
+    u32 ReadRegister(u32 method) override;
+
+    void CallMethod(u32 method, u32 argument) override;
+
+    void CallMultiMethod(u32 method, std::span<const u32> arguments) override;
+
+private:
+    Engines::Maxwell3D& maxwell3d;
+};
+
 } // namespace Macro
 
 class HLEMacro;
@@ -111,7 +129,7 @@ public:
 
 class MacroEngine {
 public:
-    explicit MacroEngine(Engines::Maxwell3D& maxwell3d);
+    explicit MacroEngine(Engines::Maxwell3D& maxwell3d, u64 program_id);
     virtual ~MacroEngine();
 
     // Store the uploaded macro code to compile them when they're called.
@@ -124,22 +142,56 @@ public:
     void Execute(u32 method, const std::vector<u32>& parameters);
 
 protected:
-    virtual std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) = 0;
+    /**
+     * Compiles macro code for the backend.
+     *
+     * @param code The macro code
+     * @param ir   Optimized IR of the code, null when the macro could not be lowered
+     */
+    virtual std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code,
+                                                 const Macro::IR::Function* ir) = 0;
 
 private:
+    struct CachedSpecialization {
+        explicit CachedSpecialization(Macro::IR::Specialization&& specialization_)
+            : specialization{std::move(specialization_)}, program{specialization.residual} {}
+
+        Macro::IR::Specialization specialization;
+        Macro::IR::Program program;
+    };
+
     struct CacheInfo {
         std::unique_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
         u64 hash{};
         bool has_hle_program{};
+
+        /// Lowered macro, null when it could not be lowered or the IR is disabled
+        std::unique_ptr<Macro::IR::Function> ir{};
+        std::vector<std::unique_ptr<CachedSpecialization>> specializations{};
+        /// Sampled calls of each parameter list without a specialization
+        std::unordered_map<u64, u32> parameter_counts{};
+        u32 calls_until_sample{};
+        u32 guard_failures{};
+        u32 trace_failures{};
     };
 
+    void Lower(CacheInfo& cache_info, const std::vector<u32>& code);
+
+    void ExecuteLLE(CacheInfo& cache_info, const std::vector<u32>& parameters, u32 method);
+
+    /// Runs a specialization of the macro, or traces a new one for hot parameter lists.
+    /// Returns false when the macro was not executed.
+    bool ExecuteSpecialized(CacheInfo& cache_info, const std::vector<u32>& parameters);
+
     std::unordered_map<u32, CacheInfo> macro_cache;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
     Engines::Maxwell3D& maxwell3d;
+    Macro::Maxwell3DEnvironment environment;
+    std::shared_ptr<Macro::DiskCache> disk_cache;
 };
 
-std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d);
+std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d, u64 program_id);
 
 } // namespace Tegra
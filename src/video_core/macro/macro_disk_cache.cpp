@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "common/common_funcs.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/macro/macro_disk_cache.h"
+
+namespace Tegra::Macro {
+
+namespace {
+
+constexpr u32 CACHE_MAGIC = Common::MakeMagic('E', 'M', 'I', 'R');
+constexpr u32 CACHE_VERSION = 1;
+
+/// Far larger than any valid entry, rejects corrupted sizes before allocating
+constexpr u32 MAX_ENTRY_SIZE = 16U << 20;
+
+struct FileHeader {
+    u32 magic;
+    u32 version;
+};
+
+struct EntryHeader {
+    u32 type;
+    u32 size;
+    u64 hash;
+};
+
+} // Anonymous namespace
+
+DiskCache::DiskCache(const std::filesystem::path& path_)
+    : path{path_}, writer{1, "MacroCacheWriter"} {}
+
+DiskCache::~DiskCache() {
+    // Stopping the worker drops the writes it did not start yet
+    writer.WaitForRequests();
+}
+
+std::shared_ptr<DiskCache> DiskCache::Get(u64 program_id) {
+    static std::mutex caches_mutex;
+    static std::map<u64, std::weak_ptr<DiskCache>> caches;
+
+    std::scoped_lock lk{caches_mutex};
+    auto& cache = caches[program_id];
+    if (auto shared = cache.lock()) {
+        return shared;
+    }
+    auto created = Create(program_id);
+    cache = created;
+    return created;
+}
+
+std::shared_ptr<DiskCache> DiskCache::Create(u64 program_id) {
+    if (program_id == 0 || !Settings::values.use_disk_shader_cache.GetValue()) {
+        return nullptr;
+    }
+    const auto shader_dir{Common::FS::GetEdenPath(Common::FS::EdenPath::ShaderDir)};
+    const auto base_dir{shader_dir / fmt::format("{:016x}", program_id)};
+    if (!Common::FS::CreateDir(shader_dir) || !Common::FS::CreateDir(base_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create macro cache directories");
+        return nullptr;
+    }
+    return std::make_shared<DiskCache>(base_dir / "macros.bin");
+}
+
+std::optional<IR::Function> DiskCache::LoadFunction(u64 hash, std::span<const u32> code) {
+    std::scoped_lock lk{mutex};
+    Load();
+    const auto it = functions.find(hash);
+    if (it == functions.end()) {
+        return std::nullopt;
+    }
+    std::span<const u8> payload{it->second};
+    u32 code_size{};
+    if (payload.size() < sizeof(code_size)) {
+        return std::nullopt;
+    }
+    std::memcpy(&code_size, payload.data(), sizeof(code_size));
+    payload = payload.subspan(sizeof(code_size));
+    if (code_size != code.size() || payload.size() < code.size_bytes() ||
+        std::memcmp(payload.data(), code.data(), code.size_bytes()) != 0) {
+        return std::nullopt;
+    }
+    payload = payload.subspan(code.size_bytes());
+    return IR::DeserializeFunction(payload);
+}
+
+std::vector<IR::Specialization> DiskCache::LoadSpecializations(u64 hash) {
+    std::scoped_lock lk{mutex};
+    Load();
+    std::vector<IR::Specialization> result;
+    const auto it = specializations.find(hash);
+    if (it == specializations.end()) {
+        return result;
+    }
+    for (const std::vector<u8>& stored : it->second) {
+        std::span<const u8> payload{stored};
+        if (auto specialization = IR::DeserializeSpecialization(payload)) {
+            result.push_back(std::move(*specialization));
+        }
+    }
+    return result;
+}
+
+void DiskCache::StoreFunction(u64 hash, std::span<const u32> code, const IR::Function& function) {
+    std::vector<u8> payload(sizeof(u32) + code.size_bytes());
+    const auto code_size = static_cast<u32>(code.size());
+    std::memcpy(payload.data(), &code_size, sizeof(code_size));
+    std::memcpy(payload.data() + sizeof(code_size), code.data(), code.size_bytes());
+    IR::Serialize(function, payload);
+    Append(EntryType::Function, hash, payload);
+}
+
+void DiskCache::StoreSpecialization(u64 hash, const IR::Specialization& specialization) {
+    std::vector<u8> payload;
+    IR::Serialize(specialization, payload);
+    Append(EntryType::Specialization, hash, payload);
+}
+
+void DiskCache::Load() {
+    if (is_loaded) {
+        return;
+    }
+    is_loaded = true;
+
+    Common::FS::IOFile input(path, Common::FS::FileAccessMode::Read,
+                             Common::FS::FileType::BinaryFile);
+    if (!input.IsOpen()) {
+        return;
+    }
+    FileHeader header{};
+    if (!input.ReadObject(header) || header.magic != CACHE_MAGIC ||
+        header.version != CACHE_VERSION) {
+        LOG_INFO(HW_GPU, "Discarding outdated macro cache");
+        input.Close();
+        (void)Common::FS::RemoveFile(path);
+        return;
+    }
+    size_t num_entries = 0;
+    EntryHeader entry{};
+    while (input.ReadObject(entry)) {
+        std::vector<u8> payload(std::min(entry.size, MAX_ENTRY_SIZE));
+        if (entry.size > MAX_ENTRY_SIZE ||
+            input.ReadSpan(std::span<u8>(payload)) != payload.size()) {
+            // Truncated by a crash while appending, the entries before it are still valid
+            needs_rewrite = true;
+            break;
+        }
+        const auto type = static_cast<EntryType>(entry.type);
+        if ((type != EntryType::Function && type != EntryType::Specialization) ||
+            Contains(type, entry.hash, payload)) {
+            needs_rewrite = true;
+            continue;
+        }
+        if (!Insert(type, entry.hash, std::move(payload))) {
+            needs_rewrite = true;
+        }
+        ++num_entries;
+    }
+    LOG_INFO(HW_GPU, "Loaded {} entries from the macro cache", num_entries);
+    input.Close();
+    if (needs_rewrite) {
+        // Compact the file now instead of on the next store, which may never come
+        QueueWrite();
+    }
+}
+
+bool DiskCache::Contains(EntryType type, u64 hash, std::span<const u8> payload) const {
+    const auto equals = [payload](const std::vector<u8>& stored) {
+        return std::ranges::equal(stored, payload);
+    };
+    if (type == EntryType::Function) {
+        const auto it = functions.find(hash);
+        return it != functions.end() && equals(it->second);
+    }
+    const auto it = specializations.find(hash);
+    return it != specializations.end() && std::ranges::any_of(it->second, equals);
+}
+
+void DiskCache::Append(EntryType type, u64 hash, std::span<const u8> payload) {
+    if (payload.size() > MAX_ENTRY_SIZE) {
+        return;
+    }
+    std::scoped_lock lk{mutex};
+    Load();
+    if (Contains(type, hash, payload)) {
+        return;
+    }
+    std::vector<u8> copy(payload.begin(), payload.end());
+    pending.push_back({.type = type, .hash = hash, .payload = copy});
+    if (!Insert(type, hash, std::move(copy))) {
+        // The entry this one replaced is dead in the file
+        needs_rewrite = true;
+    }
+    QueueWrite();
+}
+
+bool DiskCache::Insert(EntryType type, u64 hash, std::vector<u8> payload) {
+    if (type == EntryType::Function) {
+        // A later entry replaces the function, the earlier one is dead
+        return functions.insert_or_assign(hash, std::move(payload)).second;
+    }
+    std::vector<std::vector<u8>>& stored = specializations[hash];
+    stored.push_back(std::move(payload));
+    if (stored.size() <= MAX_SPECIALIZATIONS) {
+        return true;
+    }
+    stored.erase(stored.begin());
+    return false;
+}
+
+void DiskCache::QueueWrite() {
+    if (is_write_queued) {
+        return;
+    }
+    is_write_queued = true;
+    writer.QueueWork([this] { Write(); });
+}
+
+void DiskCache::Write() {
+    std::vector<Entry> entries;
+    bool rewrite{};
+    {
+        std::scoped_lock lk{mutex};
+        is_write_queued = false;
+        // Damaged or compacted files are rewritten from the entries in memory
+        rewrite = needs_rewrite || (!file.IsOpen() && !Common::FS::Exists(path));
+        if (rewrite) {
+            needs_rewrite = false;
+            pending.clear();
+            for (const auto& [hash, payload] : functions) {
+                entries.push_back({.type = EntryType::Function, .hash = hash, .payload = payload});
+            }
+            for (const auto& [hash, stored] : specializations) {
+                for (const std::vector<u8>& payload : stored) {
+                    entries.push_back(
+                        {.type = EntryType::Specialization, .hash = hash, .payload = payload});
+                }
+            }
+        } else {
+            entries = std::exchange(pending, {});
+        }
+    }
+    if ((rewrite || !file.IsOpen()) && !OpenFile(rewrite)) {
+        // Try again with every entry on the next store
+        std::scoped_lock lk{mutex};
+        needs_rewrite = true;
+        return;
+    }
+    for (const Entry& entry : entries) {
+        WriteEntry(entry.type, entry.hash, entry.payload);
+    }
+    (void)file.Flush();
+}
+
+bool DiskCache::OpenFile(bool rewrite) {
+    file.Open(path,
+              rewrite ? Common::FS::FileAccessMode::Write : Common::FS::FileAccessMode::Append,
+              Common::FS::FileType::BinaryFile);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open macro cache {}",
+                  Common::FS::PathToUTF8String(path));
+        return false;
+    }
+    if (rewrite) {
+        (void)file.WriteObject(FileHeader{CACHE_MAGIC, CACHE_VERSION});
+    }
+    return true;
+}
+
+void DiskCache::WriteEntry(EntryType type, u64 hash, std::span<const u8> payload) {
+    (void)file.WriteObject(EntryHeader{
+        .type = static_cast<u32>(type),
+        .size = static_cast<u32>(payload.size()),
+        .hash = hash,
+    });
+    (void)file.WriteSpan(payload);
+}
+
+} // namespace Tegra::Macro
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/thread_worker.h"
+#include "video_core/macro/macro_ir.h"
+
+namespace Tegra::Macro {
+
+/**
+ * Lowered macros and their specializations, stored per title so they are available on the first
+ * call of a macro in later runs. Entries are read all at once the first time the cache is queried.
+ * New entries are written by a worker thread, so macro execution never waits on the file. The
+ * worker also compacts the file when it holds dead entries.
+ * The macro engines of every channel of a title share a single cache.
+ */
+class DiskCache {
+public:
+    /// Specializations kept for each macro, older ones are dropped first
+    static constexpr size_t MAX_SPECIALIZATIONS = 16;
+
+    explicit DiskCache(const std::filesystem::path& path_);
+    ~DiskCache();
+
+    /// Returns the cache of a title, shared while in use, null when the disk cache is disabled
+    [[nodiscard]] static std::shared_ptr<DiskCache> Get(u64 program_id);
+
+    /// Returns the function stored for a macro, code is compared to avoid hash collisions
+    [[nodiscard]] std::optional<IR::Function> LoadFunction(u64 hash, std::span<const u32> code);
+
+    /// Returns the specializations stored for a macro, oldest first
+    [[nodiscard]] std::vector<IR::Specialization> LoadSpecializations(u64 hash);
+
+    void StoreFunction(u64 hash, std::span<const u32> code, const IR::Function& function);
+
+    void StoreSpecialization(u64 hash, const IR::Specialization& specialization);
+
+private:
+    enum class EntryType : u32 {
+        Function,
+        Specialization,
+    };
+
+    struct Entry {
+        EntryType type;
+        u64 hash;
+        std::vector<u8> payload;
+    };
+
+    [[nodiscard]] static std::shared_ptr<DiskCache> Create(u64 program_id);
+
+    void Load();
+
+    /// Returns true when an entry with the same contents is already stored
+    [[nodiscard]] bool Contains(EntryType type, u64 hash, std::span<const u8> payload) const;
+
+    void Append(EntryType type, u64 hash, std::span<const u8> payload);
+
+    /// Adds an entry to the maps, returns false when it replaced or dropped an older entry
+    bool Insert(EntryType type, u64 hash, std::vector<u8> payload);
+
+    /// Queues a write of the pending entries, or of the whole file when it has to be compacted
+    void QueueWrite();
+
+    /// Runs on the writer thread
+    void Write();
+
+    [[nodiscard]] bool OpenFile(bool rewrite);
+
+    void WriteEntry(EntryType type, u64 hash, std::span<const u8> payload);
+
+    std::filesystem::path path;
+    std::mutex mutex;
+    bool is_loaded{};
+    bool needs_rewrite{};
+    bool is_write_queued{};
+    std::unordered_map<u64, std::vector<u8>> functions;
+    std::unordered_map<u64, std::vector<std::vector<u8>>> specializations;
+    /// Entries stored since the last write
+    std::vector<Entry> pending;
+    /// Only accessed by the writer thread
+    Common::FS::IOFile file;
+    Common::ThreadWorker writer;
+};
+
+} // namespace Tegra::Macro
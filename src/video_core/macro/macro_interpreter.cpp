@@ -350,12 +350,32 @@ u32 MacroInterpreterImpl::FetchParameter() {
     ASSERT(next_parameter_index < num_parameters);
     return parameters[next_parameter_index++];
 }
+
+/// Executes the optimized IR of a macro, which skips its dead code and folded instructions
+class MacroIRImpl final : public CachedMacro {
+public:
+    explicit MacroIRImpl(Engines::Maxwell3D& maxwell3d_, const Macro::IR::Function& function)
+        : environment{maxwell3d_}, program{function} {}
+
+    void Execute(const std::vector<u32>& parameters, [[maybe_unused]] u32 method) override {
+        program.Execute(environment, parameters);
+    }
+
+private:
+    Macro::Maxwell3DEnvironment environment;
+    Macro::IR::Program program;
+};
+
 } // Anonymous namespace
 
-MacroInterpreter::MacroInterpreter(Engines::Maxwell3D& maxwell3d_)
-    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+MacroInterpreter::MacroInterpreter(Engines::Maxwell3D& maxwell3d_, u64 program_id)
+    : MacroEngine{maxwell3d_, program_id}, maxwell3d{maxwell3d_} {}
 
-std::unique_ptr<CachedMacro> MacroInterpreter::Compile(const std::vector<u32>& code) {
+std::unique_ptr<CachedMacro> MacroInterpreter::Compile(const std::vector<u32>& code,
+                                                       const Macro::IR::Function* ir) {
+    if (ir) {
+        return std::make_unique<MacroIRImpl>(maxwell3d, *ir);
+    }
     return std::make_unique<MacroInterpreterImpl>(maxwell3d, code);
 }
 
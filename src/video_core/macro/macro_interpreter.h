@@ -15,10 +15,11 @@ class Maxwell3D;
 
 class MacroInterpreter final : public MacroEngine {
 public:
-    explicit MacroInterpreter(Engines::Maxwell3D& maxwell3d_);
+    explicit MacroInterpreter(Engines::Maxwell3D& maxwell3d_, u64 program_id);
 
 protected:
-    std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) override;
+    std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code,
+                                         const Macro::IR::Function* ir) override;
 
 private:
     Engines::Maxwell3D& maxwell3d;
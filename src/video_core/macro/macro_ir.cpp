@@ -0,0 +1,1245 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_ir.h"
+
+namespace Tegra::Macro::IR {
+
+namespace {
+
+/// Registers r1-r7, the method address and the carry flag, r0 is always zero
+constexpr size_t NUM_VARIABLES = NUM_MACRO_REGISTERS + 2;
+constexpr u32 METHOD_VARIABLE = NUM_MACRO_REGISTERS;
+constexpr u32 CARRY_VARIABLE = NUM_MACRO_REGISTERS + 1;
+
+/// Larger macros are left to the regular backends
+constexpr size_t MAX_CODE_SIZE = 0x1000;
+
+constexpr u32 INVALID_BLOCK = ~u32{0};
+
+/// Instructions that can be folded when all their arguments are constant
+constexpr bool IsPure(Opcode opcode) {
+    return NumArgs(opcode) > 0 && opcode != Opcode::Identity && opcode != Opcode::Read &&
+           opcode != Opcode::Send;
+}
+
+constexpr bool IsValidALUOperation(ALUOperation operation) {
+    switch (operation) {
+    case ALUOperation::Add:
+    case ALUOperation::AddWithCarry:
+    case ALUOperation::Subtract:
+    case ALUOperation::SubtractWithBorrow:
+    case ALUOperation::Xor:
+    case ALUOperation::Or:
+    case ALUOperation::And:
+    case ALUOperation::AndNot:
+    case ALUOperation::Nand:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool IsConst(const Function& function, Value value) {
+    return function.insts[value].opcode == Opcode::Const;
+}
+
+bool IsConst(const Function& function, Value value, u32 imm) {
+    const Inst& inst = function.insts[value];
+    return inst.opcode == Opcode::Const && inst.imm == imm;
+}
+
+Value Resolve(const Function& function, Value value) {
+    while (value != INVALID_VALUE && function.insts[value].opcode == Opcode::Identity) {
+        value = function.insts[value].args[0];
+    }
+    return value;
+}
+
+void ReplaceWith(Function& function, Value value, Value replacement) {
+    Inst& inst = function.insts[value];
+    inst.opcode = Opcode::Identity;
+    inst.imm = 0;
+    inst.args = {replacement, INVALID_VALUE, INVALID_VALUE};
+    inst.list.clear();
+}
+
+template <typename Func>
+void ForEachSuccessor(const Block& block, Func&& func) {
+    switch (block.terminator.type) {
+    case TerminatorType::Exit:
+        break;
+    case TerminatorType::Jump:
+        func(block.terminator.targets[0]);
+        break;
+    case TerminatorType::Branch:
+        func(block.terminator.targets[0]);
+        func(block.terminator.targets[1]);
+        break;
+    }
+}
+
+/// Unlinks an edge, dropping the matching phi operands of the successor
+void RemovePredecessor(Function& function, u32 block_id, u32 predecessor) {
+    Block& block = function.blocks[block_id];
+    const auto it = std::ranges::find(block.predecessors, predecessor);
+    if (it == block.predecessors.end()) {
+        return;
+    }
+    const auto index = static_cast<size_t>(it - block.predecessors.begin());
+    block.predecessors.erase(it);
+    for (const Value value : block.insts) {
+        Inst& inst = function.insts[value];
+        if (inst.opcode == Opcode::Phi) {
+            inst.list.erase(inst.list.begin() + index);
+        }
+    }
+}
+
+std::vector<u32> ReversePostOrder(const Function& function) {
+    std::vector<u32> order;
+    std::vector<bool> visited(function.blocks.size());
+    std::vector<std::pair<u32, size_t>> stack{{0, 0}};
+    visited[0] = true;
+    while (!stack.empty()) {
+        auto& [block_id, next] = stack.back();
+        const Terminator& terminator = function.blocks[block_id].terminator;
+        const size_t num_successors = terminator.type == TerminatorType::Exit   ? 0
+                                      : terminator.type == TerminatorType::Jump ? 1
+                                                                                : 2;
+        if (next == num_successors) {
+            order.push_back(block_id);
+            stack.pop_back();
+            continue;
+        }
+        const u32 successor = terminator.targets[next++];
+        if (!visited[successor]) {
+            visited[successor] = true;
+            stack.emplace_back(successor, 0);
+        }
+    }
+    std::ranges::reverse(order);
+    return order;
+}
+
+/// Builds the SSA form of a macro as described in "Simple and Efficient Construction of Static
+/// Single Assignment Form" by Braun et al.
+class Builder {
+public:
+    explicit Builder(std::span<const u32> code_) : code{code_} {}
+
+    std::optional<Function> Build() {
+        if (code.empty() || code.size() > MAX_CODE_SIZE || !FindLeaders()) {
+            return std::nullopt;
+        }
+        BuildBlocks();
+        EmitBlocks();
+        ResolveIdentities();
+        return std::move(function);
+    }
+
+private:
+    Macro::Opcode Instruction(u32 pc) const {
+        return {code[pc]};
+    }
+
+    /// Delay slots can not hold branches
+    bool IsValidDelaySlot(u32 pc) const {
+        return pc < code.size() && IsValidBody(Instruction(pc));
+    }
+
+    bool FindLeaders() {
+        is_leader.assign(code.size(), false);
+        std::vector<bool> visited(code.size());
+        std::vector<u32> worklist{0};
+        is_leader[0] = true;
+        const auto add_leader = [&](u32 pc) {
+            if (!is_leader[pc]) {
+                is_leader[pc] = true;
+                worklist.push_back(pc);
+            }
+        };
+        while (!worklist.empty()) {
+            u32 pc = worklist.back();
+            worklist.pop_back();
+            for (bool first = true;; first = false, ++pc) {
+                if (pc >= code.size()) {
+                    return false;
+                }
+                if (visited[pc]) {
+                    // Falling through into code explored from another leader
+                    if (!first) {
+                        is_leader[pc] = true;
+                    }
+                    break;
+                }
+                visited[pc] = true;
+                const Macro::Opcode opcode = Instruction(pc);
+                if (opcode.operation == Operation::Branch) {
+                    const s64 target = static_cast<s64>(pc) + opcode.immediate;
+                    if (target < 0 || target >= static_cast<s64>(code.size())) {
+                        return false;
+                    }
+                    if ((!opcode.branch_annul || opcode.is_exit) && !IsValidDelaySlot(pc + 1)) {
+                        return false;
+                    }
+                    add_leader(static_cast<u32>(target));
+                    if (!opcode.is_exit) {
+                        if (pc + 1 >= code.size()) {
+                            return false;
+                        }
+                        add_leader(pc + 1);
+                    }
+                    break;
+                }
+                if (!IsValidBody(opcode)) {
+                    return false;
+                }
+                if (opcode.is_exit) {
+                    if (!IsValidDelaySlot(pc + 1)) {
+                        return false;
+                    }
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool IsValidBody(Macro::Opcode opcode) {
+        switch (opcode.operation) {
+        case Operation::ALU:
+            return IsValidALUOperation(opcode.alu_operation);
+        case Operation::AddImmediate:
+        case Operation::ExtractInsert:
+        case Operation::ExtractShiftLeftImmediate:
+        case Operation::ExtractShiftLeftRegister:
+        case Operation::Read:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    u32 AddBlock() {
+        function.blocks.emplace_back();
+        steps.emplace_back();
+        branch_pcs.push_back(0);
+        return static_cast<u32>(function.blocks.size() - 1);
+    }
+
+    void AddEdge(u32 from, u32 to) {
+        function.blocks[to].predecessors.push_back(from);
+    }
+
+    void SetJump(u32 block_id, u32 target) {
+        function.blocks[block_id].terminator = {
+            .type = TerminatorType::Jump,
+            .cond = INVALID_VALUE,
+            .targets{target, 0},
+        };
+        AddEdge(block_id, target);
+    }
+
+    /// Creates a block executing a delay slot and then going to target, or exiting
+    u32 AddDelaySlotBlock(u32 pc, u32 target) {
+        const u32 block_id = AddBlock();
+        steps[block_id].push_back(pc);
+        if (target == INVALID_BLOCK) {
+            function.blocks[block_id].terminator.type = TerminatorType::Exit;
+        } else {
+            SetJump(block_id, target);
+        }
+        return block_id;
+    }
+
+    void BuildBlocks() {
+        // The entry block sets up the initial state and is never the target of a branch
+        const u32 entry = AddBlock();
+        std::vector<u32> leader_blocks(code.size(), INVALID_BLOCK);
+        for (u32 pc = 0; pc < code.size(); ++pc) {
+            if (is_leader[pc]) {
+                leader_blocks[pc] = AddBlock();
+            }
+        }
+        SetJump(entry, leader_blocks[0]);
+
+        for (u32 leader = 0; leader < code.size(); ++leader) {
+            if (!is_leader[leader]) {
+                continue;
+            }
+            const u32 block_id = leader_blocks[leader];
+            for (u32 pc = leader;; ++pc) {
+                const Macro::Opcode opcode = Instruction(pc);
+                if (opcode.operation == Operation::Branch) {
+                    const u32 target_pc = static_cast<u32>(static_cast<s64>(pc) + opcode.immediate);
+                    const u32 taken = opcode.branch_annul
+                                          ? leader_blocks[target_pc]
+                                          : AddDelaySlotBlock(pc + 1, leader_blocks[target_pc]);
+                    const u32 not_taken = opcode.is_exit ? AddDelaySlotBlock(pc + 1, INVALID_BLOCK)
+                                                         : leader_blocks[pc + 1];
+                    if (taken == not_taken) {
+                        SetJump(block_id, taken);
+                        break;
+                    }
+                    const bool on_zero = opcode.branch_condition == BranchCondition::Zero;
+                    Block& block = function.blocks[block_id];
+                    block.terminator.type = TerminatorType::Branch;
+                    block.terminator.targets = on_zero ? std::array{not_taken, taken}
+                                                       : std::array{taken, not_taken};
+                    AddEdge(block_id, block.terminator.targets[0]);
+                    AddEdge(block_id, block.terminator.targets[1]);
+                    branch_pcs[block_id] = pc;
+                    break;
+                }
+                steps[block_id].push_back(pc);
+                if (opcode.is_exit) {
+                    steps[block_id].push_back(pc + 1);
+                    function.blocks[block_id].terminator.type = TerminatorType::Exit;
+                    break;
+                }
+                if (is_leader[pc + 1]) {
+                    SetJump(block_id, leader_blocks[pc + 1]);
+                    break;
+                }
+            }
+        }
+    }
+
+    void EmitBlocks() {
+        const size_t num_blocks = function.blocks.size();
+        current_defs.assign(num_blocks, {});
+        for (auto& defs : current_defs) {
+            defs.fill(INVALID_VALUE);
+        }
+        incomplete_phis.assign(num_blocks, {});
+        sealed.assign(num_blocks, false);
+        num_filled_predecessors.assign(num_blocks, 0);
+
+        // Register 1 holds the first parameter, everything else starts zeroed
+        sealed[0] = true;
+        current_block = 0;
+        WriteVariable(1, 0, Emit(Opcode::Parameter));
+        for (u32 variable = 2; variable < NUM_VARIABLES; ++variable) {
+            WriteVariable(variable, 0, Const(0));
+        }
+
+        for (const u32 block_id : ReversePostOrder(function)) {
+            current_block = block_id;
+            for (const u32 pc : steps[block_id]) {
+                EmitInstruction(Instruction(pc));
+            }
+            Terminator& terminator = function.blocks[block_id].terminator;
+            if (terminator.type == TerminatorType::Branch) {
+                terminator.cond = Register(Instruction(branch_pcs[block_id]).src_a);
+            }
+            ForEachSuccessor(function.blocks[block_id], [&](u32 successor) {
+                ++num_filled_predecessors[successor];
+                if (num_filled_predecessors[successor] ==
+                    function.blocks[successor].predecessors.size()) {
+                    SealBlock(successor);
+                }
+            });
+        }
+    }
+
+    void EmitInstruction(Macro::Opcode opcode) {
+        Value result{};
+        switch (opcode.operation) {
+        case Operation::ALU:
+            result = EmitALU(opcode);
+            break;
+        case Operation::AddImmediate:
+            result = Emit(Opcode::Add, Register(opcode.src_a),
+                          Const(static_cast<u32>(opcode.immediate.Value())), Const(0));
+            break;
+        case Operation::ExtractInsert:
+            result = Emit(Opcode::ExtractInsert, Register(opcode.src_a), Register(opcode.src_b));
+            function.insts[result].imm = opcode.raw;
+            break;
+        case Operation::ExtractShiftLeftImmediate:
+            result = Emit(Opcode::ExtractShiftLeftImmediate, Register(opcode.src_a),
+                          Register(opcode.src_b));
+            function.insts[result].imm = opcode.raw;
+            break;
+        case Operation::ExtractShiftLeftRegister:
+            result = Emit(Opcode::ExtractShiftLeftRegister, Register(opcode.src_a),
+                          Register(opcode.src_b));
+            function.insts[result].imm = opcode.raw;
+            break;
+        case Operation::Read: {
+            const Value address = Emit(Opcode::Add, Register(opcode.src_a),
+                                       Const(static_cast<u32>(opcode.immediate.Value())), Const(0));
+            result = Emit(Opcode::Read, address);
+            break;
+        }
+        default:
+            break;
+        }
+        EmitResult(opcode.result_operation, opcode.dst, result);
+    }
+
+    Value EmitALU(Macro::Opcode opcode) {
+        const Value a = Register(opcode.src_a);
+        const Value b = Register(opcode.src_b);
+        const auto arithmetic = [&](Opcode value_op, Opcode carry_op, Value carry_in) {
+            const Value result = Emit(value_op, a, b, carry_in);
+            WriteVariable(CARRY_VARIABLE, current_block, Emit(carry_op, a, b, carry_in));
+            return result;
+        };
+        switch (opcode.alu_operation) {
+        case ALUOperation::Add:
+            return arithmetic(Opcode::Add, Opcode::AddCarry, Const(0));
+        case ALUOperation::AddWithCarry:
+            return arithmetic(Opcode::Add, Opcode::AddCarry, Variable(CARRY_VARIABLE));
+        case ALUOperation::Subtract:
+            return arithmetic(Opcode::Subtract, Opcode::SubtractCarry, Const(1));
+        case ALUOperation::SubtractWithBorrow:
+            return arithmetic(Opcode::Subtract, Opcode::SubtractCarry, Variable(CARRY_VARIABLE));
+        case ALUOperation::Xor:
+            return Emit(Opcode::Xor, a, b);
+        case ALUOperation::Or:
+            return Emit(Opcode::Or, a, b);
+        case ALUOperation::And:
+            return Emit(Opcode::And, a, b);
+        case ALUOperation::AndNot:
+            return Emit(Opcode::AndNot, a, b);
+        case ALUOperation::Nand:
+            return Emit(Opcode::Nand, a, b);
+        default:
+            return Const(0);
+        }
+    }
+
+    void EmitResult(ResultOperation operation, u32 reg, Value result) {
+        switch (operation) {
+        case ResultOperation::IgnoreAndFetch:
+            SetRegister(reg, Emit(Opcode::Parameter));
+            break;
+        case ResultOperation::Move:
+            SetRegister(reg, result);
+            break;
+        case ResultOperation::MoveAndSetMethod:
+            SetRegister(reg, result);
+            WriteVariable(METHOD_VARIABLE, current_block, result);
+            break;
+        case ResultOperation::FetchAndSend:
+            SetRegister(reg, Emit(Opcode::Parameter));
+            EmitSend(result);
+            break;
+        case ResultOperation::MoveAndSend:
+            SetRegister(reg, result);
+            EmitSend(result);
+            break;
+        case ResultOperation::FetchAndSetMethod:
+            SetRegister(reg, Emit(Opcode::Parameter));
+            WriteVariable(METHOD_VARIABLE, current_block, result);
+            break;
+        case ResultOperation::MoveAndSetMethodFetchAndSend:
+            SetRegister(reg, result);
+            WriteVariable(METHOD_VARIABLE, current_block, result);
+            EmitSend(Emit(Opcode::Parameter));
+            break;
+        case ResultOperation::MoveAndSetMethodSend: {
+            SetRegister(reg, result);
+            WriteVariable(METHOD_VARIABLE, current_block, result);
+            const Value value = Emit(Opcode::BitExtract, result);
+            function.insts[value].imm = 12 | (0x3f << 8);
+            EmitSend(value);
+            break;
+        }
+        }
+    }
+
+    void EmitSend(Value value) {
+        const Value method = Variable(METHOD_VARIABLE);
+        Emit(Opcode::Send, method, value);
+        WriteVariable(METHOD_VARIABLE, current_block, Emit(Opcode::MethodIncrement, method));
+    }
+
+    Value Register(u32 reg) {
+        return reg == 0 ? Const(0) : Variable(reg);
+    }
+
+    void SetRegister(u32 reg, Value value) {
+        if (reg != 0) {
+            WriteVariable(reg, current_block, value);
+        }
+    }
+
+    Value Variable(u32 variable) {
+        return ReadVariable(variable, current_block);
+    }
+
+    Value NewInst(Opcode opcode, Value a = INVALID_VALUE, Value b = INVALID_VALUE,
+                  Value c = INVALID_VALUE) {
+        function.insts.push_back({
+            .opcode = opcode,
+            .imm = 0,
+            .args{a, b, c},
+            .list{},
+        });
+        return static_cast<Value>(function.insts.size() - 1);
+    }
+
+    Value Emit(Opcode opcode, Value a = INVALID_VALUE, Value b = INVALID_VALUE,
+               Value c = INVALID_VALUE) {
+        const Value value = NewInst(opcode, a, b, c);
+        function.blocks[current_block].insts.push_back(value);
+        return value;
+    }
+
+    /// Constants are not placed in blocks, they are available everywhere
+    Value Const(u32 imm) {
+        const auto [it, is_new] = constants.try_emplace(imm, INVALID_VALUE);
+        if (is_new) {
+            it->second = NewInst(Opcode::Const);
+            function.insts[it->second].imm = imm;
+        }
+        return it->second;
+    }
+
+    void WriteVariable(u32 variable, u32 block_id, Value value) {
+        current_defs[block_id][variable] = value;
+    }
+
+    Value ReadVariable(u32 variable, u32 block_id) {
+        const Value def = current_defs[block_id][variable];
+        if (def != INVALID_VALUE) {
+            return def;
+        }
+        return ReadVariableRecursive(variable, block_id);
+    }
+
+    Value ReadVariableRecursive(u32 variable, u32 block_id) {
+        Value value;
+        const Block& block = function.blocks[block_id];
+        if (!sealed[block_id]) {
+            value = NewPhi(block_id);
+            incomplete_phis[block_id].emplace_back(variable, value);
+        } else if (block.predecessors.size() == 1) {
+            value = ReadVariable(variable, block.predecessors[0]);
+        } else {
+            value = NewPhi(block_id);
+            WriteVariable(variable, block_id, value);
+            value = AddPhiOperands(variable, value, block_id);
+        }
+        WriteVariable(variable, block_id, value);
+        return value;
+    }
+
+    Value NewPhi(u32 block_id) {
+        const Value phi = NewInst(Opcode::Phi);
+        Block& block = function.blocks[block_id];
+        const auto first_non_phi = std::ranges::find_if(block.insts, [&](Value value) {
+            return function.insts[value].opcode != Opcode::Phi;
+        });
+        block.insts.insert(first_non_phi, phi);
+        return phi;
+    }
+
+    Value AddPhiOperands(u32 variable, Value phi, u32 block_id) {
+        for (const u32 predecessor : function.blocks[block_id].predecessors) {
+            const Value operand = ReadVariable(variable, predecessor);
+            function.insts[phi].list.push_back(operand);
+        }
+        return TryRemoveTrivialPhi(phi);
+    }
+
+    Value TryRemoveTrivialPhi(Value phi) {
+        Value same = INVALID_VALUE;
+        for (const Value operand : function.insts[phi].list) {
+            const Value resolved = Resolve(function, operand);
+            if (resolved == same || resolved == phi) {
+                continue;
+            }
+            if (same != INVALID_VALUE) {
+                return phi;
+            }
+            same = resolved;
+        }
+        if (same == INVALID_VALUE) {
+            // Only reachable through itself
+            same = Const(0);
+        }
+        ReplaceWith(function, phi, same);
+        return same;
+    }
+
+    void SealBlock(u32 block_id) {
+        for (const auto& [variable, phi] : incomplete_phis[block_id]) {
+            AddPhiOperands(variable, phi, block_id);
+        }
+        incomplete_phis[block_id].clear();
+        sealed[block_id] = true;
+    }
+
+    void ResolveIdentities() {
+        for (Block& block : function.blocks) {
+            std::erase_if(block.insts, [&](Value value) {
+                return function.insts[value].opcode == Opcode::Identity;
+            });
+            for (const Value value : block.insts) {
+                Inst& inst = function.insts[value];
+                for (Value& arg : inst.args) {
+                    arg = Resolve(function, arg);
+                }
+                if (inst.opcode == Opcode::Phi) {
+                    for (u32& operand : inst.list) {
+                        operand = Resolve(function, operand);
+                    }
+                }
+            }
+            block.terminator.cond = Resolve(function, block.terminator.cond);
+        }
+    }
+
+    std::span<const u32> code;
+    Function function;
+
+    std::vector<bool> is_leader;
+    std::vector<std::vector<u32>> steps;
+    std::vector<u32> branch_pcs;
+
+    u32 current_block{};
+    std::map<u32, Value> constants;
+    std::vector<std::array<Value, NUM_VARIABLES>> current_defs;
+    std::vector<std::vector<std::pair<u32, Value>>> incomplete_phis;
+    std::vector<bool> sealed;
+    std::vector<size_t> num_filled_predecessors;
+};
+
+/// Returns a constant holding imm, reusing an existing one when possible
+Value GetConst(Function& function, std::map<u32, Value>& constants, u32 imm) {
+    const auto [it, is_new] = constants.try_emplace(imm, INVALID_VALUE);
+    if (is_new) {
+        function.insts.push_back({
+            .opcode = Opcode::Const,
+            .imm = imm,
+            .args{INVALID_VALUE, INVALID_VALUE, INVALID_VALUE},
+            .list{},
+        });
+        it->second = static_cast<Value>(function.insts.size() - 1);
+    }
+    return it->second;
+}
+
+/// Simplifies an instruction with some constant arguments, returns the value replacing it
+Value Simplify(Function& function, std::map<u32, Value>& constants, Value value) {
+    const Inst& inst = function.insts[value];
+    const auto [a, b, c] = inst.args;
+    const auto is_zero = [&](Value arg) { return IsConst(function, arg, 0); };
+    switch (inst.opcode) {
+    case Opcode::Add:
+        if (is_zero(c) && (is_zero(a) || is_zero(b))) {
+            return is_zero(a) ? b : a;
+        }
+        break;
+    case Opcode::AddCarry:
+        if (is_zero(c) && (is_zero(a) || is_zero(b))) {
+            return GetConst(function, constants, 0);
+        }
+        break;
+    case Opcode::Subtract:
+        if (is_zero(b) && IsConst(function, c, 1)) {
+            return a;
+        }
+        break;
+    case Opcode::SubtractCarry:
+        if (is_zero(b) && IsConst(function, c, 1)) {
+            return GetConst(function, constants, 1);
+        }
+        break;
+    case Opcode::Xor:
+    case Opcode::Or:
+        if (is_zero(a) || is_zero(b)) {
+            return is_zero(a) ? b : a;
+        }
+        if (a == b) {
+            return inst.opcode == Opcode::Or ? a : GetConst(function, constants, 0);
+        }
+        break;
+    case Opcode::And:
+        if (is_zero(a) || is_zero(b)) {
+            return GetConst(function, constants, 0);
+        }
+        if (a == b) {
+            return a;
+        }
+        break;
+    case Opcode::AndNot:
+        if (is_zero(a) || a == b) {
+            return GetConst(function, constants, 0);
+        }
+        if (is_zero(b)) {
+            return a;
+        }
+        break;
+    default:
+        break;
+    }
+    return value;
+}
+
+bool FoldConstants(Function& function, std::map<u32, Value>& constants) {
+    bool changed = false;
+    for (Block& block : function.blocks) {
+        for (const Value value : block.insts) {
+            Inst& inst = function.insts[value];
+            for (Value& arg : inst.args) {
+                arg = Resolve(function, arg);
+            }
+            if (inst.opcode == Opcode::Phi) {
+                Value same = INVALID_VALUE;
+                bool is_trivial = true;
+                for (u32& operand : inst.list) {
+                    operand = Resolve(function, operand);
+                    if (operand == value || operand == same) {
+                        continue;
+                    }
+                    if (same != INVALID_VALUE && !(IsConst(function, same) &&
+                                                   IsConst(function, operand,
+                                                           function.insts[same].imm))) {
+                        is_trivial = false;
+                    }
+                    same = operand;
+                }
+                if (is_trivial && same != INVALID_VALUE) {
+                    ReplaceWith(function, value, same);
+                    changed = true;
+                }
+                continue;
+            }
+            if (!IsPure(inst.opcode)) {
+                continue;
+            }
+            const size_t num_args = NumArgs(inst.opcode);
+            bool all_const = true;
+            for (size_t i = 0; i < num_args; ++i) {
+                all_const &= IsConst(function, inst.args[i]);
+            }
+            if (all_const) {
+                const auto arg = [&](size_t i) {
+                    return i < num_args ? function.insts[inst.args[i]].imm : 0;
+                };
+                const u32 result = Evaluate(inst.opcode, inst.imm, arg(0), arg(1), arg(2));
+                ReplaceWith(function, value, GetConst(function, constants, result));
+                changed = true;
+                continue;
+            }
+            const Value replacement = Simplify(function, constants, value);
+            if (replacement != value) {
+                ReplaceWith(function, value, replacement);
+                changed = true;
+            }
+        }
+        block.terminator.cond = Resolve(function, block.terminator.cond);
+        std::erase_if(block.insts, [&](Value value) {
+            return function.insts[value].opcode == Opcode::Identity;
+        });
+    }
+    return changed;
+}
+
+bool FoldBranches(Function& function) {
+    bool changed = false;
+    for (u32 block_id = 0; block_id < function.blocks.size(); ++block_id) {
+        Terminator& terminator = function.blocks[block_id].terminator;
+        if (terminator.type != TerminatorType::Branch || !IsConst(function, terminator.cond)) {
+            continue;
+        }
+        const bool taken = function.insts[terminator.cond].imm != 0;
+        const u32 target = terminator.targets[taken ? 0 : 1];
+        const u32 skipped = terminator.targets[taken ? 1 : 0];
+        terminator = {
+            .type = TerminatorType::Jump,
+            .cond = INVALID_VALUE,
+            .targets{target, 0},
+        };
+        RemovePredecessor(function, skipped, block_id);
+        changed = true;
+    }
+    return changed;
+}
+
+/// Merges blocks with a single predecessor that jumps straight into them
+bool MergeBlocks(Function& function) {
+    bool changed = false;
+    for (u32 block_id = 0; block_id < function.blocks.size(); ++block_id) {
+        for (;;) {
+            Block& block = function.blocks[block_id];
+            if (block.terminator.type != TerminatorType::Jump) {
+                break;
+            }
+            const u32 next_id = block.terminator.targets[0];
+            Block& next = function.blocks[next_id];
+            if (next_id == block_id || next_id == 0 || next.predecessors.size() != 1) {
+                break;
+            }
+            for (const Value value : next.insts) {
+                Inst& inst = function.insts[value];
+                if (inst.opcode == Opcode::Phi) {
+                    ReplaceWith(function, value, inst.list[0]);
+                } else {
+                    block.insts.push_back(value);
+                }
+            }
+            block.terminator = next.terminator;
+            next.insts.clear();
+            next.predecessors.clear();
+            next.terminator = {};
+            ForEachSuccessor(block, [&](u32 successor) {
+                for (u32& predecessor : function.blocks[successor].predecessors) {
+                    if (predecessor == next_id) {
+                        predecessor = block_id;
+                    }
+                }
+            });
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/// Drops blocks that can not be reached from the entry point and renumbers the rest
+bool RemoveUnreachableBlocks(Function& function) {
+    const std::vector<u32> order = ReversePostOrder(function);
+    if (order.size() == function.blocks.size()) {
+        return false;
+    }
+    std::vector<u32> remap(function.blocks.size(), INVALID_BLOCK);
+    for (const u32 block_id : order) {
+        remap[block_id] = 0;
+    }
+    for (u32 block_id = 0; block_id < function.blocks.size(); ++block_id) {
+        if (remap[block_id] != INVALID_BLOCK) {
+            continue;
+        }
+        ForEachSuccessor(function.blocks[block_id], [&](u32 successor) {
+            if (remap[successor] != INVALID_BLOCK) {
+                RemovePredecessor(function, successor, block_id);
+            }
+        });
+    }
+    std::vector<Block> blocks;
+    blocks.reserve(order.size());
+    for (u32 block_id = 0; block_id < function.blocks.size(); ++block_id) {
+        if (remap[block_id] != INVALID_BLOCK) {
+            remap[block_id] = static_cast<u32>(blocks.size());
+            blocks.push_back(std::move(function.blocks[block_id]));
+        }
+    }
+    for (Block& block : blocks) {
+        for (u32& predecessor : block.predecessors) {
+            predecessor = remap[predecessor];
+        }
+        for (u32& target : block.terminator.targets) {
+            if (target < remap.size() && remap[target] != INVALID_BLOCK) {
+                target = remap[target];
+            }
+        }
+    }
+    function.blocks = std::move(blocks);
+    return true;
+}
+
+/// Removes instructions whose results are never used. Since every write to a macro register, the
+/// method address or the carry flag is its own value, this also drops dead stores to them.
+void EliminateDeadCode(Function& function) {
+    std::vector<bool> live(function.insts.size());
+    std::vector<Value> worklist;
+    const auto mark = [&](Value value) {
+        if (value != INVALID_VALUE && !live[value]) {
+            live[value] = true;
+            worklist.push_back(value);
+        }
+    };
+    for (const Block& block : function.blocks) {
+        for (const Value value : block.insts) {
+            if (HasSideEffects(function.insts[value].opcode)) {
+                mark(value);
+            }
+        }
+        mark(block.terminator.cond);
+    }
+    while (!worklist.empty()) {
+        const Inst& inst = function.insts[worklist.back()];
+        worklist.pop_back();
+        for (size_t i = 0; i < NumArgs(inst.opcode); ++i) {
+            mark(inst.args[i]);
+        }
+        if (inst.opcode == Opcode::Phi) {
+            for (const u32 operand : inst.list) {
+                mark(operand);
+            }
+        }
+    }
+    for (Block& block : function.blocks) {
+        std::erase_if(block.insts, [&](Value value) { return !live[value]; });
+    }
+}
+
+/// Renumbers values so that only referenced instructions remain
+void Compact(Function& function) {
+    std::vector<Value> remap(function.insts.size(), INVALID_VALUE);
+    std::vector<Inst> insts;
+    const auto add = [&](Value value) {
+        if (value != INVALID_VALUE && remap[value] == INVALID_VALUE) {
+            remap[value] = static_cast<Value>(insts.size());
+            insts.push_back(function.insts[value]);
+        }
+    };
+    for (const Block& block : function.blocks) {
+        for (const Value value : block.insts) {
+            const Inst& inst = function.insts[value];
+            for (size_t i = 0; i < NumArgs(inst.opcode); ++i) {
+                add(inst.args[i]);
+            }
+            if (inst.opcode == Opcode::Phi) {
+                for (const u32 operand : inst.list) {
+                    add(operand);
+                }
+            }
+            add(value);
+        }
+        add(block.terminator.cond);
+    }
+    for (Inst& inst : insts) {
+        for (size_t i = 0; i < NumArgs(inst.opcode); ++i) {
+            inst.args[i] = remap[inst.args[i]];
+        }
+        if (inst.opcode == Opcode::Phi) {
+            for (u32& operand : inst.list) {
+                operand = remap[operand];
+            }
+        }
+    }
+    for (Block& block : function.blocks) {
+        for (Value& value : block.insts) {
+            value = remap[value];
+        }
+        if (block.terminator.cond != INVALID_VALUE) {
+            block.terminator.cond = remap[block.terminator.cond];
+        }
+    }
+    function.insts = std::move(insts);
+}
+
+template <typename T>
+void Write(std::vector<u8>& out, const T& value) {
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+bool Read(std::span<const u8>& in, T& value) {
+    if (in.size() < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, in.data(), sizeof(T));
+    in = in.subspan(sizeof(T));
+    return true;
+}
+
+bool ReadList(std::span<const u8>& in, std::vector<u32>& list, size_t max_size) {
+    u32 size{};
+    if (!Read(in, size) || size > max_size || in.size() < size * sizeof(u32)) {
+        return false;
+    }
+    list.resize(size);
+    if (size != 0) {
+        std::memcpy(list.data(), in.data(), size * sizeof(u32));
+    }
+    in = in.subspan(size * sizeof(u32));
+    return true;
+}
+
+void WriteList(std::vector<u8>& out, const std::vector<u32>& list) {
+    Write(out, static_cast<u32>(list.size()));
+    const size_t offset = out.size();
+    if (!list.empty()) {
+        out.resize(offset + list.size() * sizeof(u32));
+        std::memcpy(out.data() + offset, list.data(), list.size() * sizeof(u32));
+    }
+}
+
+} // Anonymous namespace
+
+u32 Evaluate(Opcode opcode, u32 imm, u32 a, u32 b, u32 c) {
+    switch (opcode) {
+    case Opcode::Const:
+        return imm;
+    case Opcode::Add:
+        return static_cast<u32>(u64{a} + b + (c != 0 ? 1 : 0));
+    case Opcode::AddCarry:
+        return u64{a} + b + (c != 0 ? 1 : 0) > 0xffffffff ? 1 : 0;
+    case Opcode::Subtract:
+        return static_cast<u32>(u64{a} - b - (c != 0 ? 0 : 1));
+    case Opcode::SubtractCarry:
+        return u64{a} - b - (c != 0 ? 0 : 1) < 0x100000000 ? 1 : 0;
+    case Opcode::Xor:
+        return a ^ b;
+    case Opcode::Or:
+        return a | b;
+    case Opcode::And:
+        return a & b;
+    case Opcode::AndNot:
+        return a & ~b;
+    case Opcode::Nand:
+        return ~(a & b);
+    case Opcode::BitExtract:
+        return (a >> (imm & 0xff)) & (imm >> 8);
+    case Opcode::ExtractInsert: {
+        const Macro::Opcode opcode_bits{imm};
+        const u32 mask = opcode_bits.GetBitfieldMask();
+        const u32 src = (b >> opcode_bits.bf_src_bit) & mask;
+        return (a & ~(mask << opcode_bits.bf_dst_bit)) | (src << opcode_bits.bf_dst_bit);
+    }
+    case Opcode::ExtractShiftLeftImmediate: {
+        const Macro::Opcode opcode_bits{imm};
+        return ((b >> (a & 31)) & opcode_bits.GetBitfieldMask()) << opcode_bits.bf_dst_bit;
+    }
+    case Opcode::ExtractShiftLeftRegister: {
+        const Macro::Opcode opcode_bits{imm};
+        return ((b >> opcode_bits.bf_src_bit) & opcode_bits.GetBitfieldMask()) << (a & 31);
+    }
+    case Opcode::MethodIncrement: {
+        MethodAddress method{a};
+        method.address.Assign(method.address.Value() + method.increment.Value());
+        return method.raw;
+    }
+    default:
+        return 0;
+    }
+}
+
+std::optional<Function> Lower(std::span<const u32> code) {
+    std::optional<Function> function = Builder{code}.Build();
+    if (function) {
+        Compact(*function);
+    }
+    return function;
+}
+
+void Optimize(Function& function) {
+    std::map<u32, Value> constants;
+    for (Value value = 0; value < function.insts.size(); ++value) {
+        const Inst& inst = function.insts[value];
+        if (inst.opcode == Opcode::Const) {
+            constants.try_emplace(inst.imm, value);
+        }
+    }
+    bool changed = true;
+    while (changed) {
+        changed = FoldConstants(function, constants);
+        changed |= FoldBranches(function);
+        changed |= MergeBlocks(function);
+        changed |= RemoveUnreachableBlocks(function);
+    }
+    EliminateDeadCode(function);
+    Compact(function);
+}
+
+void BatchSends(Function& function) {
+    const auto batch_method = [&](Value value) -> std::optional<u32> {
+        const Inst& inst = function.insts[value];
+        if (inst.opcode != Opcode::Send || !IsConst(function, inst.args[0]) ||
+            !IsConst(function, inst.args[1])) {
+            return std::nullopt;
+        }
+        return MethodAddress{function.insts[inst.args[0]].imm}.address.Value();
+    };
+    for (Block& block : function.blocks) {
+        std::vector<Value> insts;
+        insts.reserve(block.insts.size());
+        for (size_t i = 0; i < block.insts.size();) {
+            const std::optional<u32> method = batch_method(block.insts[i]);
+            size_t end = i + 1;
+            while (method && end < block.insts.size() && batch_method(block.insts[end]) == method) {
+                ++end;
+            }
+            if (end - i < 2) {
+                insts.push_back(block.insts[i++]);
+                continue;
+            }
+            Inst& batch = function.insts[block.insts[i]];
+            std::vector<u32> values;
+            for (size_t j = i; j < end; ++j) {
+                values.push_back(function.insts[function.insts[block.insts[j]].args[1]].imm);
+            }
+            batch.opcode = Opcode::SendBatch;
+            batch.imm = *method;
+            batch.args = {INVALID_VALUE, INVALID_VALUE, INVALID_VALUE};
+            batch.list = std::move(values);
+            insts.push_back(block.insts[i]);
+            i = end;
+        }
+        block.insts = std::move(insts);
+    }
+    Compact(function);
+}
+
+bool Validate(const Function& function) {
+    const size_t num_insts = function.insts.size();
+    const size_t num_blocks = function.blocks.size();
+    if (num_blocks == 0 || !function.blocks[0].predecessors.empty()) {
+        return false;
+    }
+    for (const Inst& inst : function.insts) {
+        if (inst.opcode == Opcode::Identity || inst.opcode > Opcode::SendBatch) {
+            return false;
+        }
+        for (size_t i = 0; i < NumArgs(inst.opcode); ++i) {
+            if (inst.args[i] >= num_insts) {
+                return false;
+            }
+        }
+    }
+    std::vector<bool> placed(num_insts);
+    for (u32 block_id = 0; block_id < num_blocks; ++block_id) {
+        const Block& block = function.blocks[block_id];
+        bool past_phis = false;
+        for (const Value value : block.insts) {
+            if (value >= num_insts || placed[value]) {
+                return false;
+            }
+            placed[value] = true;
+            const Inst& inst = function.insts[value];
+            if (inst.opcode == Opcode::Const) {
+                return false;
+            }
+            if (inst.opcode == Opcode::Phi) {
+                if (past_phis || inst.list.size() != block.predecessors.size() ||
+                    std::ranges::any_of(inst.list, [&](u32 arg) { return arg >= num_insts; })) {
+                    return false;
+                }
+            } else {
+                past_phis = true;
+            }
+        }
+        const Terminator& terminator = block.terminator;
+        switch (terminator.type) {
+        case TerminatorType::Exit:
+            break;
+        case TerminatorType::Branch:
+            if (terminator.cond >= num_insts || terminator.targets[0] == terminator.targets[1]) {
+                return false;
+            }
+            [[fallthrough]];
+        case TerminatorType::Jump:
+            for (size_t i = 0; i < (terminator.type == TerminatorType::Jump ? 1 : 2); ++i) {
+                const u32 target = terminator.targets[i];
+                if (target >= num_blocks || target == 0 ||
+                    std::ranges::count(function.blocks[target].predecessors, block_id) != 1) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            return false;
+        }
+        for (const u32 predecessor : block.predecessors) {
+            if (predecessor >= num_blocks) {
+                return false;
+            }
+            const Terminator& edge = function.blocks[predecessor].terminator;
+            const bool links = (edge.type != TerminatorType::Exit && edge.targets[0] == block_id) ||
+                               (edge.type == TerminatorType::Branch && edge.targets[1] == block_id);
+            if (!links) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void Serialize(const Function& function, std::vector<u8>& out) {
+    Write(out, static_cast<u32>(function.insts.size()));
+    for (const Inst& inst : function.insts) {
+        Write(out, inst.opcode);
+        Write(out, inst.imm);
+        Write(out, inst.args);
+        WriteList(out, inst.list);
+    }
+    Write(out, static_cast<u32>(function.blocks.size()));
+    for (const Block& block : function.blocks) {
+        WriteList(out, block.insts);
+        WriteList(out, block.predecessors);
+        Write(out, block.terminator.type);
+        Write(out, block.terminator.cond);
+        Write(out, block.terminator.targets);
+    }
+}
+
+std::optional<Function> DeserializeFunction(std::span<const u8>& in) {
+    // Generous bounds that no valid function reaches, to reject corrupted sizes early
+    constexpr size_t MAX_ITEMS = MAX_CODE_SIZE * 64;
+    Function function;
+    u32 num_insts{};
+    if (!Read(in, num_insts) || num_insts > MAX_ITEMS) {
+        return std::nullopt;
+    }
+    function.insts.resize(num_insts);
+    for (Inst& inst : function.insts) {
+        if (!Read(in, inst.opcode) || !Read(in, inst.imm) || !Read(in, inst.args) ||
+            !ReadList(in, inst.list, MAX_ITEMS)) {
+            return std::nullopt;
+        }
+    }
+    u32 num_blocks{};
+    if (!Read(in, num_blocks) || num_blocks > MAX_ITEMS) {
+        return std::nullopt;
+    }
+    function.blocks.resize(num_blocks);
+    for (Block& block : function.blocks) {
+        if (!ReadList(in, block.insts, MAX_ITEMS) || !ReadList(in, block.predecessors, MAX_ITEMS) ||
+            !Read(in, block.terminator.type) || !Read(in, block.terminator.cond) ||
+            !Read(in, block.terminator.targets)) {
+            return std::nullopt;
+        }
+    }
+    if (!Validate(function)) {
+        return std::nullopt;
+    }
+    return function;
+}
+
+void Serialize(const Specialization& specialization, std::vector<u8>& out) {
+    WriteList(out, specialization.parameters);
+    Write(out, static_cast<u32>(specialization.guards.size()));
+    for (const auto& [reg, value] : specialization.guards) {
+        Write(out, reg);
+        Write(out, value);
+    }
+    Serialize(specialization.residual, out);
+}
+
+std::optional<Specialization> DeserializeSpecialization(std::span<const u8>& in) {
+    Specialization specialization;
+    u32 num_guards{};
+    if (!ReadList(in, specialization.parameters, MAX_CODE_SIZE * 64) || !Read(in, num_guards) ||
+        num_guards > Specialization::MAX_GUARDS) {
+        return std::nullopt;
+    }
+    specialization.guards.resize(num_guards);
+    for (auto& [reg, value] : specialization.guards) {
+        if (!Read(in, reg) || !Read(in, value)) {
+            return std::nullopt;
+        }
+    }
+    auto residual = DeserializeFunction(in);
+    if (!residual) {
+        return std::nullopt;
+    }
+    specialization.residual = std::move(*residual);
+    return specialization;
+}
+
+} // namespace Tegra::Macro::IR
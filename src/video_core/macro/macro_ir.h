@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Tegra::Macro::IR {
+
+/// Index of an instruction in Function::insts, instructions are their own result
+using Value = u32;
+constexpr Value INVALID_VALUE = ~Value{0};
+
+enum class Opcode : u8 {
+    Identity,                  ///< Alias of args[0], only present while building
+    Const,                     ///< imm
+    Phi,                       ///< One operand in list for each predecessor of the block
+    Parameter,                 ///< Next macro parameter
+    Read,                      ///< Maxwell3D register args[0]
+    Add,                       ///< args[0] + args[1] + args[2]
+    AddCarry,                  ///< Carry out of Add
+    Subtract,                  ///< args[0] - args[1] - (1 - args[2])
+    SubtractCarry,             ///< Carry out of Subtract, set when there is no borrow
+    Xor,                       ///< args[0] ^ args[1]
+    Or,                        ///< args[0] | args[1]
+    And,                       ///< args[0] & args[1]
+    AndNot,                    ///< args[0] & ~args[1]
+    Nand,                      ///< ~(args[0] & args[1])
+    BitExtract,                ///< (args[0] >> (imm & 0xff)) & (imm >> 8)
+    ExtractInsert,             ///< Bitfield instructions, imm holds the macro opcode
+    ExtractShiftLeftImmediate, ///<
+    ExtractShiftLeftRegister,  ///<
+    MethodIncrement,           ///< Method address args[0] after a send
+    Send,                      ///< Calls method args[0] with args[1]
+    SendBatch,                 ///< Calls method imm with each value in list
+};
+
+/// Returns true when the instruction has to be kept even if its result is unused
+[[nodiscard]] constexpr bool HasSideEffects(Opcode opcode) {
+    return opcode == Opcode::Parameter || opcode == Opcode::Send || opcode == Opcode::SendBatch;
+}
+
+/// Returns the number of values read from args
+[[nodiscard]] constexpr size_t NumArgs(Opcode opcode) {
+    switch (opcode) {
+    case Opcode::Identity:
+    case Opcode::Read:
+    case Opcode::BitExtract:
+    case Opcode::MethodIncrement:
+        return 1;
+    case Opcode::Xor:
+    case Opcode::Or:
+    case Opcode::And:
+    case Opcode::AndNot:
+    case Opcode::Nand:
+    case Opcode::ExtractInsert:
+    case Opcode::ExtractShiftLeftImmediate:
+    case Opcode::ExtractShiftLeftRegister:
+    case Opcode::Send:
+        return 2;
+    case Opcode::Add:
+    case Opcode::AddCarry:
+    case Opcode::Subtract:
+    case Opcode::SubtractCarry:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+struct Inst {
+    Opcode opcode{};
+    u32 imm{};
+    std::array<Value, 3> args{INVALID_VALUE, INVALID_VALUE, INVALID_VALUE};
+    /// Phi operands in predecessor order, or the arguments of a SendBatch
+    std::vector<u32> list;
+};
+
+enum class TerminatorType : u8 {
+    Exit,
+    Jump,   ///< Goes to targets[0]
+    Branch, ///< Goes to targets[0] when cond is not zero, targets[1] otherwise
+};
+
+struct Terminator {
+    TerminatorType type{};
+    Value cond{INVALID_VALUE};
+    std::array<u32, 2> targets{};
+};
+
+struct Block {
+    /// Instructions in execution order, phis first
+    std::vector<Value> insts;
+    std::vector<u32> predecessors;
+    Terminator terminator;
+};
+
+/// Macro program in SSA form, block 0 is the entry point
+struct Function {
+    std::vector<Inst> insts;
+    std::vector<Block> blocks;
+};
+
+/**
+ * Straight-line version of a function for one list of parameters, with every register read before
+ * the first send folded. It is valid while the registers in guards hold the values they had when it
+ * was traced.
+ */
+struct Specialization {
+    static constexpr size_t MAX_GUARDS = 64;
+
+    std::vector<u32> parameters;
+    /// Register and expected value pairs
+    std::vector<std::pair<u32, u32>> guards;
+    Function residual;
+};
+
+/// Folds an instruction with constant arguments
+[[nodiscard]] u32 Evaluate(Opcode opcode, u32 imm, u32 a, u32 b, u32 c);
+
+/// Builds the SSA form of macro code, returns nullopt on encodings it does not handle
+[[nodiscard]] std::optional<Function> Lower(std::span<const u32> code);
+
+/// Folds constants and known branches, then removes dead instructions and blocks
+void Optimize(Function& function);
+
+/// Merges runs of sends with the same constant method and constant arguments into batches
+void BatchSends(Function& function);
+
+/// Returns true when the function is well formed, used to validate deserialized functions
+[[nodiscard]] bool Validate(const Function& function);
+
+void Serialize(const Function& function, std::vector<u8>& out);
+void Serialize(const Specialization& specialization, std::vector<u8>& out);
+
+/// Reads a function written by Serialize, advancing the input span
+[[nodiscard]] std::optional<Function> DeserializeFunction(std::span<const u8>& in);
+
+/// Reads a specialization written by Serialize, advancing the input span
+[[nodiscard]] std::optional<Specialization> DeserializeSpecialization(std::span<const u8>& in);
+
+} // namespace Tegra::Macro::IR
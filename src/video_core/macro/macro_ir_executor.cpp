@@ -0,0 +1,349 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_ir_executor.h"
+
+namespace Tegra::Macro::IR {
+
+namespace {
+
+/// Traces that emit more instructions than this are not worth keeping around
+constexpr size_t MAX_RESIDUAL_SIZE = 4096;
+
+u32 MethodOf(u32 value) {
+    return MethodAddress{value}.address.Value();
+}
+
+class Tracer {
+public:
+    explicit Tracer(const Function& function_, Environment& env_, std::span<const u32> parameters_)
+        : function{function_}, env{env_}, parameters{parameters_} {}
+
+    std::optional<Specialization> Run() {
+        const size_t num_insts = function.insts.size();
+        values.assign(num_insts, 0);
+        mapped.assign(num_insts, INVALID_VALUE);
+        deps.assign(num_insts, 0);
+        residual.blocks.resize(1);
+        for (Value value = 0; value < num_insts; ++value) {
+            const Inst& inst = function.insts[value];
+            if (inst.opcode == Opcode::Const) {
+                values[value] = inst.imm;
+                mapped[value] = Const(inst.imm);
+            }
+        }
+
+        u32 block_id = 0;
+        u32 previous = 0;
+        for (;;) {
+            const Block& block = function.blocks[block_id];
+            ExecutePhis(block, previous);
+            for (const Value value : block.insts) {
+                if (function.insts[value].opcode != Opcode::Phi) {
+                    ExecuteInst(value);
+                }
+            }
+            const Terminator& terminator = block.terminator;
+            if (terminator.type == TerminatorType::Exit) {
+                break;
+            }
+            u32 next = terminator.targets[0];
+            if (terminator.type == TerminatorType::Branch) {
+                if (!IsStatic(terminator.cond)) {
+                    tracing = false;
+                }
+                used_guards |= deps[terminator.cond];
+                next = terminator.targets[values[terminator.cond] != 0 ? 0 : 1];
+            }
+            previous = block_id;
+            block_id = next;
+        }
+        if (!tracing) {
+            return std::nullopt;
+        }
+
+        Specialization specialization{
+            .parameters{parameters.begin(), parameters.end()},
+            .guards{},
+            .residual = std::move(residual),
+        };
+        for (size_t index = 0; index < guards.size(); ++index) {
+            if ((used_guards >> index) & 1) {
+                specialization.guards.push_back(guards[index]);
+            }
+        }
+        Optimize(specialization.residual);
+        BatchSends(specialization.residual);
+        return specialization;
+    }
+
+private:
+    void ExecutePhis(const Block& block, u32 previous) {
+        const auto it = std::ranges::find(block.predecessors, previous);
+        const auto index = static_cast<size_t>(it - block.predecessors.begin());
+        phi_scratch.clear();
+        for (const Value value : block.insts) {
+            const Inst& inst = function.insts[value];
+            if (inst.opcode != Opcode::Phi) {
+                break;
+            }
+            const Value operand = inst.list[index];
+            phi_scratch.push_back({value, values[operand], mapped[operand], deps[operand]});
+        }
+        for (const PhiCopy& copy : phi_scratch) {
+            values[copy.phi] = copy.value;
+            mapped[copy.phi] = copy.mapped;
+            deps[copy.phi] = copy.deps;
+        }
+    }
+
+    void ExecuteInst(Value value) {
+        const Inst& inst = function.insts[value];
+        const auto [a, b, c] = inst.args;
+        switch (inst.opcode) {
+        case Opcode::Parameter:
+            values[value] = next_parameter < parameters.size() ? parameters[next_parameter] : 0;
+            ++next_parameter;
+            mapped[value] = Const(values[value]);
+            break;
+        case Opcode::Read:
+            values[value] = env.ReadRegister(values[a]);
+            if (!sent && IsStatic(a)) {
+                // Nothing the macro does can change registers before it calls a method
+                deps[value] = deps[a] | Guard(values[a], values[value]);
+                mapped[value] = Const(values[value]);
+            } else {
+                Use(a);
+                mapped[value] = Emit(inst);
+            }
+            break;
+        case Opcode::Send:
+            env.CallMethod(MethodOf(values[a]), values[b]);
+            sent = true;
+            Use(a);
+            Use(b);
+            Emit(inst);
+            break;
+        case Opcode::SendBatch:
+            env.CallMultiMethod(inst.imm, inst.list);
+            sent = true;
+            Emit(inst);
+            break;
+        default: {
+            const size_t num_args = NumArgs(inst.opcode);
+            const auto arg = [&](size_t i) { return i < num_args ? values[inst.args[i]] : 0; };
+            values[value] = Evaluate(inst.opcode, inst.imm, arg(0), arg(1), arg(2));
+            bool is_static = true;
+            u64 value_deps = 0;
+            for (size_t i = 0; i < num_args; ++i) {
+                is_static &= IsStatic(inst.args[i]);
+                value_deps |= deps[inst.args[i]];
+            }
+            if (is_static) {
+                deps[value] = value_deps;
+                mapped[value] = Const(values[value]);
+            } else {
+                used_guards |= value_deps;
+                mapped[value] = Emit(inst);
+            }
+            break;
+        }
+        }
+    }
+
+    bool IsStatic(Value value) const {
+        const Value residual_value = mapped[value];
+        return residual_value != INVALID_VALUE &&
+               residual.insts[residual_value].opcode == Opcode::Const;
+    }
+
+    void Use(Value value) {
+        used_guards |= deps[value];
+    }
+
+    /// Returns the mask of the guard expecting reg to hold value
+    u64 Guard(u32 reg, u32 value) {
+        const auto [it, is_new] = guard_indices.try_emplace(reg, guards.size());
+        if (is_new) {
+            if (guards.size() == Specialization::MAX_GUARDS) {
+                tracing = false;
+                return 0;
+            }
+            guards.emplace_back(reg, value);
+        }
+        return u64{1} << it->second;
+    }
+
+    Value Const(u32 imm) {
+        const auto [it, is_new] = constants.try_emplace(imm, INVALID_VALUE);
+        if (is_new) {
+            residual.insts.push_back({
+                .opcode = Opcode::Const,
+                .imm = imm,
+                .args{INVALID_VALUE, INVALID_VALUE, INVALID_VALUE},
+                .list{},
+            });
+            it->second = static_cast<Value>(residual.insts.size() - 1);
+        }
+        return it->second;
+    }
+
+    /// Copies an instruction to the residual with its arguments remapped
+    Value Emit(const Inst& inst) {
+        if (!tracing) {
+            return INVALID_VALUE;
+        }
+        if (residual.blocks[0].insts.size() == MAX_RESIDUAL_SIZE) {
+            tracing = false;
+            return INVALID_VALUE;
+        }
+        Inst copy = inst;
+        for (size_t i = 0; i < NumArgs(inst.opcode); ++i) {
+            copy.args[i] = mapped[inst.args[i]];
+        }
+        residual.insts.push_back(std::move(copy));
+        const auto value = static_cast<Value>(residual.insts.size() - 1);
+        residual.blocks[0].insts.push_back(value);
+        return value;
+    }
+
+    struct PhiCopy {
+        Value phi;
+        u32 value;
+        Value mapped;
+        u64 deps;
+    };
+
+    const Function& function;
+    Environment& env;
+    std::span<const u32> parameters;
+
+    /// Values computed by the function
+    std::vector<u32> values;
+    /// Value in the residual matching each value of the function
+    std::vector<Value> mapped;
+    /// Guards each constant value depends on
+    std::vector<u64> deps;
+    std::vector<PhiCopy> phi_scratch;
+
+    Function residual;
+    std::map<u32, Value> constants;
+    std::vector<std::pair<u32, u32>> guards;
+    std::map<u32, size_t> guard_indices;
+    u64 used_guards{};
+
+    size_t next_parameter{};
+    bool sent{};
+    bool tracing{true};
+};
+
+} // Anonymous namespace
+
+Program::Program(const Function& function) : insts{function.insts} {
+    const auto zero = static_cast<Value>(insts.size());
+    values.assign(insts.size() + 1, 0);
+    for (Value value = 0; value < insts.size(); ++value) {
+        Inst& inst = insts[value];
+        if (inst.opcode == Opcode::Const) {
+            values[value] = inst.imm;
+        }
+        for (size_t i = NumArgs(inst.opcode); i < inst.args.size(); ++i) {
+            inst.args[i] = zero;
+        }
+    }
+    size_t max_copies = 0;
+    blocks.reserve(function.blocks.size());
+    for (u32 block_id = 0; block_id < function.blocks.size(); ++block_id) {
+        const Block& block = function.blocks[block_id];
+        FlatBlock& flat = blocks.emplace_back();
+        flat.insts_begin = static_cast<u32>(order.size());
+        for (const Value value : block.insts) {
+            if (insts[value].opcode != Opcode::Phi) {
+                order.push_back(value);
+            }
+        }
+        flat.insts_end = static_cast<u32>(order.size());
+        flat.type = block.terminator.type;
+        flat.cond = block.terminator.type == TerminatorType::Branch ? block.terminator.cond : zero;
+
+        const size_t num_edges = block.terminator.type == TerminatorType::Exit   ? 0
+                                 : block.terminator.type == TerminatorType::Jump ? 1
+                                                                                 : 2;
+        for (size_t edge_index = 0; edge_index < num_edges; ++edge_index) {
+            const u32 target = block.terminator.targets[edge_index];
+            const Block& successor = function.blocks[target];
+            const auto it = std::ranges::find(successor.predecessors, block_id);
+            const auto predecessor_index = static_cast<size_t>(it - successor.predecessors.begin());
+            Edge& edge = flat.edges[edge_index];
+            edge.target = target;
+            edge.copies_begin = static_cast<u32>(copies.size());
+            for (const Value value : successor.insts) {
+                const Inst& inst = function.insts[value];
+                if (inst.opcode != Opcode::Phi) {
+                    break;
+                }
+                copies.push_back({value, inst.list[predecessor_index]});
+            }
+            edge.copies_end = static_cast<u32>(copies.size());
+            max_copies = (std::max)(max_copies, size_t{edge.copies_end - edge.copies_begin});
+        }
+    }
+    copy_scratch.resize(max_copies);
+}
+
+void Program::Execute(Environment& env, std::span<const u32> parameters) {
+    size_t next_parameter = 0;
+    u32 block_id = 0;
+    for (;;) {
+        const FlatBlock& block = blocks[block_id];
+        for (u32 index = block.insts_begin; index < block.insts_end; ++index) {
+            const Value value = order[index];
+            const Inst& inst = insts[value];
+            switch (inst.opcode) {
+            case Opcode::Parameter:
+                values[value] =
+                    next_parameter < parameters.size() ? parameters[next_parameter] : 0;
+                ++next_parameter;
+                break;
+            case Opcode::Read:
+                values[value] = env.ReadRegister(values[inst.args[0]]);
+                break;
+            case Opcode::Send:
+                env.CallMethod(MethodOf(values[inst.args[0]]), values[inst.args[1]]);
+                break;
+            case Opcode::SendBatch:
+                env.CallMultiMethod(inst.imm, inst.list);
+                break;
+            default:
+                values[value] = Evaluate(inst.opcode, inst.imm, values[inst.args[0]],
+                                         values[inst.args[1]], values[inst.args[2]]);
+                break;
+            }
+        }
+        if (block.type == TerminatorType::Exit) {
+            return;
+        }
+        const bool taken = block.type == TerminatorType::Jump || values[block.cond] != 0;
+        const Edge& edge = block.edges[taken ? 0 : 1];
+        // Phis read the values from before the edge was taken, copy them all at once
+        for (u32 index = edge.copies_begin; index < edge.copies_end; ++index) {
+            copy_scratch[index - edge.copies_begin] = values[copies[index].src];
+        }
+        for (u32 index = edge.copies_begin; index < edge.copies_end; ++index) {
+            values[copies[index].dst] = copy_scratch[index - edge.copies_begin];
+        }
+        block_id = edge.target;
+    }
+}
+
+std::optional<Specialization> Trace(const Function& function, Environment& env,
+                                    std::span<const u32> parameters) {
+    return Tracer{function, env, parameters}.Run();
+}
+
+} // namespace Tegra::Macro::IR
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/macro/macro_ir.h"
+
+namespace Tegra::Macro::IR {
+
+/// Engine state the executed macros interact with
+class Environment {
+public:
+    virtual ~Environment() = default;
+
+    [[nodiscard]] virtual u32 ReadRegister(u32 method) = 0;
+
+    virtual void CallMethod(u32 method, u32 argument) = 0;
+
+    /// Calls the same method with each argument, in order
+    virtual void CallMultiMethod(u32 method, std::span<const u32> arguments) = 0;
+};
+
+/// Function flattened for execution
+class Program {
+public:
+    explicit Program(const Function& function);
+
+    void Execute(Environment& env, std::span<const u32> parameters);
+
+private:
+    struct Copy {
+        Value dst;
+        Value src;
+    };
+
+    struct Edge {
+        u32 target;
+        u32 copies_begin;
+        u32 copies_end;
+    };
+
+    struct FlatBlock {
+        u32 insts_begin;
+        u32 insts_end;
+        TerminatorType type;
+        Value cond;
+        std::array<Edge, 2> edges;
+    };
+
+    std::vector<Inst> insts;
+    std::vector<Value> order;
+    std::vector<FlatBlock> blocks;
+    std::vector<Copy> copies;
+    /// Holds every value plus a trailing zero read by unused arguments
+    std::vector<u32> values;
+    std::vector<u32> copy_scratch;
+};
+
+/**
+ * Executes a function while recording a specialization of it for the given parameters.
+ * The function always runs to completion, nullopt is returned when its control flow depends on
+ * state that is only known after a method has been called, or when the residual grows too large.
+ */
+[[nodiscard]] std::optional<Specialization> Trace(const Function& function, Environment& env,
+                                                  std::span<const u32> parameters);
+
+} // namespace Tegra::Macro::IR
@@ -659,10 +659,13 @@ Macro::Opcode MacroJITx64Impl::GetOpCode() const {
 }
 } // Anonymous namespace
 
-MacroJITx64::MacroJITx64(Engines::Maxwell3D& maxwell3d_)
-    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+MacroJITx64::MacroJITx64(Engines::Maxwell3D& maxwell3d_, u64 program_id)
+    : MacroEngine{maxwell3d_, program_id}, maxwell3d{maxwell3d_} {}
 
-std::unique_ptr<CachedMacro> MacroJITx64::Compile(const std::vector<u32>& code) {
+std::unique_ptr<CachedMacro> MacroJITx64::Compile(const std::vector<u32>& code,
+                                                  [[maybe_unused]] const Macro::IR::Function* ir) {
+    // Native code generated straight from the macro is already faster than running the IR, the
+    // IR only contributes its specializations here
     return std::make_unique<MacroJITx64Impl>(maxwell3d, code);
 }
 } // namespace Tegra
@@ -14,10 +14,11 @@ class Maxwell3D;
 
 class MacroJITx64 final : public MacroEngine {
 public:
-    explicit MacroJITx64(Engines::Maxwell3D& maxwell3d_);
+    explicit MacroJITx64(Engines::Maxwell3D& maxwell3d_, u64 program_id);
 
 protected:
-    std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) override;
+    std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code,
+                                         const Macro::IR::Function* ir) override;
 
 private:
     Engines::Maxwell3D& maxwell3d;
@@ -9,6 +9,8 @@
 #include "core/core.h"
 #include "core/hle/kernel/k_page_table.h"
 #include "core/hle/kernel/k_process.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/guest_memory.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/invalidation_accumulator.h"
@@ -181,10 +183,14 @@ void MemoryManager::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_)
 
 GPUVAddr MemoryManager::Map(GPUVAddr gpu_addr, DAddr dev_addr, std::size_t size, PTEKind kind,
                             bool is_big_pages) {
-    if (is_big_pages) [[likely]] {
-        return BigPageTableOp<EntryType::Mapped>(gpu_addr, dev_addr, size, kind);
+    const GPUVAddr mapped_addr =
+        is_big_pages ? BigPageTableOp<EntryType::Mapped>(gpu_addr, dev_addr, size, kind)
+                     : PageTableOp<EntryType::Mapped>(gpu_addr, dev_addr, size, kind);
+    auto& capture = system.GPU().CaptureRecorder();
+    if (capture.IsActive()) [[unlikely]] {
+        capture.RecordMap(*this, gpu_addr, dev_addr, size, kind, is_big_pages);
     }
-    return PageTableOp<EntryType::Mapped>(gpu_addr, dev_addr, size, kind);
+    return mapped_addr;
 }
 
 GPUVAddr MemoryManager::MapSparse(GPUVAddr gpu_addr, std::size_t size, bool is_big_pages) {
@@ -198,6 +204,10 @@ void MemoryManager::Unmap(GPUVAddr gpu_addr, std::size_t size) {
     if (size == 0) {
         return;
     }
+    auto& capture = system.GPU().CaptureRecorder();
+    if (capture.IsActive()) [[unlikely]] {
+        capture.RecordUnmap(*this, gpu_addr, size);
+    }
     GetSubmappedRangeImpl<false>(gpu_addr, size, page_stash);
 
     for (const auto& [map_addr, map_size] : page_stash) {
@@ -49,6 +49,22 @@ public:
         return unique_identifier;
     }
 
+    u64 GetAddressSpaceBits() const {
+        return address_space_bits;
+    }
+
+    GPUVAddr GetSplitAddress() const {
+        return split_address;
+    }
+
+    u64 GetBigPageBits() const {
+        return big_page_bits;
+    }
+
+    u64 GetPageBits() const {
+        return page_bits;
+    }
+
     /// Binds a renderer to the memory manager.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
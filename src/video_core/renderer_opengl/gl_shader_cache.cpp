@@ -54,7 +54,7 @@ using VideoCommon::LoadPipelines;
 using VideoCommon::SerializePipeline;
 using Context = ShaderContext::Context;
 
-constexpr u32 CACHE_VERSION = 10;
+constexpr u32 CACHE_VERSION = 12;
 
 template <typename Container>
 auto MakeSpan(Container& container) {
@@ -294,12 +294,21 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
             workers->QueueWork(std::move(work));
         }
     }};
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::span<const char> key_data,
+                                VideoCommon::PipelineEnvironmentLoader load_envs, u64 first_use) {
+        ContinueFirstUseOrder(first_use);
         ComputePipelineKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-        queue_work([this, key, env_ = std::move(env), &state, &callback](Context* ctx) mutable {
+        if (!VideoCommon::ReadPipelineKey(key_data, key)) {
+            return;
+        }
+        queue_work([this, key, load_envs_ = std::move(load_envs), &state,
+                    &callback](Context* ctx) mutable {
+            std::vector<FileEnvironment> envs{load_envs_()};
             ctx->pools.ReleaseContents();
-            auto pipeline{CreateComputePipeline(ctx->pools, key, env_, true)};
+            std::unique_ptr<ComputePipeline> pipeline;
+            if (!envs.empty()) {
+                pipeline = CreateComputePipeline(ctx->pools, key, envs.front(), true);
+            }
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 compute_cache.emplace(key, std::move(pipeline));
@@ -311,16 +320,25 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::span<const char> key_data,
+                                 VideoCommon::PipelineEnvironmentLoader load_envs, u64 first_use) {
+        ContinueFirstUseOrder(first_use);
         GraphicsPipelineKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-        queue_work([this, key, envs_ = std::move(envs), &state, &callback](Context* ctx) mutable {
+        if (!VideoCommon::ReadPipelineKey(key_data, key)) {
+            return;
+        }
+        queue_work([this, key, load_envs_ = std::move(load_envs), &state,
+                    &callback](Context* ctx) mutable {
+            std::vector<FileEnvironment> envs{load_envs_()};
             boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
+            for (auto& env : envs) {
                 env_ptrs.push_back(&env);
             }
             ctx->pools.ReleaseContents();
-            auto pipeline{CreateGraphicsPipeline(ctx->pools, key, MakeSpan(env_ptrs), false, true)};
+            std::unique_ptr<GraphicsPipeline> pipeline;
+            if (!envs.empty()) {
+                pipeline = CreateGraphicsPipeline(ctx->pools, key, MakeSpan(env_ptrs), false, true);
+            }
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 graphics_cache.emplace(key, std::move(pipeline));
@@ -332,7 +350,8 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    LoadPipelines(stop_loading, shader_cache_filename, CACHE_VERSION, load_compute, load_graphics);
+    shader_cache_reader = LoadPipelines(stop_loading, shader_cache_filename, CACHE_VERSION,
+                                        load_compute, load_graphics);
 
     LOG_INFO(Render_OpenGL, "Total Pipeline Count: {}", state.total);
 
@@ -450,7 +469,8 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline() {
             env_ptrs.push_back(&environments.envs[index]);
         }
     }
-    SerializePipeline(graphics_key, env_ptrs, shader_cache_filename, CACHE_VERSION);
+    SerializePipeline(graphics_key, env_ptrs, SessionTime(), shader_cache_filename, CACHE_VERSION,
+                      shader_cache_reader.get());
     return pipeline;
 }
 
@@ -474,8 +494,9 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
                                        index == static_cast<u32>(Maxwell::ShaderType::Geometry);
         if (key.unique_hashes[index] == 0 && is_emulated_stage) {
             auto topology = MaxwellToOutputTopology(key.gs_input_topology);
-            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
-                                                          *layer_source_program, topology);
+            programs[index] =
+                GenerateGeometryPassthrough(pools.inst, pools.block, pools.arena, host_info,
+                                            *layer_source_program, topology);
             continue;
         }
         if (key.unique_hashes[index] == 0) {
@@ -493,14 +514,16 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
 
         if (!uses_vertex_a || index != 1) {
             // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
+            programs[index] =
+                TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info);
 
             total_storage_buffers +=
                 Shader::NumDescriptors(programs[index].info.storage_buffers_descriptors);
         } else {
             // VertexB path when VertexA is present.
             auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+            auto program_vb{
+                TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info)};
             total_storage_buffers +=
                 Shader::NumDescriptors(program_vb.info.storage_buffers_descriptors);
             programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
@@ -573,8 +596,8 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     if (!pipeline || shader_cache_filename.empty()) {
         return pipeline;
     }
-    SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env}, shader_cache_filename,
-                      CACHE_VERSION);
+    SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env}, SessionTime(),
+                      shader_cache_filename, CACHE_VERSION, shader_cache_reader.get());
     return pipeline;
 }
 
@@ -590,7 +613,7 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
         env.Dump(hash, key.unique_hash);
     }
 
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    auto program{TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info)};
     const u32 num_storage_buffers{Shader::NumDescriptors(program.info.storage_buffers_descriptors)};
     Shader::RuntimeInfo info;
     info.glasm_use_storage_buffers = num_storage_buffers <= device.GetMaxGLASMStorageBufferBlocks();
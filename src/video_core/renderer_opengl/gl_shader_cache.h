@@ -4,6 +4,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <unordered_map>
 
 #include "common/common_types.h"
@@ -86,6 +87,8 @@ private:
     Shader::HostTranslateInfo host_info;
 
     std::filesystem::path shader_cache_filename;
+    /// Mapping of the shader cache file loaded at boot, pipelines found in it are not appended
+    std::shared_ptr<VideoCommon::PipelineCacheReader> shader_cache_reader;
     std::unique_ptr<ShaderWorker> workers;
 };
 
@@ -14,8 +14,11 @@ struct ShaderPools {
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
+        arena.ReleaseContents();
     }
 
+    /// Declared first so the instructions and blocks using it are destroyed before it
+    Shader::Arena arena;
     Shader::ObjectPool<Shader::IR::Inst> inst{8192};
     Shader::ObjectPool<Shader::IR::Block> block{32};
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
@@ -5,10 +5,15 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -55,7 +60,7 @@ using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
 
-constexpr u32 CACHE_VERSION = 12;
+constexpr u32 CACHE_VERSION = 14;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
 
 template <typename Container>
@@ -282,6 +287,76 @@ size_t GetTotalPipelineWorkers() {
 
 } // Anonymous namespace
 
+/// Disk pipelines waiting to be built in the background while the game runs.
+/// Jobs are taken in the order they were first used in previous sessions, except for pipelines
+/// the game requests before their turn, which are moved to the front of the queue.
+struct PipelineCache::PrecompileQueue {
+    struct Job {
+        u64 first_use{};
+        bool is_compute{};
+        bool taken{};
+        bool promoted{};
+        GraphicsPipelineCacheKey graphics_key{};
+        ComputePipelineCacheKey compute_key{};
+        const VideoCommon::PipelineCacheEntry* entry{};
+    };
+
+    /// Orders the jobs by first use and indexes them by key, skipping duplicated entries
+    void Sort() {
+        std::ranges::stable_sort(jobs, {}, &Job::first_use);
+        for (size_t index = 0; index < jobs.size(); ++index) {
+            Job& job{jobs[index]};
+            const bool is_unique{job.is_compute
+                                     ? compute_jobs.emplace(job.compute_key, index).second
+                                     : graphics_jobs.emplace(job.graphics_key, index).second};
+            if (is_unique) {
+                ++remaining;
+            } else {
+                job.taken = true;
+            }
+        }
+    }
+
+    /// Marks the next job to build as taken and returns its index
+    std::optional<size_t> TakeNext() {
+        while (!promoted.empty()) {
+            const size_t index{promoted.front()};
+            promoted.pop_front();
+            if (!jobs[index].taken) {
+                jobs[index].taken = true;
+                return index;
+            }
+        }
+        while (next_job < jobs.size()) {
+            const size_t index{next_job++};
+            if (!jobs[index].taken) {
+                jobs[index].taken = true;
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Returns true when some job might still have to be taken
+    bool HasUntakenJobs() const noexcept {
+        return !promoted.empty() || next_job < jobs.size();
+    }
+
+    std::mutex mutex;
+    std::vector<Job> jobs;
+    size_t next_job{};
+    std::deque<size_t> promoted;
+    std::unordered_map<GraphicsPipelineCacheKey, size_t> graphics_jobs;
+    std::unordered_map<ComputePipelineCacheKey, size_t> compute_jobs;
+    std::vector<std::pair<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>>>
+        built_graphics;
+    std::vector<std::pair<ComputePipelineCacheKey, std::unique_ptr<ComputePipeline>>> built_compute;
+    /// Jobs whose pipeline has not been collected or claimed by the GPU thread yet
+    size_t remaining{};
+    std::shared_ptr<VideoCommon::PipelineCacheReader> reader;
+    std::unique_ptr<PipelineStatistics> statistics;
+};
+
 size_t ComputePipelineCacheKey::Hash() const noexcept {
     const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), sizeof *this);
     return static_cast<size_t>(hash);
@@ -312,10 +387,14 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
       texture_cache{texture_cache_}, shader_notify{shader_notify_},
       use_asynchronous_shaders{Settings::values.use_asynchronous_shaders.GetValue()},
       use_vulkan_pipeline_cache{Settings::values.use_vulkan_driver_pipeline_cache.GetValue()},
+      use_streaming_precompile{Settings::values.use_streaming_pipeline_precompile.GetValue()},
       optimize_spirv_output{Settings::values.optimize_spirv_output.GetValue() != Settings::SpirvOptimizeMode::Never},
       workers(device.HasBrokenParallelShaderCompiling() ? 1ULL : GetTotalPipelineWorkers(),
               "VkPipelineBuilder"),
-      serialization_thread(1, "VkPipelineSerialization") {
+      serialization_thread(1, "VkPipelineSerialization"),
+      translation_workers(
+          std::min<size_t>(GetTotalPipelineWorkers(), Maxwell::MaxShaderProgram - 1),
+          "VkShaderTranslator") {
     const auto& float_control{device.FloatControlProperties()};
     const VkDriverId driver_id{device.GetDriverID()};
     profile = Shader::Profile{
@@ -424,6 +503,8 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
 }
 
 PipelineCache::~PipelineCache() {
+    // The driver cache may still be being saved after a background precompile
+    serialization_thread.WaitForRequests();
     if (use_vulkan_pipeline_cache && !vulkan_pipeline_cache_filename.empty()) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
                                      CACHE_VERSION);
@@ -460,12 +541,17 @@ ComputePipeline* PipelineCache::CurrentComputePipeline() {
         .shared_memory_size = qmd.shared_alloc,
         .workgroup_size{qmd.block_dim_x, qmd.block_dim_y, qmd.block_dim_z},
     };
+    if (precompile) {
+        CollectPrecompiledPipelines();
+    }
     const auto [pair, is_new]{compute_cache.try_emplace(key)};
     auto& pipeline{pair->second};
     if (!is_new) {
         return pipeline.get();
     }
-    pipeline = CreateComputePipeline(key, shader);
+    // Dispatches can't be skipped, build it now even if a worker has already started it
+    const bool is_cached{precompile && DropPrecompileJob(key)};
+    pipeline = CreateComputePipeline(key, shader, !is_cached);
     return pipeline.get();
 }
 
@@ -488,24 +574,91 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
             LoadVulkanPipelineCache(vulkan_pipeline_cache_filename, CACHE_VERSION);
     }
 
+    const auto has_current_dynamic_state{[this](const GraphicsPipelineCacheKey& key) {
+        return (key.state.extended_dynamic_state != 0) ==
+                   dynamic_features.has_extended_dynamic_state &&
+               (key.state.extended_dynamic_state_2 != 0) ==
+                   dynamic_features.has_extended_dynamic_state_2 &&
+               (key.state.extended_dynamic_state_2_extra != 0) ==
+                   dynamic_features.has_extended_dynamic_state_2_extra &&
+               (key.state.extended_dynamic_state_3_blend != 0) ==
+                   dynamic_features.has_extended_dynamic_state_3_blend &&
+               (key.state.extended_dynamic_state_3_enables != 0) ==
+                   dynamic_features.has_extended_dynamic_state_3_enables &&
+               (key.state.dynamic_vertex_input != 0) == dynamic_features.has_dynamic_vertex_input;
+    }};
+    std::unique_ptr<PipelineStatistics> statistics;
+    if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
+        statistics = std::make_unique<PipelineStatistics>(device);
+    }
+
+    if (use_streaming_precompile) {
+        // Let the game boot right away and build the cached pipelines while it runs. Only the file
+        // index is read here, workers decompress each pipeline when they get to it.
+        auto queue{std::make_shared<PrecompileQueue>()};
+        pipeline_cache_reader = std::make_shared<VideoCommon::PipelineCacheReader>(
+            pipeline_cache_filename, CACHE_VERSION);
+        pipeline_cache_reader->UpdateIndex();
+        queue->reader = pipeline_cache_reader;
+        for (const VideoCommon::PipelineCacheEntry& entry : queue->reader->Entries()) {
+            ContinueFirstUseOrder(entry.first_use);
+            PrecompileQueue::Job job{
+                .first_use = entry.first_use,
+                .is_compute = entry.is_compute,
+                .entry = &entry,
+            };
+            const bool is_usable{
+                entry.is_compute ? VideoCommon::ReadPipelineKey(entry.key, job.compute_key)
+                                 : VideoCommon::ReadPipelineKey(entry.key, job.graphics_key) &&
+                                       has_current_dynamic_state(job.graphics_key)};
+            if (is_usable) {
+                queue->jobs.push_back(job);
+            }
+        }
+
+        LOG_INFO(Render_Vulkan, "Total Pipeline Count: {}, building in the background",
+                 queue->jobs.size());
+
+        if (queue->jobs.empty()) {
+            FinishDiskResources(statistics.get());
+            return;
+        }
+        queue->Sort();
+        queue->statistics = std::move(statistics);
+        // Keep only as many tasks in flight as there are workers, so pipelines the game builds
+        // asynchronously don't wait behind the whole cache
+        const size_t num_workers{
+            device.HasBrokenParallelShaderCompiling() ? size_t{1} : GetTotalPipelineWorkers()};
+        precompile = queue;
+        for (size_t i = 0; i < std::min(num_workers, queue->jobs.size()); ++i) {
+            QueuePrecompileWork(queue);
+        }
+        return;
+    }
+
     struct {
         std::mutex mutex;
         size_t total{};
         size_t built{};
         bool has_loaded{};
-        std::unique_ptr<PipelineStatistics> statistics;
     } state;
 
-    if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
-        state.statistics = std::make_unique<PipelineStatistics>(device);
-    }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::span<const char> key_data,
+                                VideoCommon::PipelineEnvironmentLoader load_envs, u64 first_use) {
+        ContinueFirstUseOrder(first_use);
         ComputePipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+        if (!VideoCommon::ReadPipelineKey(key_data, key)) {
+            return;
+        }
 
-        workers.QueueWork([this, key, env_ = std::move(env), &state, &callback]() mutable {
+        workers.QueueWork([this, key, load_envs_ = std::move(load_envs), &state, &statistics,
+                           &callback]() mutable {
             ShaderPools pools;
-            auto pipeline{CreateComputePipeline(pools, key, env_, state.statistics.get(), false)};
+            std::vector<FileEnvironment> envs{load_envs_()};
+            std::unique_ptr<ComputePipeline> pipeline;
+            if (!envs.empty()) {
+                pipeline = CreateComputePipeline(pools, key, envs.front(), statistics.get(), false);
+            }
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 compute_cache.emplace(key, std::move(pipeline));
@@ -517,31 +670,26 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::span<const char> key_data,
+                                 VideoCommon::PipelineEnvironmentLoader load_envs, u64 first_use) {
+        ContinueFirstUseOrder(first_use);
         GraphicsPipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-
-        if ((key.state.extended_dynamic_state != 0) !=
-                dynamic_features.has_extended_dynamic_state ||
-            (key.state.extended_dynamic_state_2 != 0) !=
-                dynamic_features.has_extended_dynamic_state_2 ||
-            (key.state.extended_dynamic_state_2_extra != 0) !=
-                dynamic_features.has_extended_dynamic_state_2_extra ||
-            (key.state.extended_dynamic_state_3_blend != 0) !=
-                dynamic_features.has_extended_dynamic_state_3_blend ||
-            (key.state.extended_dynamic_state_3_enables != 0) !=
-                dynamic_features.has_extended_dynamic_state_3_enables ||
-            (key.state.dynamic_vertex_input != 0) != dynamic_features.has_dynamic_vertex_input) {
+        if (!VideoCommon::ReadPipelineKey(key_data, key) || !has_current_dynamic_state(key)) {
             return;
         }
-        workers.QueueWork([this, key, envs_ = std::move(envs), &state, &callback]() mutable {
+        workers.QueueWork([this, key, load_envs_ = std::move(load_envs), &state, &statistics,
+                           &callback]() mutable {
             ShaderPools pools;
+            std::vector<FileEnvironment> envs{load_envs_()};
             boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
+            for (auto& env : envs) {
                 env_ptrs.push_back(&env);
             }
-            auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
-                                                 state.statistics.get(), false)};
+            std::unique_ptr<GraphicsPipeline> pipeline;
+            if (!envs.empty()) {
+                pipeline =
+                    CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs), statistics.get(), false);
+            }
 
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
@@ -554,8 +702,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
-                               load_graphics);
+    pipeline_cache_reader = VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename,
+                                                       CACHE_VERSION, load_compute, load_graphics);
 
     LOG_INFO(Render_Vulkan, "Total Pipeline Count: {}", state.total);
 
@@ -566,25 +714,168 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
 
     workers.WaitForRequests(stop_loading);
 
+    FinishDiskResources(statistics.get());
+}
+
+void PipelineCache::QueuePrecompileWork(std::shared_ptr<PrecompileQueue> queue) {
+    workers.QueueWork([this, queue_ = std::move(queue)] { BuildNextPrecompileJob(queue_); });
+}
+
+void PipelineCache::BuildNextPrecompileJob(const std::shared_ptr<PrecompileQueue>& queue) {
+    std::unique_lock lock{queue->mutex};
+    const std::optional<size_t> index{queue->TakeNext()};
+    if (!index) {
+        return;
+    }
+    PrecompileQueue::Job& job{queue->jobs[*index]};
+    const bool is_compute{job.is_compute};
+    const GraphicsPipelineCacheKey graphics_key{job.graphics_key};
+    const ComputePipelineCacheKey compute_key{job.compute_key};
+    const VideoCommon::PipelineCacheEntry& entry{*job.entry};
+    lock.unlock();
+
+    std::vector<FileEnvironment> envs{queue->reader->ReadEnvironments(entry)};
+    ShaderPools pools;
+    if (envs.empty()) {
+        lock.lock();
+        if (is_compute) {
+            queue->built_compute.emplace_back(compute_key, nullptr);
+        } else {
+            queue->built_graphics.emplace_back(graphics_key, nullptr);
+        }
+    } else if (is_compute) {
+        auto pipeline{CreateComputePipeline(pools, compute_key, envs.front(),
+                                            queue->statistics.get(), false)};
+        lock.lock();
+        queue->built_compute.emplace_back(compute_key, std::move(pipeline));
+    } else {
+        boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
+        for (auto& env : envs) {
+            env_ptrs.push_back(&env);
+        }
+        auto pipeline{CreateGraphicsPipeline(pools, graphics_key, MakeSpan(env_ptrs),
+                                             queue->statistics.get(), false)};
+        lock.lock();
+        queue->built_graphics.emplace_back(graphics_key, std::move(pipeline));
+    }
+    const bool has_more_jobs{queue->HasUntakenJobs()};
+    lock.unlock();
+
+    if (has_more_jobs) {
+        QueuePrecompileWork(queue);
+    }
+}
+
+void PipelineCache::CollectPrecompiledPipelines() {
+    std::unique_lock lock{precompile->mutex};
+    for (auto& [key, pipeline] : precompile->built_graphics) {
+        if (precompile->graphics_jobs.erase(key) == 0) {
+            // The GPU thread has claimed and built this one itself
+            continue;
+        }
+        --precompile->remaining;
+        if (pipeline) {
+            graphics_cache.try_emplace(key, std::move(pipeline));
+        }
+    }
+    for (auto& [key, pipeline] : precompile->built_compute) {
+        if (precompile->compute_jobs.erase(key) == 0) {
+            continue;
+        }
+        --precompile->remaining;
+        if (pipeline) {
+            compute_cache.try_emplace(key, std::move(pipeline));
+        }
+    }
+    precompile->built_graphics.clear();
+    precompile->built_compute.clear();
+    if (precompile->remaining != 0) {
+        return;
+    }
+    lock.unlock();
+
+    LOG_INFO(Render_Vulkan, "Finished building {} pipelines in the background",
+             precompile->jobs.size());
+    // Workers may still hold stale tasks referencing the queue, they own a reference to it.
+    // Saving the driver pipeline cache can take a while, keep it off the draw path.
+    std::shared_ptr<PrecompileQueue> queue{std::move(precompile)};
+    serialization_thread.QueueWork(
+        [this, queue_ = std::move(queue)] { SaveDiskResources(queue_->statistics.get()); });
+    EndLoadTimeSpirvOptimization();
+}
+
+PipelineCache::PrecompileClaim PipelineCache::ClaimPrecompileJob(
+    const GraphicsPipelineCacheKey& key) {
+    std::scoped_lock lock{precompile->mutex};
+    const auto it{precompile->graphics_jobs.find(key)};
+    if (it == precompile->graphics_jobs.end()) {
+        return PrecompileClaim::NotQueued;
+    }
+    PrecompileQueue::Job& job{precompile->jobs[it->second]};
+    if (use_asynchronous_shaders) {
+        // Skip the draw and let a worker build it next
+        if (!job.taken && !job.promoted) {
+            job.promoted = true;
+            precompile->promoted.push_front(it->second);
+        }
+        return PrecompileClaim::Deferred;
+    }
+    // Build it now, a result from a worker that has already started will be discarded
+    job.taken = true;
+    precompile->graphics_jobs.erase(it);
+    --precompile->remaining;
+    return PrecompileClaim::Claimed;
+}
+
+bool PipelineCache::DropPrecompileJob(const ComputePipelineCacheKey& key) {
+    std::scoped_lock lock{precompile->mutex};
+    const auto it{precompile->compute_jobs.find(key)};
+    if (it == precompile->compute_jobs.end()) {
+        return false;
+    }
+    precompile->jobs[it->second].taken = true;
+    precompile->compute_jobs.erase(it);
+    --precompile->remaining;
+    return true;
+}
+
+void PipelineCache::FinishDiskResources(PipelineStatistics* statistics) {
+    SaveDiskResources(statistics);
+    EndLoadTimeSpirvOptimization();
+}
+
+void PipelineCache::SaveDiskResources(PipelineStatistics* statistics) {
     if (use_vulkan_pipeline_cache) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
                                      CACHE_VERSION);
     }
 
-    if (state.statistics) {
-        state.statistics->Report();
+    if (statistics) {
+        statistics->Report();
     }
+}
 
+void PipelineCache::EndLoadTimeSpirvOptimization() {
     if (Settings::values.optimize_spirv_output.GetValue() != Settings::SpirvOptimizeMode::Always) {
         this->optimize_spirv_output = false;
     }
 }
 
 GraphicsPipeline* PipelineCache::CurrentGraphicsPipelineSlowPath() {
+    if (precompile) {
+        CollectPrecompiledPipelines();
+    }
     const auto [pair, is_new]{graphics_cache.try_emplace(graphics_key)};
     auto& pipeline{pair->second};
     if (is_new) {
-        pipeline = CreateGraphicsPipeline();
+        const PrecompileClaim claim{precompile ? ClaimPrecompileJob(graphics_key)
+                                               : PrecompileClaim::NotQueued};
+        if (claim == PrecompileClaim::Deferred) {
+            graphics_cache.erase(pair);
+            return nullptr;
+        }
+        // Pipelines loaded from the disk cache are already stored in it
+        pipeline = CreateGraphicsPipeline(claim == PrecompileClaim::NotQueued);
     }
     if (!pipeline) {
         return nullptr;
@@ -624,11 +915,19 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     bool build_in_parallel) try {
     auto hash = key.Hash();
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
-    size_t env_index{0};
     std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
     const bool uses_vertex_a{key.unique_hashes[0] != 0};
     const bool uses_vertex_b{key.unique_hashes[1] != 0};
 
+    std::array<Shader::Environment*, Maxwell::MaxShaderProgram> stage_envs{};
+    size_t env_index{0};
+    for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        if (key.unique_hashes[index] != 0) {
+            stage_envs[index] = envs[env_index++];
+        }
+    }
+    TranslateStages(pools, programs, stage_envs, build_in_parallel);
+
     // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
     Shader::IR::Program* layer_source_program{};
 
@@ -637,26 +936,19 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
                                        index == static_cast<u32>(Maxwell::ShaderType::Geometry);
         if (key.unique_hashes[index] == 0 && is_emulated_stage) {
             auto topology = MaxwellToOutputTopology(key.state.topology);
-            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
-                                                          *layer_source_program, topology);
+            programs[index] =
+                GenerateGeometryPassthrough(pools.inst, pools.block, pools.arena, host_info,
+                                            *layer_source_program, topology);
             continue;
         }
         if (key.unique_hashes[index] == 0) {
             continue;
         }
-        Shader::Environment& env{*envs[env_index]};
-        ++env_index;
-
-        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
-        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
-        if (!uses_vertex_a || index != 1) {
-            // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
-        } else {
+        Shader::Environment& env{*stage_envs[index]};
+        if (uses_vertex_a && index == 1) {
             // VertexB path when VertexA is present.
-            auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-            programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
+            auto program_vb{std::move(programs[index])};
+            programs[index] = MergeDualVertexPrograms(programs[0], program_vb, env);
         }
 
         if (Settings::values.dump_shaders) {
@@ -720,17 +1012,78 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     return nullptr;
 }
 
-std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
+void PipelineCache::TranslateStages(ShaderPools& pools, std::span<Shader::IR::Program> programs,
+                                    std::span<Shader::Environment* const> stage_envs,
+                                    bool in_parallel) {
+    const auto translate{[&](size_t index, ShaderPools& stage_pool) {
+        Shader::Environment& env{*stage_envs[index]};
+        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
+        Shader::Maxwell::Flow::CFG cfg(env, stage_pool.flow_block, cfg_offset, index == 0);
+        programs[index] = TranslateProgram(stage_pool.inst, stage_pool.block, stage_pool.arena,
+                                           env, cfg, host_info);
+    }};
+    boost::container::static_vector<size_t, Maxwell::MaxShaderProgram> stages;
+    for (size_t index = 0; index < stage_envs.size(); ++index) {
+        if (stage_envs[index] != nullptr) {
+            stages.push_back(index);
+        }
+    }
+    if (!in_parallel || stages.size() < 2) {
+        for (const size_t index : stages) {
+            translate(index, pools);
+        }
+        return;
+    }
+    // Stages are only linked after translation, so each one can be translated on its own thread.
+    // The calling thread takes the first stage.
+    std::array<std::exception_ptr, Maxwell::MaxShaderProgram> exceptions;
+    std::mutex mutex;
+    std::condition_variable done_condition;
+    size_t num_pending{stages.size() - 1};
+    for (size_t i = 1; i < stages.size(); ++i) {
+        translation_workers.QueueWork([&, index = stages[i]] {
+            try {
+                translate(index, stage_pools[index]);
+            } catch (...) {
+                exceptions[index] = std::current_exception();
+            }
+            std::scoped_lock lock{mutex};
+            if (--num_pending == 0) {
+                done_condition.notify_one();
+            }
+        });
+    }
+    try {
+        translate(stages[0], stage_pools[stages[0]]);
+    } catch (...) {
+        exceptions[stages[0]] = std::current_exception();
+    }
+    {
+        std::unique_lock lock{mutex};
+        done_condition.wait(lock, [&] { return num_pending == 0; });
+    }
+    for (const std::exception_ptr& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(bool serialize) {
     GraphicsEnvironments environments;
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
 
     main_pools.ReleaseContents();
+    for (ShaderPools& stage_pool : stage_pools) {
+        stage_pool.ReleaseContents();
+    }
     auto pipeline{
         CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true)};
-    if (!pipeline || pipeline_cache_filename.empty()) {
+    if (!pipeline || !serialize || pipeline_cache_filename.empty()) {
         return pipeline;
     }
-    serialization_thread.QueueWork([this, key = graphics_key, envs = std::move(environments.envs)] {
+    serialization_thread.QueueWork([this, key = graphics_key, envs = std::move(environments.envs),
+                                    first_use = SessionTime()] {
         boost::container::static_vector<const GenericEnvironment*, Maxwell::MaxShaderProgram>
             env_ptrs;
         for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
@@ -738,13 +1091,14 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
                 env_ptrs.push_back(&envs[index]);
             }
         }
-        SerializePipeline(key, env_ptrs, pipeline_cache_filename, CACHE_VERSION);
+        SerializePipeline(key, env_ptrs, first_use, pipeline_cache_filename, CACHE_VERSION,
+                          pipeline_cache_reader.get());
     });
     return pipeline;
 }
 
 std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
-    const ComputePipelineCacheKey& key, const ShaderInfo* shader) {
+    const ComputePipelineCacheKey& key, const ShaderInfo* shader, bool serialize) {
     const GPUVAddr program_base{kepler_compute->regs.code_loc.Address()};
     const auto& qmd{kepler_compute->launch_description};
     ComputeEnvironment env{*kepler_compute, *gpu_memory, program_base, qmd.program_start};
@@ -752,12 +1106,12 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
 
     main_pools.ReleaseContents();
     auto pipeline{CreateComputePipeline(main_pools, key, env, nullptr, true)};
-    if (!pipeline || pipeline_cache_filename.empty()) {
+    if (!pipeline || !serialize || pipeline_cache_filename.empty()) {
         return pipeline;
     }
-    serialization_thread.QueueWork([this, key, env_ = std::move(env)] {
-        SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env_},
-                          pipeline_cache_filename, CACHE_VERSION);
+    serialization_thread.QueueWork([this, key, env_ = std::move(env), first_use = SessionTime()] {
+        SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env_}, first_use,
+                          pipeline_cache_filename, CACHE_VERSION, pipeline_cache_reader.get());
     });
     return pipeline;
 }
@@ -780,7 +1134,7 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
         env.Dump(hash, key.unique_hash);
     }
 
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    auto program{TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info)};
     const std::vector<u32> code{EmitSPIRV(profile, program, this->optimize_spirv_output)};
     device.SaveShader(code);
     vk::ShaderModule spv_module{BuildShader(device, code)};
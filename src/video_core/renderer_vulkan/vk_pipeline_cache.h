@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "common/common_types.h"
 #include "common/thread_worker.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/program.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/host_translate_info.h"
@@ -90,8 +92,11 @@ struct ShaderPools {
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
+        arena.ReleaseContents();
     }
 
+    /// Declared first so the instructions and blocks using it are destroyed before it
+    Shader::Arena arena;
     Shader::ObjectPool<Shader::IR::Inst> inst{8192};
     Shader::ObjectPool<Shader::IR::Block> block{32};
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
@@ -114,19 +119,61 @@ public:
                            const VideoCore::DiskResourceLoadCallback& callback);
 
 private:
+    struct PrecompileQueue;
+
     [[nodiscard]] GraphicsPipeline* CurrentGraphicsPipelineSlowPath();
 
+    /// Queues a task on the pipeline workers that builds the next job of the precompile queue
+    void QueuePrecompileWork(std::shared_ptr<PrecompileQueue> queue);
+
+    /// Builds the highest priority job of the precompile queue, if any is left
+    void BuildNextPrecompileJob(const std::shared_ptr<PrecompileQueue>& queue);
+
+    /// Moves pipelines built in the background into the caches
+    void CollectPrecompiledPipelines();
+
+    /// Result of looking up a pipeline the GPU thread needs in the precompile queue
+    enum class PrecompileClaim {
+        NotQueued, ///< Not in the disk cache, the caller builds and stores it
+        Claimed,   ///< In the disk cache, the caller builds it without storing it again
+        Deferred,  ///< A worker builds it next, the caller skips the draw
+    };
+
+    /// Returns how the given pipeline has to be built by the caller
+    [[nodiscard]] PrecompileClaim ClaimPrecompileJob(const GraphicsPipelineCacheKey& key);
+
+    /// Removes a compute job the GPU thread is about to build itself, returns true when the
+    /// pipeline was in the disk cache
+    bool DropPrecompileJob(const ComputePipelineCacheKey& key);
+
+    /// Stores the driver pipeline cache and reports statistics once all disk pipelines are built
+    void FinishDiskResources(PipelineStatistics* statistics);
+
+    /// Stores the driver pipeline cache and reports statistics, safe to call from a worker
+    void SaveDiskResources(PipelineStatistics* statistics);
+
+    /// Stops optimizing SPIR-V once the disk pipelines are built, unless it is always requested
+    void EndLoadTimeSpirvOptimization();
+
     [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline) const noexcept;
 
-    std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
+    /// Builds the current graphics pipeline, and stores it in the disk cache when requested
+    std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline(bool serialize);
 
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline(
         ShaderPools& pools, const GraphicsPipelineCacheKey& key,
         std::span<Shader::Environment* const> envs, PipelineStatistics* statistics,
         bool build_in_parallel);
 
+    /// Translates the guest programs of a pipeline, stages are translated concurrently with their
+    /// own pools when in_parallel is set
+    void TranslateStages(ShaderPools& pools, std::span<Shader::IR::Program> programs,
+                         std::span<Shader::Environment* const> stage_envs, bool in_parallel);
+
+    /// Builds the current compute pipeline, and stores it in the disk cache when requested
     std::unique_ptr<ComputePipeline> CreateComputePipeline(const ComputePipelineCacheKey& key,
-                                                           const ShaderInfo* shader);
+                                                           const ShaderInfo* shader,
+                                                           bool serialize);
 
     std::unique_ptr<ComputePipeline> CreateComputePipeline(ShaderPools& pools,
                                                            const ComputePipelineCacheKey& key,
@@ -150,6 +197,7 @@ private:
     VideoCore::ShaderNotify& shader_notify;
     bool use_asynchronous_shaders{};
     bool use_vulkan_pipeline_cache{};
+    bool use_streaming_precompile{};
     bool optimize_spirv_output{};
 
     GraphicsPipelineCacheKey graphics_key{};
@@ -159,17 +207,24 @@ private:
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
 
     ShaderPools main_pools;
+    std::array<ShaderPools, Maxwell::MaxShaderProgram> stage_pools;
 
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
 
     std::filesystem::path pipeline_cache_filename;
+    /// Mapping of the pipeline cache file loaded at boot, pipelines found in it are not appended
+    std::shared_ptr<VideoCommon::PipelineCacheReader> pipeline_cache_reader;
 
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
 
+    /// Disk pipelines still being built in the background, null when nothing is left
+    std::shared_ptr<PrecompileQueue> precompile;
+
     Common::ThreadWorker workers;
     Common::ThreadWorker serialization_thread;
+    Common::ThreadWorker translation_workers;
     DynamicFeatures dynamic_features;
 };
 
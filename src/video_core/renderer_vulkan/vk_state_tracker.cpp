@@ -250,6 +250,7 @@ void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     SetupDirtyVertexBindings(tables);
     SetupDirtySpecialOps(tables);
     SetupRasterModes(tables);
+    channel_state.maxwell_3d->UpdateMethodClasses();
 }
 
 void StateTracker::ChangeChannel(Tegra::Control::ChannelState& channel_state) {
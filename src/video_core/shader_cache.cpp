@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <vector>
 
 #include "common/assert.h"
@@ -36,7 +37,17 @@ void ShaderCache::SyncGuestHost() {
 }
 
 ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_)
-    : device_memory{device_memory_} {}
+    : device_memory{device_memory_}, session_start{std::chrono::steady_clock::now()} {}
+
+u64 ShaderCache::SessionTime() const noexcept {
+    const auto elapsed{std::chrono::steady_clock::now() - session_start};
+    return first_use_base +
+           static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void ShaderCache::ContinueFirstUseOrder(u64 first_use) noexcept {
+    first_use_base = std::max(first_use_base, first_use + 1);
+}
 
 bool ShaderCache::RefreshStages(std::array<u64, 6>& unique_hashes) {
     auto& dirty{maxwell3d->dirty.flags};
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <span>
@@ -93,6 +94,15 @@ protected:
     void GetGraphicsEnvironments(GraphicsEnvironments& result,
                                  const std::array<u64, NUM_PROGRAMS>& unique_hashes);
 
+    /// @brief Returns the nanoseconds elapsed since the cache was created, offset past the first
+    /// use of every pipeline loaded from disk
+    /// @note Stored next to each cached pipeline to order precompilation by first use
+    u64 SessionTime() const noexcept;
+
+    /// @brief Orders the pipelines first used in this session after one recorded by an earlier
+    /// session, so first uses from different sessions compare in a single sort
+    void ContinueFirstUseOrder(u64 first_use) noexcept;
+
     std::array<const ShaderInfo*, NUM_PROGRAMS> shader_infos{};
     bool last_shaders_valid = false;
 
@@ -147,6 +157,8 @@ private:
     const ShaderInfo* MakeShaderInfo(GenericEnvironment& env, VAddr cpu_addr);
 
     Tegra::MaxwellDeviceMemoryManager& device_memory;
+    const std::chrono::steady_clock::time_point session_start;
+    u64 first_use_base{};
 
     mutable std::mutex lookup_mutex;
     std::mutex invalidation_mutex;
@@ -2,20 +2,26 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <optional>
+#include <sstream>
+#include <streambuf>
+#include <unordered_set>
 #include <utility>
 
 #include "common/assert.h"
 #include "common/cityhash.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "common/zstd_compression.h"
 #include "shader_recompiler/environment.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/memory_manager.h"
@@ -27,6 +33,41 @@ namespace VideoCommon {
 
 constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
 
+/// Version of the container layout below, independent from the renderer cache versions
+constexpr u32 CONTAINER_VERSION = 2;
+
+/// Header at the start of a pipeline cache file
+struct CacheFileHeader {
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    u32 container_version;
+    /// Location of the last index written, zero when there is none
+    u64 index_offset;
+    u64 index_count;
+    /// Records from this offset to the end of the file are not covered by the index
+    u64 unindexed_offset;
+};
+static_assert(std::is_trivially_copyable_v<CacheFileHeader>);
+
+/// Header of a pipeline record, followed by the key and the zstd compressed environments
+struct CacheRecordHeader {
+    u64 key_hash;
+    u64 first_use;
+    u32 key_size;
+    u32 num_envs;
+    u32 compressed_size;
+    u32 uncompressed_size;
+    u32 is_compute;
+    u32 padding;
+};
+static_assert(std::is_trivially_copyable_v<CacheRecordHeader>);
+
+struct CacheIndexEntry {
+    u64 key_hash;
+    u64 offset;
+};
+static_assert(std::is_trivially_copyable_v<CacheIndexEntry>);
+
 constexpr size_t INST_SIZE = sizeof(u64);
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
@@ -193,7 +234,7 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
-void GenericEnvironment::Serialize(std::ofstream& file) const {
+void GenericEnvironment::Serialize(std::ostream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
     const u64 num_texture_pixel_formats{static_cast<u64>(texture_pixel_formats.size())};
@@ -448,7 +489,7 @@ u32 ComputeEnvironment::ReadViewportTransformState() {
     return viewport_transform_state;
 }
 
-void FileEnvironment::Deserialize(std::ifstream& file) {
+void FileEnvironment::Deserialize(std::istream& file) {
     u64 code_size{};
     u64 num_texture_types{};
     u64 num_texture_pixel_formats{};
@@ -582,61 +623,57 @@ std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u3
     return it->second;
 }
 
-void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
-                       const std::filesystem::path& filename, u32 cache_version) try {
-    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
-    file.exceptions(std::ifstream::failbit);
-    if (!file.is_open()) {
-        LOG_ERROR(Common_Filesystem, "Failed to open pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
-        return;
-    }
-    if (file.tellp() == 0) {
-        // Write header
-        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
-            .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+namespace {
+/// Read-only stream buffer over decompressed memory
+class MemoryStreamBuffer final : public std::streambuf {
+public:
+    explicit MemoryStreamBuffer(std::span<const u8> data) {
+        char* const begin{reinterpret_cast<char*>(const_cast<u8*>(data.data()))};
+        setg(begin, begin, begin + data.size());
     }
-    if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
-        return;
-    }
-    const u32 num_envs{static_cast<u32>(envs.size())};
-    file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
-    for (const GenericEnvironment* const env : envs) {
-        env->Serialize(file);
+};
+
+template <typename T>
+std::optional<T> ReadMapped(std::span<const u8> data, u64 offset) {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) {
+        return std::nullopt;
     }
-    file.write(key.data(), key.size_bytes());
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
 
-} catch (const std::ios_base::failure& e) {
-    LOG_ERROR(Common_Filesystem, "{}", e.what());
-    if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
+u64 RecordSize(const CacheRecordHeader& record) {
+    return sizeof(CacheRecordHeader) + record.key_size + record.compressed_size;
+}
+} // Anonymous namespace
+
+std::optional<u32> ReadPipelineCacheVersion(const std::filesystem::path& filename) {
+    std::ifstream file{filename, std::ios::binary};
+    CacheFileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic_number != MAGIC_NUMBER || header.container_version != CONTAINER_VERSION) {
+        return std::nullopt;
     }
+    return header.cache_version;
 }
 
-void LoadPipelines(
-    std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
+PipelineCacheReader::PipelineCacheReader(const std::filesystem::path& filename_,
+                                         u32 expected_cache_version)
+    : filename{filename_}, file{filename_} {
+    const std::span<const u8> data{file.Data()};
+    if (!file.IsOpen()) {
         return;
     }
-    file.exceptions(std::ifstream::failbit);
-    const auto end{file.tellg()};
-    file.seekg(0, std::ios::beg);
-
-    std::array<char, 8> magic_number;
-    u32 cache_version;
-    file.read(magic_number.data(), magic_number.size())
-        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
-    if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
-        file.close();
+    const std::optional<CacheFileHeader> header{ReadMapped<CacheFileHeader>(data, 0)};
+    if (!header || header->magic_number != MAGIC_NUMBER ||
+        header->cache_version != expected_cache_version ||
+        header->container_version != CONTAINER_VERSION) {
+        file.Close();
         if (Common::FS::RemoveFile(filename)) {
-            if (magic_number != MAGIC_NUMBER) {
+            if (!header || header->magic_number != MAGIC_NUMBER) {
                 LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
-            }
-            if (cache_version != expected_cache_version) {
+            } else {
                 LOG_INFO(Common_Filesystem, "Deleting old pipeline cache");
             }
         } else {
@@ -646,29 +683,244 @@ void LoadPipelines(
         }
         return;
     }
-    while (file.tellg() != end) {
-        if (stop_loading.stop_requested()) {
-            return;
-        }
-        u32 num_envs{};
-        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
-        std::vector<FileEnvironment> envs(num_envs);
-        for (FileEnvironment& env : envs) {
-            env.Deserialize(file);
+    const auto add_record{[&](u64 offset, std::optional<u64> expected_hash) -> std::optional<u64> {
+        const std::optional<CacheRecordHeader> record{ReadMapped<CacheRecordHeader>(data, offset)};
+        if (!record || data.size() - offset < RecordSize(*record) || record->num_envs == 0 ||
+            (expected_hash && *expected_hash != record->key_hash)) {
+            return std::nullopt;
         }
-        if (envs.front().ShaderStage() == Shader::Stage::Compute) {
-            load_compute(file, std::move(envs.front()));
+        const std::span<const char> key(
+            reinterpret_cast<const char*>(data.data()) + offset + sizeof(CacheRecordHeader),
+            record->key_size);
+        // Keys sharing a hash are told apart by their contents
+        if (!FindByHash(record->key_hash, key)) {
+            entry_by_hash.emplace(record->key_hash, entries.size());
+            entries.push_back({
+                .key_hash = record->key_hash,
+                .offset = offset,
+                .first_use = record->first_use,
+                .num_envs = record->num_envs,
+                .is_compute = record->is_compute != 0,
+                .key = key,
+            });
         } else {
-            load_graphics(file, std::move(envs));
+            index_is_stale = true;
+        }
+        return offset + RecordSize(*record);
+    }};
+    if (header->index_offset != 0) {
+        for (u64 i = 0; i < header->index_count; ++i) {
+            const u64 entry_offset{header->index_offset + i * sizeof(CacheIndexEntry)};
+            const std::optional<CacheIndexEntry> entry{
+                ReadMapped<CacheIndexEntry>(data, entry_offset)};
+            if (!entry || !add_record(entry->offset, entry->key_hash)) {
+                LOG_ERROR(Common_Filesystem, "Invalid pipeline cache index entry {}", i);
+                index_is_stale = true;
+            }
         }
     }
+    // Walk the records appended since the index was written
+    std::optional<u64> offset{header->unindexed_offset};
+    while (*offset < data.size()) {
+        index_is_stale = true;
+        offset = add_record(*offset, std::nullopt);
+        if (!offset) {
+            // Torn write, the index written next will skip over it
+            LOG_WARNING(Common_Filesystem, "Pipeline cache file has a truncated record");
+            break;
+        }
+    }
+    std::ranges::sort(entries, {}, &PipelineCacheEntry::offset);
+    entry_by_hash.clear();
+    for (size_t index = 0; index < entries.size(); ++index) {
+        entry_by_hash.emplace(entries[index].key_hash, index);
+    }
+}
+
+PipelineCacheReader::~PipelineCacheReader() {
+    if (!is_invalidated) {
+        return;
+    }
+    // A mapped file can't be deleted on every host
+    file.Close();
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+const PipelineCacheEntry* PipelineCacheReader::Find(std::span<const char> key) const {
+    return FindByHash(Common::CityHash64(key.data(), key.size()), key);
+}
+
+const PipelineCacheEntry* PipelineCacheReader::FindByHash(u64 key_hash,
+                                                          std::span<const char> key) const {
+    const auto [begin, end]{entry_by_hash.equal_range(key_hash)};
+    for (auto it = begin; it != end; ++it) {
+        const PipelineCacheEntry& entry{entries[it->second]};
+        if (std::ranges::equal(entry.key, key)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<FileEnvironment> PipelineCacheReader::ReadEnvironments(
+    const PipelineCacheEntry& entry) const try {
+    const std::span<const u8> data{file.Data()};
+    const CacheRecordHeader record{*ReadMapped<CacheRecordHeader>(data, entry.offset)};
+    const std::vector<u8> uncompressed{Common::Compression::DecompressDataZSTD(data.subspan(
+        entry.offset + sizeof(CacheRecordHeader) + record.key_size, record.compressed_size))};
+    if (uncompressed.size() != record.uncompressed_size) {
+        LOG_ERROR(Common_Filesystem, "Failed to decompress pipeline at offset {}", entry.offset);
+        return {};
+    }
+    MemoryStreamBuffer buffer{uncompressed};
+    std::istream stream{&buffer};
+    stream.exceptions(std::istream::failbit);
+    std::vector<FileEnvironment> envs(record.num_envs);
+    for (FileEnvironment& env : envs) {
+        env.Deserialize(stream);
+    }
+    return envs;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "Invalid pipeline at offset {}: {}", entry.offset, e.what());
+    return {};
+}
+
+void PipelineCacheReader::UpdateIndex() {
+    if (!file.IsOpen() || !index_is_stale) {
+        return;
+    }
+    // The mapping is read-only, the index is written through a separate handle
+    Common::FS::IOFile stream{filename, Common::FS::FileAccessMode::ReadWrite,
+                              Common::FS::FileType::BinaryFile,
+                              Common::FS::FileShareFlag::ShareReadWrite};
+    if (!stream.IsOpen() || !stream.Seek(0, Common::FS::SeekOrigin::End)) {
+        LOG_ERROR(Common_Filesystem, "Failed to open pipeline cache file {} for writing",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    const u64 index_offset{static_cast<u64>(stream.Tell())};
+
+    std::vector<CacheIndexEntry> index;
+    index.reserve(entries.size());
+    for (const PipelineCacheEntry& entry : entries) {
+        index.push_back({.key_hash = entry.key_hash, .offset = entry.offset});
+    }
+    // Publish the new index only once it is on disk, a crash before the header is rewritten
+    // leaves the previous index in place and the new one as dead space
+    if (stream.WriteSpan(std::span<const CacheIndexEntry>(index)) != index.size() ||
+        !stream.Commit()) {
+        LOG_ERROR(Common_Filesystem, "Failed to write pipeline cache index");
+        return;
+    }
+    CacheFileHeader header{*ReadMapped<CacheFileHeader>(file.Data(), 0)};
+    header.index_offset = index_offset;
+    header.index_count = index.size();
+    header.unindexed_offset = index_offset + index.size() * sizeof(CacheIndexEntry);
+    if (!stream.Seek(0) || !stream.WriteObject(header) || !stream.Commit()) {
+        LOG_ERROR(Common_Filesystem, "Failed to publish pipeline cache index");
+        return;
+    }
+    index_is_stale = false;
+}
+
+void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
+                       u64 first_use, const std::filesystem::path& filename, u32 cache_version,
+                       PipelineCacheReader* reader) try {
+    if (reader && (reader->IsInvalidated() || reader->Find(key))) {
+        return;
+    }
+    if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
+        return;
+    }
+    std::ostringstream blob(std::ios::binary);
+    blob.exceptions(std::ios::failbit);
+    for (const GenericEnvironment* const env : envs) {
+        env->Serialize(blob);
+    }
+    const std::string uncompressed{std::move(blob).str()};
+    const std::vector<u8> compressed{Common::Compression::CompressDataZSTDDefault(
+        reinterpret_cast<const u8*>(uncompressed.data()), uncompressed.size())};
+    if (compressed.empty()) {
+        LOG_ERROR(Common_Filesystem, "Failed to compress pipeline");
+        return;
+    }
+    const CacheRecordHeader record{
+        .key_hash = Common::CityHash64(key.data(), key.size()),
+        .first_use = first_use,
+        .key_size = static_cast<u32>(key.size()),
+        .num_envs = static_cast<u32>(envs.size()),
+        .compressed_size = static_cast<u32>(compressed.size()),
+        .uncompressed_size = static_cast<u32>(uncompressed.size()),
+        .is_compute = envs.front()->ShaderStage() == Shader::Stage::Compute ? 1U : 0U,
+        .padding = 0,
+    };
+
+    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    if (file.tellp() == 0) {
+        // Write header
+        const CacheFileHeader header{
+            .magic_number = MAGIC_NUMBER,
+            .cache_version = cache_version,
+            .container_version = CONTAINER_VERSION,
+            .index_offset = 0,
+            .index_count = 0,
+            .unindexed_offset = sizeof(CacheFileHeader),
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record))
+        .write(key.data(), key.size_bytes())
+        .write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
+    if (reader) {
+        reader->Invalidate();
+        return;
+    }
     if (!Common::FS::RemoveFile(filename)) {
         LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
                   Common::FS::PathToUTF8String(filename));
     }
 }
 
+std::shared_ptr<PipelineCacheReader> LoadPipelines(
+    std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
+    Common::UniqueFunction<void, std::span<const char>, PipelineEnvironmentLoader, u64>
+        load_compute,
+    Common::UniqueFunction<void, std::span<const char>, PipelineEnvironmentLoader, u64>
+        load_graphics) {
+    auto reader{std::make_shared<PipelineCacheReader>(filename, expected_cache_version)};
+    if (!reader->IsOpen()) {
+        return reader;
+    }
+    reader->UpdateIndex();
+    for (const PipelineCacheEntry& entry : reader->Entries()) {
+        if (stop_loading.stop_requested()) {
+            return reader;
+        }
+        PipelineEnvironmentLoader load_envs{
+            [reader, entry_ = &entry] { return reader->ReadEnvironments(*entry_); }};
+        u64 first_use{entry.first_use};
+        if (entry.is_compute) {
+            load_compute(std::span<const char>{entry.key}, std::move(load_envs),
+                         std::move(first_use));
+        } else {
+            load_graphics(std::span<const char>{entry.key}, std::move(load_envs),
+                          std::move(first_use));
+        }
+    }
+    return reader;
+}
+
 } // namespace VideoCommon
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstring>
 #include <filesystem>
 #include <iosfwd>
 #include <limits>
@@ -15,6 +17,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/fs/mapped_file.h"
 #include "common/polyfill_thread.h"
 #include "common/unique_function.h"
 #include "shader_recompiler/environment.h"
@@ -60,7 +63,7 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
-    void Serialize(std::ofstream& file) const;
+    void Serialize(std::ostream& file) const;
 
     bool HasHLEMacroState() const override {
         return has_hle_engine_state;
@@ -165,7 +168,7 @@ public:
     FileEnvironment& operator=(const FileEnvironment&) = delete;
     FileEnvironment(const FileEnvironment&) = delete;
 
-    void Deserialize(std::ifstream& file);
+    void Deserialize(std::istream& file);
 
     [[nodiscard]] u64 ReadInstruction(u32 address) override;
 
@@ -212,21 +215,124 @@ private:
     u32 viewport_transform_state = 1;
 };
 
+/// Pipeline stored in a cache file
+struct PipelineCacheEntry {
+    u64 key_hash;
+    u64 offset;
+    u64 first_use;
+    u32 num_envs;
+    bool is_compute;
+    /// Pipeline key, pointing into the file mapping
+    std::span<const char> key;
+};
+
+/// Returns the renderer cache version of a pipeline cache file, nullopt when it is not one
+[[nodiscard]] std::optional<u32> ReadPipelineCacheVersion(const std::filesystem::path& filename);
+
+/// Memory mapped view of a pipeline cache file.
+/// Only the index is parsed when the file is opened, environments are decompressed on demand.
+class PipelineCacheReader {
+public:
+    /// Opens and validates a cache file, deleting it when it is invalid or outdated
+    explicit PipelineCacheReader(const std::filesystem::path& filename,
+                                 u32 expected_cache_version);
+    ~PipelineCacheReader();
+
+    PipelineCacheReader(const PipelineCacheReader&) = delete;
+    PipelineCacheReader& operator=(const PipelineCacheReader&) = delete;
+
+    [[nodiscard]] bool IsOpen() const noexcept {
+        return file.IsOpen();
+    }
+
+    /// Returns every unique pipeline in the file, in file order
+    [[nodiscard]] std::span<const PipelineCacheEntry> Entries() const noexcept {
+        return entries;
+    }
+
+    /// Looks up a pipeline by its key
+    [[nodiscard]] const PipelineCacheEntry* Find(std::span<const char> key) const;
+
+    template <typename Key>
+    [[nodiscard]] const PipelineCacheEntry* Find(const Key& key) const {
+        static_assert(std::is_trivially_copyable_v<Key>);
+        return Find(std::span(reinterpret_cast<const char*>(&key), sizeof(key)));
+    }
+
+    /// Decompresses the environments of a pipeline, returns an empty vector on error.
+    /// Safe to call from multiple threads.
+    [[nodiscard]] std::vector<FileEnvironment> ReadEnvironments(
+        const PipelineCacheEntry& entry) const;
+
+    /// Writes an index covering every pipeline in the file when pipelines were appended after the
+    /// last index, so the next load doesn't have to walk them.
+    void UpdateIndex();
+
+    /// Deletes the file once the reader is destroyed and the file is unmapped.
+    /// SerializePipeline drops the pipelines passed along with an invalidated reader.
+    void Invalidate() noexcept {
+        is_invalidated = true;
+    }
+
+    [[nodiscard]] bool IsInvalidated() const noexcept {
+        return is_invalidated;
+    }
+
+private:
+    [[nodiscard]] const PipelineCacheEntry* FindByHash(u64 key_hash,
+                                                       std::span<const char> key) const;
+
+    std::filesystem::path filename;
+    Common::FS::MappedFile file;
+    std::vector<PipelineCacheEntry> entries;
+    std::unordered_multimap<u64, size_t> entry_by_hash;
+    bool index_is_stale{};
+    std::atomic_bool is_invalidated{};
+};
+
+/// Appends a pipeline to the cache file.
+/// first_use orders the pipeline by its first use, across the sessions that appended to the file.
+/// reader, when not null, maps the same file: pipelines it already holds are not appended again,
+/// and a failed append deletes the file only once the reader has unmapped it.
 void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
-                       const std::filesystem::path& filename, u32 cache_version);
+                       u64 first_use, const std::filesystem::path& filename, u32 cache_version,
+                       PipelineCacheReader* reader);
 
 template <typename Key, typename Envs>
-void SerializePipeline(const Key& key, const Envs& envs, const std::filesystem::path& filename,
-                       u32 cache_version) {
+void SerializePipeline(const Key& key, const Envs& envs, u64 first_use,
+                       const std::filesystem::path& filename, u32 cache_version,
+                       PipelineCacheReader* reader) {
     static_assert(std::is_trivially_copyable_v<Key>);
     static_assert(std::has_unique_object_representations_v<Key>);
     SerializePipeline(std::span(reinterpret_cast<const char*>(&key), sizeof(key)),
-                      std::span(envs.data(), envs.size()), filename, cache_version);
+                      std::span(envs.data(), envs.size()), first_use, filename, cache_version,
+                      reader);
+}
+
+/// Copies a pipeline key read from a cache file, returns false when its size doesn't match
+template <typename Key>
+[[nodiscard]] bool ReadPipelineKey(std::span<const char> data, Key& key) {
+    static_assert(std::is_trivially_copyable_v<Key>);
+    if (data.size() != sizeof(key)) {
+        return false;
+    }
+    std::memcpy(&key, data.data(), sizeof(key));
+    return true;
 }
 
-void LoadPipelines(
+/// Decompresses the environments of a pipeline passed by LoadPipelines, returns an empty vector on
+/// error. Safe to call from any thread, it keeps the cache file mapped until it is destroyed.
+using PipelineEnvironmentLoader = Common::UniqueFunction<std::vector<FileEnvironment>>;
+
+/// Reads every pipeline in the cache file, in file order, passing its key, a loader for its
+/// environments and its first use along. Only the index is read here, so the environments can be
+/// decompressed by the threads building the pipelines.
+/// Returns the reader of the file, to pass to SerializePipeline.
+[[nodiscard]] std::shared_ptr<PipelineCacheReader> LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics);
+    Common::UniqueFunction<void, std::span<const char>, PipelineEnvironmentLoader, u64>
+        load_compute,
+    Common::UniqueFunction<void, std::span<const char>, PipelineEnvironmentLoader, u64>
+        load_graphics);
 
 } // namespace VideoCommon
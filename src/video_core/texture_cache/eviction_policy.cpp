@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "common/logging/log.h"
+#include "video_core/texture_cache/eviction_policy.h"
+
+namespace VideoCommon {
+
+namespace {
+
+/// Frames an image has to stay unused before it can be evicted, for each level of pressure
+constexpr u64 RELAXED_MINIMUM_AGE = 50;
+constexpr u64 HIGH_MINIMUM_AGE = 25;
+constexpr u64 CRITICAL_MINIMUM_AGE = 4;
+
+/// Downloads stall the GPU, only a few are allowed per pass until the budget is exceeded
+constexpr u32 HIGH_MAX_DOWNLOADS = 4;
+
+/// Frames an eviction is remembered for, an image created again within them counts as a re-upload
+constexpr u64 REUPLOAD_WINDOW = 300;
+
+/// Frames between two debug log reports of the statistics, skipped while nothing was evicted
+constexpr u64 STATISTICS_LOG_INTERVAL = 3600;
+
+/// Cost of creating an image and its views, measured in bytes uploaded on the GPU
+constexpr double CREATION_COST = 256.0 * 1024.0;
+
+/// Relative cost of loading back a byte through each upload path
+constexpr double UploadCost(UploadPath path) {
+    switch (path) {
+    case UploadPath::Accelerated:
+        return 1.0;
+    case UploadPath::Unswizzle:
+        return 2.0;
+    case UploadPath::Converted:
+        return 8.0;
+    }
+    return 1.0;
+}
+
+} // Anonymous namespace
+
+void EvictionPolicy::Configure(u64 minimum, u64 expected, u64 budget) {
+    budget_memory = budget;
+    expected_memory = (std::min)(expected, budget);
+    minimum_memory = (std::min)(minimum, expected_memory);
+}
+
+EvictionPlan EvictionPolicy::Plan(u64 used_memory) const {
+    if (used_memory <= minimum_memory) {
+        return {};
+    }
+    if (used_memory < expected_memory) {
+        // Trickle out images that have not been used in a while to keep some headroom
+        return {
+            .bytes_to_free = (std::min)(used_memory - minimum_memory, budget_memory / 64),
+            .minimum_age = RELAXED_MINIMUM_AGE,
+            .max_downloads = 0,
+            .allow_costly = false,
+        };
+    }
+    if (used_memory < budget_memory) {
+        // Get back under the expected usage with some margin, so this does not run every frame
+        return {
+            .bytes_to_free = used_memory - expected_memory + (budget_memory - expected_memory) / 4,
+            .minimum_age = HIGH_MINIMUM_AGE,
+            .max_downloads = HIGH_MAX_DOWNLOADS,
+            .allow_costly = false,
+        };
+    }
+    return {
+        .bytes_to_free = used_memory - expected_memory,
+        .minimum_age = CRITICAL_MINIMUM_AGE,
+        .max_downloads = (std::numeric_limits<u32>::max)(),
+        .allow_costly = true,
+    };
+}
+
+std::span<const EvictionCandidate> EvictionPolicy::Select(const EvictionPlan& plan,
+                                                          std::span<EvictionCandidate> candidates,
+                                                          u64 frame_tick) const {
+    if (plan.bytes_to_free == 0) {
+        return {};
+    }
+    const auto eligible_end =
+        std::partition(candidates.begin(), candidates.end(), [&](const EvictionCandidate& c) {
+            if (c.last_use + plan.minimum_age > frame_tick) {
+                return false;
+            }
+            if (c.costly_load && !plan.allow_costly) {
+                return false;
+            }
+            return !c.must_download || plan.max_downloads > 0;
+        });
+    const std::span<EvictionCandidate> eligible{candidates.begin(), eligible_end};
+    std::ranges::sort(eligible, std::greater{}, [frame_tick](const EvictionCandidate& c) {
+        return Score(c, frame_tick);
+    });
+
+    size_t num_selected = 0;
+    u64 freed_bytes = 0;
+    u32 num_downloads = 0;
+    for (const EvictionCandidate& candidate : eligible) {
+        if (freed_bytes >= plan.bytes_to_free) {
+            break;
+        }
+        if (candidate.must_download) {
+            if (num_downloads == plan.max_downloads) {
+                continue;
+            }
+            ++num_downloads;
+        }
+        freed_bytes += candidate.size_bytes;
+        candidates[num_selected++] = candidate;
+    }
+    return candidates.first(num_selected);
+}
+
+void EvictionPolicy::RecordEviction(const EvictionCandidate& candidate, u64 frame_tick) {
+    ++statistics.evictions;
+    statistics.evicted_bytes += candidate.size_bytes;
+    if (candidate.must_download) {
+        ++statistics.downloads;
+        statistics.downloaded_bytes += candidate.size_bytes;
+    }
+    recent_evictions.insert_or_assign(candidate.gpu_addr,
+                                      RecentEviction{candidate.size_bytes, frame_tick});
+}
+
+void EvictionPolicy::RecordRegistration(GPUVAddr gpu_addr, u64 size_bytes, u64 frame_tick) {
+    const auto it = recent_evictions.find(gpu_addr);
+    if (it == recent_evictions.end()) {
+        return;
+    }
+    const RecentEviction eviction = it->second;
+    recent_evictions.erase(it);
+    if (eviction.size_bytes != size_bytes || eviction.frame_tick + REUPLOAD_WINDOW < frame_tick) {
+        return;
+    }
+    ++statistics.reuploads;
+    statistics.reuploaded_bytes += size_bytes;
+}
+
+void EvictionPolicy::TickFrame(u64 used_memory, u64 frame_tick) {
+    statistics.peak_memory = (std::max)(statistics.peak_memory, used_memory);
+    if (used_memory > budget_memory) {
+        ++statistics.budget_overruns;
+    }
+    if (frame_tick % REUPLOAD_WINDOW == 0) {
+        std::erase_if(recent_evictions, [frame_tick](const auto& pair) {
+            return pair.second.frame_tick + REUPLOAD_WINDOW < frame_tick;
+        });
+    }
+    if (frame_tick % STATISTICS_LOG_INTERVAL == 0 &&
+        (statistics.evictions != logged_evictions ||
+         statistics.budget_overruns != logged_budget_overruns)) {
+        LogStatistics();
+    }
+}
+
+void EvictionPolicy::LogStatistics() {
+    LOG_DEBUG(HW_GPU,
+              "Texture cache: {} evictions ({} MiB), {} downloads ({} MiB), "
+              "{} re-uploads ({} MiB), {} frames over budget, peak {} MiB",
+              statistics.evictions, statistics.evicted_bytes >> 20, statistics.downloads,
+              statistics.downloaded_bytes >> 20, statistics.reuploads,
+              statistics.reuploaded_bytes >> 20, statistics.budget_overruns,
+              statistics.peak_memory >> 20);
+    logged_evictions = statistics.evictions;
+    logged_budget_overruns = statistics.budget_overruns;
+}
+
+double EvictionPolicy::Score(const EvictionCandidate& candidate, u64 frame_tick) {
+    double cost_per_byte = UploadCost(candidate.upload_path);
+    if (candidate.costly_load) {
+        cost_per_byte += 8.0;
+    }
+    if (candidate.must_download) {
+        cost_per_byte += 4.0;
+    }
+    const double age = static_cast<double>(frame_tick - candidate.last_use + 1);
+    const double size = static_cast<double>(candidate.size_bytes);
+    return age * size / (size * cost_per_byte + CREATION_COST);
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <span>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+/// How the contents of an image are brought back to the host after it has been evicted
+enum class UploadPath : u8 {
+    Accelerated, ///< Unswizzled on the GPU
+    Unswizzle,   ///< Unswizzled on the CPU
+    Converted,   ///< Unswizzled and converted to a host format on the CPU
+};
+
+/// Image the garbage collector may evict, as seen by the eviction policy
+struct EvictionCandidate {
+    ImageId image_id;
+    GPUVAddr gpu_addr;
+    u64 size_bytes;
+    u64 last_use;
+    UploadPath upload_path;
+    bool costly_load;
+    bool must_download;
+};
+
+/// What the garbage collector is allowed to do in a single pass
+struct EvictionPlan {
+    u64 bytes_to_free = 0;
+    u64 minimum_age = 0;
+    u32 max_downloads = 0;
+    bool allow_costly = false;
+};
+
+struct EvictionStatistics {
+    u64 evictions = 0;
+    u64 evicted_bytes = 0;
+    u64 downloads = 0;
+    u64 downloaded_bytes = 0;
+    /// Evicted images that were created again shortly after
+    u64 reuploads = 0;
+    u64 reuploaded_bytes = 0;
+    /// Frames that ended above the budget after collecting
+    u64 budget_overruns = 0;
+    u64 peak_memory = 0;
+};
+
+/**
+ * Decides which images the texture cache evicts to stay within a VRAM budget.
+ * Images are scored by how long they have been unused and how expensive they are to load back,
+ * so large images that upload on the GPU go first and images converted on the CPU or that must be
+ * downloaded before deletion go last.
+ */
+class EvictionPolicy {
+public:
+    /**
+     * Sets the memory thresholds the policy works with.
+     * @param minimum  Usage below which nothing is collected
+     * @param expected Usage the policy tries to stay under
+     * @param budget   Usage that must not be exceeded, old images are evicted regardless of cost
+     */
+    void Configure(u64 minimum, u64 expected, u64 budget);
+
+    /// Returns what the garbage collector may do with the given memory usage
+    [[nodiscard]] EvictionPlan Plan(u64 used_memory) const;
+
+    /**
+     * Orders candidates from the best to the worst to evict and drops the ones the plan does not
+     * allow to be evicted.
+     * @returns Leading candidates that should be evicted to satisfy the plan
+     */
+    [[nodiscard]] std::span<const EvictionCandidate> Select(
+        const EvictionPlan& plan, std::span<EvictionCandidate> candidates, u64 frame_tick) const;
+
+    /// Records that a candidate returned by Select was evicted
+    void RecordEviction(const EvictionCandidate& candidate, u64 frame_tick);
+
+    /// Records that an image was created, to detect evicted images that had to be loaded back
+    void RecordRegistration(GPUVAddr gpu_addr, u64 size_bytes, u64 frame_tick);
+
+    /// Closes a frame, called after the garbage collector has run.
+    /// The statistics are debug logged periodically while images are being evicted.
+    void TickFrame(u64 used_memory, u64 frame_tick);
+
+    [[nodiscard]] const EvictionStatistics& Statistics() const noexcept {
+        return statistics;
+    }
+
+private:
+    struct RecentEviction {
+        u64 size_bytes;
+        u64 frame_tick;
+    };
+
+    /// Returns how desirable it is to evict a candidate, higher is better
+    [[nodiscard]] static double Score(const EvictionCandidate& candidate, u64 frame_tick);
+
+    void LogStatistics();
+
+    u64 minimum_memory = 0;
+    u64 expected_memory = 0;
+    u64 budget_memory = 0;
+
+    std::unordered_map<GPUVAddr, RecentEviction> recent_evictions;
+    EvictionStatistics statistics;
+    u64 logged_evictions = 0;
+    u64 logged_budget_overruns = 0;
+};
+
+} // namespace VideoCommon
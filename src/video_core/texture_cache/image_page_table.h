@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/**
+ * Two level page directory mapping page numbers to the ids registered on them.
+ * A lookup is two array indexings instead of a hash lookup, and pages with a few ids keep them
+ * inline instead of allocating. Leaves are allocated on first use, so sparse address spaces only
+ * pay for the regions that actually hold images.
+ */
+template <typename Id, size_t INLINE_CAPACITY = 4>
+class ImagePageTable {
+    static constexpr size_t LEAF_BITS = 10;
+    static constexpr size_t LEAF_SIZE = size_t{1} << LEAF_BITS;
+    static constexpr u64 LEAF_MASK = LEAF_SIZE - 1;
+
+public:
+    using Bucket = boost::container::small_vector<Id, INLINE_CAPACITY>;
+
+    /// Returns the ids registered in a page, nullptr when nothing was ever registered around it
+    [[nodiscard]] Bucket* Find(u64 page) noexcept {
+        const u64 leaf_index = page >> LEAF_BITS;
+        if (leaf_index >= directory.size() || !directory[leaf_index]) [[unlikely]] {
+            return nullptr;
+        }
+        return &(*directory[leaf_index])[page & LEAF_MASK];
+    }
+
+    [[nodiscard]] const Bucket* Find(u64 page) const noexcept {
+        return const_cast<ImagePageTable*>(this)->Find(page);
+    }
+
+    /// Returns the ids registered in a page, allocating storage for it when needed
+    [[nodiscard]] Bucket& operator[](u64 page) {
+        const u64 leaf_index = page >> LEAF_BITS;
+        if (leaf_index >= directory.size()) [[unlikely]] {
+            directory.resize(leaf_index + 1);
+        }
+        std::unique_ptr<Leaf>& leaf = directory[leaf_index];
+        if (!leaf) [[unlikely]] {
+            leaf = std::make_unique<Leaf>();
+        }
+        return (*leaf)[page & LEAF_MASK];
+    }
+
+private:
+    using Leaf = std::array<Bucket, LEAF_SIZE>;
+
+    std::vector<std::unique_ptr<Leaf>> directory;
+};
+
+} // namespace VideoCommon
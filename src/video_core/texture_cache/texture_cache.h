@@ -71,78 +71,78 @@ TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManag
         critical_memory = DEFAULT_CRITICAL_MEMORY + 1_GiB;
         minimum_memory = 0;
     }
+    if (const u64 budget = u64{Settings::values.vram_budget.GetValue()} * 1_MiB; budget != 0) {
+        critical_memory = budget;
+        expected_memory = budget - budget / 8;
+        minimum_memory = budget / 2;
+    }
+    eviction_policy.Configure(minimum_memory, expected_memory, critical_memory);
 }
 
 template <class P>
 void TextureCache<P>::RunGarbageCollector() {
-    bool high_priority_mode = false;
-    bool aggressive_mode = false;
-    u64 ticks_to_destroy = 0;
-    size_t num_iterations = 0;
-
-    const auto Configure = [&](bool allow_aggressive) {
-        high_priority_mode = total_used_memory >= expected_memory;
-        aggressive_mode = allow_aggressive && total_used_memory >= critical_memory;
-        ticks_to_destroy = aggressive_mode ? 10ULL : high_priority_mode ? 25ULL : 50ULL;
-        num_iterations = aggressive_mode ? 40 : (high_priority_mode ? 20 : 10);
-    };
-    const auto Cleanup = [this, &num_iterations, &high_priority_mode,
-                          &aggressive_mode](ImageId image_id) {
-        if (num_iterations == 0) {
+    const EvictionPlan plan = eviction_policy.Plan(total_used_memory);
+    if (plan.bytes_to_free == 0) {
+        return;
+    }
+    eviction_candidates.clear();
+    lru_cache.ForEachItemBelow(frame_tick - plan.minimum_age, [&](ImageId image_id) {
+        if (eviction_candidates.size() == MAX_EVICTION_CANDIDATES) {
             return true;
         }
-        --num_iterations;
-        auto& image = slot_images[image_id];
+        const Image& image = slot_images[image_id];
         if (True(image.flags & ImageFlagBits::IsDecoding)) {
             // This image is still being decoded, deleting it will invalidate the slot
             // used by the async decoder thread.
             return false;
         }
-        if (!aggressive_mode && True(image.flags & ImageFlagBits::CostlyLoad)) {
-            return false;
-        }
-        const bool must_download =
-            image.IsSafeDownload() && False(image.flags & ImageFlagBits::BadOverlap);
-        if (!high_priority_mode && must_download) {
-            return false;
-        }
-        if (must_download) {
-            auto map = runtime.DownloadStagingBuffer(image.unswizzled_size_bytes);
-            const auto copies = FullDownloadCopies(image.info);
-            image.DownloadMemory(map, copies);
-            runtime.Finish();
-            SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
-                         swizzle_data_buffer);
-        }
-        if (True(image.flags & ImageFlagBits::Tracked)) {
-            UntrackImage(image, image_id);
-        }
-        UnregisterImage(image_id);
-        DeleteImage(image_id, image.scale_tick > frame_tick + 5);
-        if (total_used_memory < critical_memory) {
-            if (aggressive_mode) {
-                // Sink the aggresiveness.
-                num_iterations >>= 2;
-                aggressive_mode = false;
-                return false;
-            }
-            if (high_priority_mode && total_used_memory < expected_memory) {
-                num_iterations >>= 1;
-                high_priority_mode = false;
-            }
-        }
+        eviction_candidates.push_back(MakeEvictionCandidate(image_id, image));
         return false;
-    };
+    });
+    for (const EvictionCandidate& candidate :
+         eviction_policy.Select(plan, eviction_candidates, frame_tick)) {
+        EvictImage(candidate);
+        eviction_policy.RecordEviction(candidate, frame_tick);
+    }
+}
 
-    // Try to remove anything old enough and not high priority.
-    Configure(false);
-    lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+template <class P>
+EvictionCandidate TextureCache<P>::MakeEvictionCandidate(ImageId image_id, const Image& image) {
+    UploadPath upload_path = UploadPath::Unswizzle;
+    if (True(image.flags & ImageFlagBits::AcceleratedUpload)) {
+        upload_path = UploadPath::Accelerated;
+    } else if (True(image.flags & ImageFlagBits::Converted)) {
+        upload_path = UploadPath::Converted;
+    }
+    return {
+        .image_id = image_id,
+        .gpu_addr = image.gpu_addr,
+        .size_bytes = GetScaledImageSizeBytes(image),
+        .last_use = lru_cache.GetTick(image.lru_index),
+        .upload_path = upload_path,
+        .costly_load = True(image.flags & ImageFlagBits::CostlyLoad),
+        .must_download =
+            image.IsSafeDownload() && False(image.flags & ImageFlagBits::BadOverlap),
+    };
+}
 
-    // If pressure is still too high, prune aggressively.
-    if (total_used_memory >= critical_memory) {
-        Configure(true);
-        lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+template <class P>
+void TextureCache<P>::EvictImage(const EvictionCandidate& candidate) {
+    const ImageId image_id = candidate.image_id;
+    Image& image = slot_images[image_id];
+    if (candidate.must_download) {
+        auto map = runtime.DownloadStagingBuffer(image.unswizzled_size_bytes);
+        const auto copies = FullDownloadCopies(image.info);
+        image.DownloadMemory(map, copies);
+        runtime.Finish();
+        SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
+                     swizzle_data_buffer);
+    }
+    if (True(image.flags & ImageFlagBits::Tracked)) {
+        UntrackImage(image, image_id);
     }
+    UnregisterImage(image_id);
+    DeleteImage(image_id, image.scale_tick > frame_tick + 5);
 }
 
 template <class P>
@@ -154,6 +154,7 @@ void TextureCache<P>::TickFrame() {
     if (total_used_memory > minimum_memory) {
         RunGarbageCollector();
     }
+    eviction_policy.TickFrame(total_used_memory, frame_tick);
     sentenced_images.Tick();
     sentenced_framebuffers.Tick();
     sentenced_image_view.Tick();
@@ -735,13 +736,12 @@ template <class P>
 std::pair<typename P::ImageView*, bool> TextureCache<P>::TryFindFramebufferImageView(
     const Tegra::FramebufferConfig& config, DAddr cpu_addr) {
     // TODO: Properly implement this
-    const auto it = page_table.find(cpu_addr >> YUZU_PAGEBITS);
-    if (it == page_table.end()) {
+    const auto* const image_map_ids = page_table.Find(cpu_addr >> YUZU_PAGEBITS);
+    if (!image_map_ids) {
         return {};
     }
-    const auto& image_map_ids = it->second;
     boost::container::small_vector<ImageId, 4> valid_image_ids;
-    for (const ImageMapId map_id : image_map_ids) {
+    for (const ImageMapId map_id : *image_map_ids) {
         const ImageMapView& map = slot_map_views[map_id];
         const ImageBase& image = slot_images[map.image_id];
         if (image.cpu_addr != cpu_addr) {
@@ -1815,15 +1815,15 @@ void TextureCache<P>::ForEachImageInRegion(DAddr cpu_addr, size_t size, Func&& f
     boost::container::small_vector<ImageId, 32> images;
     boost::container::small_vector<ImageMapId, 32> maps;
     ForEachCPUPage(cpu_addr, size, [this, &images, &maps, cpu_addr, size, func](u64 page) {
-        const auto it = page_table.find(page);
-        if (it == page_table.end()) {
+        const auto* const map_ids = page_table.Find(page);
+        if (!map_ids) {
             if constexpr (BOOL_BREAK) {
                 return false;
             } else {
                 return;
             }
         }
-        for (const ImageMapId map_id : it->second) {
+        for (const ImageMapId map_id : *map_ids) {
             ImageMapView& map = slot_map_views[map_id];
             if (map.picked) {
                 continue;
@@ -1873,15 +1873,15 @@ void TextureCache<P>::ForEachImageInRegionGPU(size_t as_id, GPUVAddr gpu_addr, s
     auto& gpu_page_table = gpu_page_table_storage[*storage_id * 2];
     ForEachGPUPage(gpu_addr, size,
                    [this, &gpu_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = gpu_page_table.find(page);
-                       if (it == gpu_page_table.end()) {
+                       const auto* const image_ids = gpu_page_table.Find(page);
+                       if (!image_ids) {
                            if constexpr (BOOL_BREAK) {
                                return false;
                            } else {
                                return;
                            }
                        }
-                       for (const ImageId image_id : it->second) {
+                       for (const ImageId image_id : *image_ids) {
                            Image& image = slot_images[image_id];
                            if (True(image.flags & ImageFlagBits::Picked)) {
                                continue;
@@ -1922,15 +1922,15 @@ void TextureCache<P>::ForEachSparseImageInRegion(size_t as_id, GPUVAddr gpu_addr
     auto& sparse_page_table = gpu_page_table_storage[*storage_id * 2 + 1];
     ForEachGPUPage(gpu_addr, size,
                    [this, &sparse_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = sparse_page_table.find(page);
-                       if (it == sparse_page_table.end()) {
+                       const auto* const image_ids = sparse_page_table.Find(page);
+                       if (!image_ids) {
                            if constexpr (BOOL_BREAK) {
                                return false;
                            } else {
                                return;
                            }
                        }
-                       for (const ImageId image_id : it->second) {
+                       for (const ImageId image_id : *image_ids) {
                            Image& image = slot_images[image_id];
                            if (True(image.flags & ImageFlagBits::Picked)) {
                                continue;
@@ -2002,6 +2002,7 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     }
     total_used_memory += Common::AlignUp(tentative_size, 1024);
     image.lru_index = lru_cache.Insert(image_id, frame_tick);
+    eviction_policy.RecordRegistration(image.gpu_addr, GetScaledImageSizeBytes(image), frame_tick);
 
     ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
         (*channel_state->gpu_page_table)[page].push_back(image_id);
@@ -2036,43 +2037,38 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
     image.flags &= ~ImageFlagBits::Registered;
     image.flags &= ~ImageFlagBits::BadOverlap;
     lru_cache.Free(image.lru_index);
-    const auto& clear_page_table =
-        [image_id](u64 page,
-                   std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>&
-                       selected_page_table) {
-            const auto page_it = selected_page_table.find(page);
-            if (page_it == selected_page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
-                return;
-            }
-            std::vector<ImageId>& image_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_ids, image_id);
-            if (vector_it == image_ids.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
-                           page << YUZU_PAGEBITS);
-                return;
-            }
-            image_ids.erase(vector_it);
-        };
+    const auto& clear_page_table = [image_id](u64 page, TextureCacheGPUMap& selected_page_table) {
+        auto* const image_ids = selected_page_table.Find(page);
+        if (!image_ids) {
+            ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
+            return;
+        }
+        const auto vector_it = std::ranges::find(*image_ids, image_id);
+        if (vector_it == image_ids->end()) {
+            ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
+                       page << YUZU_PAGEBITS);
+            return;
+        }
+        image_ids->erase(vector_it);
+    };
     ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, &clear_page_table](u64 page) {
         clear_page_table(page, (*channel_state->gpu_page_table));
     });
     if (False(image.flags & ImageFlagBits::Sparse)) {
         const auto map_id = image.map_view_id;
         ForEachCPUPage(image.cpu_addr, image.guest_size_bytes, [this, map_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
+            auto* const image_map_ids = page_table.Find(page);
+            if (!image_map_ids) {
                 ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
                 return;
             }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_map_ids, map_id);
-            if (vector_it == image_map_ids.end()) {
+            const auto vector_it = std::ranges::find(*image_map_ids, map_id);
+            if (vector_it == image_map_ids->end()) {
                 ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
                            page << YUZU_PAGEBITS);
                 return;
             }
-            image_map_ids.erase(vector_it);
+            image_map_ids->erase(vector_it);
         });
         slot_map_views.erase(map_id);
         return;
@@ -2088,14 +2084,13 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
         const DAddr cpu_addr = map_range.cpu_addr;
         const std::size_t size = map_range.size;
         ForEachCPUPage(cpu_addr, size, [this, image_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
+            auto* const image_map_ids = page_table.Find(page);
+            if (!image_map_ids) {
                 ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
                 return;
             }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            auto vector_it = image_map_ids.begin();
-            while (vector_it != image_map_ids.end()) {
+            auto vector_it = image_map_ids->begin();
+            while (vector_it != image_map_ids->end()) {
                 ImageMapView& map = slot_map_views[*vector_it];
                 if (map.image_id != image_id) {
                     vector_it++;
@@ -2104,7 +2099,7 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
                 if (!map.picked) {
                     map.picked = true;
                 }
-                vector_it = image_map_ids.erase(vector_it);
+                vector_it = image_map_ids->erase(vector_it);
             }
         });
         slot_map_views.erase(map_view_id);
@@ -32,8 +32,10 @@
 #include "video_core/engines/fermi_2d.h"
 #include "video_core/surface.h"
 #include "video_core/texture_cache/descriptor_table.h"
+#include "video_core/texture_cache/eviction_policy.h"
 #include "video_core/texture_cache/image_base.h"
 #include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/image_page_table.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/render_targets.h"
 #include "video_core/texture_cache/types.h"
@@ -66,7 +68,7 @@ struct AsyncDecodeContext {
     std::atomic_bool complete;
 };
 
-using TextureCacheGPUMap = std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>;
+using TextureCacheGPUMap = ImagePageTable<ImageId>;
 
 class TextureCacheChannelInfo : public ChannelInfo {
 public:
@@ -292,6 +294,12 @@ private:
     /// Runs the Garbage Collector.
     void RunGarbageCollector();
 
+    /// Describes an image to the eviction policy
+    [[nodiscard]] EvictionCandidate MakeEvictionCandidate(ImageId image_id, const Image& image);
+
+    /// Evicts an image picked by the garbage collector, downloading it first when needed
+    void EvictImage(const EvictionCandidate& candidate);
+
     /// Fills image_view_ids in the image views in indices
     template <bool has_blacklists>
     void FillImageViews(DescriptorTable<TICEntry>& table,
@@ -434,7 +442,7 @@ private:
 
     std::unordered_map<RenderTargets, FramebufferId> framebuffers;
 
-    std::unordered_map<u64, std::vector<ImageMapId>, Common::IdentityHash<u64>> page_table;
+    ImagePageTable<ImageMapId> page_table;
     std::unordered_map<ImageId, boost::container::small_vector<ImageViewId, 16>> sparse_views;
 
     DAddr virtual_invalid_space{};
@@ -479,6 +487,11 @@ private:
     };
     Common::LeastRecentlyUsedCache<LRUItemParams> lru_cache;
 
+    /// Oldest images looked at by a single garbage collector pass
+    static constexpr size_t MAX_EVICTION_CANDIDATES = 512;
+    EvictionPolicy eviction_policy;
+    std::vector<EvictionCandidate> eviction_candidates;
+
     static constexpr size_t TICKS_TO_DESTROY = 8;
     DelayedDestructionRing<Image, TICKS_TO_DESTROY> sentenced_images;
     DelayedDestructionRing<ImageView, TICKS_TO_DESTROY> sentenced_image_view;
@@ -5,6 +5,7 @@
 // <http://gamma.cs.unc.edu/FasTC/>
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cassert>
 #include <cstring>
@@ -13,56 +14,77 @@
 
 #include <boost/container/static_vector.hpp>
 
+#if defined(ARCHITECTURE_x86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#elif defined(ARCHITECTURE_arm64)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wimplicit-int-conversion"
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wshadow"
+#include <sse2neon.h>
+#pragma GCC diagnostic pop
+#endif
+
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
 #include "video_core/textures/astc.h"
+#include "video_core/textures/astc_kernels.h"
 #include "video_core/textures/workers.h"
 
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#endif
+
+// Reads the bits of a block, which is at most 128 bits long, out of two 64-bit words so that
+// each read is a couple of shifts instead of a loop over the bytes it spans.
 class InputBitStream {
 public:
-    constexpr explicit InputBitStream(std::span<const u8> data, size_t start_offset = 0)
-        : cur_byte{data.data()}, total_bits{data.size()}, next_bit{start_offset % 8} {}
+    constexpr explicit InputBitStream(std::span<const u8> data)
+        : total_bits{(std::min)(data.size(), size_t{16}) * 8} {
+        for (size_t i = 0; i < total_bits / 8; ++i) {
+            words[i / 8] |= static_cast<u64>(data[i]) << ((i % 8) * 8);
+        }
+    }
 
     constexpr size_t GetBitsRead() const {
         return bits_read;
     }
 
     constexpr bool ReadBit() {
-        if (bits_read >= total_bits * 8) {
-            return 0;
-        }
-        const bool bit = ((*cur_byte >> next_bit) & 1) != 0;
-        ++next_bit;
-        while (next_bit >= 8) {
-            next_bit -= 8;
-            ++cur_byte;
-        }
-        ++bits_read;
-        return bit;
+        return ReadBits(1) != 0;
     }
 
     constexpr u32 ReadBits(std::size_t nBits) {
-        u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
+        // Bits past the end of the data read as zero, the words are zero padded
+        if (nBits == 0 || bits_read >= total_bits) {
+            return 0;
         }
-        return ret;
+        const size_t pos = bits_read;
+        u64 value = 0;
+        if (pos >= 64) {
+            value = words[1] >> (pos - 64);
+        } else if (pos == 0) {
+            value = words[0];
+        } else {
+            value = (words[0] >> pos) | (words[1] << (64 - pos));
+        }
+        bits_read = (std::min)(pos + nBits, total_bits);
+        return static_cast<u32>(value & ((u64{1} << nBits) - 1));
     }
 
     template <std::size_t nBits>
     constexpr u32 ReadBits() {
-        u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
-        }
-        return ret;
+        return ReadBits(nBits);
     }
 
 private:
-    const u8* cur_byte;
+    std::array<u64, 2> words{};
     size_t total_bits = 0;
-    size_t next_bit = 0;
     size_t bits_read = 0;
 };
 
@@ -115,35 +137,6 @@ private:
     std::size_t next_bit = 0;
 };
 
-template <typename IntType>
-class Bits {
-public:
-    explicit Bits(const IntType& v) : m_Bits(v) {}
-
-    Bits(const Bits&) = delete;
-    Bits& operator=(const Bits&) = delete;
-
-    u8 operator[](u32 bitPos) const {
-        return static_cast<u8>((m_Bits >> bitPos) & 1);
-    }
-
-    IntType operator()(u32 start, u32 end) const {
-        if (start == end) {
-            return (*this)[start];
-        } else if (start > end) {
-            u32 t = start;
-            start = end;
-            end = t;
-        }
-
-        u64 mask = (1 << (end - start + 1)) - 1;
-        return (m_Bits >> start) & static_cast<IntType>(mask);
-    }
-
-private:
-    const IntType& m_Bits;
-};
-
 enum class IntegerEncoding { JustBits, Quint, Trit };
 
 struct IntegerEncodedValue {
@@ -221,57 +214,100 @@ using IntegerEncodedVector = boost::container::static_vector<
         boost::container::inplace_alignment<alignof(IntegerEncodedValue)>,
         boost::container::throw_on_overflow<false>>::type>;
 
-static void DecodeTritBlock(InputBitStream& bits, IntegerEncodedVector& result, u32 nBitsPerValue) {
-    // Implement the algorithm in section C.2.12
-    std::array<u32, 5> m;
-    std::array<u32, 5> t;
-    u32 T;
-
-    // Read the trit encoded block according to
-    // table C.2.14
-    m[0] = bits.ReadBits(nBitsPerValue);
-    T = bits.ReadBits<2>();
-    m[1] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBits<2>() << 2;
-    m[2] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBit() << 4;
-    m[3] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBits<2>() << 5;
-    m[4] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBit() << 7;
-
+// Unpacks the five trits of an 8-bit trit block value, following section C.2.12
+static constexpr std::array<u8, 5> UnpackTrits(u32 T) {
+    const auto bits = [T](u32 start, u32 end) { return (T >> start) & ((2U << (end - start)) - 1); };
+    std::array<u8, 5> t{};
     u32 C = 0;
-
-    Bits<u32> Tb(T);
-    if (Tb(2, 4) == 7) {
-        C = (Tb(5, 7) << 2) | Tb(0, 1);
+    if (bits(2, 4) == 7) {
+        C = (bits(5, 7) << 2) | bits(0, 1);
         t[4] = t[3] = 2;
     } else {
-        C = Tb(0, 4);
-        if (Tb(5, 6) == 3) {
+        C = bits(0, 4);
+        if (bits(5, 6) == 3) {
             t[4] = 2;
-            t[3] = Tb[7];
+            t[3] = static_cast<u8>(bits(7, 7));
         } else {
-            t[4] = Tb[7];
-            t[3] = Tb(5, 6);
+            t[4] = static_cast<u8>(bits(7, 7));
+            t[3] = static_cast<u8>(bits(5, 6));
         }
     }
 
-    Bits<u32> Cb(C);
-    if (Cb(0, 1) == 3) {
+    const auto c = [C](u32 bit) { return (C >> bit) & 1; };
+    if ((C & 3) == 3) {
         t[2] = 2;
-        t[1] = Cb[4];
-        t[0] = (Cb[3] << 1) | (Cb[2] & ~Cb[3]);
-    } else if (Cb(2, 3) == 3) {
+        t[1] = static_cast<u8>(c(4));
+        t[0] = static_cast<u8>((c(3) << 1) | (c(2) & ~c(3) & 1));
+    } else if (((C >> 2) & 3) == 3) {
         t[2] = 2;
         t[1] = 2;
-        t[0] = Cb(0, 1);
+        t[0] = static_cast<u8>(C & 3);
     } else {
-        t[2] = Cb[4];
-        t[1] = Cb(2, 3);
-        t[0] = (Cb[1] << 1) | (Cb[0] & ~Cb[1]);
+        t[2] = static_cast<u8>(c(4));
+        t[1] = static_cast<u8>((C >> 2) & 3);
+        t[0] = static_cast<u8>((c(1) << 1) | (c(0) & ~c(1) & 1));
     }
+    return t;
+}
+
+// Unpacks the three quints of a 7-bit quint block value, following section C.2.12
+static constexpr std::array<u8, 3> UnpackQuints(u32 Q) {
+    const auto bits = [Q](u32 start, u32 end) { return (Q >> start) & ((2U << (end - start)) - 1); };
+    const auto q_bit = [Q](u32 bit) { return (Q >> bit) & 1; };
+    std::array<u8, 3> q{};
+    if (bits(1, 2) == 3 && bits(5, 6) == 0) {
+        q[0] = q[1] = 4;
+        q[2] = static_cast<u8>((q_bit(0) << 2) | ((q_bit(4) & ~q_bit(0) & 1) << 1) |
+                               (q_bit(3) & ~q_bit(0) & 1));
+        return q;
+    }
+
+    u32 C = 0;
+    if (bits(1, 2) == 3) {
+        q[2] = 4;
+        C = (bits(3, 4) << 3) | ((~bits(5, 6) & 3) << 1) | q_bit(0);
+    } else {
+        q[2] = static_cast<u8>(bits(5, 6));
+        C = bits(0, 4);
+    }
+    if ((C & 7) == 5) {
+        q[1] = 4;
+        q[0] = static_cast<u8>((C >> 3) & 3);
+    } else {
+        q[1] = static_cast<u8>((C >> 3) & 3);
+        q[0] = static_cast<u8>(C & 7);
+    }
+    return q;
+}
+
+template <typename T, size_t N>
+static constexpr std::array<T, N> MakeUnpackTable(T (*unpack)(u32)) {
+    std::array<T, N> table{};
+    for (u32 i = 0; i < N; ++i) {
+        table[i] = unpack(i);
+    }
+    return table;
+}
+
+// Every block value decodes to a fixed set of digits, so the branches above are folded into tables
+static constexpr auto TRIT_TABLE = MakeUnpackTable<std::array<u8, 5>, 256>(UnpackTrits);
+static constexpr auto QUINT_TABLE = MakeUnpackTable<std::array<u8, 3>, 128>(UnpackQuints);
 
+static void DecodeTritBlock(InputBitStream& bits, IntegerEncodedVector& result, u32 nBitsPerValue) {
+    // Read the trit encoded block according to table C.2.14
+    std::array<u32, 5> m;
+    m[0] = bits.ReadBits(nBitsPerValue);
+    u32 T = bits.ReadBits<2>();
+    m[1] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBits<2>() << 2;
+    m[2] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBits<1>() << 4;
+    m[3] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBits<2>() << 5;
+    m[4] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBits<1>() << 7;
+
+    const std::array<u8, 5>& t = TRIT_TABLE[T];
     for (std::size_t i = 0; i < 5; ++i) {
         IntegerEncodedValue& val = result.emplace_back(IntegerEncoding::Trit, nBitsPerValue);
         val.bit_value = m[i];
@@ -281,44 +317,16 @@ static void DecodeTritBlock(InputBitStream& bits, IntegerEncodedVector& result,
 
 static void DecodeQuintBlock(InputBitStream& bits, IntegerEncodedVector& result,
                              u32 nBitsPerValue) {
-    // Implement the algorithm in section C.2.12
-    u32 m[3];
-    u32 q[3];
-    u32 Q;
-
-    // Read the trit encoded block according to
-    // table C.2.15
+    // Read the quint encoded block according to table C.2.15
+    std::array<u32, 3> m;
     m[0] = bits.ReadBits(nBitsPerValue);
-    Q = bits.ReadBits<3>();
+    u32 Q = bits.ReadBits<3>();
     m[1] = bits.ReadBits(nBitsPerValue);
     Q |= bits.ReadBits<2>() << 3;
     m[2] = bits.ReadBits(nBitsPerValue);
     Q |= bits.ReadBits<2>() << 5;
 
-    Bits<u32> Qb(Q);
-    if (Qb(1, 2) == 3 && Qb(5, 6) == 0) {
-        q[0] = q[1] = 4;
-        q[2] = (Qb[0] << 2) | ((Qb[4] & ~Qb[0]) << 1) | (Qb[3] & ~Qb[0]);
-    } else {
-        u32 C = 0;
-        if (Qb(1, 2) == 3) {
-            q[2] = 4;
-            C = (Qb(3, 4) << 3) | ((~Qb(5, 6) & 3) << 1) | Qb[0];
-        } else {
-            q[2] = Qb(5, 6);
-            C = Qb(0, 4);
-        }
-
-        Bits<u32> Cb(C);
-        if (Cb(0, 2) == 5) {
-            q[1] = 4;
-            q[0] = Cb(3, 4);
-        } else {
-            q[1] = Cb(3, 4);
-            q[0] = Cb(0, 2);
-        }
-    }
-
+    const std::array<u8, 3>& q = QUINT_TABLE[Q];
     for (std::size_t i = 0; i < 3; ++i) {
         IntegerEncodedValue& val = result.emplace_back(IntegerEncoding::Quint, nBitsPerValue);
         val.bit_value = m[i];
@@ -847,7 +855,7 @@ static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, co
     // We now have enough to decode our integer sequence.
     IntegerEncodedVector decodedColorValues;
 
-    InputBitStream colorStream(data, 0);
+    InputBitStream colorStream(data);
     DecodeIntegerSequence(decodedColorValues, colorStream, range, nValues);
 
     // Once we have the decoded values, we need to dequantize them to the 0-255 range
@@ -1419,8 +1427,8 @@ static void FillError(std::span<u32> outBuf, u32 blockWidth, u32 blockHeight) {
     }
 }
 
-static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
-                            const u32 blockHeight, std::span<u32, 12 * 12> outBuf) {
+bool DecodeBlock(std::span<const u8, 16> inBuf, const u32 blockWidth, const u32 blockHeight,
+                 DecodedBlock& decoded, std::span<u32> outBuf) {
     InputBitStream strm(inBuf);
     TexelWeightParams weightParams = DecodeBlockInfo(strm);
 
@@ -1428,30 +1436,30 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
     if (weightParams.m_bError) {
         assert(false && "Invalid block mode");
         FillError(outBuf, blockWidth, blockHeight);
-        return;
+        return false;
     }
 
     if (weightParams.m_bVoidExtentLDR) {
         FillVoidExtentLDR(strm, outBuf, blockWidth, blockHeight);
-        return;
+        return false;
     }
 
     if (weightParams.m_bVoidExtentHDR) {
         assert(false && "HDR void extent blocks are unsupported!");
         FillError(outBuf, blockWidth, blockHeight);
-        return;
+        return false;
     }
 
     if (weightParams.m_Width > blockWidth) {
         assert(false && "Texel weight grid width should be smaller than block width");
         FillError(outBuf, blockWidth, blockHeight);
-        return;
+        return false;
     }
 
     if (weightParams.m_Height > blockHeight) {
         assert(false && "Texel weight grid height should be smaller than block height");
         FillError(outBuf, blockWidth, blockHeight);
-        return;
+        return false;
     }
 
     // Read num partitions
@@ -1461,7 +1469,7 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
     if (nPartitions == 4 && weightParams.m_bDualPlane) {
         assert(false && "Dual plane mode is incompatible with four partition blocks");
         FillError(outBuf, blockWidth, blockHeight);
-        return;
+        return false;
     }
 
     // Based on the number of partitions, read the color endpoint mode for
@@ -1613,42 +1621,143 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
     DecodeIntegerSequence(texelWeightValues, weightStream, weightParams.m_MaxWeight,
                           weightParams.GetNumWeightValues());
 
-    // Blocks can be at most 12x12, so we can have as many as 144 weights
-    u32 weights[2][144];
-    UnquantizeTexelWeights(weights, texelWeightValues, weightParams, blockWidth, blockHeight);
+    UnquantizeTexelWeights(decoded.weights, texelWeightValues, weightParams, blockWidth,
+                           blockHeight);
+
+    // Endpoints are expanded to 16 bits and stored in the byte order of the packed output
+    for (u32 partition = 0; partition < nPartitions; partition++) {
+        for (u32 lane = 0; lane < 4; lane++) {
+            const u32 c = (lane + 1) & 3;
+            decoded.endpoint_low[partition][lane] =
+                ReplicateByteTo16(static_cast<u32>(endpoints[partition][0].Component(c)));
+            decoded.endpoint_high[partition][lane] =
+                ReplicateByteTo16(static_cast<u32>(endpoints[partition][1].Component(c)));
+        }
+    }
 
-    // Now that we have endpoints and weights, we can interpolate and generate
-    // the proper decoding...
-    for (u32 j = 0; j < blockHeight; j++)
-        for (u32 i = 0; i < blockWidth; i++) {
-            u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions,
-                                              (blockHeight * blockWidth) < 32);
-            assert(partition < nPartitions);
-
-            Pixel p;
-            for (u32 c = 0; c < 4; c++) {
-                u32 C0 = endpoints[partition][0].Component(c);
-                C0 = ReplicateByteTo16(C0);
-                u32 C1 = endpoints[partition][1].Component(c);
-                C1 = ReplicateByteTo16(C1);
-
-                u32 plane = 0;
-                if (weightParams.m_bDualPlane && (((planeIdx + 1) & 3) == c)) {
-                    plane = 1;
-                }
+    decoded.dual_plane = weightParams.m_bDualPlane;
+    for (u32 lane = 0; lane < 4; lane++) {
+        decoded.plane_mask[lane] = decoded.dual_plane && lane == (planeIdx & 3) ? ~0U : 0U;
+    }
 
-                u32 weight = weights[plane][j * blockWidth + i];
-                u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
-                if (C == 65535) {
-                    p.Component(c) = 255;
-                } else {
-                    double Cf = static_cast<double>(C);
-                    p.Component(c) = static_cast<u16>(255.0 * (Cf / 65536.0) + 0.5);
-                }
+    decoded.single_partition = nPartitions == 1;
+    if (!decoded.single_partition) {
+        const bool smallBlock = (blockHeight * blockWidth) < 32;
+        for (u32 j = 0; j < blockHeight; j++) {
+            for (u32 i = 0; i < blockWidth; i++) {
+                const u32 partition =
+                    Select2DPartition(partitionIndex, i, j, nPartitions, smallBlock);
+                assert(partition < nPartitions);
+                decoded.partition[j * blockWidth + i] = static_cast<u8>(partition);
             }
+        }
+    }
+    return true;
+}
+
+// Interpolation of a texel between its endpoints, as described in C.2.19. The 16-bit result is
+// converted to UNORM8 with round to nearest, (255 * C + 32768) >> 16 is exact for all inputs.
+void InterpolateScalar(const DecodedBlock& block, u32 num_texels, u32* out) {
+    for (u32 texel = 0; texel < num_texels; texel++) {
+        const u32 partition = block.single_partition ? 0 : block.partition[texel];
+        u32 packed = 0;
+        for (u32 lane = 0; lane < 4; lane++) {
+            const u32 C0 = block.endpoint_low[partition][lane];
+            const u32 C1 = block.endpoint_high[partition][lane];
+            const u32 weight = block.weights[block.plane_mask[lane] != 0 ? 1 : 0][texel];
+            const u32 C = (C0 * (64 - weight) + C1 * weight + 32) >> 6;
+            packed |= ((255 * C + 32768) >> 16) << (lane * 8);
+        }
+        out[texel] = packed;
+    }
+}
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+static inline __m128i InterpolateTexelSSE41(__m128i low, __m128i high, __m128i weight) {
+    // low * (64 - w) + high * w == low * 64 + (high - low) * w, wrapping is fine here
+    __m128i c = _mm_mullo_epi32(_mm_sub_epi32(high, low), weight);
+    c = _mm_add_epi32(_mm_slli_epi32(low, 6), c);
+    c = _mm_srli_epi32(_mm_add_epi32(c, _mm_set1_epi32(32)), 6);
+    const __m128i c255 = _mm_sub_epi32(_mm_slli_epi32(c, 8), c);
+    return _mm_srli_epi32(_mm_add_epi32(c255, _mm_set1_epi32(32768)), 16);
+}
+
+void InterpolateSSE41(const DecodedBlock& block, u32 num_texels, u32* out) {
+    const __m128i plane_mask =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(block.plane_mask.data()));
+    const auto weight = [&](u32 texel) {
+        const __m128i w0 = _mm_set1_epi32(static_cast<s32>(block.weights[0][texel]));
+        if (!block.dual_plane) {
+            return w0;
+        }
+        const __m128i w1 = _mm_set1_epi32(static_cast<s32>(block.weights[1][texel]));
+        return _mm_blendv_epi8(w0, w1, plane_mask);
+    };
+    const auto texel_color = [&](u32 texel) {
+        const u32 partition = block.single_partition ? 0 : block.partition[texel];
+        const __m128i low =
+            _mm_load_si128(reinterpret_cast<const __m128i*>(block.endpoint_low[partition].data()));
+        const __m128i high =
+            _mm_load_si128(reinterpret_cast<const __m128i*>(block.endpoint_high[partition].data()));
+        return InterpolateTexelSSE41(low, high, weight(texel));
+    };
 
-            outBuf[j * blockWidth + i] = p.Pack();
+    u32 texel = 0;
+    for (; texel + 4 <= num_texels; texel += 4) {
+        const __m128i t01 = _mm_packus_epi32(texel_color(texel + 0), texel_color(texel + 1));
+        const __m128i t23 = _mm_packus_epi32(texel_color(texel + 2), texel_color(texel + 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + texel), _mm_packus_epi16(t01, t23));
+    }
+    for (; texel < num_texels; texel++) {
+        const __m128i t = _mm_packus_epi32(texel_color(texel), _mm_setzero_si128());
+        out[texel] = static_cast<u32>(_mm_cvtsi128_si32(_mm_packus_epi16(t, t)));
+    }
+}
+#endif
+
+static InterpolateFunction SelectInterpolateFunction() {
+#if defined(ARCHITECTURE_x86_64)
+    const auto& cpu_caps{Common::GetCPUCaps()};
+    if (cpu_caps.avx2) {
+        return InterpolateAVX2;
+    }
+    if (cpu_caps.sse4_1) {
+        return InterpolateSSE41;
+    }
+    return InterpolateScalar;
+#elif defined(ARCHITECTURE_arm64)
+    return InterpolateSSE41;
+#else
+    return InterpolateScalar;
+#endif
+}
+
+void DecompressBlocks(std::span<const u8> blocks, u32 block_width, u32 block_height,
+                      std::span<u32> output) {
+    static const InterpolateFunction interpolate = SelectInterpolateFunction();
+
+    // Decode the bitstreams of a batch first, then run the interpolation over the whole batch
+    constexpr size_t BATCH_SIZE = 8;
+    std::array<DecodedBlock, BATCH_SIZE> decoded;
+    std::array<u32*, BATCH_SIZE> destinations;
+
+    const u32 num_texels = block_width * block_height;
+    const size_t num_blocks = blocks.size() / 16;
+    for (size_t first = 0; first < num_blocks; first += BATCH_SIZE) {
+        const size_t batch_end = (std::min)(first + BATCH_SIZE, num_blocks);
+        size_t pending = 0;
+        for (size_t block = first; block < batch_end; ++block) {
+            const std::span<const u8, 16> block_data{blocks.subspan(block * 16, 16)};
+            const std::span<u32> block_output{output.subspan(block * num_texels, num_texels)};
+            if (DecodeBlock(block_data, block_width, block_height, decoded[pending],
+                            block_output)) {
+                destinations[pending++] = block_output.data();
+            }
+        }
+        for (size_t i = 0; i < pending; ++i) {
+            interpolate(decoded[i], num_texels, destinations[i]);
         }
+    }
 }
 
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
@@ -1664,23 +1773,26 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
             auto decompress_stride = [data, width, height, block_width, block_height, output, rows,
                                       cols, z, depth_offset, y_index] {
                 const u32 y = y_index * block_height;
-                for (u32 x_index = 0; x_index < cols; ++x_index) {
-                    const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
-                    const u32 x = x_index * block_width;
+                const u32 num_texels = block_width * block_height;
+                const u32 row_index = (z * rows * cols) + (y_index * cols);
 
-                    const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+                // Decode the whole row of blocks at once, into a buffer that every worker thread
+                // keeps between rows
+                thread_local std::vector<u32> uncompData;
+                uncompData.resize(cols * num_texels);
+                DecompressBlocks(data.subspan(row_index * 16, cols * 16), block_width,
+                                 block_height, uncompData);
 
-                    // Blocks can be at most 12x12
-                    std::array<u32, 12 * 12> uncompData;
-                    DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                    u32 decompWidth = (std::min)(block_width, width - x);
-                    u32 decompHeight = (std::min)(block_height, height - y);
+                const u32 decompHeight = (std::min)(block_height, height - y);
+                for (u32 x_index = 0; x_index < cols; ++x_index) {
+                    const u32 x = x_index * block_width;
+                    const u32 decompWidth = (std::min)(block_width, width - x);
+                    const u32* const block_texels = uncompData.data() + x_index * num_texels;
 
                     const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
                     for (u32 h = 0; h < decompHeight; ++h) {
-                        std::memcpy(outRow.data() + h * width * 4,
-                                    uncompData.data() + h * block_width, decompWidth * 4);
+                        std::memcpy(outRow.data() + h * width * 4, block_texels + h * block_width,
+                                    decompWidth * 4);
                     }
                 }
             };
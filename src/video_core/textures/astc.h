@@ -3,8 +3,16 @@
 
 #pragma once
 
+#include <cstdint>
+#include <span>
+
 namespace Tegra::Texture::ASTC {
 
+/// Decodes a contiguous run of 16-byte blocks. The texels of each block are written to output
+/// one block after another, as block_width * block_height packed RGBA8 values.
+void DecompressBlocks(std::span<const uint8_t> blocks, uint32_t block_width,
+                      uint32_t block_height, std::span<uint32_t> output);
+
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output);
 
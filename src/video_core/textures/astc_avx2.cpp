@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+#include "video_core/textures/astc_kernels.h"
+
+// This file is built with AVX2 enabled, it must only be called after checking the CPU caps.
+
+namespace Tegra::Texture::ASTC {
+
+static inline __m256i InterpolateTexelsAVX2(__m256i low, __m256i high, __m256i weight) {
+    // low * (64 - w) + high * w == low * 64 + (high - low) * w, wrapping is fine here
+    __m256i c = _mm256_mullo_epi32(_mm256_sub_epi32(high, low), weight);
+    c = _mm256_add_epi32(_mm256_slli_epi32(low, 6), c);
+    c = _mm256_srli_epi32(_mm256_add_epi32(c, _mm256_set1_epi32(32)), 6);
+    const __m256i c255 = _mm256_sub_epi32(_mm256_slli_epi32(c, 8), c);
+    return _mm256_srli_epi32(_mm256_add_epi32(c255, _mm256_set1_epi32(32768)), 16);
+}
+
+void InterpolateAVX2(const DecodedBlock& block, u32 num_texels, u32* out) {
+    const __m128i plane_mask_128 =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(block.plane_mask.data()));
+    const __m256i plane_mask = _mm256_set_m128i(plane_mask_128, plane_mask_128);
+
+    // Two texels per vector, the first one in the low 128-bit lane
+    const auto load_endpoints = [&](const auto& endpoint, u32 first, u32 second) {
+        const u32 p0 = block.single_partition ? 0 : block.partition[first];
+        const u32 p1 = block.single_partition ? 0 : block.partition[second];
+        return _mm256_set_m128i(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(endpoint[p1].data())),
+            _mm_load_si128(reinterpret_cast<const __m128i*>(endpoint[p0].data())));
+    };
+    const auto load_weights = [&](u32 plane, u32 first, u32 second) {
+        return _mm256_set_m128i(_mm_set1_epi32(static_cast<s32>(block.weights[plane][second])),
+                                _mm_set1_epi32(static_cast<s32>(block.weights[plane][first])));
+    };
+    const auto texel_pair = [&](u32 first, u32 second) {
+        __m256i weight = load_weights(0, first, second);
+        if (block.dual_plane) {
+            weight = _mm256_blendv_epi8(weight, load_weights(1, first, second), plane_mask);
+        }
+        return InterpolateTexelsAVX2(load_endpoints(block.endpoint_low, first, second),
+                                     load_endpoints(block.endpoint_high, first, second), weight);
+    };
+
+    // Packing works within 128-bit lanes, this restores the texel order afterwards
+    const __m256i texel_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    u32 texel = 0;
+    for (; texel + 8 <= num_texels; texel += 8) {
+        const __m256i t0123 = _mm256_packus_epi32(texel_pair(texel + 0, texel + 1),
+                                                  texel_pair(texel + 2, texel + 3));
+        const __m256i t4567 = _mm256_packus_epi32(texel_pair(texel + 4, texel + 5),
+                                                  texel_pair(texel + 6, texel + 7));
+        const __m256i packed = _mm256_packus_epi16(t0123, t4567);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + texel),
+                            _mm256_permutevar8x32_epi32(packed, texel_order));
+    }
+    for (; texel < num_texels; texel += 2) {
+        // An odd texel count interpolates the last texel twice
+        const u32 second = (std::min)(texel + 1, num_texels - 1);
+        const __m256i t01 = _mm256_packus_epi32(texel_pair(texel, second), _mm256_setzero_si256());
+        const __m256i packed = _mm256_packus_epi16(t01, t01);
+        out[texel] = static_cast<u32>(_mm256_extract_epi32(packed, 0));
+        out[second] = static_cast<u32>(_mm256_extract_epi32(packed, 4));
+    }
+}
+
+} // namespace Tegra::Texture::ASTC
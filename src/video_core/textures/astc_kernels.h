@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: Copyright 2025 Eden Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Tegra::Texture::ASTC {
+
+/// Block state left after the scalar bitstream decode, consumed by the interpolation kernels.
+/// Endpoint and plane lanes are in the byte order of the packed RGBA8 output.
+struct DecodedBlock {
+    alignas(16) std::array<std::array<u32, 4>, 4> endpoint_low;
+    alignas(16) std::array<std::array<u32, 4>, 4> endpoint_high;
+    /// Lanes set to all ones take their weight from the second plane
+    alignas(16) std::array<u32, 4> plane_mask;
+    /// Blocks can be at most 12x12, so we can have as many as 144 weights
+    u32 weights[2][144];
+    /// Partition of each texel, only valid when the block has more than one partition
+    std::array<u8, 144> partition;
+    bool dual_plane;
+    bool single_partition;
+};
+
+/// Decodes the bitstream of a block. Returns false when the block was written to output directly
+/// (void extent and error blocks), true when its texels still have to be interpolated.
+bool DecodeBlock(std::span<const u8, 16> data, u32 block_width, u32 block_height,
+                 DecodedBlock& decoded, std::span<u32> output);
+
+/// Interpolates the texels of a decoded block into packed RGBA8 values
+using InterpolateFunction = void (*)(const DecodedBlock& block, u32 num_texels, u32* out);
+
+void InterpolateScalar(const DecodedBlock& block, u32 num_texels, u32* out);
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+void InterpolateSSE41(const DecodedBlock& block, u32 num_texels, u32* out);
+#endif
+
+#if defined(ARCHITECTURE_x86_64)
+void InterpolateAVX2(const DecodedBlock& block, u32 num_texels, u32* out);
+#endif
+
+} // namespace Tegra::Texture::ASTC
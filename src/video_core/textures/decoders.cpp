@@ -4,14 +4,27 @@
 #include <array>
 #include <cmath>
 #include <cstring>
+#include <latch>
+#include <memory>
 #include <span>
 
+#if defined(ARCHITECTURE_x86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/div_ceil.h"
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
+#include "video_core/textures/workers.h"
 
 namespace Tegra::Texture {
 namespace {
@@ -88,6 +101,129 @@ void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32
     }
 }
 
+// Rows of a GOB are made of four 16-byte sectors, this is the swizzled offset of each of them
+constexpr u32 GOB_SECTOR_SIZE = 16;
+constexpr u32 GOB_SECTORS_X = GOB_SIZE_X / GOB_SECTOR_SIZE;
+
+constexpr auto MakeGOBSectorOffsets() {
+    std::array<u32, GOB_SIZE_Y * GOB_SECTORS_X> offsets{};
+    for (u32 line = 0; line < GOB_SIZE_Y; ++line) {
+        for (u32 sector = 0; sector < GOB_SECTORS_X; ++sector) {
+            offsets[line * GOB_SECTORS_X + sector] =
+                pdep<SWIZZLE_X_BITS>(sector * GOB_SECTOR_SIZE) | pdep<SWIZZLE_Y_BITS>(line);
+        }
+    }
+    return offsets;
+}
+
+constexpr auto GOB_SECTOR_OFFSETS = MakeGOBSectorOffsets();
+
+void CopySector(u8* dst, const u8* src) {
+#if defined(ARCHITECTURE_x86_64)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+#elif defined(ARCHITECTURE_arm64)
+    vst1q_u8(dst, vld1q_u8(src));
+#else
+    std::memcpy(dst, src, GOB_SECTOR_SIZE);
+#endif
+}
+
+/// Copies a whole GOB, or its top-left part at the edges of the image, with 16-byte moves
+template <bool TO_LINEAR>
+void CopyGOB(std::span<u8> output, std::span<const u8> input, u32 swizzled_offset,
+             u32 unswizzled_offset, u32 pitch, u32 num_lines, u32 num_sectors) {
+    const auto copy_sector = [&](u32 line, u32 sector) {
+        const u32 swizzled = swizzled_offset + GOB_SECTOR_OFFSETS[line * GOB_SECTORS_X + sector];
+        const u32 unswizzled = unswizzled_offset + line * pitch + sector * GOB_SECTOR_SIZE;
+        CopySector(&output[TO_LINEAR ? swizzled : unswizzled],
+                   &input[TO_LINEAR ? unswizzled : swizzled]);
+    };
+    if (num_lines == GOB_SIZE_Y && num_sectors == GOB_SECTORS_X) {
+        // Constant trip counts so the common case is fully unrolled
+        for (u32 line = 0; line < GOB_SIZE_Y; ++line) {
+            for (u32 sector = 0; sector < GOB_SECTORS_X; ++sector) {
+                copy_sector(line, sector);
+            }
+        }
+        return;
+    }
+    for (u32 line = 0; line < num_lines; ++line) {
+        for (u32 sector = 0; sector < num_sectors; ++sector) {
+            copy_sector(line, sector);
+        }
+    }
+}
+
+/// Equivalent to SwizzleImpl with 16 bytes per pixel, walking the image one GOB at a time.
+/// Large images are split in rows of GOBs across the texture workers.
+template <bool TO_LINEAR>
+void SwizzleGOBs(std::span<u8> output, std::span<const u8> input, u32 width, u32 height,
+                 u32 depth, u32 block_height, u32 block_depth, u32 stride) {
+    // Amount of linear data below which the work is not worth splitting
+    static constexpr u32 PARALLEL_THRESHOLD = 1U << 20;
+    static constexpr u32 BYTES_PER_TASK = 256U << 10;
+
+    const u32 pitch = width * GOB_SECTOR_SIZE;
+
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
+    const u32 slice_size =
+        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
+
+    const u32 block_height_mask = (1U << block_height) - 1;
+    const u32 block_depth_mask = (1U << block_depth) - 1;
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
+
+    const u32 gob_columns = Common::DivCeilLog2(pitch, GOB_SIZE_X_SHIFT);
+    const u32 gob_rows = Common::DivCeilLog2(height, GOB_SIZE_Y_SHIFT);
+
+    const auto swizzle_rows = [=](u32 slice, u32 first_row, u32 last_row) {
+        const u32 offset_z = (slice >> block_depth) * slice_size +
+                             ((slice & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
+        for (u32 block_y = first_row; block_y < last_row; ++block_y) {
+            const u32 offset_y = (block_y >> block_height) * block_size +
+                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+            const u32 line = block_y << GOB_SIZE_Y_SHIFT;
+            const u32 num_lines = (std::min)(GOB_SIZE_Y, height - line);
+            for (u32 gob_x = 0; gob_x < gob_columns; ++gob_x) {
+                const u32 x = gob_x << GOB_SIZE_X_SHIFT;
+                const u32 num_sectors = (std::min)(GOB_SIZE_X, pitch - x) / GOB_SECTOR_SIZE;
+                const u32 swizzled_offset = offset_z + offset_y + (gob_x << x_shift);
+                const u32 unswizzled_offset = slice * pitch * height + line * pitch + x;
+                CopyGOB<TO_LINEAR>(output, input, swizzled_offset, unswizzled_offset, pitch,
+                                   num_lines, num_sectors);
+            }
+        }
+    };
+
+    if (pitch * height * depth < PARALLEL_THRESHOLD) {
+        for (u32 slice = 0; slice < depth; ++slice) {
+            swizzle_rows(slice, 0, gob_rows);
+        }
+        return;
+    }
+    const u32 gob_row_size = pitch << GOB_SIZE_Y_SHIFT;
+    const u32 rows_per_task = (std::max)(1U, BYTES_PER_TASK / gob_row_size);
+    const u32 tasks_per_slice = Common::DivCeil(gob_rows, rows_per_task);
+
+    // Only the tasks of this call are waited for, the workers are shared with other decoders. The
+    // latch is shared with the tasks so that the last one may still touch it after the wait.
+    const auto done = std::make_shared<std::latch>(static_cast<std::ptrdiff_t>(depth) *
+                                                   tasks_per_slice);
+    Common::ThreadWorker& workers{GetThreadWorkers()};
+    for (u32 slice = 0; slice < depth; ++slice) {
+        for (u32 row = 0; row < gob_rows; row += rows_per_task) {
+            const u32 last_row = (std::min)(row + rows_per_task, gob_rows);
+            workers.QueueWork([swizzle_rows, done, slice, row, last_row] {
+                swizzle_rows(slice, row, last_row);
+                done->count_down();
+            });
+        }
+    }
+    done->wait();
+}
+
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
 void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height,
                         u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 num_lines,
@@ -166,8 +302,10 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
         BPP_CASE(6)
         BPP_CASE(8)
         BPP_CASE(12)
-        BPP_CASE(16)
 #undef BPP_CASE
+    case 16:
+        return SwizzleGOBs<TO_LINEAR>(output, input, width, height, depth, block_height,
+                                      block_depth, stride_alignment);
     default:
         ASSERT_MSG(false, "Invalid bytes_per_pixel={}", bytes_per_pixel);
         break;
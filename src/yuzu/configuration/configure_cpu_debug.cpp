@@ -34,6 +34,9 @@ void ConfigureCpuDebug::SetConfiguration() {
     ui->cpuopt_const_prop->setChecked(Settings::values.cpuopt_const_prop.GetValue());
     ui->cpuopt_misc_ir->setEnabled(runtime_lock);
     ui->cpuopt_misc_ir->setChecked(Settings::values.cpuopt_misc_ir.GetValue());
+    ui->cpuopt_live_range_reg_alloc->setEnabled(runtime_lock);
+    ui->cpuopt_live_range_reg_alloc->setChecked(
+        Settings::values.cpuopt_live_range_reg_alloc.GetValue());
     ui->cpuopt_reduce_misalign_checks->setEnabled(runtime_lock);
     ui->cpuopt_reduce_misalign_checks->setChecked(
         Settings::values.cpuopt_reduce_misalign_checks.GetValue());
@@ -58,6 +61,7 @@ void ConfigureCpuDebug::ApplyConfiguration() {
     Settings::values.cpuopt_context_elimination = ui->cpuopt_context_elimination->isChecked();
     Settings::values.cpuopt_const_prop = ui->cpuopt_const_prop->isChecked();
     Settings::values.cpuopt_misc_ir = ui->cpuopt_misc_ir->isChecked();
+    Settings::values.cpuopt_live_range_reg_alloc = ui->cpuopt_live_range_reg_alloc->isChecked();
     Settings::values.cpuopt_reduce_misalign_checks = ui->cpuopt_reduce_misalign_checks->isChecked();
     Settings::values.cpuopt_fastmem = ui->cpuopt_fastmem->isChecked();
     Settings::values.cpuopt_fastmem_exclusives = ui->cpuopt_fastmem_exclusives->isChecked();